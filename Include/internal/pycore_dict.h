@@ -12,6 +12,12 @@ extern "C" {
 #include "pycore_pyatomic_ft_wrappers.h" // FT_ATOMIC_LOAD_SSIZE_ACQUIRE
 #include "pycore_stackref.h"             // _PyStackRef
 
+// GC object standing for a combined table shared by copies of a dict
+extern PyTypeObject _PyDictSharedKeys_Type;
+
+// Detach the combined tables still shared when the interpreter is cleared
+extern void _PyDict_ClearSharedKeys(PyInterpreterState *interp);
+
 // Unsafe flavor of PyDict_GetItemWithError(): no error checking
 extern PyObject* _PyDict_GetItemWithError(PyObject *dp, PyObject *key);
 
@@ -14,6 +14,9 @@ extern "C" {
 struct _Py_dict_state {
     uint32_t next_keys_version;
     PyDict_WatchCallback watchers[DICT_MAX_WATCHERS];
+    // Maps the combined tables shared by copies of dicts to their
+    // _PyDictSharedKeys_Type object
+    struct _Py_hashtable_t *shared_keys;
 };
 
 #define _dict_state_INIT \
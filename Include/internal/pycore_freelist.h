@@ -47,16 +47,41 @@ _Py_freelists_GET(void)
 
 #define _Py_FREELIST_SIZE(NAME) (int)((_Py_freelists_GET()->NAME).size)
 
+// Current capacity of the free list, given its base capacity `maxsize`.
+static inline Py_ssize_t
+_PyFreeList_Capacity(struct _Py_freelist *fl, Py_ssize_t maxsize)
+{
+    return maxsize << fl->shift;
+}
+
+// Called when an item is rejected because the free list is full.  Once a
+// whole base capacity worth of items has been rejected, the capacity is
+// doubled (up to _Py_FREELIST_MAXSHIFT) so that bursty allocation patterns
+// are served from the free list next time.
+static inline void
+_PyFreeList_Overflow(struct _Py_freelist *fl, Py_ssize_t maxsize)
+{
+    if (++fl->overflows >= maxsize) {
+        fl->overflows = 0;
+        if (fl->shift < _Py_FREELIST_MAXSHIFT) {
+            fl->shift++;
+        }
+    }
+}
+
 static inline int
 _PyFreeList_Push(struct _Py_freelist *fl, void *obj, Py_ssize_t maxsize)
 {
-    if (fl->size < maxsize && fl->size >= 0) {
+    if (fl->size < _PyFreeList_Capacity(fl, maxsize) && fl->size >= 0) {
         FT_ATOMIC_STORE_PTR_RELAXED(*(void **)obj, fl->freelist);
         fl->freelist = obj;
         fl->size++;
         OBJECT_STAT_INC(to_freelist);
         return 1;
     }
+    if (fl->size >= 0) {
+        _PyFreeList_Overflow(fl, maxsize);
+    }
     return 0;
 }
 
@@ -86,9 +111,13 @@ _PyFreeList_Pop(struct _Py_freelist *fl)
 {
     PyObject *op = _PyFreeList_PopNoStats(fl);
     if (op != NULL) {
+        fl->hits++;
         OBJECT_STAT_INC(from_freelist);
         _Py_NewReference(op);
     }
+    else {
+        fl->misses++;
+    }
     return op;
 }
 
@@ -97,8 +126,12 @@ _PyFreeList_PopMem(struct _Py_freelist *fl)
 {
     void *op = _PyFreeList_PopNoStats(fl);
     if (op != NULL) {
+        fl->hits++;
         OBJECT_STAT_INC(from_freelist);
     }
+    else {
+        fl->misses++;
+    }
     return op;
 }
 
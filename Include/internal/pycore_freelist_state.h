@@ -25,6 +25,17 @@ extern "C" {
 #  define Py_object_stack_chunks_MAXFREELIST 4
 #  define Py_unicode_writers_MAXFREELIST 1
 #  define Py_pymethodobjects_MAXFREELIST 20
+#  define Py_cells_MAXFREELIST 80
+#  define Py_enumerates_MAXFREELIST 20
+#  define Py_range_iters_MAXFREELIST 20
+#  define PyGen_MAXSAVESLOTS 32      // Largest generator frame (in slots) to save on freelist
+#  define Py_gens_MAXFREELIST 20     // Maximum number of generators of each frame size to save
+
+// The *_MAXFREELIST values above are the base capacities.  A freelist that
+// keeps overflowing doubles its capacity, up to
+// (base << _Py_FREELIST_MAXSHIFT) entries, and halves it again at each
+// full garbage collection.
+#  define _Py_FREELIST_MAXSHIFT 3
 
 // A generic freelist of either PyObjects or other data structures.
 struct _Py_freelist {
@@ -35,6 +46,17 @@ struct _Py_freelist {
 
     // The number of items in the free list or -1 if the free list is disabled
     Py_ssize_t size;
+
+    // The capacity is the base capacity shifted left by `shift`.
+    int shift;
+
+    // Number of items rejected because the free list was full since the
+    // capacity was last adjusted.
+    Py_ssize_t overflows;
+
+    // Number of pops served from the free list (hits) or not (misses).
+    Py_ssize_t hits;
+    Py_ssize_t misses;
 };
 
 struct _Py_freelists {
@@ -54,6 +76,12 @@ struct _Py_freelists {
     struct _Py_freelist object_stack_chunks;
     struct _Py_freelist unicode_writers;
     struct _Py_freelist pymethodobjects;
+    struct _Py_freelist cells;
+    struct _Py_freelist enumerates;
+    struct _Py_freelist range_iters;
+    // Generators, coroutines and async generators share one layout; they
+    // are binned by the number of slots of their embedded frame.
+    struct _Py_freelist gens[PyGen_MAXSAVESLOTS];
 };
 
 #ifdef __cplusplus
@@ -233,7 +233,9 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(_asyncio_future_blocking)
         STRUCT_FOR_ID(_blksize)
         STRUCT_FOR_ID(_bootstrap)
+        STRUCT_FOR_ID(_cancelled)
         STRUCT_FOR_ID(_check_retval_)
+        STRUCT_FOR_ID(_clock_resolution)
         STRUCT_FOR_ID(_dealloc_warn)
         STRUCT_FOR_ID(_feature_version)
         STRUCT_FOR_ID(_field_types)
@@ -254,17 +256,27 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(_loop)
         STRUCT_FOR_ID(_needs_com_addref_)
         STRUCT_FOR_ID(_only_immortal)
+        STRUCT_FOR_ID(_process_events)
+        STRUCT_FOR_ID(_ready)
+        STRUCT_FOR_ID(_repr_info)
         STRUCT_FOR_ID(_restype_)
+        STRUCT_FOR_ID(_run)
+        STRUCT_FOR_ID(_scheduled)
+        STRUCT_FOR_ID(_selector)
         STRUCT_FOR_ID(_showwarnmsg)
         STRUCT_FOR_ID(_shutdown)
         STRUCT_FOR_ID(_slotnames)
+        STRUCT_FOR_ID(_stopping)
         STRUCT_FOR_ID(_strptime)
         STRUCT_FOR_ID(_strptime_datetime_date)
         STRUCT_FOR_ID(_strptime_datetime_datetime)
         STRUCT_FOR_ID(_strptime_datetime_time)
+        STRUCT_FOR_ID(_timer_cancelled_count)
+        STRUCT_FOR_ID(_timer_handle_cancelled)
         STRUCT_FOR_ID(_type_)
         STRUCT_FOR_ID(_uninitialized_submodules)
         STRUCT_FOR_ID(_warn_unawaited_coroutine)
+        STRUCT_FOR_ID(_when)
         STRUCT_FOR_ID(_xoptions)
         STRUCT_FOR_ID(abs_tol)
         STRUCT_FOR_ID(access)
@@ -402,6 +414,7 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(end_lineno)
         STRUCT_FOR_ID(end_offset)
         STRUCT_FOR_ID(endpos)
+        STRUCT_FOR_ID(entries)
         STRUCT_FOR_ID(entrypoint)
         STRUCT_FOR_ID(env)
         STRUCT_FOR_ID(errors)
@@ -550,6 +563,7 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(mapping)
         STRUCT_FOR_ID(match)
         STRUCT_FOR_ID(max_length)
+        STRUCT_FOR_ID(max_workers)
         STRUCT_FOR_ID(maxdigits)
         STRUCT_FOR_ID(maxevents)
         STRUCT_FOR_ID(maxlen)
@@ -565,6 +579,7 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(microsecond)
         STRUCT_FOR_ID(milliseconds)
         STRUCT_FOR_ID(minute)
+        STRUCT_FOR_ID(mmap)
         STRUCT_FOR_ID(mod)
         STRUCT_FOR_ID(mode)
         STRUCT_FOR_ID(module)
@@ -633,6 +648,7 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(pi_factory)
         STRUCT_FOR_ID(pid)
         STRUCT_FOR_ID(policy)
+        STRUCT_FOR_ID(popleft)
         STRUCT_FOR_ID(pos)
         STRUCT_FOR_ID(pos1)
         STRUCT_FOR_ID(pos2)
@@ -671,6 +687,7 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(return)
         STRUCT_FOR_ID(reverse)
         STRUCT_FOR_ID(reversed)
+        STRUCT_FOR_ID(run)
         STRUCT_FOR_ID(salt)
         STRUCT_FOR_ID(sched_priority)
         STRUCT_FOR_ID(scheduler)
@@ -678,11 +695,13 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(security_attributes)
         STRUCT_FOR_ID(seek)
         STRUCT_FOR_ID(seekable)
+        STRUCT_FOR_ID(select)
         STRUCT_FOR_ID(selectors)
         STRUCT_FOR_ID(self)
         STRUCT_FOR_ID(send)
         STRUCT_FOR_ID(sep)
         STRUCT_FOR_ID(sequence)
+        STRUCT_FOR_ID(sequential)
         STRUCT_FOR_ID(server_hostname)
         STRUCT_FOR_ID(server_side)
         STRUCT_FOR_ID(session)
@@ -739,6 +758,7 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(text)
         STRUCT_FOR_ID(threading)
         STRUCT_FOR_ID(throw)
+        STRUCT_FOR_ID(time)
         STRUCT_FOR_ID(timeout)
         STRUCT_FOR_ID(timer)
         STRUCT_FOR_ID(times)
@@ -774,6 +794,7 @@ struct _Py_global_strings {
         STRUCT_FOR_ID(wbits)
         STRUCT_FOR_ID(week)
         STRUCT_FOR_ID(weekday)
+        STRUCT_FOR_ID(when)
         STRUCT_FOR_ID(which)
         STRUCT_FOR_ID(who)
         STRUCT_FOR_ID(withdata)
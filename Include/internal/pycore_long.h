@@ -117,6 +117,13 @@ PyAPI_FUNC(PyObject*) _PyLong_Add(PyLongObject *left, PyLongObject *right);
 PyAPI_FUNC(PyObject*) _PyLong_Multiply(PyLongObject *left, PyLongObject *right);
 PyAPI_FUNC(PyObject*) _PyLong_Subtract(PyLongObject *left, PyLongObject *right);
 
+// Multiplication and division algorithms used for large ints, bypassing the
+// size cutoffs.  The products ignore the signs.
+// Export for '_testinternalcapi' shared extension.
+PyAPI_FUNC(PyObject*) _PyLong_MultiplyToom3(PyLongObject *a, PyLongObject *b);
+PyAPI_FUNC(PyObject*) _PyLong_MultiplyNTT(PyLongObject *a, PyLongObject *b);
+PyAPI_FUNC(PyObject*) _PyLong_DivremBZ(PyLongObject *a, PyLongObject *b);
+
 // Export for 'binascii' shared extension.
 PyAPI_DATA(unsigned char) _PyLong_DigitValue[256];
 
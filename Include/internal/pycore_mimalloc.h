@@ -60,6 +60,11 @@ struct _mimalloc_interp_state {
 struct _mimalloc_thread_state {
     mi_heap_t *current_object_heap;
     mi_heap_t heaps[_Py_MIMALLOC_HEAP_COUNT];
+    // Object heaps used inside an allocation scope, from
+    // _Py_MIMALLOC_HEAP_OBJECT on (the _Py_MIMALLOC_HEAP_MEM entry is
+    // unused). Each shares the tag of heaps[i], which takes over its pages
+    // when the outermost scope exits.
+    mi_heap_t scoped_heaps[_Py_MIMALLOC_HEAP_COUNT];
     mi_tld_t tld;
     int initialized;
     struct llist_node page_list;
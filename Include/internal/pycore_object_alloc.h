@@ -14,18 +14,30 @@ extern "C" {
 #endif
 
 #ifdef Py_GIL_DISABLED
+// Object heaps of the thread: the scoped heaps inside an allocation scope
+// (see _PyMem_EnterAllocationScope()), the regular heaps otherwise.
 static inline mi_heap_t *
-_PyObject_GetAllocationHeap(_PyThreadStateImpl *tstate, PyTypeObject *tp)
+_PyObject_GetObjectHeaps(_PyThreadStateImpl *tstate)
 {
     struct _mimalloc_thread_state *m = &tstate->mimalloc;
+    if (tstate->allocation_scope_depth > 0) {
+        return m->scoped_heaps;
+    }
+    return m->heaps;
+}
+
+static inline mi_heap_t *
+_PyObject_GetAllocationHeap(_PyThreadStateImpl *tstate, PyTypeObject *tp)
+{
+    mi_heap_t *heaps = _PyObject_GetObjectHeaps(tstate);
     if (_PyType_HasFeature(tp, Py_TPFLAGS_PREHEADER)) {
-        return &m->heaps[_Py_MIMALLOC_HEAP_GC_PRE];
+        return &heaps[_Py_MIMALLOC_HEAP_GC_PRE];
     }
     else if (_PyType_IS_GC(tp)) {
-        return &m->heaps[_Py_MIMALLOC_HEAP_GC];
+        return &heaps[_Py_MIMALLOC_HEAP_GC];
     }
     else {
-        return &m->heaps[_Py_MIMALLOC_HEAP_OBJECT];
+        return &heaps[_Py_MIMALLOC_HEAP_OBJECT];
     }
 }
 #endif
@@ -45,7 +57,8 @@ _PyObject_MallocWithType(PyTypeObject *tp, size_t size)
 #endif
     void *mem = PyObject_Malloc(size);
 #ifdef Py_GIL_DISABLED
-    m->current_object_heap = &m->heaps[_Py_MIMALLOC_HEAP_OBJECT];
+    m->current_object_heap =
+        &_PyObject_GetObjectHeaps(tstate)[_Py_MIMALLOC_HEAP_OBJECT];
 #endif
     return mem;
 }
@@ -60,7 +73,8 @@ _PyObject_ReallocWithType(PyTypeObject *tp, void *ptr, size_t size)
 #endif
     void *mem = PyObject_Realloc(ptr, size);
 #ifdef Py_GIL_DISABLED
-    m->current_object_heap = &m->heaps[_Py_MIMALLOC_HEAP_OBJECT];
+    m->current_object_heap =
+        &_PyObject_GetObjectHeaps(tstate)[_Py_MIMALLOC_HEAP_OBJECT];
 #endif
     return mem;
 }
@@ -47,6 +47,13 @@ struct _pymem_allocators {
     } debug;
     int is_debug_enabled;
     PyObjectArenaAllocator obj_arena;
+    /* Set by _PyMem_SetArenaOptions() */
+    int arena_hugepages;
+    int arena_numa;
+    /* Second half of the last huge page region split into two arenas */
+    void *arena_spare;
+    /* PYTHON_MALLOC_RELEASE_THRESHOLD, in bytes (0: disabled) */
+    size_t release_threshold;
 };
 
 struct _Py_mem_interp_free_queue {
@@ -116,6 +123,20 @@ extern wchar_t *_PyMem_DefaultRawWcsdup(const wchar_t *str);
 /* Is the debug allocator enabled? */
 extern int _PyMem_DebugEnabled(void);
 
+/* Back new arenas with transparent huge pages (PYTHON_MALLOC_HUGEPAGES)
+   and/or prefer the NUMA node of the allocating thread for their memory
+   (PYTHON_MALLOC_NUMA).  Only affects arenas allocated after the call. */
+extern void _PyMem_SetArenaOptions(int hugepages, int numa);
+
+/* Give the memory of free pymalloc pools back to the OS and force mimalloc
+   to purge the free pages of the current thread.  Return the number of
+   bytes released from pymalloc pools. */
+extern Py_ssize_t _PyMem_ReleaseFreeMemory(PyInterpreterState *interp);
+
+/* Called after full collections: release free pymalloc pools if they hold
+   at least PYTHON_MALLOC_RELEASE_THRESHOLD bytes. */
+extern void _PyMem_ReleaseFreeMemoryIfNeeded(PyInterpreterState *interp);
+
 // Enqueue a pointer to be freed possibly after some delay.
 extern void _PyMem_FreeDelayed(void *ptr);
 
@@ -145,6 +166,15 @@ extern void _PyMem_AbandonDelayed(PyThreadState *tstate);
 // On interpreter shutdown, frees all delayed free requests.
 extern void _PyMem_FiniDelayed(PyInterpreterState *interp);
 
+// Enter and exit an allocation scope: non-GC objects allocated by the
+// thread inside the scope are kept apart from longer-lived objects.
+// Exiting without a matching enter raises RuntimeError and returns -1.
+extern void _PyMem_EnterAllocationScope(PyThreadState *tstate);
+extern int _PyMem_ExitAllocationScope(PyThreadState *tstate);
+
+// Type of sys._allocation_scope, a context manager around both functions.
+extern PyTypeObject _PyAllocationScope_Type;
+
 #ifdef __cplusplus
 }
 #endif
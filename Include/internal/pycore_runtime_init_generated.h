@@ -742,7 +742,9 @@ extern "C" {
     INIT_ID(_asyncio_future_blocking), \
     INIT_ID(_blksize), \
     INIT_ID(_bootstrap), \
+    INIT_ID(_cancelled), \
     INIT_ID(_check_retval_), \
+    INIT_ID(_clock_resolution), \
     INIT_ID(_dealloc_warn), \
     INIT_ID(_feature_version), \
     INIT_ID(_field_types), \
@@ -763,17 +765,27 @@ extern "C" {
     INIT_ID(_loop), \
     INIT_ID(_needs_com_addref_), \
     INIT_ID(_only_immortal), \
+    INIT_ID(_process_events), \
+    INIT_ID(_ready), \
+    INIT_ID(_repr_info), \
     INIT_ID(_restype_), \
+    INIT_ID(_run), \
+    INIT_ID(_scheduled), \
+    INIT_ID(_selector), \
     INIT_ID(_showwarnmsg), \
     INIT_ID(_shutdown), \
     INIT_ID(_slotnames), \
+    INIT_ID(_stopping), \
     INIT_ID(_strptime), \
     INIT_ID(_strptime_datetime_date), \
     INIT_ID(_strptime_datetime_datetime), \
     INIT_ID(_strptime_datetime_time), \
+    INIT_ID(_timer_cancelled_count), \
+    INIT_ID(_timer_handle_cancelled), \
     INIT_ID(_type_), \
     INIT_ID(_uninitialized_submodules), \
     INIT_ID(_warn_unawaited_coroutine), \
+    INIT_ID(_when), \
     INIT_ID(_xoptions), \
     INIT_ID(abs_tol), \
     INIT_ID(access), \
@@ -911,6 +923,7 @@ extern "C" {
     INIT_ID(end_lineno), \
     INIT_ID(end_offset), \
     INIT_ID(endpos), \
+    INIT_ID(entries), \
     INIT_ID(entrypoint), \
     INIT_ID(env), \
     INIT_ID(errors), \
@@ -1059,6 +1072,7 @@ extern "C" {
     INIT_ID(mapping), \
     INIT_ID(match), \
     INIT_ID(max_length), \
+    INIT_ID(max_workers), \
     INIT_ID(maxdigits), \
     INIT_ID(maxevents), \
     INIT_ID(maxlen), \
@@ -1074,6 +1088,7 @@ extern "C" {
     INIT_ID(microsecond), \
     INIT_ID(milliseconds), \
     INIT_ID(minute), \
+    INIT_ID(mmap), \
     INIT_ID(mod), \
     INIT_ID(mode), \
     INIT_ID(module), \
@@ -1142,6 +1157,7 @@ extern "C" {
     INIT_ID(pi_factory), \
     INIT_ID(pid), \
     INIT_ID(policy), \
+    INIT_ID(popleft), \
     INIT_ID(pos), \
     INIT_ID(pos1), \
     INIT_ID(pos2), \
@@ -1180,6 +1196,7 @@ extern "C" {
     INIT_ID(return), \
     INIT_ID(reverse), \
     INIT_ID(reversed), \
+    INIT_ID(run), \
     INIT_ID(salt), \
     INIT_ID(sched_priority), \
     INIT_ID(scheduler), \
@@ -1187,11 +1204,13 @@ extern "C" {
     INIT_ID(security_attributes), \
     INIT_ID(seek), \
     INIT_ID(seekable), \
+    INIT_ID(select), \
     INIT_ID(selectors), \
     INIT_ID(self), \
     INIT_ID(send), \
     INIT_ID(sep), \
     INIT_ID(sequence), \
+    INIT_ID(sequential), \
     INIT_ID(server_hostname), \
     INIT_ID(server_side), \
     INIT_ID(session), \
@@ -1248,6 +1267,7 @@ extern "C" {
     INIT_ID(text), \
     INIT_ID(threading), \
     INIT_ID(throw), \
+    INIT_ID(time), \
     INIT_ID(timeout), \
     INIT_ID(timer), \
     INIT_ID(times), \
@@ -1283,6 +1303,7 @@ extern "C" {
     INIT_ID(wbits), \
     INIT_ID(week), \
     INIT_ID(weekday), \
+    INIT_ID(when), \
     INIT_ID(which), \
     INIT_ID(who), \
     INIT_ID(withdata), \
@@ -31,6 +31,9 @@ typedef struct _PyThreadStateImpl {
     struct _qsbr_thread_state *qsbr;  // only used by free-threaded build
     struct llist_node mem_free_queue; // delayed free queue
 
+    // Nesting depth of _PyMem_EnterAllocationScope() calls
+    int allocation_scope_depth;
+
 
 #ifdef Py_GIL_DISABLED
     struct _gc_thread_state gc;
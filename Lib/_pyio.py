@@ -26,6 +26,9 @@
 # open() uses st_blksize whenever we can
 DEFAULT_BUFFER_SIZE = 8 * 1024  # bytes
 
+# Largest buffer of a BufferedReader in sequential mode.
+_SEQUENTIAL_MAX_BUFFER_SIZE = 256 * 1024  # bytes
+
 # NOTE: Base classes defined here are registered with the "official" ABCs
 # defined in io.py. We don't use real inheritance though, because we don't want
 # to inherit the C implementations.
@@ -72,7 +75,8 @@ def text_encoding(encoding, stacklevel=2):
 # See init_set_builtins_open() in Python/pylifecycle.c.
 @staticmethod
 def open(file, mode="r", buffering=-1, encoding=None, errors=None,
-         newline=None, closefd=True, opener=None):
+         newline=None, closefd=True, opener=None, *, sequential=False,
+         mmap=False):
 
     r"""Open file and return a stream.  Raise OSError upon failure.
 
@@ -175,6 +179,15 @@ def open(file, mode="r", buffering=-1, encoding=None, errors=None,
     descriptor (passing os.open as *opener* results in functionality similar to
     passing None).
 
+    If sequential is true, the file is expected to be read from start to
+    end, for example a large file being scanned: the buffer grows while the
+    file is read sequentially, and the operating system is asked to read
+    ahead.  It is only supported by buffered files opened for reading only.
+
+    If mmap is true, the file is memory mapped and a FileIO object serving
+    reads from the mapping is returned instead of a buffered file.  It is
+    only supported in binary mode for reading only.
+
     open() returns a file object whose type depends on the mode, and
     through which the standard file operations such as reading and writing
     are performed. When open() is used to open a file in a text mode ('w',
@@ -223,6 +236,10 @@ def open(file, mode="r", buffering=-1, encoding=None, errors=None,
         raise ValueError("binary mode doesn't take an errors argument")
     if binary and newline is not None:
         raise ValueError("binary mode doesn't take a newline argument")
+    if sequential and not (reading and not updating):
+        raise ValueError("sequential mode is only supported for reading")
+    if mmap and not (binary and reading and not updating):
+        raise ValueError("mmap mode is only supported for binary reading")
     if binary and buffering == 1:
         import warnings
         warnings.warn("line buffering (buffering=1) isn't supported in binary "
@@ -234,7 +251,11 @@ def open(file, mode="r", buffering=-1, encoding=None, errors=None,
                  (writing and "w" or "") +
                  (appending and "a" or "") +
                  (updating and "+" or ""),
-                 closefd, opener=opener)
+                 closefd, opener=opener, mmap=mmap,
+                 sequential=mmap and sequential)
+    if mmap:
+        # The mapping replaces the buffer
+        return raw
     result = raw
     try:
         line_buffering = False
@@ -246,15 +267,17 @@ def open(file, mode="r", buffering=-1, encoding=None, errors=None,
         if buffering < 0:
             raise ValueError("invalid buffering size")
         if buffering == 0:
-            if binary:
-                return result
-            raise ValueError("can't have unbuffered text I/O")
+            if not binary:
+                raise ValueError("can't have unbuffered text I/O")
+            if sequential:
+                raise ValueError("can't have unbuffered sequential I/O")
+            return result
         if updating:
             buffer = BufferedRandom(raw, buffering)
         elif creating or writing or appending:
             buffer = BufferedWriter(raw, buffering)
         elif reading:
-            buffer = BufferedReader(raw, buffering)
+            buffer = BufferedReader(raw, buffering, sequential=sequential)
         else:
             raise ValueError("unknown mode: %r" % mode)
         result = buffer
@@ -1004,16 +1027,20 @@ def seekable(self):
 
 class BufferedReader(_BufferedIOMixin):
 
-    """BufferedReader(raw[, buffer_size])
+    """BufferedReader(raw[, buffer_size][, *, sequential])
 
     A buffer for a readable, sequential BaseRawIO object.
 
     The constructor creates a BufferedReader for the given readable raw
     stream and buffer_size. If buffer_size is omitted, DEFAULT_BUFFER_SIZE
     is used.
+
+    If sequential is true, the buffer grows while the stream is read
+    sequentially, and the operating system is asked to read ahead.
     """
 
-    def __init__(self, raw, buffer_size=DEFAULT_BUFFER_SIZE):
+    def __init__(self, raw, buffer_size=DEFAULT_BUFFER_SIZE, *,
+                 sequential=False):
         """Create a new buffered reader using the given readable raw IO object.
         """
         if not raw.readable():
@@ -1023,9 +1050,29 @@ def __init__(self, raw, buffer_size=DEFAULT_BUFFER_SIZE):
         if buffer_size <= 0:
             raise ValueError("invalid buffer size")
         self.buffer_size = buffer_size
+        self._sequential = sequential
+        self._sequential_min_size = buffer_size
+        self._sequential_seeked = False
+        if sequential and hasattr(os, 'posix_fadvise'):
+            try:
+                os.posix_fadvise(raw.fileno(), 0, 0,
+                                 os.POSIX_FADV_SEQUENTIAL)
+            except (OSError, ValueError):
+                # Read-ahead hints are only an optimization.
+                pass
         self._reset_read_buf()
         self._read_lock = Lock()
 
+    def _grow_buffer(self):
+        # Called before filling the empty buffer in sequential mode: the
+        # buffer doubles up to _SEQUENTIAL_MAX_BUFFER_SIZE, except for the
+        # first fill after a seek.
+        if self._sequential_seeked:
+            self._sequential_seeked = False
+        elif self.buffer_size < _SEQUENTIAL_MAX_BUFFER_SIZE:
+            self.buffer_size = min(self.buffer_size * 2,
+                                   _SEQUENTIAL_MAX_BUFFER_SIZE)
+
     def readable(self):
         return self.raw.readable()
 
@@ -1081,6 +1128,8 @@ def _read_unlocked(self, n=None):
             return buf[pos:pos+n]
         # Slow path: read from the stream until enough bytes are read,
         # or until an EOF occurs or until read() would block.
+        if self._sequential:
+            self._grow_buffer()
         chunks = [buf[pos:]]
         wanted = max(self.buffer_size, n)
         while avail < n:
@@ -1113,6 +1162,8 @@ def _peek_unlocked(self, n=0):
         want = min(n, self.buffer_size)
         have = len(self._read_buf) - self._read_pos
         if have < want or have <= 0:
+            if self._sequential and have <= 0:
+                self._grow_buffer()
             to_read = self.buffer_size - have
             current = self.raw.read(to_read)
             if current:
@@ -1200,6 +1251,9 @@ def seek(self, pos, whence=0):
                 pos -= len(self._read_buf) - self._read_pos
             pos = _BufferedIOMixin.seek(self, pos, whence)
             self._reset_read_buf()
+            if self._sequential:
+                self.buffer_size = self._sequential_min_size
+                self._sequential_seeked = True
             return pos
 
 class BufferedWriter(_BufferedIOMixin):
@@ -1473,8 +1527,14 @@ class FileIO(RawIOBase):
     _appending = False
     _seekable = None
     _closefd = True
-
-    def __init__(self, file, mode='r', closefd=True, opener=None):
+    _sequential = False
+    _mapped = False
+    _map = None
+    _map_view = None
+    _map_pos = 0
+
+    def __init__(self, file, mode='r', closefd=True, opener=None, *,
+                 mmap=False, sequential=False):
         """Open a file.  The mode can be 'r' (default), 'w', 'x' or 'a' for reading,
         writing, exclusive creation or appending.  The file will be created if it
         doesn't exist when opened for writing or appending; it will be truncated
@@ -1486,6 +1546,13 @@ def __init__(self, file, mode='r', closefd=True, opener=None):
         object is then obtained by calling opener with (*name*, *flags*).
         *opener* must return an open file descriptor (passing os.open as *opener*
         results in functionality similar to passing None).
+
+        If *mmap* is true, the file, which must be a regular file opened for
+        reading only, is memory mapped: reads are served from the mapping
+        without system calls and getbuffer() returns a view of the mapping.
+        If *sequential* is true, the operating system is told that the file
+        will be read sequentially, otherwise a mapped file is expected to be
+        read at random positions.
         """
         if self._fd >= 0:
             # Have to close the existing file first.
@@ -1495,6 +1562,9 @@ def __init__(self, file, mode='r', closefd=True, opener=None):
                     os.close(self._fd)
             finally:
                 self._fd = -1
+        self._unmap()
+        self._mapped = False
+        self._sequential = sequential
 
         if isinstance(file, float):
             raise TypeError('integer argument expected, got float')
@@ -1537,6 +1607,9 @@ def __init__(self, file, mode='r', closefd=True, opener=None):
             self._readable = True
             self._writable = True
 
+        if mmap and not (self._readable and not self._writable):
+            raise ValueError('mmap mode is only supported for reading')
+
         if self._readable and self._writable:
             flags |= os.O_RDWR
         elif self._readable:
@@ -1592,6 +1665,16 @@ def __init__(self, file, mode='r', closefd=True, opener=None):
                 except OSError as e:
                     if e.errno != errno.ESPIPE:
                         raise
+            if mmap:
+                if not stat.S_ISREG(self._stat_atopen.st_mode):
+                    raise UnsupportedOperation(
+                        'mmap mode requires a regular file')
+                self._map_pos = os.lseek(fd, 0, SEEK_CUR)
+                self._seekable = True
+                self._remap(fd)
+                self._mapped = True
+            elif sequential and hasattr(os, 'posix_fadvise'):
+                os.posix_fadvise(fd, 0, 0, os.POSIX_FADV_SEQUENTIAL)
         except:
             self._stat_atopen = None
             if owned_fd is not None:
@@ -1599,6 +1682,59 @@ def __init__(self, file, mode='r', closefd=True, opener=None):
             raise
         self._fd = fd
 
+    def _unmap(self):
+        # Views returned by getbuffer() keep their own reference to the
+        # mapping.
+        if self._map_view is not None:
+            self._map_view.release()
+        self._map = self._map_view = None
+
+    def _remap(self, fd):
+        # Map the whole file again if its size changed since it was last
+        # mapped.
+        size = os.fstat(fd).st_size
+        if size == (len(self._map) if self._map is not None else 0):
+            return
+        if not size:
+            # The file was truncated: an empty file cannot be mapped
+            self._unmap()
+            return
+        import mmap
+        if sys.platform == 'win32':
+            map = mmap.mmap(fd, 0, access=mmap.ACCESS_READ)
+        else:
+            # Do not duplicate the file descriptor
+            map = mmap.mmap(fd, 0, access=mmap.ACCESS_READ, trackfd=False)
+        if hasattr(mmap, 'MADV_RANDOM') and hasattr(mmap, 'MADV_SEQUENTIAL'):
+            # Page faults read ahead for sequential reads only
+            map.madvise(mmap.MADV_SEQUENTIAL if self._sequential
+                        else mmap.MADV_RANDOM)
+        self._unmap()
+        self._map = map
+        self._map_view = memoryview(map)
+
+    def _mapped_avail(self):
+        # Number of bytes of the mapping after the file position.  Touching
+        # the mapping past the end of the file raises SIGBUS, so the file is
+        # remapped if another process truncated or extended it.
+        self._remap(self._fd)
+        size = len(self._map) if self._map is not None else 0
+        return max(size - self._map_pos, 0)
+
+    def _mapped_read(self, size, stop_at_newline=False):
+        n = self._mapped_avail()
+        if size is not None and 0 <= size < n:
+            n = size
+        if n == 0:
+            return b""
+        pos = self._map_pos
+        if stop_at_newline:
+            end = self._map.find(b"\n", pos, pos + n)
+            if end >= 0:
+                n = end - pos + 1
+        self._map_pos = pos + n
+        return self._map[pos:pos + n]
+
     def __del__(self):
         if self._fd >= 0 and self._closefd and not self.closed:
             import warnings
@@ -1653,6 +1789,8 @@ def read(self, size=None):
         self._checkReadable()
         if size is None or size < 0:
             return self.readall()
+        if self._mapped:
+            return self._mapped_read(size)
         try:
             return os.read(self._fd, size)
         except BlockingIOError:
@@ -1666,6 +1804,8 @@ def readall(self):
         """
         self._checkClosed()
         self._checkReadable()
+        if self._mapped:
+            return self._mapped_read(-1)
         if self._stat_atopen is None or self._stat_atopen.st_size <= 0:
             bufsize = DEFAULT_BUFFER_SIZE
         else:
@@ -1703,11 +1843,44 @@ def readinto(self, buffer):
         """Same as RawIOBase.readinto()."""
         self._checkClosed()
         self._checkReadable()
+        if self._mapped:
+            m = memoryview(buffer).cast('B')
+            n = min(self._mapped_avail(), len(m))
+            if n == 0:
+                return 0
+            pos = self._map_pos
+            m[:n] = self._map_view[pos:pos + n]
+            self._map_pos = pos + n
+            return n
         try:
             return os.readinto(self._fd, buffer)
         except BlockingIOError:
             return None
 
+    def readline(self, size=-1):
+        """Read and return a line from the file.
+
+        If size is specified, at most size bytes will be read.
+        """
+        if not self._mapped:
+            return super().readline(size)
+        self._checkClosed()
+        return self._mapped_read(size, stop_at_newline=True)
+
+    def getbuffer(self):
+        """Get a read-only view over the contents of a file opened in mmap mode.
+
+        The data is not copied, and the view stays valid after the file is
+        closed.
+        """
+        self._checkClosed()
+        if not self._mapped:
+            raise UnsupportedOperation('File not open in mmap mode')
+        self._remap(self._fd)
+        if self._map is None:
+            return memoryview(b"")
+        return memoryview(self._map)
+
     def write(self, b):
         """Write bytes b to file, return number written.
 
@@ -1736,6 +1909,21 @@ def seek(self, pos, whence=SEEK_SET):
         if isinstance(pos, float):
             raise TypeError('an integer is required')
         self._checkClosed()
+        if self._mapped:
+            pos = pos.__index__()
+            if whence == SEEK_SET:
+                base = 0
+            elif whence == SEEK_CUR:
+                base = self._map_pos
+            elif whence == SEEK_END:
+                self._remap(self._fd)
+                base = len(self._map) if self._map is not None else 0
+            else:
+                base = -1
+            if base < 0 or base + pos < 0:
+                raise OSError(errno.EINVAL, os.strerror(errno.EINVAL))
+            self._map_pos = base + pos
+            return self._map_pos
         return os.lseek(self._fd, pos, whence)
 
     def tell(self):
@@ -1743,6 +1931,8 @@ def tell(self):
 
         Can raise OSError for non seekable files."""
         self._checkClosed()
+        if self._mapped:
+            return self._map_pos
         return os.lseek(self._fd, 0, SEEK_CUR)
 
     def truncate(self, size=None):
@@ -1767,6 +1957,7 @@ def close(self):
         """
         if not self.closed:
             self._stat_atopen = None
+            self._unmap()
             try:
                 if self._closefd:
                     os.close(self._fd)
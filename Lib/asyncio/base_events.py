@@ -39,6 +39,7 @@
 from . import coroutines
 from . import events
 from . import exceptions
+from . import files
 from . import futures
 from . import protocols
 from . import sslproto
@@ -67,6 +68,13 @@
 # Maximum timeout passed to select to avoid OS limitations
 MAXIMUM_SELECT_TIMEOUT = 24 * 3600
 
+try:
+    # C implementation of BaseEventLoop._run_once(), used outside of debug
+    # mode.  It hardcodes the three constants above.
+    from _asyncio import _run_once as _c_run_once
+except ImportError:
+    _c_run_once = None
+
 
 def _format_handle(handle):
     cb = handle._callback
@@ -423,6 +431,8 @@ def __init__(self):
         self._ready = collections.deque()
         self._scheduled = []
         self._default_executor = None
+        # Runs the operations of asyncio.files, created on first use
+        self._file_backend = None
         self._internal_fds = 0
         # Identifier of the thread running the event loop, or None if the
         # event loop is not running
@@ -532,6 +542,10 @@ async def _make_subprocess_transport(self, protocol, args, shell,
         """Create subprocess transport."""
         raise NotImplementedError
 
+    def _make_file_backend(self):
+        """Create the object running the operations of asyncio.files."""
+        return files._ExecutorFileBackend(self)
+
     def _write_to_self(self):
         """Write a byte to self-pipe, to wake up the event loop.
 
@@ -740,6 +754,10 @@ def close(self):
             return
         if self._debug:
             logger.debug("Close %r", self)
+        backend = self._file_backend
+        if backend is not None:
+            self._file_backend = None
+            backend.close()
         self._closed = True
         self._ready.clear()
         self._scheduled.clear()
@@ -1961,6 +1979,9 @@ def _run_once(self):
         schedules the resulting callbacks, and finally schedules
         'call_later' callbacks.
         """
+        if _c_run_once is not None and not self._debug:
+            _c_run_once(self)
+            return
 
         sched_count = len(self._scheduled)
         if (sched_count > _MIN_SCHEDULED_TIMER_HANDLES and
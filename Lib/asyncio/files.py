@@ -0,0 +1,569 @@
+"""Asynchronous file I/O."""
+
+__all__ = ('AsyncFile', 'open_file')
+
+import errno
+import os
+import stat
+import sys
+import threading
+import warnings
+
+from . import events
+from . import exceptions
+from . import tasks
+
+try:
+    from _asyncio import FilePool as _FilePool
+except ImportError:  # pragma: no cover
+    _FilePool = None
+
+
+# Size of the reads of AsyncFile.read() on files whose size is unknown
+_READ_CHUNK_SIZE = 64 * 1024
+
+
+def _close_fd(res):
+    # Close a file opened after its future was cancelled
+    if res >= 0:
+        os.close(res)
+
+
+def _close_opened(fut):
+    if not fut.cancelled() and fut.exception() is None:
+        os.close(fut.result())
+
+
+class _ThreadFileBackend:
+    """Base class of the backends running the operations in threads.
+
+    Cancelling an operation does not interrupt its thread: a file is only
+    closed once the operations on it complete, so that its file descriptor
+    cannot be reused by another file meanwhile.
+    """
+
+    def __init__(self, loop):
+        self._loop = loop
+        # fd => number of operations on the file being run
+        self._busy = {}
+        # fd => future of close(), waiting for these operations
+        self._closing = {}
+
+    def close(self):
+        pass
+
+    def _op_started(self, fd):
+        self._busy[fd] = self._busy.get(fd, 0) + 1
+
+    def _op_done(self, fd):
+        count = self._busy.pop(fd) - 1
+        if count:
+            self._busy[fd] = count
+        else:
+            waiter = self._closing.pop(fd, None)
+            if waiter is not None and not waiter.done():
+                waiter.set_result(None)
+
+    async def file_close(self, fd):
+        if fd in self._busy:
+            waiter = self._loop.create_future()
+            self._closing[fd] = waiter
+            await waiter
+        return await self._close(fd)
+
+
+class _FilePoolBackend(_ThreadFileBackend):
+    """Run the file operations in the threads of an _asyncio.FilePool.
+
+    The pool writes to a pipe when operations complete: the event loop
+    waits for the pipe to be readable to collect their results.
+    """
+
+    def __init__(self, loop):
+        super().__init__(loop)
+        self._pool = _FilePool()
+        loop._add_reader(self._pool.fileno(), self._process_completed)
+
+    def close(self):
+        pool = self._pool
+        if pool is None:
+            return
+        self._pool = None
+        self._loop._remove_reader(pool.fileno())
+        # The operations being run are not waited for: a read of a pipe
+        # can block forever.
+        pool.close()
+
+    def _submit(self, submit, fd, *args):
+        # The token of an operation is (future, discard, fd)
+        fut = self._loop.create_future()
+        submit((fut, None, fd), fd, *args)
+        self._op_started(fd)
+        return fut
+
+    def _process_completed(self):
+        for (fut, discard, fd), res, data in self._pool.completed():
+            if fd is not None:
+                self._op_done(fd)
+            if fut.done():
+                # the future has been cancelled
+                if discard is not None:
+                    discard(res)
+            elif res < 0:
+                fut.set_exception(OSError(-res, os.strerror(-res)))
+            else:
+                fut.set_result(res if data is None else data)
+
+    def file_open(self, path, flags, mode):
+        fut = self._loop.create_future()
+        self._pool.open((fut, _close_fd, None), path, flags, mode)
+        return fut
+
+    def file_read(self, fd, size, offset):
+        return self._submit(self._pool.read, fd, size, offset)
+
+    def file_readinto(self, fd, buf, offset):
+        return self._submit(self._pool.readinto, fd, buf, offset)
+
+    def file_write(self, fd, data, offset):
+        return self._submit(self._pool.write, fd, data, offset)
+
+    def file_fsync(self, fd, datasync):
+        return self._submit(self._pool.fsync, fd, datasync)
+
+    def _close(self, fd):
+        fut = self._loop.create_future()
+        self._pool.close_fd((fut, None, None), fd)
+        return fut
+
+
+if hasattr(os, 'pread'):
+    def _read(fd, size, offset):
+        if offset < 0:
+            return os.read(fd, size)
+        return os.pread(fd, size, offset)
+
+    def _write(fd, data, offset):
+        if offset < 0:
+            return os.write(fd, data)
+        return os.pwrite(fd, data, offset)
+else:  # pragma: no cover
+    # Serialize the seeks and the reads or writes which follow them
+    _seek_lock = threading.Lock()
+
+    def _read(fd, size, offset):
+        if offset < 0:
+            return os.read(fd, size)
+        with _seek_lock:
+            os.lseek(fd, offset, os.SEEK_SET)
+            return os.read(fd, size)
+
+    def _write(fd, data, offset):
+        if offset < 0:
+            return os.write(fd, data)
+        with _seek_lock:
+            os.lseek(fd, offset, os.SEEK_SET)
+            return os.write(fd, data)
+
+
+def _readinto(fd, buf, offset):
+    if hasattr(os, 'preadv'):
+        if offset < 0:
+            return os.readv(fd, [buf])
+        return os.preadv(fd, [buf], offset)
+    with memoryview(buf) as view, view.cast('B') as view:
+        data = _read(fd, len(view), offset)
+        view[:len(data)] = data
+        return len(data)
+
+
+def _fsync(fd, datasync):
+    if datasync and hasattr(os, 'fdatasync'):
+        os.fdatasync(fd)
+    else:
+        os.fsync(fd)
+    return 0
+
+
+class _ExecutorFileBackend(_ThreadFileBackend):
+    """Run the file operations in the default executor of the loop."""
+
+    async def file_open(self, path, flags, mode):
+        fut = self._loop.run_in_executor(None, os.open, path, flags, mode)
+        try:
+            return await tasks.shield(fut)
+        except exceptions.CancelledError:
+            fut.add_done_callback(_close_opened)
+            raise
+
+    def _run(self, func, fd, *args):
+        fut = self._loop.run_in_executor(None, func, fd, *args)
+        self._op_started(fd)
+        fut.add_done_callback(lambda fut: self._op_done(fd))
+        # Cancelling the operation must not cancel fut: it tells when the
+        # thread completes the operation.
+        return tasks.shield(fut)
+
+    def file_read(self, fd, size, offset):
+        return self._run(_read, fd, size, offset)
+
+    def file_readinto(self, fd, buf, offset):
+        return self._run(_readinto, fd, buf, offset)
+
+    def file_write(self, fd, data, offset):
+        return self._run(_write, fd, data, offset)
+
+    def file_fsync(self, fd, datasync):
+        return self._run(_fsync, fd, datasync)
+
+    def _close(self, fd):
+        return self._loop.run_in_executor(None, os.close, fd)
+
+
+def _get_file_backend(loop):
+    try:
+        backend = loop._file_backend
+    except AttributeError:
+        # The event loop does not derive from BaseEventLoop.
+        return _ExecutorFileBackend(loop)
+    if backend is None:
+        backend = loop._file_backend = loop._make_file_backend()
+    return backend
+
+
+def _parse_mode(mode):
+    if not isinstance(mode, str):
+        raise TypeError(f'invalid mode: {mode!r}')
+    chars = set(mode)
+    if (chars - set('rwaxb+') or len(mode) > len(chars)
+            or sum(c in 'rwax' for c in mode) != 1):
+        raise ValueError(f'invalid mode: {mode!r}')
+    if 'b' not in chars:
+        raise ValueError(f'invalid mode: {mode!r} '
+                         f'(only binary modes are supported)')
+    readable = writable = append = False
+    if 'r' in chars:
+        readable = True
+        flags = 0
+    elif 'w' in chars:
+        writable = True
+        flags = os.O_CREAT | os.O_TRUNC
+    elif 'a' in chars:
+        writable = append = True
+        flags = os.O_CREAT | os.O_APPEND
+    else:
+        writable = True
+        flags = os.O_CREAT | os.O_EXCL
+    if '+' in chars:
+        readable = writable = True
+    if readable and writable:
+        flags |= os.O_RDWR
+    elif readable:
+        flags |= os.O_RDONLY
+    else:
+        flags |= os.O_WRONLY
+    flags |= getattr(os, 'O_BINARY', 0) | getattr(os, 'O_CLOEXEC', 0)
+    return readable, writable, append, flags
+
+
+async def open_file(file, mode='rb'):
+    """Open a file in binary mode and return an AsyncFile object.
+
+    file is a path-like object and mode is 'rb', 'wb', 'ab' or 'xb', with
+    an optional '+', like in open().  The file is opened by the event
+    loop, and its operations run in threads.
+
+    Operations on a file which is not a regular file, such as a pipe, a
+    FIFO or a terminal, can block their thread indefinitely: even opening
+    a FIFO blocks until the other end is opened.  Closing the event loop
+    does not wait for them.
+    """
+    readable, writable, append, flags = _parse_mode(mode)
+    path = os.fspath(file)
+    sys.audit('open', path, mode, flags)
+    loop = events.get_running_loop()
+    backend = _get_file_backend(loop)
+    try:
+        fd = await backend.file_open(os.fsencode(path), flags, 0o666)
+    except OSError as exc:
+        raise OSError(exc.errno, exc.strerror, path) from None
+    try:
+        # fstat() of an open file does not block: it reads the inode
+        # already in memory.
+        st = os.fstat(fd)
+        if stat.S_ISDIR(st.st_mode):
+            raise IsADirectoryError(errno.EISDIR, os.strerror(errno.EISDIR),
+                                    path)
+        seekable = stat.S_ISREG(st.st_mode)
+        if not seekable:
+            try:
+                os.lseek(fd, 0, os.SEEK_CUR)
+            except OSError:
+                pass
+            else:
+                seekable = True
+        if append and seekable:
+            # Like open(), start at the end of the file
+            os.lseek(fd, 0, os.SEEK_END)
+    except:
+        os.close(fd)
+        raise
+    return AsyncFile(fd, path, mode, backend, readable, writable, append,
+                     seekable)
+
+
+class AsyncFile:
+    """Binary file whose operations run in the event loop.
+
+    Created by open_file().  Reads and writes of seekable files pass the
+    position of the AsyncFile object to the system as an offset: several
+    operations on the file can then run at the same time.  However, the
+    position is only updated once an operation completes: reads or writes
+    started concurrently use the same position.
+    """
+
+    def __init__(self, fd, name, mode, backend, readable, writable, append,
+                 seekable):
+        self._fd = fd
+        self._name = name
+        self._mode = mode
+        self._backend = backend
+        self._readable = readable
+        self._writable = writable
+        self._append = append
+        self._seekable = seekable
+        # Position of the next read or write of a seekable file.  None
+        # means the position of the file descriptor, which O_APPEND writes
+        # move to the end of the file.
+        self._pos = None if append else 0
+        # Number of operations being awaited
+        self._running = 0
+        # Set when an operation is cancelled: it may still be running.
+        self._cancelled = False
+
+    def __repr__(self):
+        info = [self.__class__.__name__, f'name={self._name!r}',
+                f'mode={self._mode!r}']
+        if self._fd < 0:
+            info.append('closed')
+        return '<{}>'.format(' '.join(info))
+
+    def __del__(self, _warn=warnings.warn):
+        if self._fd >= 0:
+            _warn(f"unclosed file {self!r}", ResourceWarning, source=self)
+            os.close(self._fd)
+            self._fd = -1
+
+    async def __aenter__(self):
+        return self
+
+    async def __aexit__(self, exc_type, exc_value, traceback):
+        await self.close()
+
+    @property
+    def name(self):
+        return self._name
+
+    @property
+    def mode(self):
+        return self._mode
+
+    @property
+    def closed(self):
+        return self._fd < 0
+
+    def fileno(self):
+        self._check_closed()
+        return self._fd
+
+    def readable(self):
+        self._check_closed()
+        return self._readable
+
+    def writable(self):
+        self._check_closed()
+        return self._writable
+
+    def seekable(self):
+        self._check_closed()
+        return self._seekable
+
+    def _check_closed(self):
+        if self._fd < 0:
+            raise ValueError('I/O operation on closed file')
+
+    def _check_readable(self):
+        self._check_closed()
+        if not self._readable:
+            raise OSError(errno.EBADF, 'File not open for reading')
+
+    def _check_writable(self):
+        self._check_closed()
+        if not self._writable:
+            raise OSError(errno.EBADF, 'File not open for writing')
+
+    def _check_seekable(self):
+        self._check_closed()
+        if not self._seekable:
+            raise OSError(errno.ESPIPE, os.strerror(errno.ESPIPE))
+
+    def _offset(self):
+        # Offset of the next read or write, -1 to use (and move) the
+        # position of the file descriptor.
+        if not self._seekable:
+            return -1
+        if self._pos is None:
+            self._pos = os.lseek(self._fd, 0, os.SEEK_CUR)
+        return self._pos
+
+    async def _wait(self, fut):
+        self._running += 1
+        try:
+            return await fut
+        except exceptions.CancelledError:
+            self._cancelled = True
+            raise
+        finally:
+            self._running -= 1
+
+    def tell(self):
+        """Return the current position."""
+        self._check_seekable()
+        return self._offset()
+
+    def seek(self, offset, whence=os.SEEK_SET):
+        """Move to the new position and return it.
+
+        The position is checked but not moved by the system: seek() does
+        not block.
+        """
+        self._check_seekable()
+        if whence == os.SEEK_SET:
+            pos = offset
+        elif whence == os.SEEK_CUR:
+            pos = self._offset() + offset
+        elif whence == os.SEEK_END:
+            pos = os.fstat(self._fd).st_size + offset
+        else:
+            # SEEK_DATA, SEEK_HOLE
+            pos = os.lseek(self._fd, offset, whence)
+        if pos < 0:
+            raise OSError(errno.EINVAL, os.strerror(errno.EINVAL))
+        self._pos = pos
+        return pos
+
+    async def read(self, size=-1):
+        """Read at most size bytes, or up to the end of file if size is
+        negative or omitted.
+
+        Return an empty bytes object at the end of file.
+        """
+        self._check_readable()
+        if size is None or size < 0:
+            return await self._readall()
+        offset = self._offset()
+        data = await self._wait(
+            self._backend.file_read(self._fd, size, offset))
+        if offset >= 0:
+            self._pos = offset + len(data)
+        return data
+
+    async def _readall(self):
+        offset = self._offset()
+        size = _READ_CHUNK_SIZE
+        sized = False
+        if offset >= 0:
+            end = os.fstat(self._fd).st_size
+            if end > offset:
+                # Read the rest of the file in a single operation, and one
+                # byte more to see the end of file without another read.
+                size = end - offset + 1
+                sized = True
+        chunks = []
+        while True:
+            data = await self._wait(
+                self._backend.file_read(self._fd, size, offset))
+            if offset >= 0:
+                offset += len(data)
+                self._pos = offset
+            if not data:
+                break
+            chunks.append(data)
+            if sized and len(data) < size:
+                # A short read of a file with a size means the end of file:
+                # files of /proc without a size can return less.
+                break
+            size = _READ_CHUNK_SIZE
+        return b''.join(chunks)
+
+    async def readinto(self, buffer):
+        """Read bytes into a pre-allocated, writable bytes-like object.
+
+        Return the number of bytes read, 0 at the end of file.
+        """
+        self._check_readable()
+        offset = self._offset()
+        n = await self._wait(
+            self._backend.file_readinto(self._fd, buffer, offset))
+        if offset >= 0:
+            self._pos = offset + n
+        return n
+
+    async def write(self, data):
+        """Write the bytes-like object data and return its length.
+
+        Partial writes are continued until all the data is written.
+        """
+        self._check_writable()
+        # The views are not released explicitly: a cancelled write can still
+        # use them.
+        view = memoryview(data).cast('B')
+        size = len(view)
+        offset = -1 if self._append else self._offset()
+        written = 0
+        while written < size:
+            n = await self._wait(self._backend.file_write(
+                self._fd, view[written:] if written else view, offset))
+            written += n
+            if offset >= 0:
+                offset += n
+                self._pos = offset
+            else:
+                # the write moved the position of the file descriptor
+                self._pos = None
+        return size
+
+    async def fsync(self):
+        """Flush the data and the metadata of the file to the disk."""
+        self._check_closed()
+        await self._wait(self._backend.file_fsync(self._fd, False))
+
+    async def fdatasync(self):
+        """Flush the data of the file to the disk.
+
+        Metadata which is not needed to read the data, like the
+        modification time, may not be flushed.
+        """
+        self._check_closed()
+        await self._wait(self._backend.file_fsync(self._fd, True))
+
+    async def stat(self):
+        """Return the os.stat_result of the file."""
+        self._check_closed()
+        return os.fstat(self._fd)
+
+    async def close(self):
+        """Close the file.
+
+        The file is closed even if the coroutine is cancelled.
+        """
+        fd = self._fd
+        if fd < 0:
+            return
+        self._fd = -1
+        if not (self._writable or self._running or self._cancelled):
+            # There is nothing to flush and no operation uses the file
+            # descriptor: closing the file does not block.
+            os.close(fd)
+            return
+        await tasks.shield(self._backend.file_close(fd))
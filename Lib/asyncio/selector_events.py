@@ -23,6 +23,7 @@
 from . import base_events
 from . import constants
 from . import events
+from . import files
 from . import futures
 from . import protocols
 from . import sslproto
@@ -39,6 +40,26 @@
         # Fallback to send
         _HAS_SENDMSG = False
 
+_HAS_MMSG = (hasattr(socket.socket, 'recvmmsg_into') and
+             hasattr(socket.socket, 'sendmmsg'))
+
+# Maximum number of datagrams read by a single recvmmsg() call, or written
+# by a single sendmmsg() call, on UDP sockets.
+_DATAGRAM_BATCH_SIZE = 16
+# Size of the receive buffers: a UDP datagram never exceeds 64 KiB.
+_DATAGRAM_BUFFER_SIZE = 64 * 1024
+
+_HAS_ZEROCOPY = hasattr(socket.socket, 'send_zerocopy')
+
+# Smaller writes are copied: the completion notifications of zero-copy
+# sends cost more than the copy.
+_ZEROCOPY_MIN_SIZE = 64 * 1024
+# Closing the socket releases the data of the zero-copy sends which the
+# kernel may still be reading, so the transport polls for their completion
+# notifications before closing it, until the timeout expires.
+_ZEROCOPY_CLOSE_POLL_INTERVAL = 0.01
+_ZEROCOPY_CLOSE_TIMEOUT = 1.0
+
 def _test_selector_event(selector, fd, event):
     # Test if the selector is monitoring 'event' events
     # for the file descriptor 'fd'.
@@ -65,6 +86,7 @@ def __init__(self, selector=None):
         self._selector = selector
         self._make_self_pipe()
         self._transports = weakref.WeakValueDictionary()
+        self._datagram_buffers = None
 
     def _make_socket_transport(self, sock, protocol, waiter=None, *,
                                extra=None, server=None):
@@ -96,6 +118,16 @@ def _make_datagram_transport(self, sock, protocol,
         return _SelectorDatagramTransport(self, sock, protocol,
                                           address, waiter, extra)
 
+    def _get_datagram_buffers(self):
+        # The receive buffers are shared by all the datagram transports of
+        # the loop: they copy the datagrams out of them before calling the
+        # protocol.
+        if self._datagram_buffers is None:
+            self._datagram_buffers = [
+                memoryview(bytearray(_DATAGRAM_BUFFER_SIZE))
+                for _ in range(_DATAGRAM_BATCH_SIZE)]
+        return self._datagram_buffers
+
     def close(self):
         if self.is_running():
             raise RuntimeError("Cannot close a running event loop")
@@ -103,10 +135,16 @@ def close(self):
             return
         self._close_self_pipe()
         super().close()
+        self._datagram_buffers = None
         if self._selector is not None:
             self._selector.close()
             self._selector = None
 
+    def _make_file_backend(self):
+        if files._FilePool is None:
+            return super()._make_file_backend()
+        return files._FilePoolBackend(self)
+
     def _close_self_pipe(self):
         self._remove_reader(self._ssock.fileno())
         self._ssock.close()
@@ -940,6 +978,17 @@ def __init__(self, loop, sock, protocol, waiter=None,
             self._write_ready = self._write_sendmsg
         else:
             self._write_ready = self._write_send
+        # Send large writes without copying them if the SO_ZEROCOPY option
+        # is set on the socket.
+        self._zerocopy = False
+        self._zerocopy_pending = 0
+        self._zerocopy_close_deadline = None
+        if _HAS_ZEROCOPY and sock.family in (socket.AF_INET, socket.AF_INET6):
+            try:
+                self._zerocopy = bool(sock.getsockopt(socket.SOL_SOCKET,
+                                                      socket.SO_ZEROCOPY))
+            except OSError:
+                pass
         # Disable the Nagle algorithm -- small writes will be
         # sent without waiting for the TCP ACK.  This generally
         # decreases the latency (in some cases significantly.)
@@ -963,6 +1012,8 @@ def set_protocol(self, protocol):
         super().set_protocol(protocol)
 
     def _read_ready(self):
+        if self._zerocopy_pending:
+            self._reap_zerocopy()
         self._read_ready_cb()
 
     def _read_ready__get_buffer(self):
@@ -1048,6 +1099,37 @@ def _read_ready__on_eof(self):
         else:
             self.close()
 
+    def _can_send_zerocopy(self, data):
+        # The kernel reads the data after send_zerocopy() returns, so only
+        # immutable data can be sent.
+        if not self._zerocopy or len(data) < _ZEROCOPY_MIN_SIZE:
+            return False
+        if isinstance(data, memoryview):
+            data = data.obj
+        return type(data) is bytes
+
+    def _send_zerocopy(self, data):
+        n = self._sock.send_zerocopy(data)
+        if n:
+            self._zerocopy_pending += 1
+        return n
+
+    def _reap_zerocopy(self):
+        # Read the completion notifications of zero-copy sends: they make
+        # the socket readable and writable until they are read, and the
+        # socket keeps the data alive until then.
+        try:
+            completions = self._sock.zerocopy_completions()
+        except OSError:
+            # The error will be reported by the next send() or recv().
+            return
+        for first, last, copied in completions:
+            self._zerocopy_pending -= (last - first) % 2**32 + 1
+            if copied:
+                # The kernel copied the data anyway, e.g. on the loopback
+                # interface: stop paying for the notifications.
+                self._zerocopy = False
+
     def write(self, data):
         if not isinstance(data, (bytes, bytearray, memoryview)):
             raise TypeError(f'data argument must be a bytes-like object, '
@@ -1068,7 +1150,10 @@ def write(self, data):
         if not self._buffer:
             # Optimization: try to send now.
             try:
-                n = self._sock.send(data)
+                if self._can_send_zerocopy(data):
+                    n = self._send_zerocopy(data)
+                else:
+                    n = self._sock.send(data)
             except (BlockingIOError, InterruptedError):
                 pass
             except (SystemExit, KeyboardInterrupt):
@@ -1094,8 +1179,13 @@ def _write_sendmsg(self):
         assert self._buffer, 'Data should not be empty'
         if self._conn_lost:
             return
+        if self._zerocopy_pending:
+            self._reap_zerocopy()
         try:
-            nbytes = self._sock.sendmsg(self._get_sendmsg_buffer())
+            if self._can_send_zerocopy(self._buffer[0]):
+                nbytes = self._send_zerocopy(self._buffer[0])
+            else:
+                nbytes = self._sock.sendmsg(self._get_sendmsg_buffer())
             self._adjust_leftover_buffer(nbytes)
         except (BlockingIOError, InterruptedError):
             pass
@@ -1133,9 +1223,14 @@ def _write_send(self):
         assert self._buffer, 'Data should not be empty'
         if self._conn_lost:
             return
+        if self._zerocopy_pending:
+            self._reap_zerocopy()
         try:
             buffer = self._buffer.popleft()
-            n = self._sock.send(buffer)
+            if self._can_send_zerocopy(buffer):
+                n = self._send_zerocopy(buffer)
+            else:
+                n = self._sock.send(buffer)
             if n != len(buffer):
                 # Not all data was written
                 self._buffer.appendleft(buffer[n:])
@@ -1185,6 +1280,19 @@ def can_write_eof(self):
         return True
 
     def _call_connection_lost(self, exc):
+        if self._zerocopy_pending:
+            self._reap_zerocopy()
+        if self._zerocopy_pending:
+            now = self._loop.time()
+            if self._zerocopy_close_deadline is None:
+                self._zerocopy_close_deadline = now + _ZEROCOPY_CLOSE_TIMEOUT
+            if now < self._zerocopy_close_deadline:
+                self._loop.call_later(_ZEROCOPY_CLOSE_POLL_INTERVAL,
+                                      self._call_connection_lost, exc)
+                return
+            if self._loop.get_debug():
+                logger.debug("%r: closing with %d zero-copy sends pending",
+                             self, self._zerocopy_pending)
         try:
             super()._call_connection_lost(exc)
         finally:
@@ -1218,6 +1326,10 @@ def __init__(self, loop, sock, protocol, address=None,
         super().__init__(loop, sock, protocol, extra)
         self._address = address
         self._buffer_size = 0
+        # Move several datagrams per system call on UDP sockets.
+        self._use_mmsg = (_HAS_MMSG and
+                          sock.family in (socket.AF_INET, socket.AF_INET6) and
+                          self.max_size >= _DATAGRAM_BUFFER_SIZE)
         self._loop.call_soon(self._protocol.connection_made, self)
         # only start reading when connection_made() has been called
         self._loop.call_soon(self._add_reader,
@@ -1233,6 +1345,9 @@ def get_write_buffer_size(self):
     def _read_ready(self):
         if self._conn_lost:
             return
+        if self._use_mmsg:
+            self._read_ready__recvmmsg()
+            return
         try:
             data, addr = self._sock.recvfrom(self.max_size)
         except (BlockingIOError, InterruptedError):
@@ -1246,6 +1361,30 @@ def _read_ready(self):
         else:
             self._protocol.datagram_received(data, addr)
 
+    def _read_ready__recvmmsg(self):
+        buffers = self._loop._get_datagram_buffers()
+        try:
+            messages = self._sock.recvmmsg_into(buffers)
+        except (BlockingIOError, InterruptedError):
+            return
+        except OSError as exc:
+            self._protocol.error_received(exc)
+            return
+        except (SystemExit, KeyboardInterrupt):
+            raise
+        except BaseException as exc:
+            self._fatal_error(exc, 'Fatal read error on datagram transport')
+            return
+
+        datagrams = [(bytes(buf[:nbytes]), addr)
+                     for buf, (nbytes, _, _, addr) in zip(buffers, messages)]
+        for data, addr in datagrams:
+            if self._closing:
+                # The remaining datagrams are dropped, as they would be
+                # when closing the socket.
+                break
+            self._protocol.datagram_received(data, addr)
+
     def sendto(self, data, addr=None):
         if not isinstance(data, (bytes, bytearray, memoryview)):
             raise TypeError(f'data argument must be a bytes-like object, '
@@ -1290,6 +1429,13 @@ def sendto(self, data, addr=None):
 
     def _sendto_ready(self):
         while self._buffer:
+            if self._use_mmsg and len(self._buffer) > 1:
+                sent = self._sendto_ready__sendmmsg()
+                if sent is None:
+                    return
+                if not sent:
+                    break  # Try again later.
+                continue
             data, addr = self._buffer.popleft()
             self._buffer_size -= len(data)
             try:
@@ -1316,3 +1462,35 @@ def _sendto_ready(self):
             self._loop._remove_writer(self._sock_fd)
             if self._closing:
                 self._call_connection_lost(None)
+
+    def _sendto_ready__sendmmsg(self):
+        # Send a batch of buffered datagrams with a single system call.
+        # Return the number of datagrams sent, or None on error.
+        batch = list(itertools.islice(self._buffer, _DATAGRAM_BATCH_SIZE))
+        try:
+            if self._extra['peername']:
+                sent = self._sock.sendmmsg([data for data, _ in batch])
+            else:
+                sent = self._sock.sendmmsg([data for data, _ in batch], 0,
+                                           [addr for _, addr in batch])
+        except (BlockingIOError, InterruptedError):
+            return 0
+        except OSError as exc:
+            # sendmmsg() only fails if the first datagram cannot be sent.
+            data, addr = self._buffer.popleft()
+            self._buffer_size -= len(data)
+            self._protocol.error_received(exc)
+            return None
+        except (SystemExit, KeyboardInterrupt):
+            raise
+        except BaseException as exc:
+            data, addr = self._buffer.popleft()
+            self._buffer_size -= len(data)
+            self._fatal_error(
+                exc, 'Fatal write error on datagram transport')
+            return None
+
+        for _ in range(sent):
+            data, addr = self._buffer.popleft()
+            self._buffer_size -= len(data)
+        return sent
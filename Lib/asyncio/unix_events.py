@@ -1,5 +1,6 @@
 """Selector event loop for Unix with signal handling."""
 
+import collections
 import errno
 import io
 import itertools
@@ -36,6 +37,14 @@
 if sys.platform == 'win32':  # pragma: no cover
     raise ImportError('Signals are not really supported on Windows')
 
+_HAS_WRITEV = hasattr(os, 'writev')
+
+if _HAS_WRITEV:
+    try:
+        _IOV_MAX = os.sysconf('SC_IOV_MAX')
+    except OSError:
+        _HAS_WRITEV = False
+
 
 def _sighandler_noop(signum, frame):
     """Dummy signal handler."""
@@ -635,7 +644,8 @@ def __init__(self, loop, pipe, protocol, waiter=None, extra=None):
         self._pipe = pipe
         self._fileno = pipe.fileno()
         self._protocol = protocol
-        self._buffer = bytearray()
+        self._buffer = collections.deque()
+        self._buffer_size = 0
         self._conn_lost = 0
         self._closing = False  # Set when close() or write_eof() called.
 
@@ -691,7 +701,7 @@ def __repr__(self):
         return '<{}>'.format(' '.join(info))
 
     def get_write_buffer_size(self):
-        return len(self._buffer)
+        return self._buffer_size
 
     def _read_ready(self):
         # Pipe was closed by peer.
@@ -734,36 +744,53 @@ def write(self, data):
                 data = memoryview(data)[n:]
             self._loop._add_writer(self._fileno, self._write_ready)
 
-        self._buffer += data
+        # The buffered data is written later: keep a reference to immutable
+        # data, but copy the rest since the caller may modify it.
+        if isinstance(data, memoryview) and not isinstance(data.obj, bytes):
+            data = bytes(data)
+        self._buffer.append(data)
+        self._buffer_size += len(data)
         self._maybe_pause_protocol()
 
+    def _write_buffer(self):
+        # Write the buffers with a single system call rather than joining
+        # them.
+        if _HAS_WRITEV and len(self._buffer) > 1:
+            return os.writev(self._fileno,
+                             list(itertools.islice(self._buffer, _IOV_MAX)))
+        return os.write(self._fileno, self._buffer[0])
+
     def _write_ready(self):
         assert self._buffer, 'Data should not be empty'
 
         try:
-            n = os.write(self._fileno, self._buffer)
+            n = self._write_buffer()
         except (BlockingIOError, InterruptedError):
             pass
         except (SystemExit, KeyboardInterrupt):
             raise
         except BaseException as exc:
             self._buffer.clear()
+            self._buffer_size = 0
             self._conn_lost += 1
             # Remove writer here, _fatal_error() doesn't it
             # because _buffer is empty.
             self._loop._remove_writer(self._fileno)
             self._fatal_error(exc, 'Fatal write error on pipe transport')
         else:
-            if n == len(self._buffer):
-                self._buffer.clear()
+            self._buffer_size -= n
+            while n:
+                data = self._buffer.popleft()
+                if len(data) > n:
+                    self._buffer.appendleft(memoryview(data)[n:])
+                    break
+                n -= len(data)
+            if not self._buffer:
                 self._loop._remove_writer(self._fileno)
                 self._maybe_resume_protocol()  # May append to buffer.
                 if self._closing:
                     self._loop._remove_reader(self._fileno)
                     self._call_connection_lost(None)
-                return
-            elif n > 0:
-                del self._buffer[:n]
 
     def can_write_eof(self):
         return True
@@ -818,6 +845,7 @@ def _close(self, exc=None):
         if self._buffer:
             self._loop._remove_writer(self._fileno)
         self._buffer.clear()
+        self._buffer_size = 0
         self._loop._remove_reader(self._fileno)
         self._loop.call_soon(self._call_connection_lost, exc)
 
@@ -68,6 +68,10 @@ def _get_exports_list(module):
         from posix import _create_environ
     except ImportError:
         pass
+    try:
+        from posix import _scandir_names
+    except ImportError:
+        pass
 
     import posix
     __all__.extend(_get_exports_list(posix))
@@ -363,50 +367,14 @@ def walk(top, topdown=True, onerror=None, followlinks=False):
             yield top
             continue
 
-        dirs = []
-        nondirs = []
-        walk_dirs = []
-
         # We may not have read permission for top, in which case we can't
         # get a list of the files the directory contains.
         # We suppress the exception here, rather than blow up for a
         # minor reason when (say) a thousand readable directories are still
         # left to visit.
         try:
-            with scandir(top) as entries:
-                for entry in entries:
-                    try:
-                        if followlinks is _walk_symlinks_as_files:
-                            is_dir = entry.is_dir(follow_symlinks=False) and not entry.is_junction()
-                        else:
-                            is_dir = entry.is_dir()
-                    except OSError:
-                        # If is_dir() raises an OSError, consider the entry not to
-                        # be a directory, same behaviour as os.path.isdir().
-                        is_dir = False
-
-                    if is_dir:
-                        dirs.append(entry.name)
-                    else:
-                        nondirs.append(entry.name)
-
-                    if not topdown and is_dir:
-                        # Bottom-up: traverse into sub-directory, but exclude
-                        # symlinks to directories if followlinks is False
-                        if followlinks:
-                            walk_into = True
-                        else:
-                            try:
-                                is_symlink = entry.is_symlink()
-                            except OSError:
-                                # If is_symlink() raises an OSError, consider the
-                                # entry not to be a symbolic link, same behaviour
-                                # as os.path.islink().
-                                is_symlink = False
-                            walk_into = not is_symlink
-
-                        if walk_into:
-                            walk_dirs.append(entry.path)
+            dirs, nondirs, symlinks = _scandir_names(
+                top, followlinks is not _walk_symlinks_as_files)
         except OSError as error:
             if onerror is not None:
                 onerror(error)
@@ -427,12 +395,51 @@ def walk(top, topdown=True, onerror=None, followlinks=False):
         else:
             # Yield after sub-directory traversal if going bottom up
             stack.append((top, dirs, nondirs))
-            # Traverse into sub-directories
-            for new_path in reversed(walk_dirs):
-                stack.append(new_path)
+            # Traverse into sub-directories, but exclude symlinks to
+            # directories if followlinks is False
+            if symlinks and not followlinks:
+                symlinks = set(symlinks)
+                walk_dirs = [d for d in dirs if d not in symlinks]
+            else:
+                walk_dirs = dirs
+            for dirname in reversed(walk_dirs):
+                stack.append(join(top, dirname))
 
 __all__.append("walk")
 
+if not _exists("_scandir_names"):
+    def _scandir_names(top, follow_symlinks):
+        # Fallback for walk() on platforms without posix._scandir_names().
+        dirs = []
+        nondirs = []
+        symlinks = []
+        with scandir(top) as entries:
+            for entry in entries:
+                try:
+                    if follow_symlinks:
+                        is_dir = entry.is_dir()
+                    else:
+                        is_dir = entry.is_dir(follow_symlinks=False) and not entry.is_junction()
+                except OSError:
+                    # If is_dir() raises an OSError, consider the entry not to
+                    # be a directory, same behaviour as os.path.isdir().
+                    is_dir = False
+
+                if is_dir:
+                    dirs.append(entry.name)
+                    try:
+                        is_symlink = entry.is_symlink()
+                    except OSError:
+                        # If is_symlink() raises an OSError, consider the
+                        # entry not to be a symbolic link, same behaviour
+                        # as os.path.islink().
+                        is_symlink = False
+                    if is_symlink:
+                        symlinks.append(entry.name)
+                else:
+                    nondirs.append(entry.name)
+        return dirs, nondirs, symlinks
+
 if {open, stat} <= supports_dir_fd and {scandir, stat} <= supports_fd:
 
     def fwalk(top=".", topdown=True, onerror=None, *, follow_symlinks=False, dir_fd=None):
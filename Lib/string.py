@@ -16,9 +16,10 @@
 
 __all__ = ["ascii_letters", "ascii_lowercase", "ascii_uppercase", "capwords",
            "digits", "hexdigits", "octdigits", "printable", "punctuation",
-           "whitespace", "Formatter", "Template"]
+           "whitespace", "Formatter", "StringBuilder", "Template"]
 
 import _string
+from _string import StringBuilder
 
 # Some strings for ctype-style character classification
 whitespace = ' \t\n\r\v\f'
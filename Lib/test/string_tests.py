@@ -385,6 +385,42 @@ def test_find_with_memory(self):
             self.checkequal(len(haystack), haystack + needle, 'find', needle)
             self.checkequal(1, haystack + needle, 'count', needle)
 
+    def test_find_count_block_boundaries(self):
+        # Matches starting, ending and overlapping at every offset of the
+        # blocks compared at once by the vectorized search.
+        for m in range(2, 20):
+            needle = 'a' + 'b' * (m - 2) + 'a'
+            for n in range(m, m + 40):
+                for i in range(n - m + 1):
+                    haystack = 'c' * i + needle + 'c' * (n - m - i)
+                    self.checkequal(i, haystack, 'find', needle)
+                    self.checkequal(1, haystack, 'count', needle)
+                    j = i + m - 1
+                    self.checkequal(-1, haystack[:i] + 'c' + haystack[i+1:],
+                                    'find', needle)
+                    self.checkequal(-1, haystack[:j] + 'c' + haystack[j+1:],
+                                    'find', needle)
+        for n in range(2, 70):
+            haystack = 'a' * n
+            self.checkequal(n // 2, haystack, 'count', 'aa')
+            self.checkequal(n // 3, haystack, 'count', 'aaa')
+            self.checkequal('b' * (n // 2) + 'a' * (n % 2),
+                            haystack, 'replace', 'aa', 'b')
+            self.checkequal(0, haystack, 'find', 'aa')
+
+    def test_find_count_many_candidates(self):
+        # Every position matches the first and last characters of the
+        # needle, but there is no full match until the very end.
+        for N in 1000, 10_000, 100_000:
+            for needle in 'a' * 7 + 'b' + 'a', 'a' * 40 + 'b' + 'a' * 40:
+                haystack = 'a' * N
+                self.checkequal(-1, haystack, 'find', needle)
+                self.checkequal(0, haystack, 'count', needle)
+                self.checkequal(N, haystack + needle, 'find', needle)
+                self.checkequal(1, haystack + needle, 'count', needle)
+                self.checkequal(1, haystack + needle + haystack,
+                                'count', needle)
+
     def test_find_shift_table_overflow(self):
         """When the table of 8-bit shifts overflows."""
         N = 2**8 + 100
@@ -1045,6 +1045,18 @@ def test_asyncgen_finalization_by_gc_in_other_thread(self):
             self.assertTrue(status['finalized'])
 
 
+@unittest.skipIf(base_events._c_run_once is None,
+                 'requires the C implementation of _run_once()')
+class PyRunOnceBaseEventLoopTests(BaseEventLoopTests):
+    # Run the tests with the pure Python implementation of _run_once().
+
+    def setUp(self):
+        super().setUp()
+        patcher = mock.patch.object(base_events, '_c_run_once', None)
+        patcher.start()
+        self.addCleanup(patcher.stop)
+
+
 class MyProto(asyncio.Protocol):
     done = None
 
@@ -2708,6 +2708,26 @@ def callback(*args):
         self.assertTrue(h1 >= SMALLEST)
 
 
+class PyHandleMixin:
+    # Run the tests with the pure Python implementation of the handles.
+
+    def setUp(self):
+        super().setUp()
+        patcher = mock.patch.multiple(asyncio,
+                                      Handle=events._PyHandle,
+                                      TimerHandle=events._PyTimerHandle)
+        patcher.start()
+        self.addCleanup(patcher.stop)
+
+
+class PyHandleTests(PyHandleMixin, HandleTests):
+    pass
+
+
+class PyTimerTests(PyHandleMixin, TimerTests):
+    pass
+
+
 class AbstractEventLoopTests(unittest.TestCase):
 
     def test_not_implemented(self):
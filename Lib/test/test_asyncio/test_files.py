@@ -0,0 +1,544 @@
+"""Tests for asyncio/files.py"""
+
+import concurrent.futures
+import errno
+import os
+import select
+import sys
+import unittest
+
+import asyncio
+from asyncio import files
+from test import support
+from test.support import os_helper
+from test.support import warnings_helper
+from test.test_asyncio import utils as test_utils
+
+
+def tearDownModule():
+    asyncio._set_event_loop_policy(None)
+
+
+@unittest.skipIf(files._FilePool is None, 'requires _asyncio.FilePool')
+class FilePoolTests(unittest.TestCase):
+
+    def setUp(self):
+        self.pool = files._FilePool(2)
+        self.addCleanup(self.pool.close)
+        self.addCleanup(os_helper.unlink, os_helper.TESTFN)
+
+    def wait_for(self, count):
+        results = []
+        while len(results) < count:
+            select.select([self.pool.fileno()], [], [], support.SHORT_TIMEOUT)
+            results += self.pool.completed()
+        return results
+
+    def wait_closed(self):
+        # close() frees the operations which completed since the pool was
+        # closed
+        for _ in support.sleeping_retry(support.SHORT_TIMEOUT):
+            self.pool.close()
+            if not self.pool.inflight:
+                break
+
+    def test_file(self):
+        path = os.fsencode(os_helper.TESTFN)
+        self.pool.open('open', path, os.O_RDWR | os.O_CREAT | os.O_TRUNC)
+        [(token, fd, data)] = self.wait_for(1)
+        self.assertEqual(token, 'open')
+        self.assertGreaterEqual(fd, 0)
+        self.pool.write('write', fd, b'hello world', 0)
+        self.assertEqual(self.wait_for(1), [('write', 11, None)])
+        self.pool.read('read', fd, 5, 6)
+        self.assertEqual(self.wait_for(1), [('read', 5, b'world')])
+        buf = bytearray(10)
+        self.pool.readinto('readinto', fd, buf, 0)
+        self.assertEqual(self.wait_for(1), [('readinto', 10, None)])
+        self.assertEqual(buf, b'hello worl')
+        self.pool.fsync('fsync', fd)
+        self.pool.fsync('fdatasync', fd, True)
+        self.assertCountEqual(self.wait_for(2), [('fsync', 0, None),
+                                                 ('fdatasync', 0, None)])
+        self.pool.close_fd('close', fd)
+        self.assertEqual(self.wait_for(1), [('close', 0, None)])
+        self.assertRaises(OSError, os.fstat, fd)
+        self.assertEqual(self.pool.inflight, 0)
+
+        self.pool.open('open', path + b'.missing', os.O_RDONLY)
+        self.assertEqual(self.wait_for(1), [('open', -errno.ENOENT, None)])
+        self.assertRaises(ValueError, self.pool.open, 'open', b'a\0b', 0)
+
+    def test_workers(self):
+        rfd, wfd = os.pipe()
+        self.addCleanup(os.close, rfd)
+        self.addCleanup(os.close, wfd)
+        self.assertEqual(self.pool.workers, 0)
+        for i in range(10):
+            self.pool.write(i, wfd, b'x')
+        self.assertEqual(len(self.wait_for(10)), 10)
+        # Threads are started on demand, up to max_workers
+        self.assertIn(self.pool.workers, (1, 2))
+        self.assertEqual(os.read(rfd, 100), b'x' * 10)
+
+    def test_close(self):
+        rfd, wfd = os.pipe()
+        self.addCleanup(os.close, rfd)
+        self.addCleanup(os.close, wfd)
+        os.write(wfd, b'x')
+        self.pool.read('read', rfd, 1)
+        self.pool.close()
+        self.assertTrue(self.pool.closed)
+        self.assertEqual(self.pool.workers, 0)
+        self.wait_closed()
+        self.assertRaises(ValueError, self.pool.read, 'read', rfd, 1)
+        self.assertRaises(ValueError, self.pool.completed)
+        self.assertRaises(ValueError, self.pool.fileno)
+        # close() is idempotent
+        self.pool.close()
+
+    def test_close_blocked_read(self):
+        rfd, wfd = os.pipe()
+        self.addCleanup(os.close, rfd)
+        self.addCleanup(os.close, wfd)
+        self.pool.read('read', rfd, 1)
+        # close() does not wait for a read which blocks forever
+        self.pool.close()
+        self.assertTrue(self.pool.closed)
+        os.write(wfd, b'x')
+        self.wait_closed()
+
+    @support.requires_fork()
+    @warnings_helper.ignore_warnings(category=DeprecationWarning)
+    def test_fork(self):
+        rfd, wfd = os.pipe()
+        self.addCleanup(os.close, rfd)
+        self.addCleanup(os.close, wfd)
+        self.pool.read('read', rfd, 1)
+        pid = os.fork()
+        if pid == 0:
+            # The workers of the parent do not exist in the child
+            try:
+                closed = self.pool.closed
+                self.pool.close()
+            finally:
+                os._exit(0 if closed else 1)
+        support.wait_process(pid, exitcode=0)
+        os.write(wfd, b'x')
+        self.assertEqual(self.wait_for(1), [('read', 1, b'x')])
+
+    def test_invalid_arguments(self):
+        self.assertRaises(ValueError, files._FilePool, 0)
+        self.assertRaises(ValueError, self.pool.read, 'read', 0, -1)
+
+
+class AsyncFileTestsMixin:
+
+    def new_loop(self):
+        raise NotImplementedError
+
+    def setUp(self):
+        super().setUp()
+        self.loop = self.new_loop()
+        self.set_event_loop(self.loop)
+        self.addCleanup(os_helper.unlink, os_helper.TESTFN)
+
+    def run_loop(self, coro):
+        return self.loop.run_until_complete(coro)
+
+    def write_file(self, data):
+        with open(os_helper.TESTFN, 'wb') as f:
+            f.write(data)
+
+    def read_file(self):
+        with open(os_helper.TESTFN, 'rb') as f:
+            return f.read()
+
+    def test_write_read(self):
+        async def main():
+            async with await asyncio.open_file(os_helper.TESTFN, 'wb') as f:
+                self.assertEqual(f.name, os_helper.TESTFN)
+                self.assertEqual(f.mode, 'wb')
+                self.assertFalse(f.readable())
+                self.assertTrue(f.writable())
+                self.assertTrue(f.seekable())
+                self.assertEqual(await f.write(b'hello '), 6)
+                self.assertEqual(await f.write(memoryview(b'world')), 5)
+                self.assertEqual(f.tell(), 11)
+            self.assertTrue(f.closed)
+            self.assertEqual(self.read_file(), b'hello world')
+
+            async with await asyncio.open_file(os_helper.TESTFN) as f:
+                self.assertTrue(f.readable())
+                self.assertFalse(f.writable())
+                self.assertEqual(await f.read(5), b'hello')
+                self.assertEqual(f.tell(), 5)
+                self.assertEqual(await f.read(), b' world')
+                self.assertEqual(await f.read(), b'')
+                self.assertEqual(await f.read(5), b'')
+
+        self.run_loop(main())
+
+    def test_read_large(self):
+        data = os.urandom(1024 * 1024)
+        self.write_file(data)
+
+        async def main():
+            async with await asyncio.open_file(os_helper.TESTFN, 'rb') as f:
+                self.assertEqual(await f.read(), data)
+                f.seek(1000)
+                self.assertEqual(await f.read(-1), data[1000:])
+
+        self.run_loop(main())
+
+    def test_write_large(self):
+        data = os.urandom(1024 * 1024)
+
+        async def main():
+            async with await asyncio.open_file(os_helper.TESTFN, 'wb') as f:
+                self.assertEqual(await f.write(data), len(data))
+                self.assertEqual(await f.write(bytearray(b'end')), 3)
+
+        self.run_loop(main())
+        self.assertEqual(self.read_file(), data + b'end')
+
+    def test_readinto(self):
+        self.write_file(b'0123456789')
+
+        async def main():
+            async with await asyncio.open_file(os_helper.TESTFN, 'rb') as f:
+                buf = bytearray(4)
+                self.assertEqual(await f.readinto(buf), 4)
+                self.assertEqual(buf, b'0123')
+                self.assertEqual(await f.readinto(memoryview(buf)[1:]), 3)
+                self.assertEqual(buf, b'0456')
+                f.seek(8)
+                self.assertEqual(await f.readinto(buf), 2)
+                self.assertEqual(buf, b'8956')
+                self.assertEqual(await f.readinto(buf), 0)
+
+        self.run_loop(main())
+
+    def test_seek(self):
+        self.write_file(b'0123456789')
+
+        async def main():
+            async with await asyncio.open_file(os_helper.TESTFN, 'rb') as f:
+                self.assertEqual(f.seek(3), 3)
+                self.assertEqual(await f.read(2), b'34')
+                self.assertEqual(f.seek(2, os.SEEK_CUR), 7)
+                self.assertEqual(await f.read(1), b'7')
+                self.assertEqual(f.seek(-2, os.SEEK_END), 8)
+                self.assertEqual(await f.read(), b'89')
+                self.assertEqual(f.seek(20), 20)
+                self.assertEqual(await f.read(), b'')
+                with self.assertRaises(OSError) as cm:
+                    f.seek(-1)
+                self.assertEqual(cm.exception.errno, errno.EINVAL)
+                self.assertEqual(f.tell(), 20)
+
+        self.run_loop(main())
+
+    def test_concurrent_reads(self):
+        data = bytes(range(256)) * 64
+        self.write_file(data)
+
+        async def read_at(f, offset):
+            # The offset is passed to the system when the read starts
+            f.seek(offset)
+            return await f.read(256)
+
+        async def main():
+            async with await asyncio.open_file(os_helper.TESTFN, 'rb') as f:
+                offsets = range(0, len(data), 1024)
+                chunks = await asyncio.gather(
+                    *(read_at(f, offset) for offset in offsets))
+            for offset, chunk in zip(offsets, chunks):
+                self.assertEqual(chunk, data[offset:offset + 256])
+
+        self.run_loop(main())
+
+    def test_append(self):
+        self.write_file(b'hello')
+
+        async def main():
+            async with await asyncio.open_file(os_helper.TESTFN, 'ab+') as f:
+                self.assertEqual(f.tell(), 5)
+                self.assertEqual(await f.write(b' world'), 6)
+                self.assertEqual(f.tell(), 11)
+                f.seek(0)
+                self.assertEqual(await f.read(5), b'hello')
+                # Writes always go to the end of the file
+                await f.write(b'!')
+                self.assertEqual(f.tell(), 12)
+                f.seek(0)
+                self.assertEqual(await f.read(), b'hello world!')
+
+        self.run_loop(main())
+
+    def test_update(self):
+        self.write_file(b'hello world')
+
+        async def main():
+            async with await asyncio.open_file(os_helper.TESTFN, 'rb+') as f:
+                f.seek(6)
+                await f.write(b'WORLD')
+                f.seek(0)
+                self.assertEqual(await f.read(), b'hello WORLD')
+            async with await asyncio.open_file(os_helper.TESTFN, 'wb+') as f:
+                self.assertEqual(await f.read(), b'')
+                await f.write(b'new')
+                f.seek(0)
+                self.assertEqual(await f.read(), b'new')
+
+        self.run_loop(main())
+
+    def test_exclusive(self):
+        async def main():
+            async with await asyncio.open_file(os_helper.TESTFN, 'xb') as f:
+                await f.write(b'data')
+            with self.assertRaises(FileExistsError) as cm:
+                await asyncio.open_file(os_helper.TESTFN, 'xb')
+            self.assertEqual(cm.exception.filename, os_helper.TESTFN)
+
+        self.run_loop(main())
+        self.assertEqual(self.read_file(), b'data')
+
+    def test_open_errors(self):
+        async def main():
+            with self.assertRaises(FileNotFoundError) as cm:
+                await asyncio.open_file(os_helper.TESTFN)
+            self.assertEqual(cm.exception.filename, os_helper.TESTFN)
+            # Windows fails with EACCES
+            with self.assertRaises((IsADirectoryError, PermissionError)):
+                await asyncio.open_file(os.curdir)
+            for mode in ('r', 'w', 'rt', 'rbb', 'rwb', 'b', 'rb+x', 'rbU'):
+                with self.assertRaises(ValueError, msg=mode):
+                    await asyncio.open_file(os_helper.TESTFN, mode)
+            with self.assertRaises(TypeError):
+                await asyncio.open_file(os_helper.TESTFN, b'rb')
+            with self.assertRaises(TypeError):
+                await asyncio.open_file(None)
+
+        self.run_loop(main())
+
+    def test_closed(self):
+        self.write_file(b'data')
+
+        async def main():
+            f = await asyncio.open_file(os_helper.TESTFN, 'rb+')
+            self.assertIn('mode=', repr(f))
+            await f.close()
+            self.assertTrue(f.closed)
+            self.assertIn('closed', repr(f))
+            # close() is idempotent
+            await f.close()
+            for coro in (f.read, f.fsync, f.fdatasync, f.stat):
+                with self.assertRaises(ValueError):
+                    await coro()
+            with self.assertRaises(ValueError):
+                await f.write(b'x')
+            with self.assertRaises(ValueError):
+                await f.readinto(bytearray(1))
+            self.assertRaises(ValueError, f.fileno)
+            self.assertRaises(ValueError, f.tell)
+            self.assertRaises(ValueError, f.seek, 0)
+
+        self.run_loop(main())
+
+    def test_unsupported_operations(self):
+        self.write_file(b'data')
+
+        async def main():
+            async with await asyncio.open_file(os_helper.TESTFN, 'rb') as f:
+                with self.assertRaises(OSError) as cm:
+                    await f.write(b'x')
+                self.assertEqual(cm.exception.errno, errno.EBADF)
+            async with await asyncio.open_file(os_helper.TESTFN, 'ab') as f:
+                with self.assertRaises(OSError) as cm:
+                    await f.read()
+                self.assertEqual(cm.exception.errno, errno.EBADF)
+
+        self.run_loop(main())
+
+    def test_fsync_stat(self):
+        async def main():
+            async with await asyncio.open_file(os_helper.TESTFN, 'wb') as f:
+                await f.write(b'data')
+                self.assertIsNone(await f.fsync())
+                self.assertIsNone(await f.fdatasync())
+                st = await f.stat()
+                self.assertEqual(st.st_size, 4)
+                self.assertEqual(st, os.fstat(f.fileno()))
+
+        self.run_loop(main())
+
+    def test_unclosed(self):
+        self.write_file(b'data')
+
+        async def main():
+            return await asyncio.open_file(os_helper.TESTFN)
+
+        f = self.run_loop(main())
+        fd = f.fileno()
+        with self.assertWarns(ResourceWarning):
+            del f
+            support.gc_collect()
+        self.assertRaises(OSError, os.fstat, fd)
+
+    def make_fifo(self, name='fifo'):
+        if not hasattr(os, 'mkfifo'):
+            self.skipTest('requires os.mkfifo()')
+        path = f'{os_helper.TESTFN}.{name}'
+        os.mkfifo(path)
+        self.addCleanup(os_helper.unlink, path)
+        # Opening the write end does not block once the read end is open.
+        rfd = os.open(path, os.O_RDONLY | os.O_NONBLOCK)
+        self.addCleanup(os.close, rfd)
+        return path, rfd
+
+    def open_fifo_writer(self, path):
+        wfd = os.open(path, os.O_WRONLY)
+        self.addCleanup(os.close, wfd)
+        return wfd
+
+    def test_close_with_queued_read(self):
+        path, _ = self.make_fifo()
+        wfd = self.open_fifo_writer(path)
+        busy_path, _ = self.make_fifo('busy')
+        busy_wfd = self.open_fifo_writer(busy_path)
+        self.write_file(b'SECRET')
+
+        async def main():
+            # Keep the threads busy: the read of f is queued.
+            busy = await asyncio.open_file(busy_path, 'rb')
+            blocked = [asyncio.ensure_future(busy.read(1))
+                       for _ in range(8)]
+            f = await asyncio.open_file(path, 'rb')
+            read = asyncio.ensure_future(f.read(100))
+            await asyncio.sleep(0.01)
+            close = asyncio.ensure_future(f.close())
+            await asyncio.sleep(0.01)
+            # The file descriptor of f could be reused by another file: the
+            # queued read must not read this file.
+            fd = os.open(os_helper.TESTFN, os.O_RDONLY)
+            try:
+                os.write(wfd, b'data')
+                os.write(busy_wfd, b'x' * len(blocked))
+                await asyncio.gather(*blocked)
+                self.assertEqual(await read, b'data')
+                await close
+            finally:
+                os.close(fd)
+                await busy.close()
+
+        self.run_loop(main())
+
+    def test_cancel_blocked_write(self):
+        path, rfd = self.make_fifo()
+        data = b'x' * (4 * 1024 * 1024)
+
+        async def drain():
+            while True:
+                try:
+                    if not os.read(rfd, 65536):
+                        break
+                except BlockingIOError:
+                    await asyncio.sleep(0.01)
+
+        async def main():
+            f = await asyncio.open_file(path, 'wb')
+            # The data does not fit in the pipe: the write blocks.
+            write = asyncio.ensure_future(f.write(memoryview(data)))
+            await asyncio.sleep(0.01)
+            write.cancel()
+            with self.assertRaises(asyncio.CancelledError):
+                await write
+            reader = asyncio.ensure_future(drain())
+            await f.close()
+            await reader
+
+        self.run_loop(main())
+
+    def test_close_after_cancel(self):
+        rfd, wfd = os.pipe()
+        self.addCleanup(os.close, wfd)
+
+        async def main():
+            backend = files._get_file_backend(self.loop)
+            if not isinstance(backend, files._ThreadFileBackend):
+                os.close(rfd)
+                self.skipTest('requires threads')
+            # The thread blocks in read() until the pipe has data.
+            fut = backend.file_read(rfd, 10, -1)
+            await asyncio.sleep(0.01)
+            fut.cancel()
+            close = asyncio.ensure_future(backend.file_close(rfd))
+            await asyncio.sleep(0.01)
+            # The file is not closed while the read runs.
+            self.assertFalse(close.done())
+            os.fstat(rfd)
+            os.write(wfd, b'x')
+            await close
+            self.assertRaises(OSError, os.fstat, rfd)
+
+        self.run_loop(main())
+
+    def test_backend_closed_with_loop(self):
+        async def main():
+            async with await asyncio.open_file(os_helper.TESTFN, 'wb'):
+                pass
+
+        self.run_loop(main())
+        self.assertIsNotNone(self.loop._file_backend)
+        self.close_loop(self.loop)
+        self.assertIsNone(self.loop._file_backend)
+
+
+class SelectorFileTests(AsyncFileTestsMixin, test_utils.TestCase):
+
+    def new_loop(self):
+        return asyncio.SelectorEventLoop()
+
+    @unittest.skipIf(files._FilePool is None, 'requires _asyncio.FilePool')
+    def test_file_pool(self):
+        backend = self.loop._make_file_backend()
+        self.addCleanup(backend.close)
+        self.assertIsInstance(backend, files._FilePoolBackend)
+
+    @unittest.skipIf(files._FilePool is None, 'requires _asyncio.FilePool')
+    def test_cancel_open(self):
+        async def main():
+            backend = files._get_file_backend(self.loop)
+            fd_count = os_helper.fd_count()
+            fut = backend.file_open(os.fsencode(os_helper.TESTFN),
+                                    os.O_WRONLY | os.O_CREAT, 0o666)
+            fut.cancel()
+            while backend._pool.inflight:
+                await asyncio.sleep(0.01)
+            await asyncio.sleep(0)
+            # The file opened after the cancellation is closed
+            self.assertEqual(os_helper.fd_count(), fd_count)
+
+        self.run_loop(main())
+
+
+class ExecutorFileTests(AsyncFileTestsMixin, test_utils.TestCase):
+
+    def new_loop(self):
+        loop = asyncio.SelectorEventLoop()
+        loop._file_backend = files._ExecutorFileBackend(loop)
+        # As many threads as the pool of _asyncio
+        loop.set_default_executor(concurrent.futures.ThreadPoolExecutor(4))
+        return loop
+
+
+@unittest.skipUnless(sys.platform == 'win32', 'Windows only')
+class ProactorFileTests(AsyncFileTestsMixin, test_utils.TestCase):
+
+    def new_loop(self):
+        return asyncio.ProactorEventLoop()
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -1587,5 +1587,362 @@ class MyException(Exception):
             exc_info=(MyException, MOCK_ANY, MOCK_ANY))
 
 
+@unittest.skipUnless(selector_events._HAS_MMSG, 'no recvmmsg/sendmmsg')
+class SelectorDatagramTransportMmsgTests(test_utils.TestCase):
+
+    def setUp(self):
+        super().setUp()
+        self.loop = self.new_test_loop()
+        self.buffers = [memoryview(bytearray(16)) for _ in range(4)]
+        self.loop._get_datagram_buffers = lambda: self.buffers
+        self.protocol = test_utils.make_test_protocol(asyncio.DatagramProtocol)
+        self.sock = mock.Mock(spec_set=socket.socket)
+        self.sock.fileno.return_value = 7
+        self.sock.family = socket.AF_INET
+
+    def datagram_transport(self, address=None):
+        self.sock.getpeername.side_effect = None if address else OSError
+        transport = _SelectorDatagramTransport(self.loop, self.sock,
+                                               self.protocol,
+                                               address=address)
+        self.addCleanup(close_transport, transport)
+        return transport
+
+    def recvmmsg_into(self, *datagrams):
+        def recvmmsg_into(buffers):
+            messages = []
+            for buf, (data, addr) in zip(buffers, datagrams):
+                buf[:len(data)] = data
+                messages.append((len(data), [], 0, addr))
+            return messages
+        return recvmmsg_into
+
+    def test_read_ready(self):
+        transport = self.datagram_transport()
+        self.sock.recvmmsg_into.side_effect = self.recvmmsg_into(
+            (b'data1', ('0.0.0.0', 1234)), (b'data22', ('0.0.0.0', 1235)))
+        transport._read_ready()
+
+        self.assertFalse(self.sock.recvfrom.called)
+        self.assertEqual(self.protocol.datagram_received.call_args_list,
+                         [mock.call(b'data1', ('0.0.0.0', 1234)),
+                          mock.call(b'data22', ('0.0.0.0', 1235))])
+
+    def test_read_ready_closed(self):
+        # Datagrams received after the protocol closed the transport are
+        # dropped.
+        transport = self.datagram_transport()
+        self.sock.recvmmsg_into.side_effect = self.recvmmsg_into(
+            (b'data1', ('0.0.0.0', 1234)), (b'data2', ('0.0.0.0', 1234)))
+        self.protocol.datagram_received.side_effect = (
+            lambda data, addr: transport.close())
+        transport._read_ready()
+
+        self.protocol.datagram_received.assert_called_once_with(
+            b'data1', ('0.0.0.0', 1234))
+
+    def test_read_ready_tryagain(self):
+        transport = self.datagram_transport()
+        self.sock.recvmmsg_into.side_effect = BlockingIOError
+        transport._fatal_error = mock.Mock()
+        transport._read_ready()
+
+        self.assertFalse(transport._fatal_error.called)
+        self.assertFalse(self.protocol.datagram_received.called)
+
+    def test_read_ready_err(self):
+        transport = self.datagram_transport()
+        err = self.sock.recvmmsg_into.side_effect = RuntimeError()
+        transport._fatal_error = mock.Mock()
+        transport._read_ready()
+
+        transport._fatal_error.assert_called_with(
+                                   err,
+                                   'Fatal read error on datagram transport')
+
+    def test_read_ready_oserr(self):
+        transport = self.datagram_transport()
+        err = self.sock.recvmmsg_into.side_effect = OSError()
+        transport._fatal_error = mock.Mock()
+        transport._read_ready()
+
+        self.assertFalse(transport._fatal_error.called)
+        self.protocol.error_received.assert_called_with(err)
+
+    def test_read_ready_small_max_size(self):
+        # Fall back to recvfrom(), which truncates datagrams to max_size.
+        with mock.patch.object(_SelectorDatagramTransport, 'max_size', 1024):
+            transport = self.datagram_transport()
+            self.sock.recvfrom.return_value = (b'data', ('0.0.0.0', 1234))
+            transport._read_ready()
+
+        self.sock.recvfrom.assert_called_with(1024)
+        self.assertFalse(self.sock.recvmmsg_into.called)
+        self.protocol.datagram_received.assert_called_with(
+            b'data', ('0.0.0.0', 1234))
+
+    def test_sendto_ready(self):
+        self.sock.sendmmsg.return_value = 3
+        transport = self.datagram_transport()
+        transport._buffer.extend([(b'data1', ('0.0.0.0', 1)),
+                                  (b'data2', ('0.0.0.0', 2)),
+                                  (b'data3', ('0.0.0.0', 3))])
+        transport._buffer_size = 15
+        self.loop._add_writer(7, transport._sendto_ready)
+        transport._sendto_ready()
+
+        self.sock.sendmmsg.assert_called_once_with(
+            [b'data1', b'data2', b'data3'], 0,
+            [('0.0.0.0', 1), ('0.0.0.0', 2), ('0.0.0.0', 3)])
+        self.assertFalse(self.sock.sendto.called)
+        self.assertFalse(transport._buffer)
+        self.assertEqual(transport._buffer_size, 0)
+        self.assertFalse(self.loop.writers)
+
+    def test_sendto_ready_connected(self):
+        self.sock.sendmmsg.return_value = 2
+        transport = self.datagram_transport(address=('0.0.0.0', 1))
+        transport._buffer.extend([(b'data1', ('0.0.0.0', 1)),
+                                  (b'data2', ('0.0.0.0', 1))])
+        transport._sendto_ready()
+
+        self.sock.sendmmsg.assert_called_once_with([b'data1', b'data2'])
+        self.assertFalse(transport._buffer)
+
+    def test_sendto_ready_batches(self):
+        # The datagrams are sent by batches; the last one is sent alone.
+        self.sock.sendmmsg.side_effect = lambda data, flags, addrs: len(data)
+        transport = self.datagram_transport()
+        count = selector_events._DATAGRAM_BATCH_SIZE * 2 + 1
+        transport._buffer.extend((b'data', ('0.0.0.0', i))
+                                 for i in range(count))
+        transport._sendto_ready()
+
+        self.assertEqual(self.sock.sendmmsg.call_count, 2)
+        self.sock.sendto.assert_called_once_with(
+            b'data', ('0.0.0.0', count - 1))
+        self.assertFalse(transport._buffer)
+
+    def test_sendto_ready_partial(self):
+        self.sock.sendmmsg.side_effect = [1, BlockingIOError]
+        transport = self.datagram_transport()
+        transport._buffer.extend([(b'data1', ('0.0.0.0', 1)),
+                                  (b'data2', ('0.0.0.0', 2)),
+                                  (b'data3', ('0.0.0.0', 3))])
+        self.loop._add_writer(7, transport._sendto_ready)
+        transport._sendto_ready()
+
+        self.assertEqual(list(transport._buffer),
+                         [(b'data2', ('0.0.0.0', 2)),
+                          (b'data3', ('0.0.0.0', 3))])
+        self.loop.assert_writer(7, transport._sendto_ready)
+
+    def test_sendto_ready_error_received(self):
+        self.sock.sendmmsg.side_effect = ConnectionRefusedError
+        transport = self.datagram_transport()
+        transport._fatal_error = mock.Mock()
+        transport._buffer.extend([(b'data1', ()), (b'data2', ())])
+        transport._sendto_ready()
+
+        self.assertFalse(transport._fatal_error.called)
+        self.assertTrue(self.protocol.error_received.called)
+        self.assertEqual(list(transport._buffer), [(b'data2', ())])
+
+    def test_sendto_ready_exception(self):
+        err = self.sock.sendmmsg.side_effect = RuntimeError()
+        transport = self.datagram_transport()
+        transport._fatal_error = mock.Mock()
+        transport._buffer.extend([(b'data1', ()), (b'data2', ())])
+        transport._sendto_ready()
+
+        transport._fatal_error.assert_called_with(
+                                   err,
+                                   'Fatal write error on datagram transport')
+
+
+@unittest.skipUnless(selector_events._HAS_ZEROCOPY,
+                     'requires socket.send_zerocopy()')
+class SelectorSocketTransportZeroCopyTests(test_utils.TestCase):
+
+    def setUp(self):
+        super().setUp()
+        self.loop = self.new_test_loop()
+        self.protocol = test_utils.make_test_protocol(asyncio.Protocol)
+        self.sock = mock.Mock(socket.socket)
+        self.sock.fileno.return_value = 7
+        self.sock.family = socket.AF_INET
+        self.sock.getsockopt.return_value = 1
+        self.sock.zerocopy_completions.return_value = []
+        self.data = b'x' * selector_events._ZEROCOPY_MIN_SIZE
+
+    def socket_transport(self):
+        transport = _SelectorSocketTransport(self.loop, self.sock,
+                                             self.protocol)
+        self.addCleanup(close_transport, transport)
+        return transport
+
+    def test_ctor(self):
+        transport = self.socket_transport()
+        self.assertTrue(transport._zerocopy)
+        self.sock.getsockopt.assert_any_call(socket.SOL_SOCKET,
+                                             socket.SO_ZEROCOPY)
+
+    def test_ctor_disabled(self):
+        self.sock.getsockopt.return_value = 0
+        self.assertFalse(self.socket_transport()._zerocopy)
+        self.sock.getsockopt.side_effect = OSError
+        self.assertFalse(self.socket_transport()._zerocopy)
+
+    def test_ctor_unix(self):
+        self.sock.family = socket.AF_UNIX
+        self.assertFalse(self.socket_transport()._zerocopy)
+
+    def test_write(self):
+        self.sock.send_zerocopy.return_value = len(self.data)
+        transport = self.socket_transport()
+        transport.write(self.data)
+
+        self.sock.send_zerocopy.assert_called_with(self.data)
+        self.assertFalse(self.sock.send.called)
+        self.assertEqual(transport._zerocopy_pending, 1)
+
+    def test_write_memoryview(self):
+        data = memoryview(self.data + b'x')[1:]
+        self.sock.send_zerocopy.return_value = len(data)
+        transport = self.socket_transport()
+        transport.write(data)
+
+        self.sock.send_zerocopy.assert_called_with(data)
+
+    def test_write_copied(self):
+        # Small and mutable data is sent with send().
+        self.sock.send.side_effect = len
+        transport = self.socket_transport()
+        transport.write(self.data[1:])
+        transport.write(bytearray(self.data))
+        transport.write(memoryview(bytearray(self.data)))
+
+        self.assertEqual(self.sock.send.call_count, 3)
+        self.assertFalse(self.sock.send_zerocopy.called)
+        self.assertEqual(transport._zerocopy_pending, 0)
+
+    def test_write_partial(self):
+        self.sock.send_zerocopy.return_value = 1000
+        transport = self.socket_transport()
+        transport.write(self.data)
+
+        self.assertEqual(transport._zerocopy_pending, 1)
+        self.assertEqual(list(transport._buffer), [self.data[1000:]])
+        self.loop.assert_writer(7, transport._write_ready)
+
+    def test_write_again(self):
+        self.sock.send_zerocopy.side_effect = BlockingIOError
+        transport = self.socket_transport()
+        transport.write(self.data)
+
+        self.assertEqual(transport._zerocopy_pending, 0)
+        self.assertEqual(list(transport._buffer), [self.data])
+
+    def test_write_ready_sendmsg(self):
+        self.sock.send_zerocopy.return_value = len(self.data)
+        transport = self.socket_transport()
+        transport._write_ready = transport._write_sendmsg
+        transport._buffer.extend([self.data, b'tail'])
+        transport._buffer_size = len(self.data) + 4
+        self.loop._add_writer(7, transport._write_ready)
+        transport._write_ready()
+
+        self.sock.send_zerocopy.assert_called_once_with(self.data)
+        self.assertFalse(self.sock.sendmsg.called)
+        self.assertEqual(list(transport._buffer), [b'tail'])
+
+    def test_write_ready_send(self):
+        self.sock.send_zerocopy.return_value = len(self.data)
+        transport = self.socket_transport()
+        transport._write_ready = transport._write_send
+        transport._buffer.append(self.data)
+        transport._buffer_size = len(self.data)
+        self.loop._add_writer(7, transport._write_ready)
+        transport._write_ready()
+
+        self.sock.send_zerocopy.assert_called_once_with(self.data)
+        self.assertFalse(transport._buffer)
+        self.assertFalse(self.loop.writers)
+
+    def test_read_ready_reaps(self):
+        self.sock.recv.return_value = b'data'
+        self.sock.zerocopy_completions.return_value = [(0, 2, False)]
+        transport = self.socket_transport()
+        transport._zerocopy_pending = 4
+        transport._read_ready()
+
+        self.assertEqual(transport._zerocopy_pending, 1)
+        self.assertTrue(transport._zerocopy)
+        self.protocol.data_received.assert_called_with(b'data')
+
+    def test_reap_wraparound(self):
+        self.sock.zerocopy_completions.return_value = [(2**32 - 1, 0, False)]
+        transport = self.socket_transport()
+        transport._zerocopy_pending = 2
+        transport._reap_zerocopy()
+
+        self.assertEqual(transport._zerocopy_pending, 0)
+
+    def test_reap_copied(self):
+        # The kernel copied the data: stop using zero-copy sends.
+        self.sock.zerocopy_completions.return_value = [(0, 0, True)]
+        transport = self.socket_transport()
+        transport._zerocopy_pending = 1
+        transport._reap_zerocopy()
+
+        self.assertEqual(transport._zerocopy_pending, 0)
+        self.assertFalse(transport._zerocopy)
+        self.sock.send.side_effect = len
+        transport.write(self.data)
+        self.assertFalse(self.sock.send_zerocopy.called)
+
+    def test_reap_error(self):
+        self.sock.zerocopy_completions.side_effect = OSError
+        transport = self.socket_transport()
+        transport._zerocopy_pending = 1
+        transport._reap_zerocopy()
+
+        self.assertEqual(transport._zerocopy_pending, 1)
+
+    def test_close_waits_for_completions(self):
+        # The socket is not closed while the kernel may read the data.
+        transport = self.socket_transport()
+        transport._zerocopy_pending = 1
+        self.loop.call_later = mock.Mock()
+        transport._call_connection_lost(None)
+
+        self.assertFalse(self.sock.close.called)
+        self.assertFalse(self.protocol.connection_lost.called)
+        self.loop.call_later.assert_called_once_with(
+            selector_events._ZEROCOPY_CLOSE_POLL_INTERVAL,
+            transport._call_connection_lost, None)
+
+        self.sock.zerocopy_completions.return_value = [(0, 0, False)]
+        transport._call_connection_lost(None)
+        self.assertTrue(self.sock.close.called)
+        self.protocol.connection_lost.assert_called_once_with(None)
+
+    def test_close_timeout(self):
+        transport = self.socket_transport()
+        transport._zerocopy_pending = 1
+        self.loop.call_later = mock.Mock()
+        transport._call_connection_lost(None)
+        self.loop.advance_time(selector_events._ZEROCOPY_CLOSE_TIMEOUT / 2)
+        transport._call_connection_lost(None)
+        self.assertFalse(self.sock.close.called)
+        self.assertEqual(self.loop.call_later.call_count, 2)
+
+        self.loop.advance_time(selector_events._ZEROCOPY_CLOSE_TIMEOUT / 2)
+        transport._call_connection_lost(None)
+        self.assertTrue(self.sock.close.called)
+        self.assertEqual(self.loop.call_later.call_count, 2)
+        self.protocol.connection_lost.assert_called_once_with(None)
+
+
 if __name__ == '__main__':
     unittest.main()
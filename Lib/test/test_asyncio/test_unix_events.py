@@ -863,6 +863,10 @@ def write_pipe_transport(self, waiter=None):
         self.addCleanup(close_pipe_transport, transport)
         return transport
 
+    def set_buffer(self, tr, *data):
+        tr._buffer.extend(data)
+        tr._buffer_size = sum(map(len, data))
+
     def test_ctor(self):
         waiter = self.loop.create_future()
         tr = self.write_pipe_transport(waiter=waiter)
@@ -883,7 +887,7 @@ def test_write(self, m_write):
         tr.write(b'data')
         m_write.assert_called_with(5, b'data')
         self.assertFalse(self.loop.writers)
-        self.assertEqual(bytearray(), tr._buffer)
+        self.assertFalse(tr._buffer)
 
     @mock.patch('os.write')
     def test_write_no_data(self, m_write):
@@ -891,7 +895,7 @@ def test_write_no_data(self, m_write):
         tr.write(b'')
         self.assertFalse(m_write.called)
         self.assertFalse(self.loop.writers)
-        self.assertEqual(bytearray(b''), tr._buffer)
+        self.assertFalse(tr._buffer)
 
     @mock.patch('os.write')
     def test_write_partial(self, m_write):
@@ -899,17 +903,17 @@ def test_write_partial(self, m_write):
         m_write.return_value = 2
         tr.write(b'data')
         self.loop.assert_writer(5, tr._write_ready)
-        self.assertEqual(bytearray(b'ta'), tr._buffer)
+        self.assertEqual(list(tr._buffer), [b'ta'])
 
     @mock.patch('os.write')
     def test_write_buffer(self, m_write):
         tr = self.write_pipe_transport()
         self.loop.add_writer(5, tr._write_ready)
-        tr._buffer = bytearray(b'previous')
+        self.set_buffer(tr, b'previous')
         tr.write(b'data')
         self.assertFalse(m_write.called)
         self.loop.assert_writer(5, tr._write_ready)
-        self.assertEqual(bytearray(b'previousdata'), tr._buffer)
+        self.assertEqual(list(tr._buffer), [b'previous', b'data'])
 
     @mock.patch('os.write')
     def test_write_again(self, m_write):
@@ -918,7 +922,7 @@ def test_write_again(self, m_write):
         tr.write(b'data')
         m_write.assert_called_with(5, bytearray(b'data'))
         self.loop.assert_writer(5, tr._write_ready)
-        self.assertEqual(bytearray(b'data'), tr._buffer)
+        self.assertEqual(list(tr._buffer), [b'data'])
 
     @mock.patch('asyncio.unix_events.logger')
     @mock.patch('os.write')
@@ -930,7 +934,7 @@ def test_write_err(self, m_write, m_log):
         tr.write(b'data')
         m_write.assert_called_with(5, b'data')
         self.assertFalse(self.loop.writers)
-        self.assertEqual(bytearray(), tr._buffer)
+        self.assertFalse(tr._buffer)
         tr._fatal_error.assert_called_with(
                             err,
                             'Fatal write error on pipe transport')
@@ -970,55 +974,55 @@ def test__read_ready(self):
     def test__write_ready(self, m_write):
         tr = self.write_pipe_transport()
         self.loop.add_writer(5, tr._write_ready)
-        tr._buffer = bytearray(b'data')
+        self.set_buffer(tr, b'data')
         m_write.return_value = 4
         tr._write_ready()
         self.assertFalse(self.loop.writers)
-        self.assertEqual(bytearray(), tr._buffer)
+        self.assertFalse(tr._buffer)
 
     @mock.patch('os.write')
     def test__write_ready_partial(self, m_write):
         tr = self.write_pipe_transport()
         self.loop.add_writer(5, tr._write_ready)
-        tr._buffer = bytearray(b'data')
+        self.set_buffer(tr, b'data')
         m_write.return_value = 3
         tr._write_ready()
         self.loop.assert_writer(5, tr._write_ready)
-        self.assertEqual(bytearray(b'a'), tr._buffer)
+        self.assertEqual(list(tr._buffer), [b'a'])
 
     @mock.patch('os.write')
     def test__write_ready_again(self, m_write):
         tr = self.write_pipe_transport()
         self.loop.add_writer(5, tr._write_ready)
-        tr._buffer = bytearray(b'data')
+        self.set_buffer(tr, b'data')
         m_write.side_effect = BlockingIOError()
         tr._write_ready()
         m_write.assert_called_with(5, bytearray(b'data'))
         self.loop.assert_writer(5, tr._write_ready)
-        self.assertEqual(bytearray(b'data'), tr._buffer)
+        self.assertEqual(list(tr._buffer), [b'data'])
 
     @mock.patch('os.write')
     def test__write_ready_empty(self, m_write):
         tr = self.write_pipe_transport()
         self.loop.add_writer(5, tr._write_ready)
-        tr._buffer = bytearray(b'data')
+        self.set_buffer(tr, b'data')
         m_write.return_value = 0
         tr._write_ready()
         m_write.assert_called_with(5, bytearray(b'data'))
         self.loop.assert_writer(5, tr._write_ready)
-        self.assertEqual(bytearray(b'data'), tr._buffer)
+        self.assertEqual(list(tr._buffer), [b'data'])
 
     @mock.patch('asyncio.log.logger.error')
     @mock.patch('os.write')
     def test__write_ready_err(self, m_write, m_logexc):
         tr = self.write_pipe_transport()
         self.loop.add_writer(5, tr._write_ready)
-        tr._buffer = bytearray(b'data')
+        self.set_buffer(tr, b'data')
         m_write.side_effect = err = OSError()
         tr._write_ready()
         self.assertFalse(self.loop.writers)
         self.assertFalse(self.loop.readers)
-        self.assertEqual(bytearray(), tr._buffer)
+        self.assertFalse(tr._buffer)
         self.assertTrue(tr.is_closing())
         m_logexc.assert_not_called()
         self.assertEqual(1, tr._conn_lost)
@@ -1030,15 +1034,62 @@ def test__write_ready_closing(self, m_write):
         tr = self.write_pipe_transport()
         self.loop.add_writer(5, tr._write_ready)
         tr._closing = True
-        tr._buffer = bytearray(b'data')
+        self.set_buffer(tr, b'data')
         m_write.return_value = 4
         tr._write_ready()
         self.assertFalse(self.loop.writers)
         self.assertFalse(self.loop.readers)
-        self.assertEqual(bytearray(), tr._buffer)
+        self.assertFalse(tr._buffer)
         self.protocol.connection_lost.assert_called_with(None)
         self.pipe.close.assert_called_with()
 
+    @mock.patch('os.write')
+    def test_write_buffer_copy(self, m_write):
+        # Mutable data is copied when buffered, immutable data is not.
+        tr = self.write_pipe_transport()
+        m_write.side_effect = BlockingIOError()
+        data = b'data'
+        tr.write(data)
+        self.assertIs(tr._buffer[0], data)
+        buf = bytearray(b'more')
+        tr.write(buf)
+        buf[:] = b'xxxxx'
+        tr.write(memoryview(b'bytes')[1:])
+        self.assertEqual(list(tr._buffer), [b'data', b'more', b'ytes'])
+        self.assertEqual(tr.get_write_buffer_size(), 12)
+
+    @unittest.skipUnless(unix_events._HAS_WRITEV, 'requires os.writev()')
+    @mock.patch('os.writev')
+    def test__write_ready_writev(self, m_writev):
+        tr = self.write_pipe_transport()
+        self.loop.add_writer(5, tr._write_ready)
+        self.set_buffer(tr, b'abc', b'def', b'gh')
+        m_writev.return_value = 5
+        tr._write_ready()
+        m_writev.assert_called_with(5, [b'abc', b'def', b'gh'])
+        self.loop.assert_writer(5, tr._write_ready)
+        self.assertEqual(list(tr._buffer), [b'f', b'gh'])
+        self.assertEqual(tr.get_write_buffer_size(), 3)
+
+        m_writev.return_value = 3
+        tr._write_ready()
+        m_writev.assert_called_with(5, [b'f', b'gh'])
+        self.assertFalse(self.loop.writers)
+        self.assertFalse(tr._buffer)
+        self.assertEqual(tr.get_write_buffer_size(), 0)
+
+    @unittest.skipUnless(unix_events._HAS_WRITEV, 'requires os.writev()')
+    @mock.patch('os.writev')
+    def test__write_ready_writev_iov_max(self, m_writev):
+        tr = self.write_pipe_transport()
+        self.loop.add_writer(5, tr._write_ready)
+        self.set_buffer(tr, *[b'x'] * (unix_events._IOV_MAX + 1))
+        m_writev.return_value = unix_events._IOV_MAX
+        tr._write_ready()
+        self.assertEqual(len(m_writev.call_args[0][1]), unix_events._IOV_MAX)
+        self.assertEqual(list(tr._buffer), [b'x'])
+        self.loop.assert_writer(5, tr._write_ready)
+
     @mock.patch('os.write')
     def test_abort(self, m_write):
         tr = self.write_pipe_transport()
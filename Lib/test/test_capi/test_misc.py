@@ -4,6 +4,7 @@
 import _thread
 from collections import deque
 import contextlib
+import gc
 import importlib.machinery
 import importlib.util
 import json
@@ -2785,6 +2786,105 @@ def func():
         self.do_test(func, names)
 
 
+class TestFreeLists(unittest.TestCase):
+    def shrink_freelists(self):
+        # Each full collection halves the capacity of grown free lists
+        for _ in range(4):
+            gc.collect()
+
+    def test_adaptive_capacity(self):
+        get_stats = _testinternalcapi.get_freelist_stats
+        self.shrink_freelists()
+        base = get_stats()['floats']['capacity']
+
+        # Releasing many more floats than the free list can hold grows it
+        floats = [float(i) for i in range(base * 10)]
+        del floats
+        stats = get_stats()['floats']
+        self.assertGreater(stats['capacity'], base)
+        self.assertLessEqual(stats['size'], stats['capacity'])
+
+        # The grown free list is used for the next burst of allocations
+        hits = stats['hits']
+        floats = [float(i) for i in range(stats['size'])]
+        self.assertGreater(get_stats()['floats']['hits'], hits + base)
+        del floats
+
+        # and shrinks back to its base capacity at full collections
+        self.shrink_freelists()
+        self.assertEqual(get_stats()['floats']['capacity'], base)
+
+    def test_hits_and_misses(self):
+        get_stats = _testinternalcapi.get_freelist_stats
+        gc.collect()
+        before = get_stats()['floats']
+        floats = [float(i) for i in range(10)]
+        after = get_stats()['floats']
+        # The free list was emptied by the collection
+        self.assertGreaterEqual(after['misses'] - before['misses'], 10)
+        del floats
+        floats = [float(i) for i in range(10)]
+        self.assertGreaterEqual(get_stats()['floats']['hits'] - after['hits'], 10)
+        del floats
+
+    def check_reused(self, name, create):
+        get_stats = _testinternalcapi.get_freelist_stats
+        obj = create()
+        del obj
+        hits = get_stats()[name]['hits']
+        obj = create()
+        self.assertEqual(get_stats()[name]['hits'], hits + 1)
+        del obj
+
+    def test_cells(self):
+        def outer():
+            x = 1
+            def inner():
+                return x
+            return inner.__closure__[0]
+        self.check_reused('cells', outer)
+
+    def test_enumerate(self):
+        self.check_reused('enumerates', lambda: enumerate(()))
+
+    def test_range_iterator(self):
+        self.check_reused('range_iters', lambda: iter(range(3)))
+
+    def test_generators(self):
+        def gen_hits():
+            # Avoid creating a generator here
+            hits = 0
+            for name, stats in _testinternalcapi.get_freelist_stats().items():
+                if name.startswith('gens['):
+                    hits += stats['hits']
+            return hits
+
+        def gen():
+            yield 1
+        async def coro():
+            pass
+        async def agen():
+            yield 1
+
+        # The free list is shared by generators, coroutines and async
+        # generators with the same frame size
+        cases = [(gen, types.GeneratorType),
+                 (coro, types.CoroutineType),
+                 (agen, types.AsyncGeneratorType)]
+        gen().close()
+        for func, tp in cases:
+            with self.subTest(func=func):
+                hits = gen_hits()
+                obj = func()
+                self.assertEqual(gen_hits(), hits + 1)
+                self.assertIs(type(obj), tp)
+                if tp is not types.AsyncGeneratorType:
+                    obj.close()
+                del obj
+
+
+
+
 @unittest.skipUnless(support.Py_GIL_DISABLED, 'need Py_GIL_DISABLED')
 class TestPyThreadId(unittest.TestCase):
     def test_py_thread_id(self):
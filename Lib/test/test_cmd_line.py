@@ -975,6 +975,50 @@ def test_python_malloc_stats(self):
         rc, out, err = assert_python_ok('-c', code, PYTHONMALLOCSTATS='1')
         self.assertIn(b'Small block threshold', err)
 
+    def test_python_malloc_hugepages_and_numa(self):
+        # The options only change how arenas are backed by the OS
+        code = "x = [str(i) for i in range(10**5)]; print(x[-1])"
+        for name in ('PYTHON_MALLOC_HUGEPAGES', 'PYTHON_MALLOC_NUMA'):
+            with self.subTest(name=name):
+                rc, out, err = assert_python_ok('-c', code, **{name: '1'})
+                self.assertEqual(out.rstrip(), b'99999')
+
+    @unittest.skipUnless(sys.platform == 'linux', 'requires madvise()')
+    def test_python_malloc_release_threshold(self):
+        if not support.with_pymalloc():
+            self.skipTest('requires pymalloc')
+        # Only one object in ~7 pools survives, so most pools become free
+        # while their arenas stay allocated.
+        code = textwrap.dedent("""
+            import gc, sys
+            data = [b'%0200d' % i for i in range(50_000)]
+            kept = data[::500]
+            del data
+            gc.collect()
+            print(sys._release_free_memory())
+        """)
+        rc, out, err = assert_python_ok('-c', code, PYTHONMALLOC='pymalloc')
+        self.assertGreater(int(out), 2**20)
+        # The free pools were already released by the full collection
+        rc, out, err = assert_python_ok('-c', code, PYTHONMALLOC='pymalloc',
+                                        PYTHON_MALLOC_RELEASE_THRESHOLD='1')
+        self.assertLess(int(out), 2**20)
+        rc, out, err = assert_python_ok('-c', code, PYTHONMALLOC='pymalloc',
+                                        PYTHON_MALLOC_RELEASE_THRESHOLD='64k')
+        self.assertLess(int(out), 2**20)
+
+    def test_python_malloc_release_threshold_size(self):
+        code = 'import sys; print(sys._release_free_memory())'
+        for value in '64M', '1G', '0':
+            with self.subTest(value=value):
+                assert_python_ok('-c', code,
+                                 PYTHON_MALLOC_RELEASE_THRESHOLD=value)
+        for value in 'abc', '-1', ' 1', '64MB', '1T', '99999999999999999999':
+            with self.subTest(value=value):
+                rc, out, err = assert_python_failure(
+                    '-c', code, PYTHON_MALLOC_RELEASE_THRESHOLD=value)
+                self.assertIn(b'PYTHON_MALLOC_RELEASE_THRESHOLD must be', err)
+
     def test_python_user_base(self):
         code = "import site; print(site.USER_BASE)"
         expected = "/custom/userbase"
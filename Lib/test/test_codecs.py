@@ -917,6 +917,53 @@ def test_incremental_errors(self):
                 dec = codecs.getincrementaldecoder(self.encoding)()
                 self.assertRaises(UnicodeDecodeError, dec.decode, data)
 
+    def test_mixed_lengths(self):
+        # Strings long enough to be decoded and encoded by blocks, with a
+        # character of every length at every offset of a block.
+        chars = ['\x7f', '\x80', '\xe9', '\xff', '\u0100', '\u0436',
+                 '\u07ff', '\u0800', '\u4e2d', '\ud7ff', '\ue000',
+                 '\uffff', '\U00010000', '\U0001f600', '\U0010ffff']
+        for n in range(20):
+            for prefix in 'a' * n, '\xe9' * n, '\u0436' * n, 'a\u4e2d' * n:
+                for c in chars:
+                    for suffix in 'b' * 20, '\xe9b' * 10, '\u4e2d' * 20:
+                        s = prefix + c + suffix
+                        b = b''.join(ch.encode('utf-8') for ch in s)
+                        self.assertEqual(s.encode('utf-8'), b)
+                        self.assertEqual(b.decode('utf-8'), s)
+
+    def test_mixed_lengths_errors(self):
+        invalid = [b'\x80', b'\xbf', b'\xc0\x80', b'\xc1\xbf', b'\xc2',
+                   b'\xe0\x80\x80', b'\xe0\x9f\xbf', b'\xe4\xb8',
+                   b'\xed\xa0\x80', b'\xed\xbf\xbf', b'\xf0\x8f\xbf\xbf',
+                   b'\xf4\x90\x80\x80', b'\xf5\x80\x80\x80', b'\xff']
+        for n in range(20):
+            for prefix in 'a' * n, '\xe9' * n, 'a\u4e2d' * n:
+                for bad in invalid:
+                    for suffix in 'b' * 20, '\u0436b' * 10, '\u4e2d' * 20:
+                        p = prefix.encode('utf-8')
+                        data = p + bad + suffix.encode('utf-8')
+                        with self.assertRaises(UnicodeDecodeError) as cm:
+                            data.decode('utf-8')
+                        self.assertEqual(cm.exception.start, len(p))
+                        self.assertEqual(
+                            data.decode('utf-8', 'replace'),
+                            prefix + bad.decode('utf-8', 'replace')
+                            + suffix)
+                        self.assertEqual(
+                            data.decode('utf-8', 'surrogateescape')
+                                .encode('utf-8', 'surrogateescape'),
+                            data)
+        for n in range(20):
+            for prefix in 'a' * n, '\xe9' * n, '\u0436' * n:
+                s = prefix + '\ud800' + 'b' * 20
+                self.assertEqual(s.encode('utf-8', 'surrogatepass'),
+                                 prefix.encode('utf-8')
+                                 + b'\xed\xa0\x80' + b'b' * 20)
+                with self.assertRaises(UnicodeEncodeError) as cm:
+                    s.encode('utf-8')
+                self.assertEqual(cm.exception.start, n)
+
 
 class UTF7Test(ReadTest, unittest.TestCase):
     encoding = "utf-7"
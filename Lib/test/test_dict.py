@@ -362,6 +362,87 @@ class A:
             d2 = d.copy()
             self.assertEqual(gc.is_tracked(d), gc.is_tracked(d2))
 
+    def test_copy_on_write(self):
+        # Copies share their table until one of the dicts is modified
+        def mutators():
+            yield lambda d: d.__setitem__('new', 0)
+            yield lambda d: d.__setitem__('k5', 0)
+            yield lambda d: d.__setitem__(5, 0)
+            yield lambda d: d.__delitem__('k5')
+            yield lambda d: d.pop('k5')
+            yield lambda d: d.popitem()
+            yield lambda d: d.setdefault('new', 0)
+            yield lambda d: d.update({'k5': 0, 'new': 0})
+            yield lambda d: d.clear()
+
+        for copy in (dict.copy, lambda d: {**d}):
+            for mutate in mutators():
+                d = {f'k{i}': i for i in range(2000)}
+                expected = dict(zip(d.keys(), d.values()))
+                d2 = copy(d)
+                d3 = copy(d2)
+                mutate(d2)
+                self.assertEqual(d, expected)
+                self.assertEqual(d3, expected)
+                mutate(d)
+                self.assertEqual(d, d2)
+                self.assertEqual(d3, expected)
+
+    def test_copy_on_write_gc(self):
+        class A:
+            pass
+
+        a = A()
+        a.d = dict.fromkeys(range(2000))
+        a.d.update({'a': a, 'b': [a]})
+        ref = weakref.ref(a)
+        copies = [a.d.copy() for _ in range(3)]
+        del a
+        gc.collect()
+        for d in copies:
+            self.assertIs(d['a'], ref())
+            self.assertEqual(d['b'], [ref()])
+            self.assertIs(ref().d['a'], ref())
+        del copies[1:]
+        gc.collect()
+        self.assertIsNotNone(ref())
+        del d, copies
+        gc.collect()
+        self.assertIsNone(ref())
+
+    def test_copy_on_write_store_attr(self):
+        class A:
+            pass
+
+        a = A()
+        for i in range(2000):
+            setattr(a, f'attr{i}', i)
+        a.__dict__[1] = 1  # combined table
+        for i in range(100):
+            d = a.__dict__.copy()
+            a.attr5 = i
+            self.assertEqual(d['attr5'], i - 1 if i else 5)
+            self.assertEqual(a.attr5, i)
+
+    def test_copy_on_write_referents(self):
+        # The dicts sharing a table report its keys and values
+        class A:
+            pass
+
+        a = A()
+        d = dict.fromkeys(range(2000))
+        d['a'] = a
+        d2 = d.copy()
+        for x in (d, d2):
+            referents = gc.get_referents(x)
+            self.assertIn(a, referents)
+            self.assertIn('a', referents)
+        referrers = gc.get_referrers(a)
+        self.assertTrue(any(x is d for x in referrers))
+        self.assertTrue(any(x is d2 for x in referrers))
+        for x in gc.get_referents(d) + referrers + gc.get_objects():
+            self.assertNotEqual(type(x).__name__, 'dict_shared_keys')
+
     def test_copy_noncompact(self):
         # Dicts don't compact themselves on del/pop operations.
         # Copy will use a slow merging strategy that produces
@@ -857,6 +938,34 @@ def __eq__(self, other):
         resizing = True
         d[9] = 6
 
+    def test_large_str_keys(self):
+        # Tables of 2**16 slots or more of string keys are probed by groups
+        # of slots.  Mix insertions and deletions so that dummy slots are
+        # reused and the table is rebuilt.
+        class S(str):
+            pass
+
+        n = 50_000
+        keys = [f'key{i}' for i in range(n)]
+        d = dict.fromkeys(keys)
+        for i, k in enumerate(keys):
+            d[k] = i
+        for k in keys[::3]:
+            del d[k]
+        k, v = d.popitem()
+        self.assertEqual(k, keys[-1])
+        self.assertEqual(v, n - 1)
+        for k in keys[::6]:
+            d[k] = -1
+        expected = {k: -1 if i % 6 == 0 else i
+                    for i, k in enumerate(keys[:-1]) if i % 6 == 0 or i % 3}
+        self.assertEqual(d, expected)
+        self.assertEqual(d.copy(), expected)
+        for i, k in enumerate(keys[:-1]):
+            self.assertEqual(k in d, i % 6 == 0 or i % 3 != 0)
+            self.assertEqual(S(k) in d, k in d)
+            self.assertNotIn(k + 'x', d)
+
     def test_empty_presized_dict_in_freelist(self):
         # Bug #3537: if an empty but presized dict with a size larger
         # than 7 was in the freelist, it triggered an assertion failure
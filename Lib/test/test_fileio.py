@@ -730,6 +730,102 @@ def __setattr__(self, name, value):
         self.assertRaises(MyException, MyFileIO, fd)
         os.close(fd)  # should not raise OSError(EBADF)
 
+    def testMmap(self):
+        import_module('mmap')
+        data = b''.join(b'line %d\n' % i for i in range(1000))
+        with open(TESTFN, 'wb') as f:
+            f.write(data)
+        self.addCleanup(os.unlink, TESTFN)
+
+        with self.FileIO(TESTFN, 'r', mmap=True) as f:
+            self.assertEqual(f.read(5), data[:5])
+            self.assertEqual(f.tell(), 5)
+            self.assertEqual(f.readline(), data[5:7])
+            self.assertEqual(f.readline(3), data[7:10])
+            b = bytearray(10)
+            self.assertEqual(f.readinto(b), 10)
+            self.assertEqual(b, data[10:20])
+            self.assertEqual(f.seek(-10, io.SEEK_END), len(data) - 10)
+            self.assertEqual(f.read(), data[-10:])
+            self.assertEqual(f.read(1), b'')
+            self.assertEqual(f.readinto(b), 0)
+            self.assertEqual(f.seek(100), 100)
+            self.assertEqual(f.seek(10, io.SEEK_CUR), 110)
+            self.assertEqual(list(f), data[110:].splitlines(keepends=True))
+            self.assertRaises(OSError, f.seek, -1)
+            self.assertEqual(f.seek(len(data) + 10), len(data) + 10)
+            self.assertEqual(f.read(), b'')
+            view = f.getbuffer()
+            self.assertTrue(view.readonly)
+            self.assertEqual(view, data)
+        # The view stays valid after the file is closed.
+        self.assertEqual(bytes(view[:6]), b'line 0')
+        view.release()
+
+        # The position of the file descriptor is the initial position.
+        fd = os.open(TESTFN, os.O_RDONLY)
+        os.lseek(fd, 7, io.SEEK_SET)
+        with self.FileIO(fd, 'r', mmap=True) as f:
+            self.assertEqual(f.tell(), 7)
+            self.assertEqual(f.readline(), data[7:14])
+
+    def testMmapGrowth(self):
+        import_module('mmap')
+        self.addCleanup(os.unlink, TESTFN)
+        with (open(TESTFN, 'wb', buffering=0) as w,
+              self.FileIO(TESTFN, 'r', mmap=True, sequential=True) as f):
+            self.assertEqual(f.read(), b'')
+            self.assertEqual(f.getbuffer(), b'')
+            w.write(b'spam\n')
+            self.assertEqual(f.readline(), b'spam\n')
+            w.write(b'eggs')
+            self.assertEqual(f.read(10), b'eggs')
+            w.write(b'ham')
+            self.assertEqual(f.seek(0, io.SEEK_END), 12)
+            self.assertEqual(f.getbuffer(), b'spam\neggsham')
+
+    def testMmapTruncate(self):
+        # Reading the mapping past the end of the file raises SIGBUS.
+        import_module('mmap')
+        data = b'x' * 100_000
+        with open(TESTFN, 'wb') as f:
+            f.write(data)
+        self.addCleanup(os.unlink, TESTFN)
+        with self.FileIO(TESTFN, 'r', mmap=True) as f:
+            self.assertEqual(f.read(10), data[:10])
+            os.truncate(TESTFN, 5000)
+            self.assertEqual(f.read(100_000), data[10:5000])
+            f.seek(0)
+            os.truncate(TESTFN, 0)
+            self.assertEqual(f.read(100_000), b'')
+            b = bytearray(10)
+            self.assertEqual(f.readinto(b), 0)
+            self.assertEqual(f.getbuffer(), b'')
+            with open(TESTFN, 'wb') as w:
+                w.write(b'spam\n')
+            self.assertEqual(f.readline(), b'spam\n')
+
+    def testMmapErrors(self):
+        import_module('mmap')
+        for mode in 'w', 'a', 'r+':
+            self.assertRaises(ValueError, self.FileIO, TESTFN, mode,
+                              mmap=True)
+        self.assertFalse(os.path.exists(TESTFN))
+        self.addCleanup(os.unlink, TESTFN)
+        with self.FileIO(TESTFN, 'w') as f:
+            self.assertRaises(io.UnsupportedOperation, f.getbuffer)
+        f = self.FileIO(TESTFN, 'r', mmap=True)
+        f.close()
+        self.assertRaises(ValueError, f.read)
+        self.assertRaises(ValueError, f.readline)
+        self.assertRaises(ValueError, f.getbuffer)
+        if hasattr(os, 'pipe'):
+            r, w = os.pipe()
+            self.addCleanup(os.close, r)
+            self.addCleanup(os.close, w)
+            self.assertRaises(io.UnsupportedOperation, self.FileIO, r, 'r',
+                              closefd=False, mmap=True)
+
 
 class COtherFileTests(OtherFileTests, unittest.TestCase):
     FileIO = _io.FileIO
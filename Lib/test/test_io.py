@@ -1909,6 +1909,24 @@ def test_write_and_rewind(self):
         bufio.flush()
         self.assertEqual(raw.getvalue(), b"XYcdef123456")
 
+    def test_write_large_after_small(self):
+        # A large write following buffered data, which the C implementation
+        # writes together with a single writev() call on a FileIO.
+        self.addCleanup(os_helper.unlink, os_helper.TESTFN)
+        with self.FileIO(os_helper.TESTFN, "w+b") as raw:
+            bufio = self.tp(raw, 16)
+            self.assertEqual(bufio.write(b"abc"), 3)
+            self.assertEqual(bufio.write(b"x" * 100), 100)
+            self.assertEqual(bufio.tell(), 103)
+            self.assertEqual(bufio.write(b"def"), 3)
+            self.assertEqual(bufio.write(memoryview(b"y" * 16)), 16)
+            self.assertEqual(bufio.write(b"g"), 1)
+            bufio.flush()
+            self.assertEqual(bufio.tell(), 123)
+            raw.seek(0)
+            self.assertEqual(raw.read(),
+                             b"abc" + b"x" * 100 + b"def" + b"y" * 16 + b"g")
+
     def test_flush(self):
         writer = self.MockRawIO()
         bufio = self.tp(writer, 8)
@@ -3017,6 +3035,34 @@ def test_newlines_input(self):
             txt.seek(0)
             self.assertEqual(txt.read(), "".join(expected))
 
+    def test_newlines_long_lines(self):
+        # Lines of all lengths around the word size, with characters of
+        # each kind, some of them containing the bytes of \r and \n.
+        def split(data, sep):
+            *lines, last = data.split(sep)
+            return [line + sep for line in lines] + ([last] if last else [])
+
+        newlines = ["\n", "\r\n", "\r"]
+        for filler in ("a", "\xe9", "\u0a0d", "\U0001000a"):
+            lines = [filler * (i // 2) + "b" * (i % 2) + newlines[i % 3]
+                     for i in range(70)]
+            data = "".join(lines) + "last"
+            translated = data.replace("\r\n", "\n").replace("\r", "\n")
+            for newline, expected in [
+                (None, translated.splitlines(keepends=True)),
+                ("", data.splitlines(keepends=True)),
+                ("\n", split(data, "\n")),
+                ("\r\n", split(data, "\r\n")),
+                ("\r", split(data, "\r")),
+                ]:
+                with self.subTest(filler=filler, newline=newline):
+                    buf = self.BytesIO(data.encode("utf-8"))
+                    txt = self.TextIOWrapper(buf, encoding="utf-8",
+                                             newline=newline)
+                    self.assertEqual(list(txt), expected)
+                    if newline in (None, ""):
+                        self.assertEqual(txt.newlines, ("\r", "\n", "\r\n"))
+
     def test_newlines_output(self):
         testdict = {
             "": b"AAA\nBBB\nCCC\nX\rY\r\nZ",
@@ -4218,6 +4264,86 @@ def test___all__(self):
                              extra=self.extra_exported,
                              not_exported=self.not_exported)
 
+    def test_sequential(self):
+        sizes = []
+        class FileIO(self.FileIO):
+            def readinto(self, b):
+                sizes.append(len(b))
+                return super().readinto(b)
+            def read(self, size=-1):
+                sizes.append(size)
+                return super().read(size)
+
+        data = bytes(range(256)) * 4096
+        with self.open(os_helper.TESTFN, "wb") as f:
+            f.write(data)
+        with self.BufferedReader(FileIO(os_helper.TESTFN), 8192,
+                                 sequential=True) as f:
+            # The buffer grows while the file is read sequentially.
+            self.assertEqual(f.read(1000), data[:1000])
+            self.assertEqual(sizes, [16384])
+            chunks = [data[:1000]]
+            while chunk := f.read(1000):
+                chunks.append(chunk)
+            self.assertEqual(b"".join(chunks), data)
+            self.assertEqual(sizes[:4], [16384, 32768, 65536, 131072])
+            self.assertEqual(max(sizes), 256 * 1024)
+
+            # And shrinks back after a seek.
+            sizes.clear()
+            f.seek(1000)
+            self.assertEqual(f.read(1000), data[1000:2000])
+            self.assertEqual(f.read(8192), data[2000:10192])
+            self.assertEqual(sizes, [8192, 16384])
+
+    def test_sequential_seek_large_read(self):
+        # A read larger than the shrunk buffer after a seek is complete.
+        data = bytes(range(256)) * 8192
+        with self.open(os_helper.TESTFN, "wb") as f:
+            f.write(data)
+        with self.BufferedReader(self.FileIO(os_helper.TESTFN),
+                                 sequential=True) as f:
+            while f.tell() < 1024 * 1024:
+                f.read(1000)
+            f.seek(0)
+            self.assertEqual(f.read(100000), data[:100000])
+            self.assertEqual(f.tell(), 100000)
+
+    def test_sequential_open(self):
+        data = b"line\n" * 1000
+        with self.open(os_helper.TESTFN, "wb") as f:
+            f.write(data)
+        with self.open(os_helper.TESTFN, "rb", sequential=True) as f:
+            self.assertIsInstance(f, self.BufferedReader)
+            self.assertEqual(f.read(), data)
+        with self.open(os_helper.TESTFN, encoding="ascii",
+                       sequential=True) as f:
+            self.assertEqual(f.readlines(), ["line\n"] * 1000)
+        for mode in "r+b", "wb", "ab", "xb":
+            self.assertRaises(ValueError, self.open, os_helper.TESTFN, mode,
+                              sequential=True)
+        self.assertRaises(ValueError, self.open, os_helper.TESTFN, "rb",
+                          buffering=0, sequential=True)
+
+        # Streams without a file descriptor are supported.
+        with self.BufferedReader(self.BytesIO(data), sequential=True) as f:
+            self.assertEqual(f.read(), data)
+
+    def test_mmap_open(self):
+        import_helper.import_module("mmap")
+        data = b"line\n" * 1000
+        with self.open(os_helper.TESTFN, "wb") as f:
+            f.write(data)
+        for kwargs in {}, {"sequential": True}, {"buffering": 0}:
+            with self.open(os_helper.TESTFN, "rb", mmap=True, **kwargs) as f:
+                self.assertIsInstance(f, self.FileIO)
+                self.assertEqual(f.readline(), b"line\n")
+                self.assertEqual(f.getbuffer(), data)
+                self.assertEqual(f.read(), data[5:])
+        for mode in "r", "r+b", "wb", "ab", "xb":
+            self.assertRaises(ValueError, self.open, os_helper.TESTFN, mode,
+                              mmap=True)
+
     def test_attributes(self):
         f = self.open(os_helper.TESTFN, "wb", buffering=0)
         self.assertEqual(f.mode, "wb")
@@ -229,6 +229,76 @@ def test_karatsuba(self):
                          1)
                     self.assertEqual(x, y)
 
+    @support.cpython_only
+    def test_mul_algorithms(self):
+        # Toom-3 and the NTT, forced regardless of the size cutoffs, agree
+        # with each other and with the built-in multiplication.
+        from test.support import import_helper
+        _testinternalcapi = import_helper.import_module('_testinternalcapi')
+        toom3 = _testinternalcapi.long_mul_toom3
+        ntt = _testinternalcapi.long_mul_ntt
+        rng = random.Random(31)
+        sizes = [0, 1, 2, 3, 4, 7, 50, 151, 400, 1200, 3500]
+        for asize in sizes:
+            for bsize in sizes:
+                with self.subTest(asize=asize, bsize=bsize):
+                    a = rng.getrandbits(asize * SHIFT)
+                    b = rng.getrandbits(bsize * SHIFT)
+                    expected = a * b
+                    self.assertEqual(toom3(a, b), expected)
+                    self.assertEqual(ntt(a, b), expected)
+                    # The signs are ignored
+                    self.assertEqual(toom3(-a, b), expected)
+                    self.assertEqual(ntt(a, -b), expected)
+                    # Squaring, and all digits at their maximum
+                    self.assertEqual(toom3(a, a), a * a)
+                    self.assertEqual(ntt(a, a), a * a)
+                    a = (1 << (asize * SHIFT)) - 1
+                    b = (1 << (bsize * SHIFT)) - 1
+                    self.assertEqual(ntt(a, b), toom3(a, b))
+        # Above the cutoffs, check the products modulo a few primes.
+        for size in (5000, 20_000, 100_000):
+            a = rng.getrandbits(size * SHIFT)
+            b = rng.getrandbits(size * SHIFT * 2 // 3)
+            for p in (2**61 - 1, 10**9 + 7, 998244353):
+                with self.subTest(size=size, p=p):
+                    self.assertEqual((a * b) % p, (a % p) * (b % p) % p)
+                    self.assertEqual((a * a) % p, (a % p) ** 2 % p)
+
+    @support.cpython_only
+    def test_burnikel_ziegler_division(self):
+        from test.support import import_helper
+        _testinternalcapi = import_helper.import_module('_testinternalcapi')
+        divrem = _testinternalcapi.long_divrem_bz
+        rng = random.Random(32)
+        for bsize in (1, 2, 10, 301, 1000):
+            for extra in (0, 1, 150, 2000):
+                a = rng.getrandbits((bsize + extra) * SHIFT)
+                b = rng.getrandbits(bsize * SHIFT) | 1
+                if extra == 150:
+                    b = (1 << (bsize * SHIFT)) - 1
+                with self.subTest(bsize=bsize, extra=extra):
+                    q, r = divrem(a, b)
+                    self.assertEqual(q * b + r, a)
+                    self.assertTrue(0 <= r < b)
+                    self.assertEqual((q, r), divmod(a, b))
+                    # Truncated division, like C
+                    self.assertEqual(divrem(-a, b), (-q, -r))
+                    self.assertEqual(divrem(a, -b), (-q, r))
+                    self.assertEqual(divrem(-a, -b), (q, -r))
+        with self.assertRaises(ZeroDivisionError):
+            divrem(1, 0)
+        # Floor division of large ints uses it above a cutoff.
+        a = rng.getrandbits(5000 * SHIFT)
+        b = rng.getrandbits(1500 * SHIFT)
+        for x, y in ((a, b), (-a, b), (a, -b), (-a, -b)):
+            with self.subTest(x=x < 0, y=y < 0):
+                q, r = divmod(x, y)
+                self.assertEqual(q * y + r, x)
+                self.assertTrue(0 <= r < y if y > 0 else y < r <= 0)
+                self.assertEqual(x // y, q)
+                self.assertEqual(x % y, r)
+
     def check_bitop_identities_1(self, x):
         eq = self.assertEqual
         with self.subTest(x=x):
@@ -585,6 +585,86 @@ def test_ctypes_cast(self):
                 m[2:] = memoryview(p6).cast(format)[2:]
                 self.assertEqual(d.value, 0.6)
 
+    def test_split(self):
+        data = b' GET /a HTTP/1.1\r\nHost: x\r\n\r\nbody \t\x0b'
+        m = memoryview(data)
+        for sep in None, b'\r\n', b' ', b'\r\n\r\n', b'zz', bytearray(b':'):
+            for maxsplit in -1, 0, 1, 2, 10:
+                with self.subTest(sep=sep, maxsplit=maxsplit):
+                    views = m.split(sep, maxsplit)
+                    self.assertEqual(views, data.split(sep, maxsplit))
+                    for v in views:
+                        self.assertIsInstance(v, memoryview)
+                        self.assertIs(v.obj, data)
+                        self.assertEqual(hash(v), hash(bytes(v)))
+        self.assertEqual(m[3:20].split(maxsplit=1), data[3:20].split(maxsplit=1))
+        self.assertEqual(m.split(sep=b'/'), data.split(sep=b'/'))
+        self.assertEqual(memoryview(b'').split(), [])
+        self.assertEqual(memoryview(b'').split(b','), [b''])
+        self.assertEqual(memoryview(b' \t ').split(), [])
+        self.assertRaises(ValueError, m.split, b'')
+        self.assertRaises(TypeError, m.split, 'x')
+
+        # The views share the memory of a writable object.
+        ba = bytearray(b'ab,cd')
+        head, tail = memoryview(ba).split(b',')
+        ba[0] = ord('x')
+        self.assertEqual(head, b'xb')
+        self.assertFalse(head.readonly)
+
+        for fmt in 'bc':
+            views = memoryview(data).cast(fmt).split(b'\r\n')
+            self.assertEqual([v.tobytes() for v in views], data.split(b'\r\n'))
+            self.assertTrue(all(v.format == fmt for v in views))
+
+    def test_partition(self):
+        data = b'key=value=x'
+        m = memoryview(data)
+        for sep in b'=', b'value', b'x', b'key', b'?', bytearray(b'=v'):
+            with self.subTest(sep=sep):
+                parts = m.partition(sep)
+                self.assertIsInstance(parts, tuple)
+                self.assertEqual(parts, data.partition(sep))
+                self.assertTrue(all(p.obj is data for p in parts))
+                parts = m.rpartition(sep)
+                self.assertEqual(parts, data.rpartition(sep))
+                self.assertTrue(all(p.obj is data for p in parts))
+        self.assertEqual(m[4:].partition(b'='), (b'value', b'=', b'x'))
+        self.assertRaises(ValueError, m.partition, b'')
+        self.assertRaises(ValueError, m.rpartition, b'')
+        self.assertRaises(TypeError, m.partition, None)
+
+    def test_split_non_byte_views(self):
+        a = array.array('H', [1, 2, 3])
+        b = b'a b c d'
+        for m in memoryview(a), memoryview(b)[::2], memoryview(b).cast('B', (7, 1)):
+            with self.subTest(m=m):
+                self.assertRaises(TypeError, m.split)
+                self.assertRaises(TypeError, m.partition, b' ')
+                self.assertRaises(TypeError, m.rpartition, b' ')
+        m = memoryview(b)
+        m.release()
+        self.assertRaises(ValueError, m.split)
+        self.assertRaises(ValueError, m.partition, b' ')
+
+    def test_split_sep_releases_view(self):
+        # Getting the buffer of the separator releases the view and frees
+        # its memory.
+        ba = bytearray(b'a,b,c' * 1000)
+        m = memoryview(ba)
+
+        class Sep:
+            def __buffer__(self, flags):
+                m.release()
+                ba.clear()
+                return memoryview(b',')
+
+        self.assertRaises(ValueError, m.split, Sep())
+        m = memoryview(ba)
+        self.assertRaises(ValueError, m.partition, Sep())
+        m = memoryview(ba)
+        self.assertRaises(ValueError, m.rpartition, Sep())
+
     def test_half_float(self):
         half_data = struct.pack('eee', 0.0, -1.5, 1.5)
         float_data = struct.pack('fff', 0.0, -1.5, 1.5)
@@ -5305,6 +5305,43 @@ def test_bytes_like(self):
             with self.assertRaises(TypeError):
                 os.scandir(path_bytes)
 
+    def test_scandir_names(self):
+        # os._scandir_names() is used by os.walk()
+        self.create_file("file.txt")
+        os.mkdir(os.path.join(self.path, "dir"))
+        expected = {True: (["dir"], ["file.txt"], []),
+                    False: (["dir"], ["file.txt"], [])}
+        if os_helper.can_symlink():
+            os.symlink("dir", os.path.join(self.path, "link_dir"), True)
+            os.symlink("file.txt", os.path.join(self.path, "link_file"))
+            os.symlink("missing", os.path.join(self.path, "broken"))
+            expected = {
+                True: (["dir", "link_dir"],
+                       ["broken", "file.txt", "link_file"],
+                       ["link_dir"]),
+                False: (["dir"],
+                        ["broken", "file.txt", "link_dir", "link_file"],
+                        []),
+            }
+        for follow_symlinks in True, False:
+            with self.subTest(follow_symlinks=follow_symlinks):
+                result = os._scandir_names(self.path, follow_symlinks)
+                self.assertEqual(tuple(map(sorted, result)),
+                                 expected[follow_symlinks])
+                result = os._scandir_names(os.fsencode(self.path),
+                                           follow_symlinks)
+                self.assertEqual(
+                    tuple(sorted(map(os.fsdecode, names)) for names in result),
+                    expected[follow_symlinks])
+                for names in result:
+                    for name in names:
+                        self.assertIsInstance(name, bytes)
+
+        self.assertRaises(FileNotFoundError, os._scandir_names,
+                          os.path.join(self.path, "missing"), True)
+        self.assertRaises(NotADirectoryError, os._scandir_names,
+                          os.path.join(self.path, "file.txt"), True)
+
     @unittest.skipUnless(os.listdir in os.supports_fd,
                          'fd support for listdir required for this test.')
     def test_fd(self):
@@ -4677,6 +4677,257 @@ class RecvmsgIntoSCMRightsStreamTest(RecvmsgIntoMixin, SCMRightsTest,
     pass
 
 
+@requireAttrs(socket.socket, "recvmmsg_into", "sendmmsg")
+class MultiMessageUDPTest(SocketUDPTest):
+    # Tests for recvmmsg_into() and sendmmsg(), which move several
+    # datagrams with a single system call.
+
+    def setUp(self):
+        super().setUp()
+        self.serv.settimeout(support.LOOPBACK_TIMEOUT)
+        self.cli = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self.addCleanup(self.cli.close)
+        self.cli.bind((HOST, 0))
+        self.serv_addr = self.serv.getsockname()
+        self.cli_addr = self.cli.getsockname()
+
+    def testSendmmsgAddresses(self):
+        datagrams = [b'a', bytearray(b'bb'), memoryview(b'ccc')]
+        self.assertEqual(self.cli.sendmmsg(datagrams, 0,
+                                           [self.serv_addr] * 3), 3)
+        for data in datagrams:
+            self.assertEqual(self.serv.recvfrom(10), (data, self.cli_addr))
+
+    def testSendmmsgConnected(self):
+        self.cli.connect(self.serv_addr)
+        self.assertEqual(self.cli.sendmmsg([b'a', b'bb']), 2)
+        self.assertEqual(self.serv.recv(10), b'a')
+        self.assertEqual(self.serv.recv(10), b'bb')
+
+    def testSendmmsgEmpty(self):
+        self.assertEqual(self.cli.sendmmsg([]), 0)
+        self.assertEqual(self.cli.sendmmsg([], 0, []), 0)
+
+    def testSendmmsgBadArgs(self):
+        self.assertRaises(TypeError, self.cli.sendmmsg)
+        self.assertRaises(TypeError, self.cli.sendmmsg, b'data')
+        self.assertRaises(TypeError, self.cli.sendmmsg, [object()], 0,
+                          [self.serv_addr])
+        self.assertRaises(TypeError, self.cli.sendmmsg, [b'data'], 0,
+                          object())
+        self.assertRaises(TypeError, self.cli.sendmmsg, [b'data'], 0,
+                          [object()])
+        with self.assertRaisesRegex(ValueError, 'same length'):
+            self.cli.sendmmsg([b'data'], 0, [self.serv_addr] * 2)
+
+    def testRecvmmsgInto(self):
+        self.cli.sendmmsg([b'a', b'bb', b'ccc'], 0, [self.serv_addr] * 3)
+        buf = bytearray(20)
+        view = memoryview(buf)
+        buffers = [view[i:i + 4] for i in range(0, 20, 4)]
+        messages = self.serv.recvmmsg_into(buffers)
+        self.assertEqual(messages, [(1, [], 0, self.cli_addr),
+                                    (2, [], 0, self.cli_addr),
+                                    (3, [], 0, self.cli_addr)])
+        self.assertEqual(buf, b'a\0\0\0bb\0\0ccc' + bytes(9))
+
+    def testRecvmmsgIntoTruncated(self):
+        self.cli.sendto(b'abcdef', self.serv_addr)
+        buf = bytearray(4)
+        [(nbytes, ancdata, flags, addr)] = self.serv.recvmmsg_into([buf])
+        self.assertEqual(nbytes, 4)
+        self.assertEqual(buf, b'abcd')
+        self.assertTrue(flags & socket.MSG_TRUNC)
+
+    def testRecvmmsgIntoNonBlocking(self):
+        self.serv.setblocking(False)
+        self.assertRaises(BlockingIOError,
+                          self.serv.recvmmsg_into, [bytearray(10)])
+
+    def testRecvmmsgIntoTimeout(self):
+        self.serv.settimeout(0.01)
+        self.assertRaises(TimeoutError,
+                          self.serv.recvmmsg_into, [bytearray(10)])
+
+    def testRecvmmsgIntoEmpty(self):
+        self.assertEqual(self.serv.recvmmsg_into([]), [])
+
+    def testRecvmmsgIntoBadArgs(self):
+        self.assertRaises(TypeError, self.serv.recvmmsg_into)
+        self.assertRaises(TypeError, self.serv.recvmmsg_into, bytearray(10))
+        self.assertRaises(TypeError, self.serv.recvmmsg_into, [b'data'])
+        self.assertRaises(TypeError, self.serv.recvmmsg_into,
+                          [bytearray(10)], object())
+        self.assertRaises(ValueError, self.serv.recvmmsg_into,
+                          [bytearray(10)], -1)
+
+    @requireAttrs(socket, "IP_RECVTOS", "IP_TOS")
+    def testRecvmmsgIntoAncillaryData(self):
+        self.serv.setsockopt(socket.IPPROTO_IP, socket.IP_RECVTOS, 1)
+        self.cli.sendmmsg([b'a', b'bb'], 0, [self.serv_addr] * 2)
+        messages = self.serv.recvmmsg_into([bytearray(10), bytearray(10)],
+                                           socket.CMSG_SPACE(1))
+        self.assertEqual(len(messages), 2)
+        for nbytes, ancdata, flags, addr in messages:
+            self.assertEqual(len(ancdata), 1)
+            level, type, data = ancdata[0]
+            self.assertEqual((level, type), (socket.IPPROTO_IP,
+                                             socket.IP_TOS))
+            self.assertEqual(len(data), 1)
+
+    @requireAttrs(socket, "SOL_UDP", "UDP_SEGMENT")
+    def testUDPSegment(self):
+        try:
+            self.cli.setsockopt(socket.SOL_UDP, socket.UDP_SEGMENT, 100)
+        except OSError as exc:
+            self.skipTest(f'UDP_SEGMENT is not supported: {exc}')
+        self.cli.sendto(b'x' * 250, self.serv_addr)
+        messages = self.serv.recvmmsg_into([bytearray(1000)
+                                            for _ in range(3)])
+        self.assertEqual([nbytes for nbytes, *_ in messages], [100, 100, 50])
+
+    @requireAttrs(socket, "SOL_UDP", "UDP_SEGMENT", "UDP_GRO")
+    def testUDPGRO(self):
+        try:
+            self.cli.setsockopt(socket.SOL_UDP, socket.UDP_SEGMENT, 100)
+            self.serv.setsockopt(socket.SOL_UDP, socket.UDP_GRO, 1)
+        except OSError as exc:
+            self.skipTest(f'UDP_SEGMENT or UDP_GRO is not supported: {exc}')
+        self.cli.sendto(b'x' * 250, self.serv_addr)
+        messages = self.serv.recvmmsg_into([bytearray(1000)],
+                                           socket.CMSG_SPACE(SIZEOF_INT))
+        # The datagrams may or may not be coalesced, but the segment size
+        # is reported when they are.
+        received = 0
+        for nbytes, ancdata, flags, addr in messages:
+            received += nbytes
+            for level, type, data in ancdata:
+                if (level, type) == (socket.SOL_UDP, socket.UDP_GRO):
+                    self.assertEqual(struct.unpack('i', data)[0], 100)
+        self.assertGreaterEqual(received, 100)
+
+
+@requireAttrs(socket.socket, "recvmmsg_into", "sendmsg")
+@requireAttrs(socket, "AF_UNIX", "SOL_SOCKET", "SCM_RIGHTS")
+class RecvmmsgSCMRightsTest(unittest.TestCase):
+
+    def testFds(self):
+        left, right = socket.socketpair(socket.AF_UNIX, socket.SOCK_DGRAM)
+        self.addCleanup(left.close)
+        self.addCleanup(right.close)
+        files = [tempfile.TemporaryFile() for _ in range(2)]
+        for i, f in enumerate(files):
+            self.addCleanup(f.close)
+            f.write(b'%d' % i)
+            f.flush()
+            left.sendmsg([b'x'], [(socket.SOL_SOCKET, socket.SCM_RIGHTS,
+                                   array.array('i', [f.fileno()]))])
+
+        messages = right.recvmmsg_into([bytearray(1), bytearray(1)],
+                                       socket.CMSG_SPACE(SIZEOF_INT))
+        self.assertEqual(len(messages), 2)
+        for i, (nbytes, ancdata, flags, addr) in enumerate(messages):
+            self.assertEqual(nbytes, 1)
+            [(level, type, data)] = ancdata
+            self.assertEqual((level, type),
+                             (socket.SOL_SOCKET, socket.SCM_RIGHTS))
+            [fd] = array.array('i', data)
+            with open(fd, 'rb') as f:
+                f.seek(0)
+                self.assertEqual(f.read(), b'%d' % i)
+
+
+@requireAttrs(socket.socket, "send_zerocopy", "zerocopy_completions")
+class ZeroCopyTCPTest(unittest.TestCase):
+
+    def setUp(self):
+        with socket.create_server((HOST, 0)) as serv:
+            self.cli = socket.create_connection(serv.getsockname())
+            self.addCleanup(self.cli.close)
+            self.conn, _ = serv.accept()
+            self.addCleanup(self.conn.close)
+        self.conn.settimeout(support.LOOPBACK_TIMEOUT)
+
+    def recv_all(self, size):
+        data = bytearray()
+        while len(data) < size:
+            data += self.conn.recv(size - len(data))
+        return data
+
+    def wait_completions(self, count):
+        # Return the completions of the first count sends.
+        completions = []
+        completed = 0
+        for _ in support.sleeping_retry(support.SHORT_TIMEOUT):
+            for first, last, copied in self.cli.zerocopy_completions():
+                completions.append((first, last, copied))
+                completed += last - first + 1
+            if completed >= count:
+                return completions
+
+    def testSendZeroCopy(self):
+        data = bytearray(b'x' * 100_000)
+        self.assertEqual(self.cli.send_zerocopy(data), len(data))
+        self.assertEqual(
+            self.cli.getsockopt(socket.SOL_SOCKET, socket.SO_ZEROCOPY), 1)
+        self.assertEqual(self.recv_all(len(data)), data)
+
+    def testBufferPinned(self):
+        data = bytearray(b'x' * 1000)
+        n = self.cli.send_zerocopy(data)
+        # The buffer stays exported until the completion is read.
+        self.assertRaises(BufferError, data.append, 1)
+        self.recv_all(n)
+        completions = self.wait_completions(1)
+        self.assertEqual([(first, last) for first, last, _ in completions],
+                         [(0, 0)])
+        data.append(1)
+
+    def testIds(self):
+        for _ in range(3):
+            n = self.cli.send_zerocopy(b'x' * 100)
+            self.recv_all(n)
+        completions = self.wait_completions(3)
+        ids = [i for first, last, _ in completions
+               for i in range(first, last + 1)]
+        self.assertEqual(ids, [0, 1, 2])
+        self.assertEqual(self.cli.zerocopy_completions(), [])
+
+    def testEmpty(self):
+        data = bytearray()
+        self.assertEqual(self.cli.send_zerocopy(data), 0)
+        data.append(1)
+        self.assertEqual(self.cli.zerocopy_completions(), [])
+
+    def testNoCompletions(self):
+        self.assertEqual(self.cli.zerocopy_completions(), [])
+
+    def testCloseKeepsPendingBuffers(self):
+        # The kernel may still read the buffer after close().
+        data = bytearray(b'x' * 1000)
+        self.cli.send_zerocopy(data)
+        self.cli.close()
+        self.assertRaises(BufferError, data.append, 1)
+
+    def testDetachKeepsPendingBuffers(self):
+        data = bytearray(b'x' * 1000)
+        self.cli.send_zerocopy(data)
+        os.close(self.cli.detach())
+        self.assertRaises(BufferError, data.append, 1)
+
+    def testBadArgs(self):
+        self.assertRaises(TypeError, self.cli.send_zerocopy)
+        self.assertRaises(TypeError, self.cli.send_zerocopy, 'text')
+        self.assertRaises(TypeError, self.cli.zerocopy_completions, 0)
+
+    @requireAttrs(socket, "AF_UNIX")
+    def testUnsupported(self):
+        left, right = socket.socketpair(socket.AF_UNIX)
+        self.addCleanup(left.close)
+        self.addCleanup(right.close)
+        self.assertRaises(OSError, left.send_zerocopy, b'data')
+
+
 # Test interrupting the interruptible send/receive methods with a
 # signal when a timeout is set.  These tests avoid having multiple
 # threads alive during the test so that the OS cannot deliver the
@@ -1,4 +1,5 @@
 from test import support
+import math
 import random
 import unittest
 from functools import cmp_to_key
@@ -383,6 +384,33 @@ def test_unsafe_float_compare(self):
         check_against_PyObject_RichCompareBool(self, [float(x) for
                                                       x in range(100)])
 
+    def test_radix_sort(self):
+        # Large unsorted lists of ints fitting in 64 bits or of floats are
+        # sorted by a radix sort.
+        n = 5000
+        rand = random.Random(42)
+        lists = [
+            [rand.randrange(-2**63, 2**63) for _ in range(n)],
+            [rand.randrange(-10, 10) for _ in range(n)],
+            [rand.randrange(2**40, 2**40 + 100) for _ in range(n)],
+            [rand.choice([-1<<63, (1<<63) - 1, 0]) for _ in range(n)],
+            [rand.random() * 1000 - 500 for _ in range(n)],
+            [rand.choice([0.0, -0.0, 1.5, -1.5, math.inf, -math.inf])
+             for _ in range(n)],
+            [rand.choice([float(x), x]) for x in range(n)],
+            [rand.randrange(1 << 64) for _ in range(n)],
+            [rand.random() for _ in range(n)] + [math.nan],
+        ]
+        for L in lists:
+            check_against_PyObject_RichCompareBool(self, L)
+            # Equal keys keep their order, also when sorting in reverse.
+            L = [(x, i) for i, x in enumerate(L)]
+            by_cmp = cmp_to_key(lambda a, b: (a[0] > b[0]) - (a[0] < b[0]))
+            for reverse in False, True:
+                self.assertEqual(
+                    sorted(L, key=lambda p: p[0], reverse=reverse),
+                    sorted(L, key=by_cmp, reverse=reverse))
+
     def test_unsafe_tuple_compare(self):
         # This test was suggested by Tim Peters. It verifies that the tuple
         # comparison respects the current tuple compare semantics, which do not
@@ -311,6 +311,18 @@ def test_find(self):
         self.checkequal(-1, 'a' * 100, 'find', 'a\u0102')
         self.checkequal(-1, 'a' * 100, 'find', 'a\U00100304')
         self.checkequal(-1, '\u0102' * 100, 'find', '\u0102\U00100304')
+        # test implementation details of the vectorized search
+        self.checkequal(-1, '\u0201\u0102' * 50, 'find', '\u0102\u0102')
+        self.checkequal(-1, '\u0102\u0201' * 50, 'find', '\u0201_\u0201')
+        self.checkequal(-1, '\u0102\u0201' * 50, 'find', '\u0102\u0102')
+        self.checkequal(-1, '\u0120\u0102' * 50, 'find', '\u0201\u0201')
+        self.checkequal(99, '\u0201' * 99 + '\u0102\u0201', 'find',
+                        '\u0102\u0201')
+        for i in range(40):
+            self.checkequal(i, 'a' * i + '\u0102_\u0201' + 'a' * 40,
+                            'find', '\u0102_\u0201')
+            self.checkequal(1, 'a' * i + '\u0102_\u0201' + 'a' * 40,
+                            'count', '\u0102_\u0201')
 
     def test_rfind(self):
         string_tests.StringLikeTest.test_rfind(self)
@@ -207,6 +207,78 @@ def test_vformat_recursion_limit(self):
         self.assertIn("recursion", str(err.exception))
 
 
+class TestStringBuilder(unittest.TestCase):
+    def test_append(self):
+        b = string.StringBuilder()
+        self.assertEqual(len(b), 0)
+        self.assertEqual(b.build(), '')
+        pieces = ['abc', '', '\xe9t\xe9', '\u20ac', 'x' * 1000, '\U0001f40d', 'z']
+        for piece in pieces:
+            self.assertIsNone(b.append(piece))
+        self.assertEqual(b.build(), ''.join(pieces))
+        self.assertEqual(len(b), len(''.join(pieces)))
+
+        class S(str):
+            pass
+        b = string.StringBuilder()
+        b.append(S('abc'))
+        self.assertIs(type(b.build()), str)
+        self.assertEqual(b.build(), 'abc')
+
+        for arg in b'abc', 1, None, ['a']:
+            self.assertRaises(TypeError, b.append, arg)
+        self.assertEqual(b.build(), 'abc')
+
+    def test_write(self):
+        b = string.StringBuilder()
+        self.assertEqual(b.write('abc'), 3)
+        self.assertEqual(b.write('\u20ac'), 1)
+        print('x', 1, sep='-', end='!', file=b)
+        self.assertEqual(b.build(), 'abc\u20acx-1!')
+        self.assertRaises(TypeError, b.write, b'abc')
+
+    def test_build(self):
+        b = string.StringBuilder()
+        b.append('abc')
+        s = b.build()
+        self.assertEqual(s, 'abc')
+        self.assertIs(b.build(), s)
+        b.append('\xe9')
+        self.assertEqual(len(b), 4)
+        self.assertEqual(b.build(), 'abc\xe9')
+        self.assertEqual(s, 'abc')
+
+    def test_clear(self):
+        b = string.StringBuilder()
+        b.append('abc')
+        b.clear()
+        self.assertEqual(len(b), 0)
+        self.assertEqual(b.build(), '')
+        b.append('def')
+        b.build()
+        b.clear()
+        self.assertEqual(b.build(), '')
+
+    def test_many_appends(self):
+        b = string.StringBuilder()
+        for i in range(10000):
+            b.append(str(i))
+        self.assertEqual(b.build(), ''.join(map(str, range(10000))))
+
+    def test_subclass(self):
+        class Builder(string.StringBuilder):
+            def line(self, s):
+                self.append(s + '\n')
+        b = Builder()
+        b.line('a')
+        b.line('b')
+        self.assertEqual(b.build(), 'a\nb\n')
+
+    def test_constructor(self):
+        self.assertRaises(TypeError, string.StringBuilder, 'abc')
+        self.assertRaises(TypeError, string.StringBuilder, s='abc')
+
+
 # Template tests (formerly housed in test_pep292.py)
 
 class Bag:
@@ -852,6 +852,66 @@ def test_sys_getwindowsversion_no_instantiation(self):
     def test_clear_type_cache(self):
         sys._clear_type_cache()
 
+    @test.support.cpython_only
+    def test_allocation_scope(self):
+        sys._enter_allocation_scope()
+        try:
+            sys._enter_allocation_scope()
+            try:
+                inner = [str(i) * 10 for i in range(1000)]
+            finally:
+                sys._exit_allocation_scope()
+            outer = [float(i) for i in range(1000)]
+            garbage = [bytes(100) for i in range(1000)]
+            del garbage
+        finally:
+            sys._exit_allocation_scope()
+        # Objects that escaped the scope are still usable
+        self.assertEqual(inner[999], '999' * 10)
+        self.assertEqual(sum(outer), 499500.0)
+        del inner, outer
+
+    @test.support.cpython_only
+    def test_allocation_scope_context_manager(self):
+        with sys._allocation_scope():
+            with sys._allocation_scope() as scope:
+                self.assertIsInstance(scope, sys._allocation_scope)
+                d = {str(i): [i] for i in range(1000)}
+            garbage = [{i: i} for i in range(1000)]
+            del garbage
+        # GC objects allocated in the scope are still tracked and usable
+        self.assertTrue(gc.is_tracked(d))
+        self.assertEqual(d['999'], [999])
+        gc.collect()
+        self.assertEqual(sum(len(v) for v in d.values()), 1000)
+
+    @test.support.cpython_only
+    def test_allocation_scope_unbalanced(self):
+        with self.assertRaises(RuntimeError):
+            sys._exit_allocation_scope()
+        scope = sys._allocation_scope()
+        with self.assertRaises(RuntimeError):
+            scope.__exit__(None, None, None)
+        sys._enter_allocation_scope()
+        sys._exit_allocation_scope()
+        with self.assertRaises(RuntimeError):
+            sys._exit_allocation_scope()
+
+    def test_release_free_memory(self):
+        # Spread survivors over many pymalloc pools so that the arenas stay
+        # allocated while most of their pools become free.
+        data = [b'%0200d' % i for i in range(50_000)]
+        kept = data[::500]
+        del data
+        gc.collect()
+        released = sys._release_free_memory()
+        self.assertIsInstance(released, int)
+        self.assertGreaterEqual(released, 0)
+        # Released pools are reused
+        data = [b'%0200d' % i for i in range(50_000)]
+        self.assertEqual(kept[-1], data[49_500])
+        self.assertEqual(sum(map(len, data)), 200 * 50_000)
+
     @force_not_colorized
     @support.requires_subprocess()
     def test_ioencoding(self):
@@ -17,6 +17,14 @@
 
 #include <stddef.h>               // offsetof()
 
+/* The FilePool type runs file operations in threads on POSIX */
+#if !defined(MS_WINDOWS) && defined(HAVE_PTHREAD_H) \
+    && defined(Py_CAN_START_THREADS)
+#  define HAVE_FILE_POOL
+#  include <fcntl.h>              // O_CLOEXEC
+#  include <pthread.h>            // pthread_mutex_t
+#endif
+
 
 /*[clinic input]
 module _asyncio
@@ -79,8 +87,94 @@ typedef struct {
     PyObject *sw_arg;
 } TaskStepMethWrapper;
 
+#define HandleObj_HEAD(prefix)                                              \
+    PyObject_HEAD                                                           \
+    PyObject *prefix##_callback;                                            \
+    PyObject *prefix##_args;                                                \
+    PyObject *prefix##_loop;                                                \
+    PyObject *prefix##_context;                                             \
+    PyObject *prefix##_source_tb;                                           \
+    PyObject *prefix##_repr;                                                \
+    char prefix##_cancelled;                                                \
+
+typedef struct {
+    HandleObj_HEAD(h)
+} HandleObj;
+
+typedef struct {
+    HandleObj_HEAD(th)
+    PyObject *th_when;
+    char th_scheduled;
+} TimerHandleObj;
+
+#ifdef HAVE_FILE_POOL
+
+enum {
+    FILEPOOL_OPEN,
+    FILEPOOL_READ,
+    FILEPOOL_WRITE,
+    FILEPOOL_FSYNC,
+    FILEPOOL_FDATASYNC,
+    FILEPOOL_CLOSE,
+};
+
+typedef struct filepool_op {
+    /* Operations not collected yet, only accessed with the object locked */
+    struct filepool_op *prev;
+    struct filepool_op *next;
+    /* Pending or completed queue, protected by the pool mutex */
+    struct filepool_op *qnext;
+    int opcode;
+    int fd;
+    int flags;              /* open() flags */
+    int mode;               /* open() mode */
+    long long offset;       /* negative to use the file position */
+    Py_ssize_t res;         /* result, or a negative errno value */
+    PyObject *token;        /* returned with the completion */
+    PyObject *result;       /* bytes object filled by read() */
+    Py_buffer buf;          /* buffer used by the worker, or buf.obj NULL */
+} filepool_op;
+
+typedef struct {
+    filepool_op *head;
+    filepool_op *tail;
+} filepool_queue;
+
+/* State shared by a pool and its workers, which can outlive the pool */
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    /* Protected by mutex */
+    filepool_queue pending;
+    filepool_queue done;
+    Py_ssize_t npending;
+    int idle;               /* workers waiting for an operation */
+    int notified;           /* a byte was written since completed() */
+    int shutdown;
+    int refcnt;             /* running workers, plus one for the pool */
+    int wfd;                /* write end of the notification pipe */
+} filepool_shared;
+
+typedef struct {
+    PyObject_HEAD
+    filepool_shared *shared;
+    pid_t pid;              /* process which created the pool */
+    /* Only accessed with the object locked */
+    int nworkers;
+    int max_workers;
+    int rfd;                /* notification pipe, -1 once closed */
+    filepool_op *inflight;
+    Py_ssize_t ninflight;
+} FilePoolObj;
+
+#define FilePoolObj_CAST(op) ((FilePoolObj *)(op))
+#endif
+
 #define Future_CheckExact(state, obj) Py_IS_TYPE(obj, state->FutureType)
 #define Task_CheckExact(state, obj) Py_IS_TYPE(obj, state->TaskType)
+#define Handle_CheckExact(state, obj) Py_IS_TYPE(obj, state->HandleType)
+#define TimerHandle_CheckExact(state, obj)              \
+    Py_IS_TYPE(obj, state->TimerHandleType)
 
 #define Future_Check(state, obj)                        \
     (Future_CheckExact(state, obj)                      \
@@ -90,6 +184,14 @@ typedef struct {
     (Task_CheckExact(state, obj)                        \
      || PyObject_TypeCheck(obj, state->TaskType))
 
+#define Handle_Check(state, obj)                        \
+    (Handle_CheckExact(state, obj)                      \
+     || PyObject_TypeCheck(obj, state->HandleType))
+
+#define TimerHandle_Check(state, obj)                   \
+    (TimerHandle_CheckExact(state, obj)                 \
+     || PyObject_TypeCheck(obj, state->TimerHandleType))
+
 // This macro is optimized to quickly return for native Future *or* Task
 // objects by inlining fast "exact" checks to be called first.
 #define TaskOrFuture_Check(state, obj)                  \
@@ -135,6 +237,9 @@ typedef struct {
     PyTypeObject *TaskStepMethWrapper_Type;
     PyTypeObject *FutureType;
     PyTypeObject *TaskType;
+    PyTypeObject *HandleType;
+    PyTypeObject *TimerHandleType;
+    PyTypeObject *FilePoolType;
 
     PyObject *asyncio_mod;
     PyObject *context_kwname;
@@ -167,9 +272,17 @@ typedef struct {
     /* Imports from asyncio.coroutines. */
     PyObject *asyncio_iscoroutine_func;
 
+    /* Imports from asyncio.format_helpers. */
+    PyObject *asyncio_extract_stack_func;
+    PyObject *asyncio_format_callback_source_func;
+
     /* Imports from traceback. */
     PyObject *traceback_extract_stack;
 
+    /* Imports from heapq. */
+    PyObject *heapq_heappop;
+    PyObject *heapq_heapify;
+
     /* Counter for autogenerated Task names */
     uint64_t task_name_counter;
 
@@ -207,8 +320,10 @@ get_asyncio_state_by_def(PyObject *self)
 
 /*[clinic input]
 class _asyncio.Future "FutureObj *" "&Future_Type"
+class _asyncio.Handle "HandleObj *" "&Handle_Type"
+class _asyncio.TimerHandle "TimerHandleObj *" "&TimerHandle_Type"
 [clinic start generated code]*/
-/*[clinic end generated code: output=da39a3ee5e6b4b0d input=00d3e4abca711e0f]*/
+/*[clinic end generated code: output=da39a3ee5e6b4b0d input=2c3d68b4ae0b9508]*/
 
 
 /* Get FutureIter from Future */
@@ -3594,220 +3709,2315 @@ task_wakeup(TaskObj *task, PyObject *o)
 }
 
 
-/*********************** Functions **************************/
-
-
-/*[clinic input]
-_asyncio._get_running_loop
-
-Return the running event loop or None.
+/*********************** Handle **************************/
 
-This is a low-level function intended to be used by event loops.
-This function is thread-specific.
+/* Keep in sync with the constants of Lib/asyncio/base_events.py. */
+#define MIN_SCHEDULED_TIMER_HANDLES 100
+#define MIN_CANCELLED_TIMER_HANDLES_FRACTION 0.5
+#define MAXIMUM_SELECT_TIMEOUT (24 * 3600)
 
-[clinic start generated code]*/
+#define ENSURE_HANDLE_ALIVE(handle, ret)                                \
+    do {                                                                \
+        if (((HandleObj *)(handle))->h_loop == NULL) {                  \
+            PyErr_SetString(PyExc_RuntimeError,                         \
+                            "Handle object is not initialized.");       \
+            return ret;                                                 \
+        }                                                               \
+    } while (0);
 
-static PyObject *
-_asyncio__get_running_loop_impl(PyObject *module)
-/*[clinic end generated code: output=b4390af721411a0a input=0a21627e25a4bd43]*/
+static int
+handle_get_debug(PyObject *loop)
 {
-    _PyThreadStateImpl *ts = (_PyThreadStateImpl *)_PyThreadState_GET();
-    PyObject *loop = Py_XNewRef(ts->asyncio_running_loop);
-    if (loop == NULL) {
-        /* There's no currently running event loop */
-        Py_RETURN_NONE;
+    PyObject *res = PyObject_CallMethodNoArgs(loop, &_Py_ID(get_debug));
+    if (res == NULL) {
+        return -1;
     }
-    return loop;
+    int is_true = PyObject_IsTrue(res);
+    Py_DECREF(res);
+    return is_true;
 }
 
-/*[clinic input]
-_asyncio._set_running_loop
-    loop: 'O'
-    /
-
-Set the running event loop.
-
-This is a low-level function intended to be used by event loops.
-This function is thread-specific.
-[clinic start generated code]*/
-
-static PyObject *
-_asyncio__set_running_loop(PyObject *module, PyObject *loop)
-/*[clinic end generated code: output=ae56bf7a28ca189a input=4c9720233d606604]*/
+static int
+handle_init(asyncio_state *state, HandleObj *self, PyObject *callback,
+            PyObject *args, PyObject *loop, PyObject *context)
 {
-    _PyThreadStateImpl *ts = (_PyThreadStateImpl *)_PyThreadState_GET();
-    if (loop == Py_None) {
-        loop = NULL;
+    if (context == Py_None) {
+        context = PyContext_CopyCurrent();
+        if (context == NULL) {
+            return -1;
+        }
     }
-    Py_XSETREF(ts->asyncio_running_loop, Py_XNewRef(loop));
-    Py_RETURN_NONE;
-}
-
-/*[clinic input]
-_asyncio.get_event_loop
-
-Return an asyncio event loop.
-
-When called from a coroutine or a callback (e.g. scheduled with
-call_soon or similar API), this function will always return the
-running event loop.
-
-If there is no running event loop set, the function will return
-the result of `get_event_loop_policy().get_event_loop()` call.
-[clinic start generated code]*/
+    else {
+        Py_INCREF(context);
+    }
+    Py_XSETREF(self->h_context, context);
+    Py_XSETREF(self->h_loop, Py_NewRef(loop));
+    Py_XSETREF(self->h_callback, Py_NewRef(callback));
+    Py_XSETREF(self->h_args, Py_NewRef(args));
+    Py_XSETREF(self->h_repr, Py_NewRef(Py_None));
+    self->h_cancelled = 0;
 
-static PyObject *
-_asyncio_get_event_loop_impl(PyObject *module)
-/*[clinic end generated code: output=2a2d8b2f824c648b input=9364bf2916c8655d]*/
-{
-    asyncio_state *state = get_asyncio_state(module);
-    return get_event_loop(state);
+    int debug = handle_get_debug(loop);
+    if (debug < 0) {
+        return -1;
+    }
+    PyObject *tb;
+    if (debug && !_Py_IsInterpreterFinalizing(_PyInterpreterState_GET())) {
+        /* The frame calling the constructor is the first one returned by
+           extract_stack(): unlike the Python implementation, there is no
+           frame to skip for TimerHandle. */
+        tb = PyObject_CallNoArgs(state->asyncio_extract_stack_func);
+        if (tb == NULL) {
+            return -1;
+        }
+    }
+    else {
+        tb = Py_NewRef(Py_None);
+    }
+    Py_XSETREF(self->h_source_tb, tb);
+    return 0;
 }
 
-/*[clinic input]
-_asyncio.get_running_loop
-
-Return the running event loop.  Raise a RuntimeError if there is none.
-
-This function is thread-specific.
-[clinic start generated code]*/
-
+/* Return the source of the callback, formatted by
+   format_helpers._format_callback_source(). */
 static PyObject *
-_asyncio_get_running_loop_impl(PyObject *module)
-/*[clinic end generated code: output=c247b5f9e529530e input=2a3bf02ba39f173d]*/
+handle_format_callback(asyncio_state *state, HandleObj *self,
+                       PyObject *callback, PyObject *args)
 {
-    PyObject *loop;
-    _PyThreadStateImpl *ts = (_PyThreadStateImpl *)_PyThreadState_GET();
-    loop = Py_XNewRef(ts->asyncio_running_loop);
-    if (loop == NULL) {
-        /* There's no currently running event loop */
-        PyErr_SetString(
-            PyExc_RuntimeError, "no running event loop");
+    PyObject *debug = PyObject_CallMethodNoArgs(self->h_loop,
+                                                &_Py_ID(get_debug));
+    if (debug == NULL) {
         return NULL;
     }
-    return loop;
-}
-
-/*[clinic input]
-_asyncio._register_task
-
-    task: object
-
-Register a new task in asyncio as executed by loop.
-
-Returns None.
-[clinic start generated code]*/
-
-static PyObject *
-_asyncio__register_task_impl(PyObject *module, PyObject *task)
-/*[clinic end generated code: output=8672dadd69a7d4e2 input=21075aaea14dfbad]*/
-{
-    asyncio_state *state = get_asyncio_state(module);
-    if (Task_Check(state, task)) {
-        // task is an asyncio.Task instance or subclass, use efficient
-        // linked-list implementation.
-        register_task((TaskObj *)task);
-        Py_RETURN_NONE;
+    PyObject *kwargs = Py_BuildValue("{sN}", "debug", debug);
+    if (kwargs == NULL) {
+        return NULL;
     }
-    // As task does not inherit from asyncio.Task, fallback to less efficient
-    // weakset implementation.
-    PyObject *res = PyObject_CallMethodOneArg(state->non_asyncio_tasks,
-                                              &_Py_ID(add), task);
-    if (res == NULL) {
+    PyObject *posargs = PyTuple_Pack(2, callback, args);
+    if (posargs == NULL) {
+        Py_DECREF(kwargs);
         return NULL;
     }
-    Py_DECREF(res);
-    Py_RETURN_NONE;
+    PyObject *res = PyObject_Call(state->asyncio_format_callback_source_func,
+                                  posargs, kwargs);
+    Py_DECREF(posargs);
+    Py_DECREF(kwargs);
+    return res;
 }
 
-/*[clinic input]
-_asyncio._register_eager_task
-
-    task: object
-
-Register a new task in asyncio as executed by loop.
-
-Returns None.
-[clinic start generated code]*/
-
 static PyObject *
-_asyncio__register_eager_task_impl(PyObject *module, PyObject *task)
-/*[clinic end generated code: output=dfe1d45367c73f1a input=237f684683398c51]*/
+handle_repr_info(asyncio_state *state, HandleObj *self)
 {
-    asyncio_state *state = get_asyncio_state(module);
-    if (register_eager_task(state, task) < 0) {
-        return NULL;
+    PyObject *callback, *args, *tb;
+    Py_BEGIN_CRITICAL_SECTION(self);
+    callback = Py_XNewRef(self->h_callback);
+    args = Py_XNewRef(self->h_args);
+    tb = Py_XNewRef(self->h_source_tb);
+    Py_END_CRITICAL_SECTION();
+
+    PyObject *item = NULL;
+    PyObject *info = PyList_New(0);
+    if (info == NULL) {
+        goto error;
     }
-    Py_RETURN_NONE;
-}
 
+    item = PyType_GetName(Py_TYPE(self));
+    if (item == NULL || PyList_Append(info, item) < 0) {
+        goto error;
+    }
+    Py_CLEAR(item);
 
-/*[clinic input]
-_asyncio._unregister_task
+    if (FT_ATOMIC_LOAD_CHAR_RELAXED(self->h_cancelled)) {
+        item = PyUnicode_FromString("cancelled");
+        if (item == NULL || PyList_Append(info, item) < 0) {
+            goto error;
+        }
+        Py_CLEAR(item);
+    }
 
-    task: object
+    if (callback != NULL && callback != Py_None) {
+        item = handle_format_callback(state, self, callback,
+                                      args ? args : Py_None);
+        if (item == NULL || PyList_Append(info, item) < 0) {
+            goto error;
+        }
+        Py_CLEAR(item);
+    }
 
-Unregister a task.
+    if (tb != NULL) {
+        int is_true = PyObject_IsTrue(tb);
+        if (is_true < 0) {
+            goto error;
+        }
+        if (is_true) {
+            PyObject *frame = PySequence_GetItem(tb, -1);
+            if (frame == NULL) {
+                goto error;
+            }
+            PyObject *filename = PySequence_GetItem(frame, 0);
+            PyObject *lineno = filename ? PySequence_GetItem(frame, 1) : NULL;
+            Py_DECREF(frame);
+            if (lineno != NULL) {
+                item = PyUnicode_FromFormat("created at %S:%S",
+                                            filename, lineno);
+            }
+            Py_XDECREF(filename);
+            Py_XDECREF(lineno);
+            if (item == NULL || PyList_Append(info, item) < 0) {
+                goto error;
+            }
+            Py_CLEAR(item);
+        }
+    }
 
-Returns None.
-[clinic start generated code]*/
+    Py_XDECREF(callback);
+    Py_XDECREF(args);
+    Py_XDECREF(tb);
+    return info;
+
+error:
+    Py_XDECREF(item);
+    Py_XDECREF(info);
+    Py_XDECREF(callback);
+    Py_XDECREF(args);
+    Py_XDECREF(tb);
+    return NULL;
+}
 
 static PyObject *
-_asyncio__unregister_task_impl(PyObject *module, PyObject *task)
-/*[clinic end generated code: output=6e5585706d568a46 input=28fb98c3975f7bdc]*/
+HandleObj_repr(PyObject *self)
 {
-    asyncio_state *state = get_asyncio_state(module);
-    if (Task_Check(state, task)) {
-        unregister_task((TaskObj *)task);
-        Py_RETURN_NONE;
+    PyObject *repr;
+    Py_BEGIN_CRITICAL_SECTION(self);
+    repr = Py_XNewRef(((HandleObj *)self)->h_repr);
+    Py_END_CRITICAL_SECTION();
+    if (repr != NULL && repr != Py_None) {
+        return repr;
     }
-    PyObject *res = PyObject_CallMethodOneArg(state->non_asyncio_tasks,
-                                              &_Py_ID(discard), task);
-    if (res == NULL) {
+    Py_XDECREF(repr);
+
+    PyObject *info = PyObject_CallMethodNoArgs(self, &_Py_ID(_repr_info));
+    if (info == NULL) {
         return NULL;
     }
-    Py_DECREF(res);
-    Py_RETURN_NONE;
-}
-
-/*[clinic input]
-_asyncio._unregister_eager_task
-
-    task: object
-
-Unregister a task.
-
-Returns None.
-[clinic start generated code]*/
-
-static PyObject *
-_asyncio__unregister_eager_task_impl(PyObject *module, PyObject *task)
-/*[clinic end generated code: output=a426922bd07f23d1 input=9d07401ef14ee048]*/
-{
-    asyncio_state *state = get_asyncio_state(module);
-    if (unregister_eager_task(state, task) < 0) {
+    PyObject *sep = PyUnicode_FromOrdinal(' ');
+    if (sep == NULL) {
+        Py_DECREF(info);
         return NULL;
     }
-    Py_RETURN_NONE;
+    PyObject *joined = PyUnicode_Join(sep, info);
+    Py_DECREF(sep);
+    Py_DECREF(info);
+    if (joined == NULL) {
+        return NULL;
+    }
+    repr = PyUnicode_FromFormat("<%U>", joined);
+    Py_DECREF(joined);
+    return repr;
 }
 
+static int
+handle_cancel(HandleObj *self)
+{
+    if (self->h_cancelled) {
+        return 0;
+    }
+    FT_ATOMIC_STORE_CHAR_RELAXED(self->h_cancelled, 1);
 
-/*[clinic input]
-_asyncio._enter_task
-
-    loop: object
-    task: object
-
-Enter into task execution or resume suspended task.
-
-Task belongs to loop.
-
-Returns None.
-[clinic start generated code]*/
+    int debug = handle_get_debug(self->h_loop);
+    if (debug < 0) {
+        return -1;
+    }
+    if (debug) {
+        /* Keep a representation in debug mode to keep callback and
+           parameters.  For example, to log the warning "Executing <Handle
+           ...> took 2.5 second" */
+        PyObject *repr = PyObject_Repr((PyObject *)self);
+        if (repr == NULL) {
+            return -1;
+        }
+        Py_XSETREF(self->h_repr, repr);
+    }
+    Py_XSETREF(self->h_callback, Py_NewRef(Py_None));
+    Py_XSETREF(self->h_args, Py_NewRef(Py_None));
+    return 0;
+}
 
+/* Call callback(*args) in the context. */
 static PyObject *
-_asyncio__enter_task_impl(PyObject *module, PyObject *loop, PyObject *task)
-/*[clinic end generated code: output=a22611c858035b73 input=de1b06dca70d8737]*/
+handle_call(PyObject *context, PyObject *callback, PyObject *args)
+{
+    PyObject *argtuple;
+    if (PyTuple_CheckExact(args)) {
+        argtuple = Py_NewRef(args);
+    }
+    else {
+        argtuple = PySequence_Tuple(args);
+        if (argtuple == NULL) {
+            return NULL;
+        }
+    }
+
+    PyObject *res;
+    if (PyContext_CheckExact(context)) {
+        if (PyContext_Enter(context) < 0) {
+            Py_DECREF(argtuple);
+            return NULL;
+        }
+        res = PyObject_Vectorcall(callback, _PyTuple_ITEMS(argtuple),
+                                  PyTuple_GET_SIZE(argtuple), NULL);
+        if (PyContext_Exit(context) < 0) {
+            Py_CLEAR(res);
+        }
+    }
+    else {
+        /* Any object with a Context-like run() method */
+        PyObject *run = PyObject_GetAttr(context, &_Py_ID(run));
+        if (run == NULL) {
+            Py_DECREF(argtuple);
+            return NULL;
+        }
+        PyObject *runargs = PyTuple_New(PyTuple_GET_SIZE(argtuple) + 1);
+        if (runargs == NULL) {
+            Py_DECREF(run);
+            Py_DECREF(argtuple);
+            return NULL;
+        }
+        PyTuple_SET_ITEM(runargs, 0, Py_NewRef(callback));
+        for (Py_ssize_t i = 0; i < PyTuple_GET_SIZE(argtuple); i++) {
+            PyTuple_SET_ITEM(runargs, i + 1,
+                             Py_NewRef(PyTuple_GET_ITEM(argtuple, i)));
+        }
+        res = PyObject_Call(run, runargs, NULL);
+        Py_DECREF(runargs);
+        Py_DECREF(run);
+    }
+    Py_DECREF(argtuple);
+    return res;
+}
+
+/* Pass the exception raised by the callback to the exception handler of
+   the event loop. */
+static int
+handle_report_exception(asyncio_state *state, HandleObj *self, PyObject *exc)
+{
+    PyObject *callback, *args, *tb;
+    Py_BEGIN_CRITICAL_SECTION(self);
+    callback = Py_NewRef(self->h_callback ? self->h_callback : Py_None);
+    args = Py_NewRef(self->h_args ? self->h_args : Py_None);
+    tb = Py_XNewRef(self->h_source_tb);
+    Py_END_CRITICAL_SECTION();
+
+    int ret = -1;
+    PyObject *message = NULL;
+    PyObject *context = NULL;
+    PyObject *cb = handle_format_callback(state, self, callback, args);
+    if (cb == NULL) {
+        goto finally;
+    }
+    message = PyUnicode_FromFormat("Exception in callback %S", cb);
+    if (message == NULL) {
+        goto finally;
+    }
+    context = PyDict_New();
+    if (context == NULL) {
+        goto finally;
+    }
+    if (PyDict_SetItem(context, &_Py_ID(message), message) < 0 ||
+        PyDict_SetItem(context, &_Py_ID(exception), exc) < 0 ||
+        PyDict_SetItem(context, &_Py_ID(handle), (PyObject *)self) < 0) {
+        goto finally;
+    }
+    if (tb != NULL) {
+        int is_true = PyObject_IsTrue(tb);
+        if (is_true < 0) {
+            goto finally;
+        }
+        if (is_true &&
+            PyDict_SetItem(context, &_Py_ID(source_traceback), tb) < 0) {
+            goto finally;
+        }
+    }
+    PyObject *res = PyObject_CallMethodOneArg(
+        self->h_loop, &_Py_ID(call_exception_handler), context);
+    if (res == NULL) {
+        goto finally;
+    }
+    Py_DECREF(res);
+    ret = 0;
+
+finally:
+    Py_XDECREF(context);
+    Py_XDECREF(message);
+    Py_XDECREF(cb);
+    Py_DECREF(callback);
+    Py_DECREF(args);
+    Py_XDECREF(tb);
+    return ret;
+}
+
+/* Run the callback of the handle.  Exceptions raised by the callback are
+   passed to the exception handler of the event loop, except SystemExit
+   and KeyboardInterrupt which are propagated. */
+static int
+handle_run(asyncio_state *state, HandleObj *self)
+{
+    ENSURE_HANDLE_ALIVE(self, -1)
+
+    PyObject *callback, *args, *context;
+    Py_BEGIN_CRITICAL_SECTION(self);
+    callback = Py_XNewRef(self->h_callback);
+    args = Py_XNewRef(self->h_args);
+    context = Py_XNewRef(self->h_context);
+    Py_END_CRITICAL_SECTION();
+
+    PyObject *res;
+    if (callback == NULL || args == NULL || context == NULL) {
+        PyErr_SetString(PyExc_AttributeError,
+                        "Handle object has no callback, args or context");
+        res = NULL;
+    }
+    else {
+        res = handle_call(context, callback, args);
+    }
+    Py_XDECREF(callback);
+    Py_XDECREF(args);
+    Py_XDECREF(context);
+    if (res != NULL) {
+        Py_DECREF(res);
+        return 0;
+    }
+
+    if (PyErr_ExceptionMatches(PyExc_SystemExit) ||
+        PyErr_ExceptionMatches(PyExc_KeyboardInterrupt)) {
+        return -1;
+    }
+    PyObject *exc = PyErr_GetRaisedException();
+    int ret = handle_report_exception(state, self, exc);
+    if (ret < 0) {
+        _PyErr_ChainExceptions1(exc);
+    }
+    else {
+        Py_DECREF(exc);
+    }
+    return ret;
+}
+
+/*[clinic input]
+_asyncio.Handle.__init__
+
+    callback: object
+    args: object
+    loop: object
+    context: object = None
+
+Object returned by callback registration methods.
+[clinic start generated code]*/
+
+static int
+_asyncio_Handle___init___impl(HandleObj *self, PyObject *callback,
+                              PyObject *args, PyObject *loop,
+                              PyObject *context)
+/*[clinic end generated code: output=40a28e55725495e2 input=c0d847a7bc9e878f]*/
+{
+    asyncio_state *state = get_asyncio_state_by_def((PyObject *)self);
+    return handle_init(state, self, callback, args, loop, context);
+}
+
+/*[clinic input]
+_asyncio.Handle.get_context
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_Handle_get_context_impl(HandleObj *self)
+/*[clinic end generated code: output=533e37d94822a513 input=4f74b0143c38809e]*/
+{
+    ENSURE_HANDLE_ALIVE(self, NULL)
+    return Py_NewRef(self->h_context);
+}
+
+/*[clinic input]
+@critical_section
+_asyncio.Handle.cancel
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_Handle_cancel_impl(HandleObj *self)
+/*[clinic end generated code: output=ddb39234782aab82 input=76c7e99122ab9cbb]*/
+{
+    ENSURE_HANDLE_ALIVE(self, NULL)
+    if (handle_cancel(self) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+_asyncio.Handle.cancelled
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_Handle_cancelled_impl(HandleObj *self)
+/*[clinic end generated code: output=0f4ad57f569e9f24 input=14a55098bea1b40a]*/
+{
+    return PyBool_FromLong(FT_ATOMIC_LOAD_CHAR_RELAXED(self->h_cancelled));
+}
+
+/*[clinic input]
+_asyncio.Handle._run
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_Handle__run_impl(HandleObj *self)
+/*[clinic end generated code: output=1b186b710881500a input=94fc71ae0ddc7106]*/
+{
+    asyncio_state *state = get_asyncio_state_by_def((PyObject *)self);
+    if (handle_run(state, self) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+_asyncio.Handle._repr_info
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_Handle__repr_info_impl(HandleObj *self)
+/*[clinic end generated code: output=7838b12075048d03 input=dba1c0a083077d57]*/
+{
+    ENSURE_HANDLE_ALIVE(self, NULL)
+    asyncio_state *state = get_asyncio_state_by_def((PyObject *)self);
+    return handle_repr_info(state, self);
+}
+
+static int
+HandleObj_traverse(PyObject *op, visitproc visit, void *arg)
+{
+    HandleObj *self = (HandleObj *)op;
+    Py_VISIT(Py_TYPE(self));
+    Py_VISIT(self->h_callback);
+    Py_VISIT(self->h_args);
+    Py_VISIT(self->h_loop);
+    Py_VISIT(self->h_context);
+    Py_VISIT(self->h_source_tb);
+    Py_VISIT(self->h_repr);
+    return 0;
+}
+
+static int
+HandleObj_clear(PyObject *op)
+{
+    HandleObj *self = (HandleObj *)op;
+    Py_CLEAR(self->h_callback);
+    Py_CLEAR(self->h_args);
+    Py_CLEAR(self->h_loop);
+    Py_CLEAR(self->h_context);
+    Py_CLEAR(self->h_source_tb);
+    Py_CLEAR(self->h_repr);
+    return 0;
+}
+
+static void
+HandleObj_dealloc(PyObject *self)
+{
+    PyTypeObject *tp = Py_TYPE(self);
+    PyObject_GC_UnTrack(self);
+    PyObject_ClearWeakRefs(self);
+    (void)HandleObj_clear(self);
+    tp->tp_free(self);
+    Py_DECREF(tp);
+}
+
+static PyMethodDef Handle_methods[] = {
+    _ASYNCIO_HANDLE_GET_CONTEXT_METHODDEF
+    _ASYNCIO_HANDLE_CANCEL_METHODDEF
+    _ASYNCIO_HANDLE_CANCELLED_METHODDEF
+    _ASYNCIO_HANDLE__RUN_METHODDEF
+    _ASYNCIO_HANDLE__REPR_INFO_METHODDEF
+    {NULL, NULL}        /* Sentinel */
+};
+
+static PyMemberDef Handle_members[] = {
+    {"_callback", Py_T_OBJECT_EX, offsetof(HandleObj, h_callback), 0, NULL},
+    {"_args", Py_T_OBJECT_EX, offsetof(HandleObj, h_args), 0, NULL},
+    {"_loop", Py_T_OBJECT_EX, offsetof(HandleObj, h_loop), 0, NULL},
+    {"_context", Py_T_OBJECT_EX, offsetof(HandleObj, h_context), 0, NULL},
+    {"_source_traceback", Py_T_OBJECT_EX,
+     offsetof(HandleObj, h_source_tb), 0, NULL},
+    {"_repr", Py_T_OBJECT_EX, offsetof(HandleObj, h_repr), 0, NULL},
+    {"_cancelled", Py_T_BOOL, offsetof(HandleObj, h_cancelled), 0, NULL},
+    {NULL} /* Sentinel */
+};
+
+static PyType_Slot Handle_slots[] = {
+    {Py_tp_dealloc, HandleObj_dealloc},
+    {Py_tp_repr, HandleObj_repr},
+    {Py_tp_doc, (void *)_asyncio_Handle___init____doc__},
+    {Py_tp_traverse, HandleObj_traverse},
+    {Py_tp_clear, HandleObj_clear},
+    {Py_tp_methods, Handle_methods},
+    {Py_tp_members, Handle_members},
+    {Py_tp_init, (initproc)_asyncio_Handle___init__},
+    {Py_tp_new, PyType_GenericNew},
+    {0, NULL},
+};
+
+static PyType_Spec Handle_spec = {
+    .name = "_asyncio.Handle",
+    .basicsize = sizeof(HandleObj),
+    .flags = (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_BASETYPE |
+              Py_TPFLAGS_IMMUTABLETYPE | Py_TPFLAGS_MANAGED_WEAKREF),
+    .slots = Handle_slots,
+};
+
+
+/* ----- TimerHandle */
+
+/*[clinic input]
+_asyncio.TimerHandle.__init__
+
+    when: object
+    callback: object
+    args: object
+    loop: object
+    context: object = None
+
+Object returned by timed callback registration methods.
+[clinic start generated code]*/
+
+static int
+_asyncio_TimerHandle___init___impl(TimerHandleObj *self, PyObject *when,
+                                   PyObject *callback, PyObject *args,
+                                   PyObject *loop, PyObject *context)
+/*[clinic end generated code: output=0d98475472bfab93 input=ec6d223ba9888cec]*/
+{
+    asyncio_state *state = get_asyncio_state_by_def((PyObject *)self);
+    if (handle_init(state, (HandleObj *)self, callback, args, loop,
+                    context) < 0) {
+        return -1;
+    }
+    Py_XSETREF(self->th_when, Py_NewRef(when));
+    self->th_scheduled = 0;
+    return 0;
+}
+
+/*[clinic input]
+_asyncio.TimerHandle.when
+
+Return a scheduled callback time.
+
+The time is an absolute timestamp, using the same time
+reference as loop.time().
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_TimerHandle_when_impl(TimerHandleObj *self)
+/*[clinic end generated code: output=cab0e5577e51b3af input=de801fd191075931]*/
+{
+    ENSURE_HANDLE_ALIVE(self, NULL)
+    return Py_NewRef(self->th_when);
+}
+
+/*[clinic input]
+@critical_section
+_asyncio.TimerHandle.cancel
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_TimerHandle_cancel_impl(TimerHandleObj *self)
+/*[clinic end generated code: output=315df6426e6662ff input=64794589a90b4d63]*/
+{
+    ENSURE_HANDLE_ALIVE(self, NULL)
+    if (!self->th_cancelled) {
+        PyObject *res = PyObject_CallMethodOneArg(
+            self->th_loop, &_Py_ID(_timer_handle_cancelled),
+            (PyObject *)self);
+        if (res == NULL) {
+            return NULL;
+        }
+        Py_DECREF(res);
+    }
+    if (handle_cancel((HandleObj *)self) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+_asyncio.TimerHandle._repr_info
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_TimerHandle__repr_info_impl(TimerHandleObj *self)
+/*[clinic end generated code: output=40e332eea82788b7 input=0ea1c37005c8bd50]*/
+{
+    ENSURE_HANDLE_ALIVE(self, NULL)
+    asyncio_state *state = get_asyncio_state_by_def((PyObject *)self);
+    PyObject *info = handle_repr_info(state, (HandleObj *)self);
+    if (info == NULL) {
+        return NULL;
+    }
+    Py_ssize_t pos = FT_ATOMIC_LOAD_CHAR_RELAXED(self->th_cancelled) ? 2 : 1;
+    PyObject *item = PyUnicode_FromFormat("when=%S", self->th_when);
+    if (item == NULL || PyList_Insert(info, pos, item) < 0) {
+        Py_XDECREF(item);
+        Py_DECREF(info);
+        return NULL;
+    }
+    Py_DECREF(item);
+    return info;
+}
+
+/* Compare handles as (when, callback, args, cancelled) tuples. */
+static PyObject *
+timer_handle_eq(TimerHandleObj *a, TimerHandleObj *b)
+{
+    PyObject *items[6];
+    Py_BEGIN_CRITICAL_SECTION2(a, b);
+    items[0] = Py_XNewRef(a->th_when);
+    items[1] = Py_XNewRef(b->th_when);
+    items[2] = Py_XNewRef(a->th_callback);
+    items[3] = Py_XNewRef(b->th_callback);
+    items[4] = Py_XNewRef(a->th_args);
+    items[5] = Py_XNewRef(b->th_args);
+    Py_END_CRITICAL_SECTION2();
+
+    PyObject *res = NULL;
+    for (int i = 0; i < 6; i += 2) {
+        if (items[i] == NULL || items[i + 1] == NULL) {
+            PyErr_SetString(PyExc_RuntimeError,
+                            "Handle object is not initialized.");
+            goto done;
+        }
+        res = PyObject_RichCompare(items[i], items[i + 1], Py_EQ);
+        if (res == NULL) {
+            goto done;
+        }
+        int is_true = PyObject_IsTrue(res);
+        if (is_true <= 0) {
+            if (is_true < 0) {
+                Py_CLEAR(res);
+            }
+            goto done;
+        }
+        Py_CLEAR(res);
+    }
+    res = PyBool_FromLong(FT_ATOMIC_LOAD_CHAR_RELAXED(a->th_cancelled) ==
+                          FT_ATOMIC_LOAD_CHAR_RELAXED(b->th_cancelled));
+
+done:
+    for (int i = 0; i < 6; i++) {
+        Py_XDECREF(items[i]);
+    }
+    return res;
+}
+
+static PyObject *
+TimerHandleObj_richcompare(PyObject *self, PyObject *other, int op)
+{
+    asyncio_state *state = get_asyncio_state_by_def(self);
+    if (!TimerHandle_Check(state, other)) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    TimerHandleObj *a = (TimerHandleObj *)self;
+    TimerHandleObj *b = (TimerHandleObj *)other;
+    if (op == Py_EQ) {
+        return timer_handle_eq(a, b);
+    }
+    if (op == Py_NE) {
+        PyObject *eq = timer_handle_eq(a, b);
+        if (eq == NULL) {
+            return NULL;
+        }
+        int is_true = PyObject_IsTrue(eq);
+        Py_DECREF(eq);
+        if (is_true < 0) {
+            return NULL;
+        }
+        return PyBool_FromLong(!is_true);
+    }
+
+    ENSURE_HANDLE_ALIVE(a, NULL)
+    ENSURE_HANDLE_ALIVE(b, NULL)
+    /* The timer heap only needs "<": compare float timestamps inline. */
+    int strict_op = (op == Py_LT || op == Py_LE) ? Py_LT : Py_GT;
+    PyObject *res;
+    if (PyFloat_CheckExact(a->th_when) && PyFloat_CheckExact(b->th_when)) {
+        double x = PyFloat_AS_DOUBLE(a->th_when);
+        double y = PyFloat_AS_DOUBLE(b->th_when);
+        res = PyBool_FromLong(strict_op == Py_LT ? x < y : x > y);
+    }
+    else {
+        res = PyObject_RichCompare(a->th_when, b->th_when, strict_op);
+        if (res == NULL) {
+            return NULL;
+        }
+    }
+    if (op == Py_LT || op == Py_GT) {
+        return res;
+    }
+    int is_true = PyObject_IsTrue(res);
+    if (is_true > 0) {
+        return res;
+    }
+    Py_DECREF(res);
+    return is_true < 0 ? NULL : timer_handle_eq(a, b);
+}
+
+static Py_hash_t
+TimerHandleObj_hash(PyObject *self)
+{
+    ENSURE_HANDLE_ALIVE(self, -1)
+    return PyObject_Hash(((TimerHandleObj *)self)->th_when);
+}
+
+static int
+TimerHandleObj_traverse(PyObject *op, visitproc visit, void *arg)
+{
+    Py_VISIT(((TimerHandleObj *)op)->th_when);
+    return HandleObj_traverse(op, visit, arg);
+}
+
+static int
+TimerHandleObj_clear(PyObject *op)
+{
+    Py_CLEAR(((TimerHandleObj *)op)->th_when);
+    return HandleObj_clear(op);
+}
+
+static void
+TimerHandleObj_dealloc(PyObject *self)
+{
+    PyTypeObject *tp = Py_TYPE(self);
+    PyObject_GC_UnTrack(self);
+    PyObject_ClearWeakRefs(self);
+    (void)TimerHandleObj_clear(self);
+    tp->tp_free(self);
+    Py_DECREF(tp);
+}
+
+static PyMethodDef TimerHandle_methods[] = {
+    _ASYNCIO_TIMERHANDLE_WHEN_METHODDEF
+    _ASYNCIO_TIMERHANDLE_CANCEL_METHODDEF
+    _ASYNCIO_TIMERHANDLE__REPR_INFO_METHODDEF
+    {NULL, NULL}        /* Sentinel */
+};
+
+static PyMemberDef TimerHandle_members[] = {
+    {"_when", Py_T_OBJECT_EX, offsetof(TimerHandleObj, th_when), 0, NULL},
+    {"_scheduled", Py_T_BOOL, offsetof(TimerHandleObj, th_scheduled), 0, NULL},
+    {NULL} /* Sentinel */
+};
+
+static PyType_Slot TimerHandle_slots[] = {
+    {Py_tp_dealloc, TimerHandleObj_dealloc},
+    {Py_tp_doc, (void *)_asyncio_TimerHandle___init____doc__},
+    {Py_tp_traverse, TimerHandleObj_traverse},
+    {Py_tp_clear, TimerHandleObj_clear},
+    {Py_tp_richcompare, TimerHandleObj_richcompare},
+    {Py_tp_hash, TimerHandleObj_hash},
+    {Py_tp_methods, TimerHandle_methods},
+    {Py_tp_members, TimerHandle_members},
+    {Py_tp_init, (initproc)_asyncio_TimerHandle___init__},
+    {0, NULL},
+};
+
+static PyType_Spec TimerHandle_spec = {
+    .name = "_asyncio.TimerHandle",
+    .basicsize = sizeof(TimerHandleObj),
+    .flags = (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_BASETYPE |
+              Py_TPFLAGS_IMMUTABLETYPE),
+    .slots = TimerHandle_slots,
+};
+
+
+/* ----- Event loop iteration */
+
+static int
+handle_is_cancelled(asyncio_state *state, PyObject *handle)
+{
+    if (Handle_Check(state, handle)) {
+        return FT_ATOMIC_LOAD_CHAR_RELAXED(((HandleObj *)handle)->h_cancelled);
+    }
+    PyObject *cancelled = PyObject_GetAttr(handle, &_Py_ID(_cancelled));
+    if (cancelled == NULL) {
+        return -1;
+    }
+    int is_true = PyObject_IsTrue(cancelled);
+    Py_DECREF(cancelled);
+    return is_true;
+}
+
+static int
+timer_handle_unschedule(asyncio_state *state, PyObject *handle)
+{
+    if (TimerHandle_Check(state, handle)) {
+        FT_ATOMIC_STORE_CHAR_RELAXED(((TimerHandleObj *)handle)->th_scheduled,
+                                     0);
+        return 0;
+    }
+    return PyObject_SetAttr(handle, &_Py_ID(_scheduled), Py_False);
+}
+
+static PyObject *
+timer_handle_get_when(asyncio_state *state, PyObject *handle)
+{
+    if (TimerHandle_Check(state, handle)) {
+        ENSURE_HANDLE_ALIVE(handle, NULL)
+        return Py_NewRef(((TimerHandleObj *)handle)->th_when);
+    }
+    return PyObject_GetAttr(handle, &_Py_ID(_when));
+}
+
+/* Pop the earliest timer handle from the heap and mark it as no longer
+   scheduled.  Return a new reference. */
+static PyObject *
+timer_heap_pop(asyncio_state *state, PyObject *heap)
+{
+    PyObject *handle = PyObject_CallOneArg(state->heapq_heappop, heap);
+    if (handle == NULL) {
+        return NULL;
+    }
+    if (timer_handle_unschedule(state, handle) < 0) {
+        Py_DECREF(handle);
+        return NULL;
+    }
+    return handle;
+}
+
+/* Remove cancelled timer handles from loop._scheduled.  Return a new
+   reference to the (possibly new) list of scheduled timer handles. */
+static PyObject *
+run_once_remove_cancelled(asyncio_state *state, PyObject *loop)
+{
+    PyObject *scheduled = PyObject_GetAttr(loop, &_Py_ID(_scheduled));
+    if (scheduled == NULL) {
+        return NULL;
+    }
+    if (!PyList_Check(scheduled)) {
+        PyErr_SetString(PyExc_TypeError, "heap argument must be a list");
+        goto error;
+    }
+
+    Py_ssize_t sched_count = PyList_GET_SIZE(scheduled);
+    if (sched_count > MIN_SCHEDULED_TIMER_HANDLES) {
+        PyObject *count = PyObject_GetAttr(loop,
+                                           &_Py_ID(_timer_cancelled_count));
+        if (count == NULL) {
+            goto error;
+        }
+        double cancelled_count = PyFloat_AsDouble(count);
+        Py_DECREF(count);
+        if (cancelled_count == -1.0 && PyErr_Occurred()) {
+            goto error;
+        }
+        if (cancelled_count / sched_count >
+                MIN_CANCELLED_TIMER_HANDLES_FRACTION) {
+            /* Remove delayed calls that were cancelled if their number
+               is too high */
+            PyObject *new_scheduled = PyList_New(0);
+            if (new_scheduled == NULL) {
+                goto error;
+            }
+            for (Py_ssize_t i = 0; i < PyList_GET_SIZE(scheduled); i++) {
+                PyObject *handle = PyList_GetItemRef(scheduled, i);
+                if (handle == NULL) {
+                    Py_DECREF(new_scheduled);
+                    goto error;
+                }
+                int cancelled = handle_is_cancelled(state, handle);
+                int err = cancelled < 0;
+                if (cancelled > 0) {
+                    err = timer_handle_unschedule(state, handle) < 0;
+                }
+                else if (cancelled == 0) {
+                    err = PyList_Append(new_scheduled, handle) < 0;
+                }
+                Py_DECREF(handle);
+                if (err) {
+                    Py_DECREF(new_scheduled);
+                    goto error;
+                }
+            }
+            Py_SETREF(scheduled, new_scheduled);
+
+            PyObject *res = PyObject_CallOneArg(state->heapq_heapify,
+                                                scheduled);
+            if (res == NULL) {
+                goto error;
+            }
+            Py_DECREF(res);
+            if (PyObject_SetAttr(loop, &_Py_ID(_scheduled), scheduled) < 0 ||
+                PyObject_SetAttr(loop, &_Py_ID(_timer_cancelled_count),
+                                 _PyLong_GetZero()) < 0) {
+                goto error;
+            }
+            return scheduled;
+        }
+    }
+
+    /* Remove delayed calls that were cancelled from head of queue. */
+    while (PyList_GET_SIZE(scheduled)) {
+        PyObject *handle = PyList_GetItemRef(scheduled, 0);
+        if (handle == NULL) {
+            goto error;
+        }
+        int cancelled = handle_is_cancelled(state, handle);
+        Py_DECREF(handle);
+        if (cancelled <= 0) {
+            if (cancelled < 0) {
+                goto error;
+            }
+            break;
+        }
+        PyObject *count = PyObject_GetAttr(loop,
+                                           &_Py_ID(_timer_cancelled_count));
+        if (count == NULL) {
+            goto error;
+        }
+        Py_SETREF(count, PyNumber_Subtract(count, _PyLong_GetOne()));
+        if (count == NULL) {
+            goto error;
+        }
+        int err = PyObject_SetAttr(loop, &_Py_ID(_timer_cancelled_count),
+                                   count);
+        Py_DECREF(count);
+        if (err < 0) {
+            goto error;
+        }
+        handle = timer_heap_pop(state, scheduled);
+        if (handle == NULL) {
+            goto error;
+        }
+        Py_DECREF(handle);
+    }
+    return scheduled;
+
+error:
+    Py_DECREF(scheduled);
+    return NULL;
+}
+
+/* Compute the timeout of the selector: 0 if there are ready callbacks,
+   the delay until the earliest timer otherwise, or None to wait forever.
+   Return a new reference. */
+static PyObject *
+run_once_get_timeout(asyncio_state *state, PyObject *loop,
+                     PyObject *scheduled, PyObject *ready)
+{
+    int busy = PyObject_IsTrue(ready);
+    if (busy == 0) {
+        PyObject *stopping = PyObject_GetAttr(loop, &_Py_ID(_stopping));
+        if (stopping == NULL) {
+            return NULL;
+        }
+        busy = PyObject_IsTrue(stopping);
+        Py_DECREF(stopping);
+    }
+    if (busy) {
+        return busy < 0 ? NULL : Py_NewRef(_PyLong_GetZero());
+    }
+    if (PyList_GET_SIZE(scheduled) == 0) {
+        Py_RETURN_NONE;
+    }
+
+    /* Compute the desired timeout. */
+    PyObject *handle = PyList_GetItemRef(scheduled, 0);
+    if (handle == NULL) {
+        return NULL;
+    }
+    PyObject *when = timer_handle_get_when(state, handle);
+    Py_DECREF(handle);
+    if (when == NULL) {
+        return NULL;
+    }
+    PyObject *now = PyObject_CallMethodNoArgs(loop, &_Py_ID(time));
+    if (now == NULL) {
+        Py_DECREF(when);
+        return NULL;
+    }
+    PyObject *timeout = PyNumber_Subtract(when, now);
+    Py_DECREF(when);
+    Py_DECREF(now);
+    if (timeout == NULL) {
+        return NULL;
+    }
+
+    /* timeout = min(max(0, timeout), MAXIMUM_SELECT_TIMEOUT) */
+    int positive = PyObject_RichCompareBool(timeout, _PyLong_GetZero(), Py_GT);
+    if (positive <= 0) {
+        Py_DECREF(timeout);
+        return positive < 0 ? NULL : Py_NewRef(_PyLong_GetZero());
+    }
+    PyObject *maximum = PyLong_FromLong(MAXIMUM_SELECT_TIMEOUT);
+    if (maximum == NULL) {
+        Py_DECREF(timeout);
+        return NULL;
+    }
+    int too_long = PyObject_RichCompareBool(maximum, timeout, Py_LT);
+    if (too_long > 0) {
+        Py_DECREF(timeout);
+        return maximum;
+    }
+    Py_DECREF(maximum);
+    if (too_long < 0) {
+        Py_DECREF(timeout);
+        return NULL;
+    }
+    return timeout;
+}
+
+/* Move the timer handles which are due to the ready queue. */
+static int
+run_once_schedule_timers(asyncio_state *state, PyObject *loop,
+                         PyObject *ready)
+{
+    PyObject *now = PyObject_CallMethodNoArgs(loop, &_Py_ID(time));
+    if (now == NULL) {
+        return -1;
+    }
+    PyObject *resolution = PyObject_GetAttr(loop, &_Py_ID(_clock_resolution));
+    if (resolution == NULL) {
+        Py_DECREF(now);
+        return -1;
+    }
+    PyObject *end_time = PyNumber_Add(now, resolution);
+    Py_DECREF(now);
+    Py_DECREF(resolution);
+    if (end_time == NULL) {
+        return -1;
+    }
+    PyObject *scheduled = PyObject_GetAttr(loop, &_Py_ID(_scheduled));
+    if (scheduled == NULL) {
+        Py_DECREF(end_time);
+        return -1;
+    }
+    if (!PyList_Check(scheduled)) {
+        PyErr_SetString(PyExc_TypeError, "heap argument must be a list");
+        goto error;
+    }
+
+    while (PyList_GET_SIZE(scheduled)) {
+        PyObject *handle = PyList_GetItemRef(scheduled, 0);
+        if (handle == NULL) {
+            goto error;
+        }
+        PyObject *when = timer_handle_get_when(state, handle);
+        Py_DECREF(handle);
+        if (when == NULL) {
+            goto error;
+        }
+        int later;
+        if (PyFloat_CheckExact(when) && PyFloat_CheckExact(end_time)) {
+            later = PyFloat_AS_DOUBLE(when) >= PyFloat_AS_DOUBLE(end_time);
+        }
+        else {
+            later = PyObject_RichCompareBool(when, end_time, Py_GE);
+        }
+        Py_DECREF(when);
+        if (later) {
+            if (later < 0) {
+                goto error;
+            }
+            break;
+        }
+        handle = timer_heap_pop(state, scheduled);
+        if (handle == NULL) {
+            goto error;
+        }
+        PyObject *res = PyObject_CallMethodOneArg(ready, &_Py_ID(append),
+                                                  handle);
+        Py_DECREF(handle);
+        if (res == NULL) {
+            goto error;
+        }
+        Py_DECREF(res);
+    }
+    Py_DECREF(scheduled);
+    Py_DECREF(end_time);
+    return 0;
+
+error:
+    Py_DECREF(scheduled);
+    Py_DECREF(end_time);
+    return -1;
+}
+
+/*[clinic input]
+_asyncio._run_once
+
+    loop: object
+    /
+
+Run one full iteration of the event loop.
+
+This calls all currently ready callbacks, polls for I/O, schedules the
+resulting callbacks, and finally schedules 'call_later' callbacks.
+
+This is the implementation of BaseEventLoop._run_once() outside of
+debug mode: callbacks are not timed.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio__run_once(PyObject *module, PyObject *loop)
+/*[clinic end generated code: output=b61344df108d4a87 input=1a748def84bfd898]*/
+{
+    asyncio_state *state = get_asyncio_state(module);
+    PyObject *ready = NULL;
+    PyObject *timeout = NULL;
+
+    PyObject *scheduled = run_once_remove_cancelled(state, loop);
+    if (scheduled == NULL) {
+        return NULL;
+    }
+    ready = PyObject_GetAttr(loop, &_Py_ID(_ready));
+    if (ready == NULL) {
+        goto error;
+    }
+    timeout = run_once_get_timeout(state, loop, scheduled, ready);
+    Py_CLEAR(scheduled);
+    if (timeout == NULL) {
+        goto error;
+    }
+
+    PyObject *selector = PyObject_GetAttr(loop, &_Py_ID(_selector));
+    if (selector == NULL) {
+        goto error;
+    }
+    PyObject *event_list = PyObject_CallMethodOneArg(selector, &_Py_ID(select),
+                                                     timeout);
+    Py_DECREF(selector);
+    Py_CLEAR(timeout);
+    if (event_list == NULL) {
+        goto error;
+    }
+    PyObject *res = PyObject_CallMethodOneArg(loop, &_Py_ID(_process_events),
+                                              event_list);
+    Py_DECREF(event_list);
+    if (res == NULL) {
+        goto error;
+    }
+    Py_DECREF(res);
+
+    /* Handle 'later' callbacks that are ready. */
+    if (run_once_schedule_timers(state, loop, ready) < 0) {
+        goto error;
+    }
+
+    /* This is the only place where callbacks are actually *called*.
+       All other places just add them to ready.
+       Callbacks scheduled by the callbacks run here are run in the next
+       iteration. */
+    Py_ssize_t ntodo = PyObject_Length(ready);
+    if (ntodo < 0) {
+        goto error;
+    }
+    for (Py_ssize_t i = 0; i < ntodo; i++) {
+        PyObject *handle = PyObject_CallMethodNoArgs(ready, &_Py_ID(popleft));
+        if (handle == NULL) {
+            goto error;
+        }
+        int err = handle_is_cancelled(state, handle);
+        if (err == 0) {
+            /* Subclasses like _ThreadSafeHandle override _run() */
+            if (Handle_CheckExact(state, handle) ||
+                TimerHandle_CheckExact(state, handle)) {
+                err = handle_run(state, (HandleObj *)handle);
+            }
+            else {
+                res = PyObject_CallMethodNoArgs(handle, &_Py_ID(_run));
+                err = res == NULL ? -1 : 0;
+                Py_XDECREF(res);
+            }
+        }
+        Py_DECREF(handle);
+        if (err < 0) {
+            goto error;
+        }
+    }
+    Py_DECREF(ready);
+    Py_RETURN_NONE;
+
+error:
+    Py_XDECREF(scheduled);
+    Py_XDECREF(ready);
+    Py_XDECREF(timeout);
+    return NULL;
+}
+
+
+/* ----- FilePool */
+
+/* A pool of worker threads running the blocking system calls of the file
+   operations of asyncio.files on POSIX.  The workers never touch Python
+   objects: an operation is prepared with the GIL held, run by a worker
+   without any thread state, then moved to the completed queue.  A byte is
+   written to a pipe when this queue becomes non-empty; the event loop
+   watches the read end and collects the completions with completed(),
+   which returns (token, result, data) tuples.
+
+   The workers are detached: close() does not wait for them, since a
+   system call can block indefinitely on a pipe, a FIFO or a terminal.
+   The operations still running when the pool is closed are freed by a
+   later close() once they complete, or leaked if the pool is destroyed
+   first.  The last user of the state shared with the workers frees it. */
+
+#ifdef HAVE_FILE_POOL
+
+/*[clinic input]
+class _asyncio.FilePool "FilePoolObj *" "&FilePool_Type"
+[clinic start generated code]*/
+/*[clinic end generated code: output=da39a3ee5e6b4b0d input=4f941779b0543670]*/
+
+static void
+filepool_queue_push(filepool_queue *queue, filepool_op *op)
+{
+    op->qnext = NULL;
+    if (queue->tail != NULL) {
+        queue->tail->qnext = op;
+    }
+    else {
+        queue->head = op;
+    }
+    queue->tail = op;
+}
+
+static filepool_op *
+filepool_queue_pop(filepool_queue *queue)
+{
+    filepool_op *op = queue->head;
+    if (op != NULL) {
+        queue->head = op->qnext;
+        if (queue->head == NULL) {
+            queue->tail = NULL;
+        }
+    }
+    return op;
+}
+
+/* Run the system call of an operation.  Called without a thread state. */
+static Py_ssize_t
+filepool_run_op(filepool_op *op)
+{
+    Py_ssize_t res;
+    do {
+        switch (op->opcode) {
+        case FILEPOOL_OPEN:
+            res = open(op->buf.buf, op->flags, op->mode);
+            break;
+        case FILEPOOL_READ:
+            if (op->offset < 0) {
+                res = read(op->fd, op->buf.buf, op->buf.len);
+            }
+            else {
+                res = pread(op->fd, op->buf.buf, op->buf.len,
+                            (off_t)op->offset);
+            }
+            break;
+        case FILEPOOL_WRITE:
+            if (op->offset < 0) {
+                res = write(op->fd, op->buf.buf, op->buf.len);
+            }
+            else {
+                res = pwrite(op->fd, op->buf.buf, op->buf.len,
+                             (off_t)op->offset);
+            }
+            break;
+        case FILEPOOL_FDATASYNC:
+#ifdef HAVE_FDATASYNC
+            res = fdatasync(op->fd);
+#else
+            res = fsync(op->fd);
+#endif
+            break;
+        case FILEPOOL_FSYNC:
+            res = fsync(op->fd);
+            break;
+        case FILEPOOL_CLOSE:
+            /* Never retry close(): the file descriptor is released even
+               if it fails with EINTR. */
+            res = close(op->fd);
+            return res < 0 && errno != EINTR ? -errno : 0;
+        default:
+            Py_UNREACHABLE();
+        }
+    } while (res < 0 && errno == EINTR);
+    return res < 0 ? -errno : res;
+}
+
+static void
+filepool_shared_free(filepool_shared *shared)
+{
+    pthread_mutex_destroy(&shared->mutex);
+    pthread_cond_destroy(&shared->cond);
+    PyMem_RawFree(shared);
+}
+
+static void
+filepool_shared_decref(filepool_shared *shared)
+{
+    pthread_mutex_lock(&shared->mutex);
+    int last = (--shared->refcnt == 0);
+    pthread_mutex_unlock(&shared->mutex);
+    if (last) {
+        filepool_shared_free(shared);
+    }
+}
+
+static void
+filepool_worker(void *arg)
+{
+    filepool_shared *shared = (filepool_shared *)arg;
+
+    pthread_mutex_lock(&shared->mutex);
+    for (;;) {
+        while (shared->pending.head == NULL && !shared->shutdown) {
+            shared->idle++;
+            pthread_cond_wait(&shared->cond, &shared->mutex);
+            shared->idle--;
+        }
+        if (shared->shutdown) {
+            break;
+        }
+        filepool_op *op = filepool_queue_pop(&shared->pending);
+        shared->npending--;
+        pthread_mutex_unlock(&shared->mutex);
+
+        op->res = filepool_run_op(op);
+
+        pthread_mutex_lock(&shared->mutex);
+        filepool_queue_push(&shared->done, op);
+        /* Once the pool is closed, the pipe is closed too */
+        if (!shared->notified && !shared->shutdown) {
+            shared->notified = 1;
+            /* The pipe holds one byte at most and never fills up */
+            if (write(shared->wfd, "", 1) < 0) {
+                /* nothing else can be done */
+            }
+        }
+    }
+    int last = (--shared->refcnt == 0);
+    pthread_mutex_unlock(&shared->mutex);
+    if (last) {
+        filepool_shared_free(shared);
+    }
+}
+
+/* Put the completed operations op, linked by qnext, back at the head of
+   the done queue, and make the pipe readable for them. */
+static void
+filepool_requeue_done(FilePoolObj *self, filepool_op *op)
+{
+    filepool_shared *shared = self->shared;
+    filepool_op *last = op;
+    while (last->qnext != NULL) {
+        last = last->qnext;
+    }
+    pthread_mutex_lock(&shared->mutex);
+    last->qnext = shared->done.head;
+    if (shared->done.head == NULL) {
+        shared->done.tail = last;
+    }
+    shared->done.head = op;
+    if (!shared->notified) {
+        shared->notified = 1;
+        if (write(shared->wfd, "", 1) < 0) {
+            /* nothing else can be done */
+        }
+    }
+    pthread_mutex_unlock(&shared->mutex);
+}
+
+static PyObject *
+filepool_err_closed(void)
+{
+    PyErr_SetString(PyExc_ValueError, "I/O operation on closed pool");
+    return NULL;
+}
+
+static void
+filepool_op_free(filepool_op *op)
+{
+    Py_XDECREF(op->token);
+    Py_XDECREF(op->result);
+    if (op->buf.obj != NULL) {
+        PyBuffer_Release(&op->buf);
+    }
+    PyMem_Free(op);
+}
+
+static void
+filepool_unlink_op(FilePoolObj *self, filepool_op *op)
+{
+    if (op->prev != NULL) {
+        op->prev->next = op->next;
+    }
+    else {
+        self->inflight = op->next;
+    }
+    if (op->next != NULL) {
+        op->next->prev = op->prev;
+    }
+    self->ninflight--;
+}
+
+static void filepool_internal_close(FilePoolObj *self);
+
+/* Return 1 if the pool is closed.  A pool inherited by a child process is
+   closed first: the workers of the parent do not exist in the child. */
+static int
+filepool_is_closed(FilePoolObj *self)
+{
+    if (self->rfd >= 0 && self->pid != getpid()) {
+        filepool_internal_close(self);
+    }
+    return self->rfd < 0;
+}
+
+static filepool_op *
+filepool_op_new(FilePoolObj *self, int opcode, PyObject *token, int fd)
+{
+    if (filepool_is_closed(self)) {
+        filepool_err_closed();
+        return NULL;
+    }
+    filepool_op *op = PyMem_Malloc(sizeof(filepool_op));
+    if (op == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    memset(op, 0, sizeof(*op));
+    op->opcode = opcode;
+    op->fd = fd;
+    op->offset = -1;
+    op->token = Py_NewRef(token);
+    return op;
+}
+
+/* Queue an operation, starting a new worker if all are busy. */
+static PyObject *
+filepool_submit(FilePoolObj *self, filepool_op *op)
+{
+    filepool_shared *shared = self->shared;
+    pthread_mutex_lock(&shared->mutex);
+    int start = (shared->npending >= shared->idle
+                 && self->nworkers < self->max_workers);
+    if (start) {
+        /* The reference of the new worker */
+        shared->refcnt++;
+    }
+    pthread_mutex_unlock(&shared->mutex);
+
+    if (start) {
+        if (PyThread_start_new_thread(filepool_worker, shared)
+            != PYTHREAD_INVALID_THREAD_ID)
+        {
+            self->nworkers++;
+        }
+        else {
+            pthread_mutex_lock(&shared->mutex);
+            shared->refcnt--;
+            pthread_mutex_unlock(&shared->mutex);
+            if (self->nworkers == 0) {
+                PyErr_SetString(PyExc_RuntimeError,
+                                "can't start new thread");
+                filepool_op_free(op);
+                return NULL;
+            }
+        }
+    }
+
+    op->prev = NULL;
+    op->next = self->inflight;
+    if (self->inflight != NULL) {
+        self->inflight->prev = op;
+    }
+    self->inflight = op;
+    self->ninflight++;
+
+    pthread_mutex_lock(&shared->mutex);
+    filepool_queue_push(&shared->pending, op);
+    shared->npending++;
+    pthread_cond_signal(&shared->cond);
+    pthread_mutex_unlock(&shared->mutex);
+    Py_RETURN_NONE;
+}
+
+/* Free the operations of a queue, linked by qnext */
+static void
+filepool_free_queue(FilePoolObj *self, filepool_op *op)
+{
+    while (op != NULL) {
+        filepool_op *next = op->qnext;
+        filepool_unlink_op(self, op);
+        filepool_op_free(op);
+        op = next;
+    }
+}
+
+/* Free the operations which completed since the pool was closed, and
+   release the shared state once none is running. */
+static void
+filepool_reclaim(FilePoolObj *self)
+{
+    filepool_shared *shared = self->shared;
+    if (self->pid != getpid()) {
+        /* Forked child: the workers of the parent do not exist, but the
+           mutex may have been held by one of them.  The shared state is
+           leaked. */
+        while (self->inflight != NULL) {
+            filepool_op *op = self->inflight;
+            filepool_unlink_op(self, op);
+            filepool_op_free(op);
+        }
+        self->shared = NULL;
+        return;
+    }
+
+    pthread_mutex_lock(&shared->mutex);
+    filepool_op *done = shared->done.head;
+    shared->done.head = shared->done.tail = NULL;
+    pthread_mutex_unlock(&shared->mutex);
+    filepool_free_queue(self, done);
+
+    if (self->inflight == NULL) {
+        self->shared = NULL;
+        filepool_shared_decref(shared);
+    }
+}
+
+/* Stop the workers without waiting for them and drop the operations
+   which are not collected yet.  The operations being run are kept until
+   they complete. */
+static void
+filepool_internal_close(FilePoolObj *self)
+{
+    if (self->rfd >= 0) {
+        filepool_shared *shared = self->shared;
+        if (self->pid == getpid()) {
+            pthread_mutex_lock(&shared->mutex);
+            shared->shutdown = 1;
+            pthread_cond_broadcast(&shared->cond);
+            filepool_op *pending = shared->pending.head;
+            shared->pending.head = shared->pending.tail = NULL;
+            shared->npending = 0;
+            close(shared->wfd);
+            shared->wfd = -1;
+            pthread_mutex_unlock(&shared->mutex);
+            filepool_free_queue(self, pending);
+        }
+        else {
+            close(shared->wfd);
+        }
+        close(self->rfd);
+        self->rfd = -1;
+        self->nworkers = 0;
+    }
+    if (self->shared != NULL) {
+        filepool_reclaim(self);
+    }
+}
+
+/*[clinic input]
+@classmethod
+_asyncio.FilePool.__new__
+
+    max_workers: int = 4
+        The maximum number of worker threads.  They are started when
+        needed.
+
+Pool of threads running file operations for asyncio.
+
+The completions are collected with completed() once the file descriptor
+returned by fileno() is readable.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_FilePool_impl(PyTypeObject *type, int max_workers)
+/*[clinic end generated code: output=a70561e5609f9a73 input=e3c4a2d84ea901fd]*/
+{
+    if (max_workers <= 0) {
+        PyErr_SetString(PyExc_ValueError, "max_workers must be positive");
+        return NULL;
+    }
+    FilePoolObj *self = (FilePoolObj *)type->tp_alloc(type, 0);
+    if (self == NULL) {
+        return NULL;
+    }
+    self->rfd = -1;
+    self->max_workers = max_workers;
+    self->pid = getpid();
+
+    int fds[2];
+#ifdef HAVE_PIPE2
+    if (pipe2(fds, O_CLOEXEC | O_NONBLOCK) < 0) {
+        PyErr_SetFromErrno(PyExc_OSError);
+        goto error;
+    }
+#else
+    if (pipe(fds) < 0) {
+        PyErr_SetFromErrno(PyExc_OSError);
+        goto error;
+    }
+    for (int i = 0; i < 2; i++) {
+        if (fcntl(fds[i], F_SETFD, FD_CLOEXEC) < 0
+            || fcntl(fds[i], F_SETFL, O_NONBLOCK) < 0)
+        {
+            PyErr_SetFromErrno(PyExc_OSError);
+            close(fds[0]);
+            close(fds[1]);
+            goto error;
+        }
+    }
+#endif
+    filepool_shared *shared = PyMem_RawCalloc(1, sizeof(filepool_shared));
+    if (shared == NULL) {
+        PyErr_NoMemory();
+        close(fds[0]);
+        close(fds[1]);
+        goto error;
+    }
+    pthread_mutex_init(&shared->mutex, NULL);
+    pthread_cond_init(&shared->cond, NULL);
+    shared->refcnt = 1;
+    shared->wfd = fds[1];
+    self->shared = shared;
+    self->rfd = fds[0];
+    return (PyObject *)self;
+
+error:
+    Py_DECREF(self);
+    return NULL;
+}
+
+static int
+FilePoolObj_traverse(PyObject *op, visitproc visit, void *arg)
+{
+    FilePoolObj *self = FilePoolObj_CAST(op);
+    Py_VISIT(Py_TYPE(self));
+    for (filepool_op *o = self->inflight; o != NULL; o = o->next) {
+        Py_VISIT(o->token);
+    }
+    return 0;
+}
+
+static int
+FilePoolObj_clear(PyObject *op)
+{
+    FilePoolObj *self = FilePoolObj_CAST(op);
+    /* The buffers must be kept until the workers are done with them, but
+       the tokens are not needed by the workers. */
+    for (filepool_op *o = self->inflight; o != NULL; o = o->next) {
+        Py_CLEAR(o->token);
+    }
+    return 0;
+}
+
+static void
+FilePoolObj_dealloc(PyObject *op)
+{
+    FilePoolObj *self = FilePoolObj_CAST(op);
+    PyTypeObject *tp = Py_TYPE(self);
+    PyObject_GC_UnTrack(self);
+    PyObject *exc = PyErr_GetRaisedException();
+    filepool_internal_close(self);
+    if (self->shared != NULL) {
+        /* The operations still running are leaked: their workers use
+           their buffers. */
+        self->inflight = NULL;
+        self->ninflight = 0;
+        filepool_shared_decref(self->shared);
+    }
+    PyErr_SetRaisedException(exc);
+    tp->tp_free(self);
+    Py_DECREF(tp);
+}
+
+/*[clinic input]
+@critical_section
+_asyncio.FilePool.close
+
+Stop the workers and close the pool.
+
+Do not wait for the operations being run, which can block indefinitely
+on a pipe or a FIFO: they are counted by inflight until a later call
+finds them completed.  The completions which have not been collected yet
+are discarded.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_FilePool_close_impl(FilePoolObj *self)
+/*[clinic end generated code: output=ab0d1129f2c48356 input=56291b3f8e7bcf5f]*/
+{
+    filepool_internal_close(self);
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+@critical_section
+_asyncio.FilePool.fileno
+
+Return the file descriptor which is readable when completions are ready.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_FilePool_fileno_impl(FilePoolObj *self)
+/*[clinic end generated code: output=c4a024b207b37f76 input=5126e1bd6e2b6e36]*/
+{
+    if (filepool_is_closed(self)) {
+        return filepool_err_closed();
+    }
+    return PyLong_FromLong(self->rfd);
+}
+
+/*[clinic input]
+@critical_section
+_asyncio.FilePool.open
+
+    token: object
+    path: object(subclass_of='&PyBytes_Type')
+        The path encoded with os.fsencode().
+    flags: int
+    mode: int = 0o666
+    /
+
+Open the file path like os.open().
+
+The completion result is the new file descriptor.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_FilePool_open_impl(FilePoolObj *self, PyObject *token,
+                            PyObject *path, int flags, int mode)
+/*[clinic end generated code: output=2c2fb7a66a80e2fb input=41a55328edfb70cc]*/
+{
+    if (strlen(PyBytes_AS_STRING(path)) != (size_t)PyBytes_GET_SIZE(path)) {
+        PyErr_SetString(PyExc_ValueError, "embedded null byte");
+        return NULL;
+    }
+    filepool_op *op = filepool_op_new(self, FILEPOOL_OPEN, token, -1);
+    if (op == NULL) {
+        return NULL;
+    }
+    if (PyObject_GetBuffer(path, &op->buf, PyBUF_SIMPLE) < 0) {
+        op->buf.obj = NULL;
+        filepool_op_free(op);
+        return NULL;
+    }
+    op->flags = flags;
+    op->mode = mode;
+    return filepool_submit(self, op);
+}
+
+/*[clinic input]
+@critical_section
+_asyncio.FilePool.read
+
+    token: object
+    fd: int
+    size: Py_ssize_t
+    offset: long_long = -1
+        The file offset, or -1 to use and update the file position.
+    /
+
+Read at most size bytes from fd.
+
+The completion data is a bytes object with the data read.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_FilePool_read_impl(FilePoolObj *self, PyObject *token, int fd,
+                            Py_ssize_t size, long long offset)
+/*[clinic end generated code: output=55ea09ba8b5dc766 input=9391073ec18a5b5f]*/
+{
+    if (size < 0) {
+        PyErr_SetString(PyExc_ValueError, "negative size");
+        return NULL;
+    }
+    filepool_op *op = filepool_op_new(self, FILEPOOL_READ, token, fd);
+    if (op == NULL) {
+        return NULL;
+    }
+    op->result = PyBytes_FromStringAndSize(NULL, size);
+    if (op->result == NULL) {
+        filepool_op_free(op);
+        return NULL;
+    }
+    op->buf.buf = PyBytes_AS_STRING(op->result);
+    op->buf.len = size;
+    op->offset = offset;
+    return filepool_submit(self, op);
+}
+
+static PyObject *
+filepool_buffer_op(FilePoolObj *self, int opcode, PyObject *token, int fd,
+                   PyObject *obj, int writable, long long offset)
+{
+    filepool_op *op = filepool_op_new(self, opcode, token, fd);
+    if (op == NULL) {
+        return NULL;
+    }
+    if (PyObject_GetBuffer(obj, &op->buf,
+                           writable ? PyBUF_WRITABLE : PyBUF_SIMPLE) < 0)
+    {
+        op->buf.obj = NULL;
+        filepool_op_free(op);
+        return NULL;
+    }
+    op->offset = offset;
+    return filepool_submit(self, op);
+}
+
+/*[clinic input]
+@critical_section
+_asyncio.FilePool.readinto
+
+    token: object
+    fd: int
+    buffer: object
+    offset: long_long = -1
+    /
+
+Read from fd into a writable buffer.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_FilePool_readinto_impl(FilePoolObj *self, PyObject *token, int fd,
+                                PyObject *buffer, long long offset)
+/*[clinic end generated code: output=5b1e34be13b2eda5 input=d6022bcead143898]*/
+{
+    return filepool_buffer_op(self, FILEPOOL_READ, token, fd, buffer, 1,
+                              offset);
+}
+
+/*[clinic input]
+@critical_section
+_asyncio.FilePool.write
+
+    token: object
+    fd: int
+    data: object
+    offset: long_long = -1
+    /
+
+Write the bytes-like object data to fd.
+
+The completion result is the number of bytes written, which may be less
+than the size of data.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_FilePool_write_impl(FilePoolObj *self, PyObject *token, int fd,
+                             PyObject *data, long long offset)
+/*[clinic end generated code: output=a0f3e9a1a20247bf input=be55b996cc66ccfa]*/
+{
+    return filepool_buffer_op(self, FILEPOOL_WRITE, token, fd, data, 0,
+                              offset);
+}
+
+/*[clinic input]
+@critical_section
+_asyncio.FilePool.fsync
+
+    token: object
+    fd: int
+    datasync: bool = False
+        Only flush the data and the metadata needed to read it back, like
+        os.fdatasync().
+    /
+
+Flush the data of the file fd to disk, like os.fsync().
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_FilePool_fsync_impl(FilePoolObj *self, PyObject *token, int fd,
+                             int datasync)
+/*[clinic end generated code: output=6f2f97eece1c4cf8 input=d5031d983365170b]*/
+{
+    filepool_op *op = filepool_op_new(
+        self, datasync ? FILEPOOL_FDATASYNC : FILEPOOL_FSYNC, token, fd);
+    if (op == NULL) {
+        return NULL;
+    }
+    return filepool_submit(self, op);
+}
+
+/*[clinic input]
+@critical_section
+_asyncio.FilePool.close_fd
+
+    token: object
+    fd: int
+    /
+
+Close the file descriptor fd.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_FilePool_close_fd_impl(FilePoolObj *self, PyObject *token, int fd)
+/*[clinic end generated code: output=6981d9afc71dc3cb input=fe781fe0337f7d40]*/
+{
+    filepool_op *op = filepool_op_new(self, FILEPOOL_CLOSE, token, fd);
+    if (op == NULL) {
+        return NULL;
+    }
+    return filepool_submit(self, op);
+}
+
+/*[clinic input]
+@critical_section
+_asyncio.FilePool.completed
+
+Return the completed operations.
+
+Return a list of (token, result, data) tuples.  result is the result of
+the operation: a negative errno value on failure.  data is the bytes
+object read by read(), or None.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_FilePool_completed_impl(FilePoolObj *self)
+/*[clinic end generated code: output=0ca1f004715bd719 input=22bc392e35f99d8e]*/
+{
+    if (filepool_is_closed(self)) {
+        return filepool_err_closed();
+    }
+    /* Empty the pipe before taking the completed operations: a worker
+       completing an operation after this writes a new byte.  The pipe
+       holds one byte at most. */
+    char buf;
+    if (read(self->rfd, &buf, 1) < 0) {
+        /* EAGAIN: the pipe is empty */
+    }
+
+    filepool_shared *shared = self->shared;
+    pthread_mutex_lock(&shared->mutex);
+    filepool_op *op = shared->done.head;
+    shared->done.head = shared->done.tail = NULL;
+    shared->notified = 0;
+    pthread_mutex_unlock(&shared->mutex);
+
+    PyObject *list = PyList_New(0);
+    while (op != NULL) {
+        filepool_op *next = op->qnext;
+        PyObject *item = NULL;
+        if (list != NULL) {
+            PyObject *data = Py_None;
+            if (op->result != NULL && op->res >= 0) {
+                if (op->res != PyBytes_GET_SIZE(op->result)
+                    && _PyBytes_Resize(&op->result, op->res) < 0)
+                {
+                    /* The data is lost: fail the operation */
+                    PyErr_Clear();
+                    op->res = -ENOMEM;
+                }
+                else {
+                    data = op->result;
+                }
+            }
+            item = Py_BuildValue("(OnO)", op->token, op->res, data);
+        }
+        if (item == NULL || PyList_Append(list, item) < 0) {
+            /* The operations which were not returned are returned by the
+               next call */
+            Py_XDECREF(item);
+            filepool_requeue_done(self, op);
+            if (list != NULL && PyList_GET_SIZE(list) > 0) {
+                PyErr_Clear();
+                return list;
+            }
+            Py_XDECREF(list);
+            return NULL;
+        }
+        Py_DECREF(item);
+        filepool_unlink_op(self, op);
+        filepool_op_free(op);
+        op = next;
+    }
+    return list;
+}
+
+static PyObject *
+FilePool_get_closed(PyObject *op, void *Py_UNUSED(closure))
+{
+    FilePoolObj *self = FilePoolObj_CAST(op);
+    return PyBool_FromLong(self->rfd < 0 || self->pid != getpid());
+}
+
+static PyObject *
+FilePool_get_inflight(PyObject *op, void *Py_UNUSED(closure))
+{
+    FilePoolObj *self = FilePoolObj_CAST(op);
+    return PyLong_FromSsize_t(self->ninflight);
+}
+
+static PyObject *
+FilePool_get_workers(PyObject *op, void *Py_UNUSED(closure))
+{
+    FilePoolObj *self = FilePoolObj_CAST(op);
+    return PyLong_FromLong(self->nworkers);
+}
+
+static PyGetSetDef FilePool_getsetlist[] = {
+    {"closed", FilePool_get_closed, NULL,
+     "True if the pool is closed."},
+    {"inflight", FilePool_get_inflight, NULL,
+     "Number of operations not collected yet."},
+    {"workers", FilePool_get_workers, NULL,
+     "Number of worker threads started."},
+    {NULL},
+};
+
+static PyMethodDef FilePool_methods[] = {
+    _ASYNCIO_FILEPOOL_CLOSE_METHODDEF
+    _ASYNCIO_FILEPOOL_FILENO_METHODDEF
+    _ASYNCIO_FILEPOOL_OPEN_METHODDEF
+    _ASYNCIO_FILEPOOL_READ_METHODDEF
+    _ASYNCIO_FILEPOOL_READINTO_METHODDEF
+    _ASYNCIO_FILEPOOL_WRITE_METHODDEF
+    _ASYNCIO_FILEPOOL_FSYNC_METHODDEF
+    _ASYNCIO_FILEPOOL_CLOSE_FD_METHODDEF
+    _ASYNCIO_FILEPOOL_COMPLETED_METHODDEF
+    {NULL, NULL}
+};
+
+static PyType_Slot FilePool_slots[] = {
+    {Py_tp_dealloc, FilePoolObj_dealloc},
+    {Py_tp_doc, (void *)_asyncio_FilePool__doc__},
+    {Py_tp_traverse, FilePoolObj_traverse},
+    {Py_tp_clear, FilePoolObj_clear},
+    {Py_tp_methods, FilePool_methods},
+    {Py_tp_getset, FilePool_getsetlist},
+    {Py_tp_new, _asyncio_FilePool},
+    {0, NULL},
+};
+
+static PyType_Spec FilePool_spec = {
+    .name = "_asyncio.FilePool",
+    .basicsize = sizeof(FilePoolObj),
+    .flags = (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC |
+              Py_TPFLAGS_IMMUTABLETYPE),
+    .slots = FilePool_slots,
+};
+
+#endif  /* HAVE_FILE_POOL */
+
+
+/*********************** Functions **************************/
+
+
+/*[clinic input]
+_asyncio._get_running_loop
+
+Return the running event loop or None.
+
+This is a low-level function intended to be used by event loops.
+This function is thread-specific.
+
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio__get_running_loop_impl(PyObject *module)
+/*[clinic end generated code: output=b4390af721411a0a input=0a21627e25a4bd43]*/
+{
+    _PyThreadStateImpl *ts = (_PyThreadStateImpl *)_PyThreadState_GET();
+    PyObject *loop = Py_XNewRef(ts->asyncio_running_loop);
+    if (loop == NULL) {
+        /* There's no currently running event loop */
+        Py_RETURN_NONE;
+    }
+    return loop;
+}
+
+/*[clinic input]
+_asyncio._set_running_loop
+    loop: 'O'
+    /
+
+Set the running event loop.
+
+This is a low-level function intended to be used by event loops.
+This function is thread-specific.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio__set_running_loop(PyObject *module, PyObject *loop)
+/*[clinic end generated code: output=ae56bf7a28ca189a input=4c9720233d606604]*/
+{
+    _PyThreadStateImpl *ts = (_PyThreadStateImpl *)_PyThreadState_GET();
+    if (loop == Py_None) {
+        loop = NULL;
+    }
+    Py_XSETREF(ts->asyncio_running_loop, Py_XNewRef(loop));
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+_asyncio.get_event_loop
+
+Return an asyncio event loop.
+
+When called from a coroutine or a callback (e.g. scheduled with
+call_soon or similar API), this function will always return the
+running event loop.
+
+If there is no running event loop set, the function will return
+the result of `get_event_loop_policy().get_event_loop()` call.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_get_event_loop_impl(PyObject *module)
+/*[clinic end generated code: output=2a2d8b2f824c648b input=9364bf2916c8655d]*/
+{
+    asyncio_state *state = get_asyncio_state(module);
+    return get_event_loop(state);
+}
+
+/*[clinic input]
+_asyncio.get_running_loop
+
+Return the running event loop.  Raise a RuntimeError if there is none.
+
+This function is thread-specific.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio_get_running_loop_impl(PyObject *module)
+/*[clinic end generated code: output=c247b5f9e529530e input=2a3bf02ba39f173d]*/
+{
+    PyObject *loop;
+    _PyThreadStateImpl *ts = (_PyThreadStateImpl *)_PyThreadState_GET();
+    loop = Py_XNewRef(ts->asyncio_running_loop);
+    if (loop == NULL) {
+        /* There's no currently running event loop */
+        PyErr_SetString(
+            PyExc_RuntimeError, "no running event loop");
+        return NULL;
+    }
+    return loop;
+}
+
+/*[clinic input]
+_asyncio._register_task
+
+    task: object
+
+Register a new task in asyncio as executed by loop.
+
+Returns None.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio__register_task_impl(PyObject *module, PyObject *task)
+/*[clinic end generated code: output=8672dadd69a7d4e2 input=21075aaea14dfbad]*/
+{
+    asyncio_state *state = get_asyncio_state(module);
+    if (Task_Check(state, task)) {
+        // task is an asyncio.Task instance or subclass, use efficient
+        // linked-list implementation.
+        register_task((TaskObj *)task);
+        Py_RETURN_NONE;
+    }
+    // As task does not inherit from asyncio.Task, fallback to less efficient
+    // weakset implementation.
+    PyObject *res = PyObject_CallMethodOneArg(state->non_asyncio_tasks,
+                                              &_Py_ID(add), task);
+    if (res == NULL) {
+        return NULL;
+    }
+    Py_DECREF(res);
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+_asyncio._register_eager_task
+
+    task: object
+
+Register a new task in asyncio as executed by loop.
+
+Returns None.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio__register_eager_task_impl(PyObject *module, PyObject *task)
+/*[clinic end generated code: output=dfe1d45367c73f1a input=237f684683398c51]*/
+{
+    asyncio_state *state = get_asyncio_state(module);
+    if (register_eager_task(state, task) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+
+/*[clinic input]
+_asyncio._unregister_task
+
+    task: object
+
+Unregister a task.
+
+Returns None.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio__unregister_task_impl(PyObject *module, PyObject *task)
+/*[clinic end generated code: output=6e5585706d568a46 input=28fb98c3975f7bdc]*/
+{
+    asyncio_state *state = get_asyncio_state(module);
+    if (Task_Check(state, task)) {
+        unregister_task((TaskObj *)task);
+        Py_RETURN_NONE;
+    }
+    PyObject *res = PyObject_CallMethodOneArg(state->non_asyncio_tasks,
+                                              &_Py_ID(discard), task);
+    if (res == NULL) {
+        return NULL;
+    }
+    Py_DECREF(res);
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+_asyncio._unregister_eager_task
+
+    task: object
+
+Unregister a task.
+
+Returns None.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio__unregister_eager_task_impl(PyObject *module, PyObject *task)
+/*[clinic end generated code: output=a426922bd07f23d1 input=9d07401ef14ee048]*/
+{
+    asyncio_state *state = get_asyncio_state(module);
+    if (unregister_eager_task(state, task) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+
+/*[clinic input]
+_asyncio._enter_task
+
+    loop: object
+    task: object
+
+Enter into task execution or resume suspended task.
+
+Task belongs to loop.
+
+Returns None.
+[clinic start generated code]*/
+
+static PyObject *
+_asyncio__enter_task_impl(PyObject *module, PyObject *loop, PyObject *task)
+/*[clinic end generated code: output=a22611c858035b73 input=de1b06dca70d8737]*/
 {
     if (enter_task(loop, task) < 0) {
         return NULL;
@@ -4166,9 +6376,16 @@ module_traverse(PyObject *mod, visitproc visit, void *arg)
     Py_VISIT(state->TaskStepMethWrapper_Type);
     Py_VISIT(state->FutureType);
     Py_VISIT(state->TaskType);
+    Py_VISIT(state->HandleType);
+    Py_VISIT(state->TimerHandleType);
+    Py_VISIT(state->FilePoolType);
 
     Py_VISIT(state->asyncio_mod);
     Py_VISIT(state->traceback_extract_stack);
+    Py_VISIT(state->asyncio_extract_stack_func);
+    Py_VISIT(state->asyncio_format_callback_source_func);
+    Py_VISIT(state->heapq_heappop);
+    Py_VISIT(state->heapq_heapify);
     Py_VISIT(state->asyncio_future_repr_func);
     Py_VISIT(state->asyncio_get_event_loop_policy);
     Py_VISIT(state->asyncio_iscoroutine_func);
@@ -4196,9 +6413,16 @@ module_clear(PyObject *mod)
     Py_CLEAR(state->TaskStepMethWrapper_Type);
     Py_CLEAR(state->FutureType);
     Py_CLEAR(state->TaskType);
+    Py_CLEAR(state->HandleType);
+    Py_CLEAR(state->TimerHandleType);
+    Py_CLEAR(state->FilePoolType);
 
     Py_CLEAR(state->asyncio_mod);
     Py_CLEAR(state->traceback_extract_stack);
+    Py_CLEAR(state->asyncio_extract_stack_func);
+    Py_CLEAR(state->asyncio_format_callback_source_func);
+    Py_CLEAR(state->heapq_heappop);
+    Py_CLEAR(state->heapq_heapify);
     Py_CLEAR(state->asyncio_future_repr_func);
     Py_CLEAR(state->asyncio_get_event_loop_policy);
     Py_CLEAR(state->asyncio_iscoroutine_func);
@@ -4280,9 +6504,18 @@ module_init(asyncio_state *state)
     WITH_MOD("asyncio.coroutines")
     GET_MOD_ATTR(state->asyncio_iscoroutine_func, "iscoroutine")
 
+    WITH_MOD("asyncio.format_helpers")
+    GET_MOD_ATTR(state->asyncio_extract_stack_func, "extract_stack")
+    GET_MOD_ATTR(state->asyncio_format_callback_source_func,
+                 "_format_callback_source")
+
     WITH_MOD("traceback")
     GET_MOD_ATTR(state->traceback_extract_stack, "extract_stack")
 
+    WITH_MOD("heapq")
+    GET_MOD_ATTR(state->heapq_heappop, "heappop")
+    GET_MOD_ATTR(state->heapq_heapify, "heapify")
+
     PyObject *weak_set;
     WITH_MOD("weakref")
     GET_MOD_ATTR(weak_set, "WeakSet");
@@ -4326,6 +6559,7 @@ static PyMethodDef asyncio_methods[] = {
     _ASYNCIO_ALL_TASKS_METHODDEF
     _ASYNCIO_FUTURE_ADD_TO_AWAITED_BY_METHODDEF
     _ASYNCIO_FUTURE_DISCARD_FROM_AWAITED_BY_METHODDEF
+    _ASYNCIO__RUN_ONCE_METHODDEF
     {NULL, NULL}
 };
 
@@ -4348,6 +6582,12 @@ module_exec(PyObject *mod)
     CREATE_TYPE(mod, state->FutureIterType, &FutureIter_spec, NULL);
     CREATE_TYPE(mod, state->FutureType, &Future_spec, NULL);
     CREATE_TYPE(mod, state->TaskType, &Task_spec, state->FutureType);
+    CREATE_TYPE(mod, state->HandleType, &Handle_spec, NULL);
+    CREATE_TYPE(mod, state->TimerHandleType, &TimerHandle_spec,
+                state->HandleType);
+#ifdef HAVE_FILE_POOL
+    CREATE_TYPE(mod, state->FilePoolType, &FilePool_spec, NULL);
+#endif
 
 #undef CREATE_TYPE
 
@@ -4358,6 +6598,21 @@ module_exec(PyObject *mod)
     if (PyModule_AddType(mod, state->TaskType) < 0) {
         return -1;
     }
+
+    if (PyModule_AddType(mod, state->HandleType) < 0) {
+        return -1;
+    }
+
+    if (PyModule_AddType(mod, state->TimerHandleType) < 0) {
+        return -1;
+    }
+
+#ifdef HAVE_FILE_POOL
+    if (PyModule_AddType(mod, state->FilePoolType) < 0) {
+        return -1;
+    }
+#endif
+
     // Must be done after types are added to avoid a circular dependency
     if (module_init(state) < 0) {
         return -1;
@@ -80,6 +80,9 @@ _io.open
     newline: str(accept={str, NoneType}) = None
     closefd: bool = True
     opener: object = None
+    *
+    sequential: bool = False
+    mmap as use_mmap: bool = False
 
 Open file and return a stream.  Raise OSError upon failure.
 
@@ -181,6 +184,15 @@ calling *opener* with (*file*, *flags*). *opener* must return an open
 file descriptor (passing os.open as *opener* results in functionality
 similar to passing None).
 
+If sequential is true, the file is expected to be read from start to
+end, for example a large file being scanned: the buffer grows while the
+file is read sequentially, and the operating system is asked to read
+ahead.  It is only supported by buffered files opened for reading only.
+
+If mmap is true, the file is memory mapped and a FileIO object serving
+reads from the mapping is returned instead of a buffered file.  It is
+only supported in binary mode for reading only.
+
 open() returns a file object whose type depends on the mode, and
 through which the standard file operations such as reading and writing
 are performed. When open() is used to open a file in a text mode ('w',
@@ -199,8 +211,9 @@ opened in a binary mode.
 static PyObject *
 _io_open_impl(PyObject *module, PyObject *file, const char *mode,
               int buffering, const char *encoding, const char *errors,
-              const char *newline, int closefd, PyObject *opener)
-/*[clinic end generated code: output=aefafc4ce2b46dc0 input=cd034e7cdfbf4e78]*/
+              const char *newline, int closefd, PyObject *opener,
+              int sequential, int use_mmap)
+/*[clinic end generated code: output=6a1da4478ce47bb4 input=3d1a3ad8b18fb76a]*/
 {
     size_t i;
 
@@ -308,6 +321,18 @@ _io_open_impl(PyObject *module, PyObject *file, const char *mode,
         goto error;
     }
 
+    if (sequential && (!reading || updating)) {
+        PyErr_SetString(PyExc_ValueError,
+                        "sequential mode is only supported for reading");
+        goto error;
+    }
+
+    if (use_mmap && (!binary || !reading || updating)) {
+        PyErr_SetString(PyExc_ValueError,
+                        "mmap mode is only supported for binary reading");
+        goto error;
+    }
+
     if (binary && buffering == 1) {
         if (PyErr_WarnEx(PyExc_RuntimeWarning,
                          "line buffering (buffering=1) isn't supported in "
@@ -323,15 +348,35 @@ _io_open_impl(PyObject *module, PyObject *file, const char *mode,
         PyObject *RawIO_class = (PyObject *)state->PyFileIO_Type;
 #ifdef HAVE_WINDOWS_CONSOLE_IO
         const PyConfig *config = _Py_GetConfig();
-        if (!config->legacy_windows_stdio && _PyIO_get_console_type(path_or_fd) != '\0') {
+        if (!use_mmap && !config->legacy_windows_stdio &&
+            _PyIO_get_console_type(path_or_fd) != '\0')
+        {
             RawIO_class = (PyObject *)state->PyWindowsConsoleIO_Type;
             encoding = "utf-8";
         }
 #endif
-        raw = PyObject_CallFunction(RawIO_class, "OsOO",
-                                    path_or_fd, rawmode,
-                                    closefd ? Py_True : Py_False,
-                                    opener);
+        if (use_mmap) {
+            PyObject *args = Py_BuildValue("(OsOO)", path_or_fd, rawmode,
+                                           closefd ? Py_True : Py_False,
+                                           opener);
+            PyObject *kwargs = Py_BuildValue("{sOsO}", "mmap", Py_True,
+                                             "sequential",
+                                             sequential ? Py_True : Py_False);
+            if (args != NULL && kwargs != NULL) {
+                raw = PyObject_Call(RawIO_class, args, kwargs);
+            }
+            else {
+                raw = NULL;
+            }
+            Py_XDECREF(args);
+            Py_XDECREF(kwargs);
+        }
+        else {
+            raw = PyObject_CallFunction(RawIO_class, "OsOO",
+                                        path_or_fd, rawmode,
+                                        closefd ? Py_True : Py_False,
+                                        opener);
+        }
     }
 
     if (raw == NULL)
@@ -340,6 +385,11 @@ _io_open_impl(PyObject *module, PyObject *file, const char *mode,
 
     Py_SETREF(path_or_fd, NULL);
 
+    /* the mapping replaces the buffer, returns the raw file object */
+    if (use_mmap) {
+        return result;
+    }
+
     modeobj = PyUnicode_FromString(mode);
     if (modeobj == NULL)
         goto error;
@@ -385,6 +435,11 @@ _io_open_impl(PyObject *module, PyObject *file, const char *mode,
                             "can't have unbuffered text I/O");
             goto error;
         }
+        if (sequential) {
+            PyErr_SetString(PyExc_ValueError,
+                            "can't have unbuffered sequential I/O");
+            goto error;
+        }
 
         Py_DECREF(modeobj);
         return result;
@@ -409,7 +464,21 @@ _io_open_impl(PyObject *module, PyObject *file, const char *mode,
             goto error;
         }
 
-        buffer = PyObject_CallFunction(Buffered_class, "Oi", raw, buffering);
+        if (sequential) {
+            PyObject *args = Py_BuildValue("(Oi)", raw, buffering);
+            PyObject *kwargs = Py_BuildValue("{sO}", "sequential", Py_True);
+            if (args != NULL && kwargs != NULL) {
+                buffer = PyObject_Call(Buffered_class, args, kwargs);
+            }
+            else {
+                buffer = NULL;
+            }
+            Py_XDECREF(args);
+            Py_XDECREF(kwargs);
+        }
+        else {
+            buffer = PyObject_CallFunction(Buffered_class, "Oi", raw, buffering);
+        }
     }
     if (buffer == NULL)
         goto error;
@@ -51,6 +51,17 @@ extern int _PyIOBase_finalize(PyObject *self);
    Doesn't check the argument type, so be careful! */
 extern int _PyFileIO_closed(PyObject *self);
 
+#ifdef HAVE_WRITEV
+#include <sys/uio.h>              // struct iovec
+
+/* Writes the buffers with a single writev() call on the given FileIO
+   object, like FileIO.write() does for one buffer.  Returns the number of
+   bytes written, -2 if the write would block, or -1 with an exception set.
+   Doesn't check the argument type either. */
+extern Py_ssize_t _PyFileIO_writev(PyObject *self, struct iovec *iov,
+                                   int iovcnt);
+#endif
+
 /* Shortcut to the core of the IncrementalNewlineDecoder.decode method */
 extern PyObject *_PyIncrementalNewlineDecoder_decode(
     PyObject *self, PyObject *input, int final);
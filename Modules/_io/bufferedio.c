@@ -13,8 +13,15 @@
 #include "pycore_pyerrors.h"            // _Py_FatalErrorFormat()
 #include "pycore_pylifecycle.h"         // _Py_IsInterpreterFinalizing()
 
+#ifdef HAVE_FCNTL_H
+#  include <fcntl.h>                    // posix_fadvise()
+#endif
+
 #include "_iomodule.h"
 
+/* Largest buffer of a BufferedReader in sequential mode. */
+#define SEQUENTIAL_MAX_BUFFER_SIZE (256 * 1024)  /* bytes */
+
 /*[clinic input]
 module _io
 class _io._BufferedIOBase "PyObject *" "clinic_state()->PyBufferedIOBase_Type"
@@ -257,6 +264,17 @@ typedef struct {
     Py_ssize_t buffer_size;
     Py_ssize_t buffer_mask;
 
+    /* Sequential mode of BufferedReader: the buffer grows from
+       `seq_min_size` up to SEQUENTIAL_MAX_BUFFER_SIZE while the raw stream
+       is read sequentially, and shrinks back after a seek. */
+    int sequential;
+    /* File descriptor of the raw stream, to give the kernel read-ahead
+       hints, or -1. */
+    int seq_fd;
+    Py_ssize_t seq_min_size;
+    /* Set by seek(): the next fill keeps the minimum size. */
+    int seq_seeked;
+
     PyObject *dict;
     PyObject *weakreflist;
 } buffered;
@@ -724,6 +742,8 @@ _bufferedreader_fill_buffer(buffered *self);
 static void
 _bufferedreader_reset_buf(buffered *self);
 static void
+_bufferedreader_resize_buffer(buffered *self, Py_ssize_t size);
+static void
 _bufferedwriter_reset_buf(buffered *self);
 static PyObject *
 _bufferedreader_peek_unlocked(buffered *self);
@@ -1431,8 +1451,13 @@ _io__Buffered_seek_impl(buffered *self, PyObject *targetobj, int whence)
         goto end;
     self->raw_pos = -1;
     res = PyLong_FromOff_t(n);
-    if (res != NULL && self->readable)
+    if (res != NULL && self->readable) {
         _bufferedreader_reset_buf(self);
+        if (self->sequential) {
+            _bufferedreader_resize_buffer(self, self->seq_min_size);
+            self->seq_seeked = 1;
+        }
+    }
 
 end:
     LEAVE_BUFFERED(self)
@@ -1566,14 +1591,19 @@ static void _bufferedreader_reset_buf(buffered *self)
 _io.BufferedReader.__init__
     raw: object
     buffer_size: Py_ssize_t(c_default="DEFAULT_BUFFER_SIZE") = DEFAULT_BUFFER_SIZE
+    *
+    sequential: bool = False
 
 Create a new buffered reader using the given readable raw IO object.
+
+If sequential is true, the buffer grows while the stream is read
+sequentially, and the operating system is asked to read ahead.
 [clinic start generated code]*/
 
 static int
 _io_BufferedReader___init___impl(buffered *self, PyObject *raw,
-                                 Py_ssize_t buffer_size)
-/*[clinic end generated code: output=cddcfefa0ed294c4 input=fb887e06f11b4e48]*/
+                                 Py_ssize_t buffer_size, int sequential)
+/*[clinic end generated code: output=29025f52ca35f1f8 input=6c75b05a840fa100]*/
 {
     self->ok = 0;
     self->detached = 0;
@@ -1597,10 +1627,78 @@ _io_BufferedReader___init___impl(buffered *self, PyObject *raw,
         Py_IS_TYPE(raw, state->PyFileIO_Type)
     );
 
+    self->sequential = sequential;
+    self->seq_fd = -1;
+    self->seq_min_size = buffer_size;
+    self->seq_seeked = 0;
+    if (sequential) {
+        /* Read-ahead hints are only an optimization: the raw stream may
+           not have a file descriptor at all. */
+        self->seq_fd = PyObject_AsFileDescriptor(raw);
+        if (self->seq_fd < 0) {
+            PyErr_Clear();
+        }
+#if defined(HAVE_POSIX_FADVISE) && defined(POSIX_FADV_SEQUENTIAL)
+        else {
+            (void)posix_fadvise(self->seq_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        }
+#endif
+    }
+
     self->ok = 1;
     return 0;
 }
 
+/* Resize the buffer of a sequential reader.  The buffer must be empty:
+   it only shrinks in seek(), never while a read is in progress. */
+static void
+_bufferedreader_resize_buffer(buffered *self, Py_ssize_t size)
+{
+    char *buffer;
+
+    if (size == self->buffer_size) {
+        return;
+    }
+    buffer = PyMem_Realloc(self->buffer, size);
+    if (buffer == NULL) {
+        /* Not fatal: keep the current buffer. */
+        return;
+    }
+    self->buffer = buffer;
+    self->buffer_size = size;
+    self->buffer_mask = (size & (size - 1)) == 0 ? size - 1 : 0;
+}
+
+/* Called before a buffer fill which starts with an empty buffer, in
+   sequential mode: the buffer doubles, except for the first fill after
+   a seek. */
+static void
+_bufferedreader_grow_buffer(buffered *self)
+{
+    if (self->seq_seeked) {
+        self->seq_seeked = 0;
+    }
+    else if (self->buffer_size < SEQUENTIAL_MAX_BUFFER_SIZE) {
+        _bufferedreader_resize_buffer(
+            self, Py_MIN(self->buffer_size * 2, SEQUENTIAL_MAX_BUFFER_SIZE));
+    }
+}
+
+/* Called after a buffer fill in sequential mode: ask the kernel to start
+   reading the next chunk in the background. */
+static void
+_bufferedreader_read_ahead(buffered *self)
+{
+#if defined(HAVE_POSIX_FADVISE) && defined(POSIX_FADV_WILLNEED)
+    if (self->seq_fd >= 0 && self->abs_pos != -1) {
+        Py_BEGIN_ALLOW_THREADS
+        (void)posix_fadvise(self->seq_fd, self->abs_pos, self->buffer_size,
+                            POSIX_FADV_WILLNEED);
+        Py_END_ALLOW_THREADS
+    }
+#endif
+}
+
 static Py_ssize_t
 _bufferedreader_raw_read(buffered *self, char *start, Py_ssize_t len)
 {
@@ -1659,12 +1757,16 @@ _bufferedreader_fill_buffer(buffered *self)
         start = Py_SAFE_DOWNCAST(self->read_end, Py_off_t, Py_ssize_t);
     else
         start = 0;
+    if (self->sequential && start == 0)
+        _bufferedreader_grow_buffer(self);
     len = self->buffer_size - start;
     n = _bufferedreader_raw_read(self, self->buffer + start, len);
     if (n <= 0)
         return n;
     self->read_end = start + n;
     self->raw_pos = start + n;
+    if (self->sequential)
+        _bufferedreader_read_ahead(self);
     return n;
 }
 
@@ -2062,6 +2164,54 @@ _bufferedwriter_flush_unlocked(buffered *self)
     return NULL;
 }
 
+#ifdef HAVE_WRITEV
+/* Write the buffered data followed by a large write with a single writev()
+   call, instead of flushing the buffer first.  Only done when the raw
+   stream is a FileIO and the logical position is at the end of the
+   buffered data.  Returns the number of bytes of the new data written,
+   0 if the raw stream would block or if only part of the buffered data
+   was written (the regular path then carries on), or -1 on error. */
+static Py_ssize_t
+_bufferedwriter_raw_writev(buffered *self, Py_buffer *buffer)
+{
+    struct iovec iov[2];
+    Py_ssize_t pending, n;
+
+    if (!self->fast_closed_checks || self->readable
+        || !VALID_WRITE_BUFFER(self)
+        || self->write_pos == self->write_end
+        || self->pos != self->write_end
+        || self->raw_pos != self->write_pos
+        || buffer->len < self->buffer_size)
+    {
+        return 0;
+    }
+    pending = Py_SAFE_DOWNCAST(self->write_end - self->write_pos,
+                               Py_off_t, Py_ssize_t);
+    iov[0].iov_base = self->buffer + self->write_pos;
+    iov[0].iov_len = (size_t)pending;
+    iov[1].iov_base = buffer->buf;
+    iov[1].iov_len = (size_t)Py_MIN(buffer->len, PY_SSIZE_T_MAX - pending);
+    n = _PyFileIO_writev(self->raw, iov, 2);
+    if (n == -1) {
+        return -1;
+    }
+    if (n == -2) {
+        return 0;
+    }
+    if (self->abs_pos != -1) {
+        self->abs_pos += n;
+    }
+    if (n < pending) {
+        self->write_pos += n;
+        self->raw_pos = self->write_pos;
+        return 0;
+    }
+    _bufferedwriter_reset_buf(self);
+    return n - pending;
+}
+#endif
+
 /*[clinic input]
 @critical_section
 _io.BufferedWriter.write
@@ -2074,7 +2224,7 @@ _io_BufferedWriter_write_impl(buffered *self, Py_buffer *buffer)
 /*[clinic end generated code: output=7f8d1365759bfc6b input=6a9c041de0c337be]*/
 {
     PyObject *res = NULL;
-    Py_ssize_t written, avail, remaining;
+    Py_ssize_t written, avail, remaining, gathered = 0;
     Py_off_t offset;
 
     CHECK_INITIALIZED(self)
@@ -2107,6 +2257,12 @@ _io_BufferedWriter_write_impl(buffered *self, Py_buffer *buffer)
         goto end;
     }
 
+#ifdef HAVE_WRITEV
+    gathered = _bufferedwriter_raw_writev(self, buffer);
+    if (gathered < 0)
+        goto error;
+#endif
+
     /* First write the current buffer */
     res = _bufferedwriter_flush_unlocked(self);
     if (res == NULL) {
@@ -2162,8 +2318,8 @@ _io_BufferedWriter_write_impl(buffered *self, Py_buffer *buffer)
     }
 
     /* Then write buf itself. At this point the buffer has been emptied. */
-    remaining = buffer->len;
-    written = 0;
+    remaining = buffer->len - gathered;
+    written = gathered;
     while (remaining >= self->buffer_size) {
         Py_ssize_t n = _bufferedwriter_raw_write(
             self, (char *) buffer->buf + written, buffer->len - written);
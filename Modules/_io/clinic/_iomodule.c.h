@@ -10,7 +10,8 @@ preserve
 
 PyDoc_STRVAR(_io_open__doc__,
 "open($module, /, file, mode=\'r\', buffering=-1, encoding=None,\n"
-"     errors=None, newline=None, closefd=True, opener=None)\n"
+"     errors=None, newline=None, closefd=True, opener=None, *,\n"
+"     sequential=False, mmap=False)\n"
 "--\n"
 "\n"
 "Open file and return a stream.  Raise OSError upon failure.\n"
@@ -113,6 +114,15 @@ PyDoc_STRVAR(_io_open__doc__,
 "file descriptor (passing os.open as *opener* results in functionality\n"
 "similar to passing None).\n"
 "\n"
+"If sequential is true, the file is expected to be read from start to\n"
+"end, for example a large file being scanned: the buffer grows while the\n"
+"file is read sequentially, and the operating system is asked to read\n"
+"ahead.  It is only supported by buffered files opened for reading only.\n"
+"\n"
+"If mmap is true, the file is memory mapped and a FileIO object serving\n"
+"reads from the mapping is returned instead of a buffered file.  It is\n"
+"only supported in binary mode for reading only.\n"
+"\n"
 "open() returns a file object whose type depends on the mode, and\n"
 "through which the standard file operations such as reading and writing\n"
 "are performed. When open() is used to open a file in a text mode (\'w\',\n"
@@ -133,7 +143,8 @@ PyDoc_STRVAR(_io_open__doc__,
 static PyObject *
 _io_open_impl(PyObject *module, PyObject *file, const char *mode,
               int buffering, const char *encoding, const char *errors,
-              const char *newline, int closefd, PyObject *opener);
+              const char *newline, int closefd, PyObject *opener,
+              int sequential, int use_mmap);
 
 static PyObject *
 _io_open(PyObject *module, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
@@ -141,14 +152,14 @@ _io_open(PyObject *module, PyObject *const *args, Py_ssize_t nargs, PyObject *kw
     PyObject *return_value = NULL;
     #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
 
-    #define NUM_KEYWORDS 8
+    #define NUM_KEYWORDS 10
     static struct {
         PyGC_Head _this_is_not_used;
         PyObject_VAR_HEAD
         PyObject *ob_item[NUM_KEYWORDS];
     } _kwtuple = {
         .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
-        .ob_item = { &_Py_ID(file), &_Py_ID(mode), &_Py_ID(buffering), &_Py_ID(encoding), &_Py_ID(errors), &_Py_ID(newline), &_Py_ID(closefd), &_Py_ID(opener), },
+        .ob_item = { &_Py_ID(file), &_Py_ID(mode), &_Py_ID(buffering), &_Py_ID(encoding), &_Py_ID(errors), &_Py_ID(newline), &_Py_ID(closefd), &_Py_ID(opener), &_Py_ID(sequential), &_Py_ID(mmap), },
     };
     #undef NUM_KEYWORDS
     #define KWTUPLE (&_kwtuple.ob_base.ob_base)
@@ -157,14 +168,14 @@ _io_open(PyObject *module, PyObject *const *args, Py_ssize_t nargs, PyObject *kw
     #  define KWTUPLE NULL
     #endif  // !Py_BUILD_CORE
 
-    static const char * const _keywords[] = {"file", "mode", "buffering", "encoding", "errors", "newline", "closefd", "opener", NULL};
+    static const char * const _keywords[] = {"file", "mode", "buffering", "encoding", "errors", "newline", "closefd", "opener", "sequential", "mmap", NULL};
     static _PyArg_Parser _parser = {
         .keywords = _keywords,
         .fname = "open",
         .kwtuple = KWTUPLE,
     };
     #undef KWTUPLE
-    PyObject *argsbuf[8];
+    PyObject *argsbuf[10];
     Py_ssize_t noptargs = nargs + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 1;
     PyObject *file;
     const char *mode = "r";
@@ -174,6 +185,8 @@ _io_open(PyObject *module, PyObject *const *args, Py_ssize_t nargs, PyObject *kw
     const char *newline = NULL;
     int closefd = 1;
     PyObject *opener = Py_None;
+    int sequential = 0;
+    int use_mmap = 0;
 
     args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser,
             /*minpos*/ 1, /*maxpos*/ 8, /*minkw*/ 0, /*varpos*/ 0, argsbuf);
@@ -289,9 +302,31 @@ _io_open(PyObject *module, PyObject *const *args, Py_ssize_t nargs, PyObject *kw
             goto skip_optional_pos;
         }
     }
-    opener = args[7];
+    if (args[7]) {
+        opener = args[7];
+        if (!--noptargs) {
+            goto skip_optional_pos;
+        }
+    }
 skip_optional_pos:
-    return_value = _io_open_impl(module, file, mode, buffering, encoding, errors, newline, closefd, opener);
+    if (!noptargs) {
+        goto skip_optional_kwonly;
+    }
+    if (args[8]) {
+        sequential = PyObject_IsTrue(args[8]);
+        if (sequential < 0) {
+            goto exit;
+        }
+        if (!--noptargs) {
+            goto skip_optional_kwonly;
+        }
+    }
+    use_mmap = PyObject_IsTrue(args[9]);
+    if (use_mmap < 0) {
+        goto exit;
+    }
+skip_optional_kwonly:
+    return_value = _io_open_impl(module, file, mode, buffering, encoding, errors, newline, closefd, opener, sequential, use_mmap);
 
 exit:
     return return_value;
@@ -406,4 +441,4 @@ _io_open_code(PyObject *module, PyObject *const *args, Py_ssize_t nargs, PyObjec
 exit:
     return return_value;
 }
-/*[clinic end generated code: output=ec1df2ff5265ab16 input=a9049054013a1b77]*/
+/*[clinic end generated code: output=c4fe92db66dd7da6 input=a9049054013a1b77]*/
@@ -926,14 +926,18 @@ exit:
 }
 
 PyDoc_STRVAR(_io_BufferedReader___init____doc__,
-"BufferedReader(raw, buffer_size=DEFAULT_BUFFER_SIZE)\n"
+"BufferedReader(raw, buffer_size=DEFAULT_BUFFER_SIZE, *,\n"
+"               sequential=False)\n"
 "--\n"
 "\n"
-"Create a new buffered reader using the given readable raw IO object.");
+"Create a new buffered reader using the given readable raw IO object.\n"
+"\n"
+"If sequential is true, the buffer grows while the stream is read\n"
+"sequentially, and the operating system is asked to read ahead.");
 
 static int
 _io_BufferedReader___init___impl(buffered *self, PyObject *raw,
-                                 Py_ssize_t buffer_size);
+                                 Py_ssize_t buffer_size, int sequential);
 
 static int
 _io_BufferedReader___init__(PyObject *self, PyObject *args, PyObject *kwargs)
@@ -941,14 +945,14 @@ _io_BufferedReader___init__(PyObject *self, PyObject *args, PyObject *kwargs)
     int return_value = -1;
     #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
 
-    #define NUM_KEYWORDS 2
+    #define NUM_KEYWORDS 3
     static struct {
         PyGC_Head _this_is_not_used;
         PyObject_VAR_HEAD
         PyObject *ob_item[NUM_KEYWORDS];
     } _kwtuple = {
         .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
-        .ob_item = { &_Py_ID(raw), &_Py_ID(buffer_size), },
+        .ob_item = { &_Py_ID(raw), &_Py_ID(buffer_size), &_Py_ID(sequential), },
     };
     #undef NUM_KEYWORDS
     #define KWTUPLE (&_kwtuple.ob_base.ob_base)
@@ -957,19 +961,20 @@ _io_BufferedReader___init__(PyObject *self, PyObject *args, PyObject *kwargs)
     #  define KWTUPLE NULL
     #endif  // !Py_BUILD_CORE
 
-    static const char * const _keywords[] = {"raw", "buffer_size", NULL};
+    static const char * const _keywords[] = {"raw", "buffer_size", "sequential", NULL};
     static _PyArg_Parser _parser = {
         .keywords = _keywords,
         .fname = "BufferedReader",
         .kwtuple = KWTUPLE,
     };
     #undef KWTUPLE
-    PyObject *argsbuf[2];
+    PyObject *argsbuf[3];
     PyObject * const *fastargs;
     Py_ssize_t nargs = PyTuple_GET_SIZE(args);
     Py_ssize_t noptargs = nargs + (kwargs ? PyDict_GET_SIZE(kwargs) : 0) - 1;
     PyObject *raw;
     Py_ssize_t buffer_size = DEFAULT_BUFFER_SIZE;
+    int sequential = 0;
 
     fastargs = _PyArg_UnpackKeywords(_PyTuple_CAST(args)->ob_item, nargs, kwargs, NULL, &_parser,
             /*minpos*/ 1, /*maxpos*/ 2, /*minkw*/ 0, /*varpos*/ 0, argsbuf);
@@ -980,20 +985,33 @@ _io_BufferedReader___init__(PyObject *self, PyObject *args, PyObject *kwargs)
     if (!noptargs) {
         goto skip_optional_pos;
     }
-    {
-        Py_ssize_t ival = -1;
-        PyObject *iobj = _PyNumber_Index(fastargs[1]);
-        if (iobj != NULL) {
-            ival = PyLong_AsSsize_t(iobj);
-            Py_DECREF(iobj);
+    if (fastargs[1]) {
+        {
+            Py_ssize_t ival = -1;
+            PyObject *iobj = _PyNumber_Index(fastargs[1]);
+            if (iobj != NULL) {
+                ival = PyLong_AsSsize_t(iobj);
+                Py_DECREF(iobj);
+            }
+            if (ival == -1 && PyErr_Occurred()) {
+                goto exit;
+            }
+            buffer_size = ival;
         }
-        if (ival == -1 && PyErr_Occurred()) {
-            goto exit;
+        if (!--noptargs) {
+            goto skip_optional_pos;
         }
-        buffer_size = ival;
     }
 skip_optional_pos:
-    return_value = _io_BufferedReader___init___impl((buffered *)self, raw, buffer_size);
+    if (!noptargs) {
+        goto skip_optional_kwonly;
+    }
+    sequential = PyObject_IsTrue(fastargs[2]);
+    if (sequential < 0) {
+        goto exit;
+    }
+skip_optional_kwonly:
+    return_value = _io_BufferedReader___init___impl((buffered *)self, raw, buffer_size, sequential);
 
 exit:
     return return_value;
@@ -1246,4 +1264,4 @@ skip_optional_pos:
 exit:
     return return_value;
 }
-/*[clinic end generated code: output=f019d29701ba2556 input=a9049054013a1b77]*/
+/*[clinic end generated code: output=6c431522a785809b input=a9049054013a1b77]*/
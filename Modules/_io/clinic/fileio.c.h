@@ -7,6 +7,7 @@ preserve
 #  include "pycore_runtime.h"     // _Py_ID()
 #endif
 #include "pycore_abstract.h"      // _Py_convert_optional_to_ssize_t()
+#include "pycore_critical_section.h"// Py_BEGIN_CRITICAL_SECTION()
 #include "pycore_modsupport.h"    // _PyArg_UnpackKeywords()
 
 PyDoc_STRVAR(_io_FileIO_close__doc__,
@@ -35,7 +36,8 @@ _io_FileIO_close(PyObject *self, PyTypeObject *cls, PyObject *const *args, Py_ss
 }
 
 PyDoc_STRVAR(_io_FileIO___init____doc__,
-"FileIO(file, mode=\'r\', closefd=True, opener=None)\n"
+"FileIO(file, mode=\'r\', closefd=True, opener=None, *, mmap=False,\n"
+"       sequential=False)\n"
 "--\n"
 "\n"
 "Open a file.\n"
@@ -50,11 +52,19 @@ PyDoc_STRVAR(_io_FileIO___init____doc__,
 "passing a callable as *opener*. The underlying file descriptor for the file\n"
 "object is then obtained by calling opener with (*name*, *flags*).\n"
 "*opener* must return an open file descriptor (passing os.open as *opener*\n"
-"results in functionality similar to passing None).");
+"results in functionality similar to passing None).\n"
+"\n"
+"If *mmap* is true, the file, which must be a regular file opened for\n"
+"reading only, is memory mapped: reads are served from the mapping without\n"
+"system calls and getbuffer() returns a view of the mapping.  If\n"
+"*sequential* is true, the operating system is told that the file will be\n"
+"read sequentially, otherwise a mapped file is expected to be read at\n"
+"random positions.");
 
 static int
 _io_FileIO___init___impl(fileio *self, PyObject *nameobj, const char *mode,
-                         int closefd, PyObject *opener);
+                         int closefd, PyObject *opener, int use_mmap,
+                         int sequential);
 
 static int
 _io_FileIO___init__(PyObject *self, PyObject *args, PyObject *kwargs)
@@ -62,14 +72,14 @@ _io_FileIO___init__(PyObject *self, PyObject *args, PyObject *kwargs)
     int return_value = -1;
     #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
 
-    #define NUM_KEYWORDS 4
+    #define NUM_KEYWORDS 6
     static struct {
         PyGC_Head _this_is_not_used;
         PyObject_VAR_HEAD
         PyObject *ob_item[NUM_KEYWORDS];
     } _kwtuple = {
         .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
-        .ob_item = { &_Py_ID(file), &_Py_ID(mode), &_Py_ID(closefd), &_Py_ID(opener), },
+        .ob_item = { &_Py_ID(file), &_Py_ID(mode), &_Py_ID(closefd), &_Py_ID(opener), &_Py_ID(mmap), &_Py_ID(sequential), },
     };
     #undef NUM_KEYWORDS
     #define KWTUPLE (&_kwtuple.ob_base.ob_base)
@@ -78,14 +88,14 @@ _io_FileIO___init__(PyObject *self, PyObject *args, PyObject *kwargs)
     #  define KWTUPLE NULL
     #endif  // !Py_BUILD_CORE
 
-    static const char * const _keywords[] = {"file", "mode", "closefd", "opener", NULL};
+    static const char * const _keywords[] = {"file", "mode", "closefd", "opener", "mmap", "sequential", NULL};
     static _PyArg_Parser _parser = {
         .keywords = _keywords,
         .fname = "FileIO",
         .kwtuple = KWTUPLE,
     };
     #undef KWTUPLE
-    PyObject *argsbuf[4];
+    PyObject *argsbuf[6];
     PyObject * const *fastargs;
     Py_ssize_t nargs = PyTuple_GET_SIZE(args);
     Py_ssize_t noptargs = nargs + (kwargs ? PyDict_GET_SIZE(kwargs) : 0) - 1;
@@ -93,6 +103,8 @@ _io_FileIO___init__(PyObject *self, PyObject *args, PyObject *kwargs)
     const char *mode = "r";
     int closefd = 1;
     PyObject *opener = Py_None;
+    int use_mmap = 0;
+    int sequential = 0;
 
     fastargs = _PyArg_UnpackKeywords(_PyTuple_CAST(args)->ob_item, nargs, kwargs, NULL, &_parser,
             /*minpos*/ 1, /*maxpos*/ 4, /*minkw*/ 0, /*varpos*/ 0, argsbuf);
@@ -130,9 +142,31 @@ _io_FileIO___init__(PyObject *self, PyObject *args, PyObject *kwargs)
             goto skip_optional_pos;
         }
     }
-    opener = fastargs[3];
+    if (fastargs[3]) {
+        opener = fastargs[3];
+        if (!--noptargs) {
+            goto skip_optional_pos;
+        }
+    }
 skip_optional_pos:
-    return_value = _io_FileIO___init___impl((fileio *)self, nameobj, mode, closefd, opener);
+    if (!noptargs) {
+        goto skip_optional_kwonly;
+    }
+    if (fastargs[4]) {
+        use_mmap = PyObject_IsTrue(fastargs[4]);
+        if (use_mmap < 0) {
+            goto exit;
+        }
+        if (!--noptargs) {
+            goto skip_optional_kwonly;
+        }
+    }
+    sequential = PyObject_IsTrue(fastargs[5]);
+    if (sequential < 0) {
+        goto exit;
+    }
+skip_optional_kwonly:
+    return_value = _io_FileIO___init___impl((fileio *)self, nameobj, mode, closefd, opener, use_mmap, sequential);
 
 exit:
     return return_value;
@@ -337,6 +371,90 @@ exit:
     return return_value;
 }
 
+PyDoc_STRVAR(_io_FileIO_readline__doc__,
+"readline($self, size=-1, /)\n"
+"--\n"
+"\n"
+"Read and return a line from the file.\n"
+"\n"
+"If size is specified, at most size bytes will be read.");
+
+#define _IO_FILEIO_READLINE_METHODDEF    \
+    {"readline", _PyCFunction_CAST(_io_FileIO_readline), METH_METHOD|METH_FASTCALL|METH_KEYWORDS, _io_FileIO_readline__doc__},
+
+static PyObject *
+_io_FileIO_readline_impl(fileio *self, PyTypeObject *cls, Py_ssize_t size);
+
+static PyObject *
+_io_FileIO_readline(PyObject *self, PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+    #  define KWTUPLE (PyObject *)&_Py_SINGLETON(tuple_empty)
+    #else
+    #  define KWTUPLE NULL
+    #endif
+
+    static const char * const _keywords[] = {"", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "readline",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[1];
+    Py_ssize_t size = -1;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser,
+            /*minpos*/ 0, /*maxpos*/ 1, /*minkw*/ 0, /*varpos*/ 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    if (nargs < 1) {
+        goto skip_optional_posonly;
+    }
+    if (!_Py_convert_optional_to_ssize_t(args[0], &size)) {
+        goto exit;
+    }
+skip_optional_posonly:
+    return_value = _io_FileIO_readline_impl((fileio *)self, cls, size);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_io_FileIO_getbuffer__doc__,
+"getbuffer($self, /)\n"
+"--\n"
+"\n"
+"Get a read-only view over the contents of a file opened in mmap mode.\n"
+"\n"
+"The data is not copied, and the view stays valid after the file is\n"
+"closed.");
+
+#define _IO_FILEIO_GETBUFFER_METHODDEF    \
+    {"getbuffer", _PyCFunction_CAST(_io_FileIO_getbuffer), METH_METHOD|METH_FASTCALL|METH_KEYWORDS, _io_FileIO_getbuffer__doc__},
+
+static PyObject *
+_io_FileIO_getbuffer_impl(fileio *self, PyTypeObject *cls);
+
+static PyObject *
+_io_FileIO_getbuffer(PyObject *self, PyTypeObject *cls, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+
+    if (nargs || (kwnames && PyTuple_GET_SIZE(kwnames))) {
+        PyErr_SetString(PyExc_TypeError, "getbuffer() takes no arguments");
+        goto exit;
+    }
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _io_FileIO_getbuffer_impl((fileio *)self, cls);
+    Py_END_CRITICAL_SECTION();
+
+exit:
+    return return_value;
+}
+
 PyDoc_STRVAR(_io_FileIO_write__doc__,
 "write($self, b, /)\n"
 "--\n"
@@ -533,4 +651,4 @@ _io_FileIO_isatty(PyObject *self, PyObject *Py_UNUSED(ignored))
 #ifndef _IO_FILEIO_TRUNCATE_METHODDEF
     #define _IO_FILEIO_TRUNCATE_METHODDEF
 #endif /* !defined(_IO_FILEIO_TRUNCATE_METHODDEF) */
-/*[clinic end generated code: output=dcbeb6a0b13e4b1f input=a9049054013a1b77]*/
+/*[clinic end generated code: output=20f6499c46bbd45d input=a9049054013a1b77]*/
@@ -18,6 +18,9 @@
 #ifdef HAVE_FCNTL_H
 #  include <fcntl.h>              // open()
 #endif
+#ifdef HAVE_SYS_MMAN_H
+#  include <sys/mman.h>           // madvise()
+#endif
 
 #include "_iomodule.h"
 
@@ -70,6 +73,8 @@ typedef struct {
     unsigned int appending : 1;
     signed int seekable : 2; /* -1 means unknown */
     unsigned int closefd : 1;
+    unsigned int mapped : 1;
+    unsigned int sequential : 1;
     char finalizing;
     /* Stat result which was grabbed at file open, useful for optimizing common
        File I/O patterns to be more efficient. This is only guidance / an
@@ -78,6 +83,13 @@ typedef struct {
        modified outside of the fileio object / Python (ex. gh-90102, GH-121941,
        gh-109523). */
     struct _Py_stat_struct *stat_atopen;
+    /* In mmap mode, reads are served from a read-only mmap.mmap object of
+       the whole file, remapped when its size changes.  The file position is
+       kept in map_pos instead of the file descriptor.  map is NULL while
+       the file is empty. */
+    PyObject *map;
+    Py_buffer map_view;
+    Py_off_t map_pos;
     PyObject *weakreflist;
     PyObject *dict;
 } fileio;
@@ -87,6 +99,7 @@ typedef struct {
 
 /* Forward declarations */
 static PyObject* portable_lseek(fileio *self, PyObject *posobj, int whence, bool suppress_pipe_error);
+static void fileio_unmap(fileio *self);
 
 int
 _PyFileIO_closed(PyObject *self)
@@ -121,6 +134,7 @@ internal_close(fileio *self)
 {
     int err = 0;
     int save_errno = 0;
+    fileio_unmap(self);
     if (self->fd >= 0) {
         int fd = self->fd;
         self->fd = -1;
@@ -165,6 +179,7 @@ _io_FileIO_close_impl(fileio *self, PyTypeObject *cls)
     res = PyObject_CallMethodOneArg((PyObject*)state->PyRawIOBase_Type,
                                      &_Py_ID(close), (PyObject *)self);
     if (!self->closefd) {
+        fileio_unmap(self);
         self->fd = -1;
         return res;
     }
@@ -210,10 +225,242 @@ fileio_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->seekable = -1;
     self->stat_atopen = NULL;
     self->closefd = 1;
+    self->mapped = 0;
+    self->sequential = 0;
+    self->map = NULL;
+    self->map_pos = 0;
     self->weakreflist = NULL;
     return (PyObject *) self;
 }
 
+/* Release the memory map of the file, if any.  Views returned by
+   getbuffer() keep their own reference to the mapping. */
+static void
+fileio_unmap(fileio *self)
+{
+    if (self->map != NULL) {
+        PyBuffer_Release(&self->map_view);
+        Py_CLEAR(self->map);
+    }
+}
+
+/* Map the whole file again if its size changed since it was last mapped.
+   Returns 0 on success, -1 with exception set on failure. */
+static int
+fileio_remap(fileio *self)
+{
+    struct _Py_stat_struct st;
+    PyObject *module, *args = NULL, *kwargs = NULL, *map = NULL;
+    Py_buffer view;
+    int res;
+
+    Py_BEGIN_ALLOW_THREADS
+    res = _Py_fstat_noraise(self->fd, &st);
+    Py_END_ALLOW_THREADS
+    if (res < 0) {
+#ifdef MS_WINDOWS
+        PyErr_SetFromWindowsErr(0);
+#else
+        PyErr_SetFromErrno(PyExc_OSError);
+#endif
+        return -1;
+    }
+    if (st.st_size == (self->map != NULL ? self->map_view.len : 0)) {
+        return 0;
+    }
+    if (st.st_size == 0) {
+        /* The file was truncated: an empty file cannot be mapped */
+        fileio_unmap(self);
+        return 0;
+    }
+
+    module = PyImport_ImportModule("mmap");
+    if (module == NULL) {
+        return -1;
+    }
+    PyObject *access = PyObject_GetAttrString(module, "ACCESS_READ");
+    if (access != NULL) {
+        args = Py_BuildValue("(ii)", self->fd, 0);
+#ifdef MS_WINDOWS
+        kwargs = Py_BuildValue("{sO}", "access", access);
+#else
+        /* Do not duplicate the file descriptor */
+        kwargs = Py_BuildValue("{sOsO}", "access", access,
+                               "trackfd", Py_False);
+#endif
+        Py_DECREF(access);
+    }
+    if (args != NULL && kwargs != NULL) {
+        PyObject *mmap_type = PyObject_GetAttrString(module, "mmap");
+        if (mmap_type != NULL) {
+            map = PyObject_Call(mmap_type, args, kwargs);
+            Py_DECREF(mmap_type);
+        }
+    }
+    Py_XDECREF(args);
+    Py_XDECREF(kwargs);
+    Py_DECREF(module);
+    if (map == NULL) {
+        return -1;
+    }
+    if (PyObject_GetBuffer(map, &view, PyBUF_SIMPLE) < 0) {
+        Py_DECREF(map);
+        return -1;
+    }
+
+#if defined(HAVE_MADVISE) && defined(MADV_RANDOM) && defined(MADV_SEQUENTIAL)
+    /* Page faults read ahead for sequential reads only */
+    Py_BEGIN_ALLOW_THREADS
+    (void)madvise(view.buf, view.len,
+                  self->sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+    Py_END_ALLOW_THREADS
+#endif
+
+    fileio_unmap(self);
+    self->map = map;
+    self->map_view = view;
+    return 0;
+}
+
+/* Switch a freshly opened file to mmap mode, starting from the current
+   position of the file descriptor. */
+static int
+fileio_mmap_init(fileio *self)
+{
+    Py_off_t pos;
+
+    if (self->stat_atopen == NULL || !S_ISREG(self->stat_atopen->st_mode)) {
+        _PyIO_State *state = find_io_state_by_def(Py_TYPE(self));
+        PyErr_SetString(state->unsupported_operation,
+                        "mmap mode requires a regular file");
+        return -1;
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    _Py_BEGIN_SUPPRESS_IPH
+#ifdef MS_WINDOWS
+    pos = _lseeki64(self->fd, 0L, SEEK_CUR);
+#else
+    pos = lseek(self->fd, 0L, SEEK_CUR);
+#endif
+    _Py_END_SUPPRESS_IPH
+    Py_END_ALLOW_THREADS
+    if (pos < 0) {
+        PyErr_SetFromErrno(PyExc_OSError);
+        return -1;
+    }
+
+    self->map_pos = pos;
+    self->seekable = 1;
+    if (fileio_remap(self) < 0) {
+        return -1;
+    }
+    self->mapped = 1;
+    return 0;
+}
+
+/* Return the number of bytes of the mapping after the file position, or -1
+   with exception set.  Touching the pages of the mapping past the end of
+   the file raises SIGBUS, so the size of the file is checked before each
+   read, and the file is remapped if another process truncated or extended
+   it. */
+static Py_ssize_t
+fileio_mapped_avail(fileio *self)
+{
+    if (fileio_remap(self) < 0) {
+        return -1;
+    }
+    Py_ssize_t len = (self->map != NULL) ? self->map_view.len : 0;
+    if (self->map_pos >= len) {
+        return 0;
+    }
+    return len - (Py_ssize_t)self->map_pos;
+}
+
+/* read(), readall() and readline() in mmap mode: read at most size bytes,
+   stopping after the first newline if stop_at_newline is true.  size is
+   negative to read up to the end of the file. */
+static PyObject *
+fileio_mapped_read(fileio *self, Py_ssize_t size, int stop_at_newline)
+{
+    const char *data;
+    Py_ssize_t n = fileio_mapped_avail(self);
+    if (n < 0) {
+        return NULL;
+    }
+    if (size >= 0 && size < n) {
+        n = size;
+    }
+    if (n == 0) {
+        return PyBytes_FromStringAndSize(NULL, 0);
+    }
+    data = (const char *)self->map_view.buf + self->map_pos;
+    if (stop_at_newline) {
+        const char *end = memchr(data, '\n', n);
+        if (end != NULL) {
+            n = end - data + 1;
+        }
+    }
+    self->map_pos += n;
+    return PyBytes_FromStringAndSize(data, n);
+}
+
+static PyObject *
+fileio_mapped_readinto(fileio *self, Py_buffer *buffer)
+{
+    Py_ssize_t n = fileio_mapped_avail(self);
+    if (n < 0) {
+        return NULL;
+    }
+    if (n > buffer->len) {
+        n = buffer->len;
+    }
+    if (n > 0) {
+        memcpy(buffer->buf, (const char *)self->map_view.buf + self->map_pos,
+               n);
+        self->map_pos += n;
+    }
+    return PyLong_FromSsize_t(n);
+}
+
+static PyObject *
+fileio_mapped_seek(fileio *self, PyObject *posobj, int whence)
+{
+    Py_off_t pos, base;
+
+    pos = PyLong_AsOff_t(posobj);
+    if (pos == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+    switch (whence) {
+    case 0:
+        base = 0;
+        break;
+    case 1:
+        base = self->map_pos;
+        break;
+    case 2:
+        if (fileio_remap(self) < 0) {
+            return NULL;
+        }
+        base = (self->map != NULL) ? self->map_view.len : 0;
+        break;
+    default:
+        base = -1;
+        break;
+    }
+    if (base < 0 || (pos < 0 && base + pos < 0)) {
+        errno = EINVAL;
+        return PyErr_SetFromErrno(PyExc_OSError);
+    }
+    if (pos > 0 && base > PY_OFF_T_MAX - pos) {
+        PyErr_SetString(PyExc_OverflowError, "seek position out of range");
+        return NULL;
+    }
+    self->map_pos = base + pos;
+    return PyLong_FromOff_t(self->map_pos);
+}
+
 #ifdef O_CLOEXEC
 extern int _Py_open_cloexec_works;
 #endif
@@ -224,6 +471,9 @@ _io.FileIO.__init__
     mode: str = "r"
     closefd: bool = True
     opener: object = None
+    *
+    mmap as use_mmap: bool = False
+    sequential: bool = False
 
 Open a file.
 
@@ -238,12 +488,20 @@ passing a callable as *opener*. The underlying file descriptor for the file
 object is then obtained by calling opener with (*name*, *flags*).
 *opener* must return an open file descriptor (passing os.open as *opener*
 results in functionality similar to passing None).
+
+If *mmap* is true, the file, which must be a regular file opened for
+reading only, is memory mapped: reads are served from the mapping without
+system calls and getbuffer() returns a view of the mapping.  If
+*sequential* is true, the operating system is told that the file will be
+read sequentially, otherwise a mapped file is expected to be read at
+random positions.
 [clinic start generated code]*/
 
 static int
 _io_FileIO___init___impl(fileio *self, PyObject *nameobj, const char *mode,
-                         int closefd, PyObject *opener)
-/*[clinic end generated code: output=23413f68e6484bbd input=588aac967e0ba74b]*/
+                         int closefd, PyObject *opener, int use_mmap,
+                         int sequential)
+/*[clinic end generated code: output=5fe661f52a501522 input=b15d947e41cdd0b0]*/
 {
 #ifdef MS_WINDOWS
     wchar_t *widename = NULL;
@@ -279,6 +537,9 @@ _io_FileIO___init___impl(fileio *self, PyObject *nameobj, const char *mode,
         else
             self->fd = -1;
     }
+    fileio_unmap(self);
+    self->mapped = 0;
+    self->sequential = sequential ? 1 : 0;
 
     if (PyBool_Check(nameobj)) {
         if (PyErr_WarnEx(PyExc_RuntimeWarning,
@@ -368,6 +629,12 @@ _io_FileIO___init___impl(fileio *self, PyObject *nameobj, const char *mode,
     if (!rwa)
         goto bad_mode;
 
+    if (use_mmap && (!self->readable || self->writable)) {
+        PyErr_SetString(PyExc_ValueError,
+                        "mmap mode is only supported for reading");
+        goto error;
+    }
+
     if (self->readable && self->writable)
         flags |= O_RDWR;
     else if (self->readable)
@@ -517,6 +784,18 @@ _io_FileIO___init___impl(fileio *self, PyObject *nameobj, const char *mode,
         Py_DECREF(pos);
     }
 
+    if (use_mmap) {
+        if (fileio_mmap_init(self) < 0)
+            goto error;
+    }
+#if defined(HAVE_POSIX_FADVISE) && defined(POSIX_FADV_SEQUENTIAL)
+    else if (sequential) {
+        Py_BEGIN_ALLOW_THREADS
+        (void)posix_fadvise(self->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        Py_END_ALLOW_THREADS
+    }
+#endif
+
     goto done;
 
  error:
@@ -545,6 +824,7 @@ fileio_traverse(PyObject *op, visitproc visit, void *arg)
     fileio *self = PyFileIO_CAST(op);
     Py_VISIT(Py_TYPE(self));
     Py_VISIT(self->dict);
+    Py_VISIT(self->map);
     return 0;
 }
 
@@ -553,6 +833,7 @@ fileio_clear(PyObject *op)
 {
     fileio *self = PyFileIO_CAST(op);
     Py_CLEAR(self->dict);
+    fileio_unmap(self);
     return 0;
 }
 
@@ -688,6 +969,14 @@ _io_FileIO_readinto_impl(fileio *self, PyTypeObject *cls, Py_buffer *buffer)
         return err_mode(state, "reading");
     }
 
+    if (self->mapped) {
+        PyObject *res;
+        Py_BEGIN_CRITICAL_SECTION(self);
+        res = fileio_mapped_readinto(self, buffer);
+        Py_END_CRITICAL_SECTION();
+        return res;
+    }
+
     n = _Py_read(self->fd, buffer->buf, buffer->len);
     /* copy errno because PyBuffer_Release() can indirectly modify it */
     err = errno;
@@ -745,6 +1034,13 @@ _io_FileIO_readall_impl(fileio *self)
         return err_closed();
     }
 
+    if (self->mapped) {
+        Py_BEGIN_CRITICAL_SECTION(self);
+        result = fileio_mapped_read(self, -1, 0);
+        Py_END_CRITICAL_SECTION();
+        return result;
+    }
+
     if (self->stat_atopen != NULL && self->stat_atopen->st_size < _PY_READ_MAX) {
         end = (Py_off_t)self->stat_atopen->st_size;
     }
@@ -871,6 +1167,13 @@ _io_FileIO_read_impl(fileio *self, PyTypeObject *cls, Py_ssize_t size)
     if (size < 0)
         return _io_FileIO_readall_impl(self);
 
+    if (self->mapped) {
+        Py_BEGIN_CRITICAL_SECTION(self);
+        bytes = fileio_mapped_read(self, size, 0);
+        Py_END_CRITICAL_SECTION();
+        return bytes;
+    }
+
     if (size > _PY_READ_MAX) {
         size = _PY_READ_MAX;
     }
@@ -902,6 +1205,75 @@ _io_FileIO_read_impl(fileio *self, PyTypeObject *cls, Py_ssize_t size)
     return (PyObject *) bytes;
 }
 
+/*[clinic input]
+_io.FileIO.readline
+    cls: defining_class
+    size: Py_ssize_t(accept={int, NoneType}) = -1
+    /
+
+Read and return a line from the file.
+
+If size is specified, at most size bytes will be read.
+[clinic start generated code]*/
+
+static PyObject *
+_io_FileIO_readline_impl(fileio *self, PyTypeObject *cls, Py_ssize_t size)
+/*[clinic end generated code: output=177f1fba4cbf9547 input=4f514eb7275e3d9c]*/
+{
+    PyObject *res;
+
+    if (!self->mapped) {
+        _PyIO_State *state = get_io_state_by_cls(cls);
+        PyObject *sizeobj = PyLong_FromSsize_t(size);
+        if (sizeobj == NULL)
+            return NULL;
+        res = PyObject_CallMethodObjArgs((PyObject *)state->PyRawIOBase_Type,
+                                         &_Py_ID(readline), self, sizeobj,
+                                         NULL);
+        Py_DECREF(sizeobj);
+        return res;
+    }
+    if (self->fd < 0)
+        return err_closed();
+
+    Py_BEGIN_CRITICAL_SECTION(self);
+    res = fileio_mapped_read(self, size, 1);
+    Py_END_CRITICAL_SECTION();
+    return res;
+}
+
+/*[clinic input]
+@critical_section
+_io.FileIO.getbuffer
+    cls: defining_class
+    /
+
+Get a read-only view over the contents of a file opened in mmap mode.
+
+The data is not copied, and the view stays valid after the file is
+closed.
+[clinic start generated code]*/
+
+static PyObject *
+_io_FileIO_getbuffer_impl(fileio *self, PyTypeObject *cls)
+/*[clinic end generated code: output=7013596c4e8e8f89 input=59e1c2d82e7c98b9]*/
+{
+    if (self->fd < 0)
+        return err_closed();
+    if (!self->mapped) {
+        _PyIO_State *state = get_io_state_by_cls(cls);
+        PyErr_SetString(state->unsupported_operation,
+                        "File not open in mmap mode");
+        return NULL;
+    }
+
+    if (fileio_remap(self) < 0)
+        return NULL;
+    if (self->map == NULL)
+        return PyMemoryView_FromMemory((char *)"", 0, PyBUF_READ);
+    return PyMemoryView_FromObject(self->map);
+}
+
 /*[clinic input]
 _io.FileIO.write
     cls: defining_class
@@ -944,6 +1316,46 @@ _io_FileIO_write_impl(fileio *self, PyTypeObject *cls, Py_buffer *b)
     return PyLong_FromSsize_t(n);
 }
 
+#ifdef HAVE_WRITEV
+Py_ssize_t
+_PyFileIO_writev(PyObject *op, struct iovec *iov, int iovcnt)
+{
+    fileio *self = PyFileIO_CAST(op);
+    Py_ssize_t n;
+    int err, async_err = 0;
+
+    if (self->fd < 0) {
+        err_closed();
+        return -1;
+    }
+    if (!self->writable) {
+        err_mode(find_io_state_by_def(Py_TYPE(self)), "writing");
+        return -1;
+    }
+
+    do {
+        Py_BEGIN_ALLOW_THREADS
+        n = writev(self->fd, iov, iovcnt);
+        /* save errno because PyErr_CheckSignals() can modify it */
+        err = errno;
+        Py_END_ALLOW_THREADS
+    } while (n < 0 && err == EINTR && !(async_err = PyErr_CheckSignals()));
+
+    if (n < 0) {
+        if (async_err) {
+            return -1;
+        }
+        if (err == EAGAIN) {
+            return -2;
+        }
+        errno = err;
+        PyErr_SetFromErrno(PyExc_OSError);
+        return -1;
+    }
+    return n;
+}
+#endif
+
 /* XXX Windows support below is likely incomplete */
 
 /* Cribbed from posix_lseek() */
@@ -1034,6 +1446,14 @@ _io_FileIO_seek_impl(fileio *self, PyObject *pos, int whence)
     if (self->fd < 0)
         return err_closed();
 
+    if (self->mapped) {
+        PyObject *res;
+        Py_BEGIN_CRITICAL_SECTION(self);
+        res = fileio_mapped_seek(self, pos, whence);
+        Py_END_CRITICAL_SECTION();
+        return res;
+    }
+
     return portable_lseek(self, pos, whence, false);
 }
 
@@ -1052,6 +1472,14 @@ _io_FileIO_tell_impl(fileio *self)
     if (self->fd < 0)
         return err_closed();
 
+    if (self->mapped) {
+        PyObject *res;
+        Py_BEGIN_CRITICAL_SECTION(self);
+        res = PyLong_FromOff_t(self->map_pos);
+        Py_END_CRITICAL_SECTION();
+        return res;
+    }
+
     return portable_lseek(self, NULL, 1, false);
 }
 
@@ -1242,6 +1670,8 @@ static PyMethodDef fileio_methods[] = {
     _IO_FILEIO_READ_METHODDEF
     _IO_FILEIO_READALL_METHODDEF
     _IO_FILEIO_READINTO_METHODDEF
+    _IO_FILEIO_READLINE_METHODDEF
+    _IO_FILEIO_GETBUFFER_METHODDEF
     _IO_FILEIO_WRITE_METHODDEF
     _IO_FILEIO_SEEK_METHODDEF
     _IO_FILEIO_TELL_METHODDEF
@@ -212,6 +212,61 @@ PyType_Spec textiobase_spec = {
     .slots = textiobase_slots,
 };
 
+/* Newline search */
+
+/* A word holds SIZEOF_SIZE_T / kind characters.  (v - ones) & ~v & highs
+   is non-zero if and only if one of the characters of v is zero, so a word
+   XORed with a word filled with ch can be tested for ch at once; only the
+   word containing a match is then examined character by character. */
+static inline size_t
+word_lane_ones(int kind)
+{
+    switch (kind) {
+    case PyUnicode_1BYTE_KIND:
+        return (size_t)-1 / 0xFFU;
+    case PyUnicode_2BYTE_KIND:
+        return (size_t)-1 / 0xFFFFU;
+    default:
+        return (size_t)-1 / 0xFFFFFFFFU;
+    }
+}
+
+/* Return a pointer to the first character of [s, end) equal to ch1 or ch2,
+   or NULL if there is none. */
+static const char *
+find_control_chars(int kind, const char *s, const char *end,
+                   Py_UCS4 ch1, Py_UCS4 ch2)
+{
+    Py_UCS4 ch;
+
+    while (s < end && !_Py_IS_ALIGNED(s, ALIGNOF_SIZE_T)) {
+        ch = PyUnicode_READ(kind, s, 0);
+        if (ch == ch1 || ch == ch2)
+            return s;
+        s += kind;
+    }
+    if (end - s >= SIZEOF_SIZE_T) {
+        const size_t ones = word_lane_ones(kind);
+        const size_t highs = ones << (8 * kind - 1);
+        const size_t mask1 = ones * ch1;
+        const size_t mask2 = ones * ch2;
+        do {
+            size_t v = *(const size_t *) s;
+            size_t v1 = v ^ mask1;
+            size_t v2 = v ^ mask2;
+            if (((v1 - ones) & ~v1 & highs) | ((v2 - ones) & ~v2 & highs))
+                break;
+            s += SIZEOF_SIZE_T;
+        } while (end - s >= SIZEOF_SIZE_T);
+    }
+    for (; s < end; s += kind) {
+        ch = PyUnicode_READ(kind, s, 0);
+        if (ch == ch1 || ch == ch2)
+            return s;
+    }
+    return NULL;
+}
+
 /* IncrementalNewlineDecoder */
 
 struct nldecoder_object {
@@ -430,80 +485,67 @@ _PyIncrementalNewlineDecoder_decode(PyObject *myself,
                need translating */
         }
         else if (!self->translate) {
-            Py_ssize_t i = 0;
-            /* We have already seen all newline types, no need to scan again */
-            if (seennl == SEEN_ALL)
-                goto endscan;
-            for (;;) {
-                Py_UCS4 c;
-                /* Fast loop for non-control characters */
-                while (PyUnicode_READ(kind, in_str, i) > '\r')
-                    i++;
-                c = PyUnicode_READ(kind, in_str, i++);
-                if (c == '\n')
+            const char *s = in_str;
+            const char *end = s + kind * len;
+            /* Stop as soon as all newline types have been seen */
+            while (seennl != SEEN_ALL) {
+                s = find_control_chars(kind, s, end, '\r', '\n');
+                if (s == NULL)
+                    break;
+                if (PyUnicode_READ(kind, s, 0) == '\n')
                     seennl |= SEEN_LF;
-                else if (c == '\r') {
-                    if (PyUnicode_READ(kind, in_str, i) == '\n') {
-                        seennl |= SEEN_CRLF;
-                        i++;
-                    }
-                    else
-                        seennl |= SEEN_CR;
+                else if (s + kind < end && PyUnicode_READ(kind, s, 1) == '\n') {
+                    seennl |= SEEN_CRLF;
+                    s += kind;
                 }
-                if (i >= len)
-                    break;
-                if (seennl == SEEN_ALL)
-                    break;
+                else
+                    seennl |= SEEN_CR;
+                s += kind;
             }
-        endscan:
-            ;
         }
         else {
-            void *translated;
-            int kind = PyUnicode_KIND(output);
-            const void *in_str = PyUnicode_DATA(output);
-            Py_ssize_t in, out;
-            /* XXX: Previous in-place translation here is disabled as
-               resizing is not possible anymore */
+            PyObject *translated;
+            const char *in = in_str;
+            const char *end = in + kind * len;
+            char *out;
             /* We could try to optimize this so that we only do a copy
                when there is something to translate. On the other hand,
                we already know there is a \r byte, so chances are high
-               that something needs to be done. */
-            translated = PyMem_Malloc(kind * len);
-            if (translated == NULL) {
-                PyErr_NoMemory();
+               that something needs to be done.  Only \r and \r\n are
+               removed, so the maximum character is unchanged. */
+            translated = PyUnicode_New(len, PyUnicode_MAX_CHAR_VALUE(output));
+            if (translated == NULL)
                 goto error;
-            }
-            in = out = 0;
+            out = PyUnicode_DATA(translated);
             for (;;) {
-                Py_UCS4 c;
-                /* Fast loop for non-control characters */
-                while ((c = PyUnicode_READ(kind, in_str, in++)) > '\r')
-                    PyUnicode_WRITE(kind, translated, out++, c);
-                if (c == '\n') {
-                    PyUnicode_WRITE(kind, translated, out++, c);
+                const char *pos = find_control_chars(kind, in, end,
+                                                     '\r', '\n');
+                const char *stop = (pos != NULL) ? pos : end;
+                /* Copy the run of characters up to the newline at once */
+                memcpy(out, in, stop - in);
+                out += stop - in;
+                if (pos == NULL)
+                    break;
+                in = pos + kind;
+                if (PyUnicode_READ(kind, pos, 0) == '\n')
                     seennl |= SEEN_LF;
-                    continue;
-                }
-                if (c == '\r') {
-                    if (PyUnicode_READ(kind, in_str, in) == '\n') {
-                        in++;
-                        seennl |= SEEN_CRLF;
-                    }
-                    else
-                        seennl |= SEEN_CR;
-                    PyUnicode_WRITE(kind, translated, out++, '\n');
-                    continue;
+                else if (in < end && PyUnicode_READ(kind, in, 0) == '\n') {
+                    seennl |= SEEN_CRLF;
+                    in += kind;
                 }
-                if (in > len)
-                    break;
-                PyUnicode_WRITE(kind, translated, out++, c);
+                else
+                    seennl |= SEEN_CR;
+                PyUnicode_WRITE(kind, out, 0, '\n');
+                out += kind;
             }
             Py_DECREF(output);
-            output = PyUnicode_FromKindAndData(kind, translated, out);
-            PyMem_Free(translated);
-            if (!output)
+            if (PyUnicode_Resize(&translated,
+                    (out - (char *)PyUnicode_DATA(translated)) / kind) < 0)
+            {
+                Py_DECREF(translated);
                 return NULL;
+            }
+            output = translated;
         }
         self->seennl |= seennl;
     }
@@ -2090,9 +2132,6 @@ _io_TextIOWrapper_read_impl(textio *self, Py_ssize_t n)
 }
 
 
-/* NOTE: `end` must point to the real end of the Py_UCS4 storage,
-   that is to the NUL character. Otherwise the function will produce
-   incorrect results. */
 static const char *
 find_control_char(int kind, const char *s, const char *end, Py_UCS4 ch)
 {
@@ -2100,17 +2139,12 @@ find_control_char(int kind, const char *s, const char *end, Py_UCS4 ch)
         assert(ch < 256);
         return (char *) memchr((const void *) s, (char) ch, end - s);
     }
-    for (;;) {
-        while (PyUnicode_READ(kind, s, 0) > ch)
-            s += kind;
-        if (PyUnicode_READ(kind, s, 0) == ch)
-            return s;
-        if (s == end)
-            return NULL;
-        s += kind;
-    }
+    return find_control_chars(kind, s, end, ch, ch);
 }
 
+/* NOTE: `end` must point to the real end of the string storage, that is
+   to the NUL character: in universal newlines mode, the character after a
+   \r found at end - 1 is read to look for a \r\n. */
 Py_ssize_t
 _PyIO_find_line_ending(
     int translated, int universal, PyObject *readnl,
@@ -2132,28 +2166,16 @@ _PyIO_find_line_ending(
         /* Universal newline search. Find any of \r, \r\n, \n
          * The decoder ensures that \r\n are not split in two pieces
          */
-        const char *s = start;
-        for (;;) {
-            Py_UCS4 ch;
-            /* Fast path for non-control chars. The loop always ends
-               since the Unicode string is NUL-terminated. */
-            while (PyUnicode_READ(kind, s, 0) > '\r')
-                s += kind;
-            if (s >= end) {
-                *consumed = len;
-                return -1;
-            }
-            ch = PyUnicode_READ(kind, s, 0);
-            s += kind;
-            if (ch == '\n')
-                return (s - start)/kind;
-            if (ch == '\r') {
-                if (PyUnicode_READ(kind, s, 0) == '\n')
-                    return (s - start)/kind + 1;
-                else
-                    return (s - start)/kind;
-            }
+        const char *pos = find_control_chars(kind, start, end, '\r', '\n');
+        if (pos == NULL) {
+            *consumed = len;
+            return -1;
         }
+        /* A \r at the end is followed by the NUL character */
+        if (PyUnicode_READ(kind, pos, 0) == '\r'
+            && PyUnicode_READ(kind, pos, 1) == '\n')
+            return (pos - start)/kind + 2;
+        return (pos - start)/kind + 1;
     }
     else {
         /* Non-universal mode. */
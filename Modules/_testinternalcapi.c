@@ -20,11 +20,13 @@
 #include "pycore_dict.h"          // _PyManagedDictPointer_GetValues()
 #include "pycore_fileutils.h"     // _Py_normpath()
 #include "pycore_flowgraph.h"     // _PyCompile_OptimizeCfg()
+#include "pycore_freelist.h"      // _Py_freelists_GET()
 #include "pycore_frame.h"         // _PyInterpreterFrame
 #include "pycore_gc.h"            // PyGC_Head
 #include "pycore_hashtable.h"     // _Py_hashtable_new()
 #include "pycore_initconfig.h"    // _Py_GetConfigsAsDict()
 #include "pycore_instruction_sequence.h"  // _PyInstructionSequence_New()
+#include "pycore_long.h"          // _PyLong_MultiplyToom3()
 #include "pycore_object.h"        // _PyObject_IsFreed()
 #include "pycore_optimizer.h"     // JitOptSymbol, etc.
 #include "pycore_pathconfig.h"    // _PyPathConfig_ClearGlobal()
@@ -119,6 +121,115 @@ get_c_recursion_remaining(PyObject *self, PyObject *Py_UNUSED(args))
 }
 
 
+static int
+add_freelist_stats(PyObject *dict, const char *name,
+                   struct _Py_freelist *fl, Py_ssize_t maxsize)
+{
+    PyObject *stats = Py_BuildValue(
+        "{sn,sn,sn,sn}",
+        "size", fl->size,
+        "capacity", _PyFreeList_Capacity(fl, maxsize),
+        "hits", fl->hits,
+        "misses", fl->misses);
+    if (stats == NULL) {
+        return -1;
+    }
+    int res = PyDict_SetItemString(dict, name, stats);
+    Py_DECREF(stats);
+    return res;
+}
+
+static PyObject*
+get_freelist_stats(PyObject *self, PyObject *Py_UNUSED(args))
+{
+    struct _Py_freelists *freelists = _Py_freelists_GET();
+    PyObject *dict = PyDict_New();
+    if (dict == NULL) {
+        return NULL;
+    }
+
+#define ADD(NAME) \
+    do { \
+        if (add_freelist_stats(dict, #NAME, &freelists->NAME, \
+                               Py_ ## NAME ## _MAXFREELIST) < 0) { \
+            goto error; \
+        } \
+    } while (0)
+
+    ADD(floats);
+    ADD(ints);
+    ADD(lists);
+    ADD(list_iters);
+    ADD(tuple_iters);
+    ADD(dicts);
+    ADD(dictkeys);
+    ADD(slices);
+    ADD(contexts);
+    ADD(async_gens);
+    ADD(async_gen_asends);
+    ADD(futureiters);
+    ADD(object_stack_chunks);
+    ADD(unicode_writers);
+    ADD(pymethodobjects);
+    ADD(cells);
+    ADD(enumerates);
+    ADD(range_iters);
+#undef ADD
+
+    for (int i = 0; i < PyTuple_MAXSAVESIZE; i++) {
+        char name[32];
+        PyOS_snprintf(name, sizeof(name), "tuples[%d]", i);
+        if (add_freelist_stats(dict, name, &freelists->tuples[i],
+                               Py_tuple_MAXFREELIST) < 0) {
+            goto error;
+        }
+    }
+    for (int i = 0; i < PyGen_MAXSAVESLOTS; i++) {
+        char name[32];
+        PyOS_snprintf(name, sizeof(name), "gens[%d]", i);
+        if (add_freelist_stats(dict, name, &freelists->gens[i],
+                               Py_gens_MAXFREELIST) < 0) {
+            goto error;
+        }
+    }
+    return dict;
+
+error:
+    Py_DECREF(dict);
+    return NULL;
+}
+
+
+static PyObject*
+long_algorithm(PyObject *args,
+               PyObject *(*func)(PyLongObject *, PyLongObject *))
+{
+    PyObject *a, *b;
+    if (!PyArg_ParseTuple(args, "O!O!", &PyLong_Type, &a, &PyLong_Type, &b)) {
+        return NULL;
+    }
+    return func((PyLongObject *)a, (PyLongObject *)b);
+}
+
+static PyObject*
+long_mul_toom3(PyObject *self, PyObject *args)
+{
+    return long_algorithm(args, _PyLong_MultiplyToom3);
+}
+
+static PyObject*
+long_mul_ntt(PyObject *self, PyObject *args)
+{
+    return long_algorithm(args, _PyLong_MultiplyNTT);
+}
+
+static PyObject*
+long_divrem_bz(PyObject *self, PyObject *args)
+{
+    return long_algorithm(args, _PyLong_DivremBZ);
+}
+
+
 static PyObject*
 test_bswap(PyObject *self, PyObject *Py_UNUSED(args))
 {
@@ -1996,6 +2107,10 @@ static PyMethodDef module_functions[] = {
     {"get_configs", get_configs, METH_NOARGS},
     {"get_recursion_depth", get_recursion_depth, METH_NOARGS},
     {"get_c_recursion_remaining", get_c_recursion_remaining, METH_NOARGS},
+    {"get_freelist_stats", get_freelist_stats, METH_NOARGS},
+    {"long_mul_toom3", long_mul_toom3, METH_VARARGS},
+    {"long_mul_ntt", long_mul_ntt, METH_VARARGS},
+    {"long_divrem_bz", long_divrem_bz, METH_VARARGS},
     {"test_bswap", test_bswap, METH_NOARGS},
     {"test_popcount", test_popcount, METH_NOARGS},
     {"test_bit_length", test_bit_length, METH_NOARGS},
@@ -6,6 +6,7 @@ preserve
 #  include "pycore_gc.h"          // PyGC_Head
 #  include "pycore_runtime.h"     // _Py_ID()
 #endif
+#include "pycore_abstract.h"      // _PyNumber_Index()
 #include "pycore_critical_section.h"// Py_BEGIN_CRITICAL_SECTION()
 #include "pycore_modsupport.h"    // _PyArg_UnpackKeywords()
 
@@ -1497,6 +1498,802 @@ _asyncio_Task_set_name(TaskObj *self, PyObject *value)
     return return_value;
 }
 
+PyDoc_STRVAR(_asyncio_Handle___init____doc__,
+"Handle(callback, args, loop, context=None)\n"
+"--\n"
+"\n"
+"Object returned by callback registration methods.");
+
+static int
+_asyncio_Handle___init___impl(HandleObj *self, PyObject *callback,
+                              PyObject *args, PyObject *loop,
+                              PyObject *context);
+
+static int
+_asyncio_Handle___init__(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    int return_value = -1;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 4
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_item = { &_Py_ID(callback), &_Py_ID(args), &_Py_ID(loop), &_Py_ID(context), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"callback", "args", "loop", "context", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "Handle",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[4];
+    PyObject * const *fastargs;
+    Py_ssize_t nargs = PyTuple_GET_SIZE(args);
+    Py_ssize_t noptargs = nargs + (kwargs ? PyDict_GET_SIZE(kwargs) : 0) - 3;
+    PyObject *callback;
+    PyObject *__clinic_args;
+    PyObject *loop;
+    PyObject *context = Py_None;
+
+    fastargs = _PyArg_UnpackKeywords(_PyTuple_CAST(args)->ob_item, nargs, kwargs, NULL, &_parser,
+            /*minpos*/ 3, /*maxpos*/ 4, /*minkw*/ 0, /*varpos*/ 0, argsbuf);
+    if (!fastargs) {
+        goto exit;
+    }
+    callback = fastargs[0];
+    __clinic_args = fastargs[1];
+    loop = fastargs[2];
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    context = fastargs[3];
+skip_optional_pos:
+    return_value = _asyncio_Handle___init___impl((HandleObj *)self, callback, __clinic_args, loop, context);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_asyncio_Handle_get_context__doc__,
+"get_context($self, /)\n"
+"--\n"
+"\n");
+
+#define _ASYNCIO_HANDLE_GET_CONTEXT_METHODDEF    \
+    {"get_context", (PyCFunction)_asyncio_Handle_get_context, METH_NOARGS, _asyncio_Handle_get_context__doc__},
+
+static PyObject *
+_asyncio_Handle_get_context_impl(HandleObj *self);
+
+static PyObject *
+_asyncio_Handle_get_context(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return _asyncio_Handle_get_context_impl((HandleObj *)self);
+}
+
+PyDoc_STRVAR(_asyncio_Handle_cancel__doc__,
+"cancel($self, /)\n"
+"--\n"
+"\n");
+
+#define _ASYNCIO_HANDLE_CANCEL_METHODDEF    \
+    {"cancel", (PyCFunction)_asyncio_Handle_cancel, METH_NOARGS, _asyncio_Handle_cancel__doc__},
+
+static PyObject *
+_asyncio_Handle_cancel_impl(HandleObj *self);
+
+static PyObject *
+_asyncio_Handle_cancel(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _asyncio_Handle_cancel_impl((HandleObj *)self);
+    Py_END_CRITICAL_SECTION();
+
+    return return_value;
+}
+
+PyDoc_STRVAR(_asyncio_Handle_cancelled__doc__,
+"cancelled($self, /)\n"
+"--\n"
+"\n");
+
+#define _ASYNCIO_HANDLE_CANCELLED_METHODDEF    \
+    {"cancelled", (PyCFunction)_asyncio_Handle_cancelled, METH_NOARGS, _asyncio_Handle_cancelled__doc__},
+
+static PyObject *
+_asyncio_Handle_cancelled_impl(HandleObj *self);
+
+static PyObject *
+_asyncio_Handle_cancelled(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return _asyncio_Handle_cancelled_impl((HandleObj *)self);
+}
+
+PyDoc_STRVAR(_asyncio_Handle__run__doc__,
+"_run($self, /)\n"
+"--\n"
+"\n");
+
+#define _ASYNCIO_HANDLE__RUN_METHODDEF    \
+    {"_run", (PyCFunction)_asyncio_Handle__run, METH_NOARGS, _asyncio_Handle__run__doc__},
+
+static PyObject *
+_asyncio_Handle__run_impl(HandleObj *self);
+
+static PyObject *
+_asyncio_Handle__run(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return _asyncio_Handle__run_impl((HandleObj *)self);
+}
+
+PyDoc_STRVAR(_asyncio_Handle__repr_info__doc__,
+"_repr_info($self, /)\n"
+"--\n"
+"\n");
+
+#define _ASYNCIO_HANDLE__REPR_INFO_METHODDEF    \
+    {"_repr_info", (PyCFunction)_asyncio_Handle__repr_info, METH_NOARGS, _asyncio_Handle__repr_info__doc__},
+
+static PyObject *
+_asyncio_Handle__repr_info_impl(HandleObj *self);
+
+static PyObject *
+_asyncio_Handle__repr_info(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return _asyncio_Handle__repr_info_impl((HandleObj *)self);
+}
+
+PyDoc_STRVAR(_asyncio_TimerHandle___init____doc__,
+"TimerHandle(when, callback, args, loop, context=None)\n"
+"--\n"
+"\n"
+"Object returned by timed callback registration methods.");
+
+static int
+_asyncio_TimerHandle___init___impl(TimerHandleObj *self, PyObject *when,
+                                   PyObject *callback, PyObject *args,
+                                   PyObject *loop, PyObject *context);
+
+static int
+_asyncio_TimerHandle___init__(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    int return_value = -1;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 5
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_item = { &_Py_ID(when), &_Py_ID(callback), &_Py_ID(args), &_Py_ID(loop), &_Py_ID(context), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"when", "callback", "args", "loop", "context", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "TimerHandle",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[5];
+    PyObject * const *fastargs;
+    Py_ssize_t nargs = PyTuple_GET_SIZE(args);
+    Py_ssize_t noptargs = nargs + (kwargs ? PyDict_GET_SIZE(kwargs) : 0) - 4;
+    PyObject *when;
+    PyObject *callback;
+    PyObject *__clinic_args;
+    PyObject *loop;
+    PyObject *context = Py_None;
+
+    fastargs = _PyArg_UnpackKeywords(_PyTuple_CAST(args)->ob_item, nargs, kwargs, NULL, &_parser,
+            /*minpos*/ 4, /*maxpos*/ 5, /*minkw*/ 0, /*varpos*/ 0, argsbuf);
+    if (!fastargs) {
+        goto exit;
+    }
+    when = fastargs[0];
+    callback = fastargs[1];
+    __clinic_args = fastargs[2];
+    loop = fastargs[3];
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    context = fastargs[4];
+skip_optional_pos:
+    return_value = _asyncio_TimerHandle___init___impl((TimerHandleObj *)self, when, callback, __clinic_args, loop, context);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_asyncio_TimerHandle_when__doc__,
+"when($self, /)\n"
+"--\n"
+"\n"
+"Return a scheduled callback time.\n"
+"\n"
+"The time is an absolute timestamp, using the same time\n"
+"reference as loop.time().");
+
+#define _ASYNCIO_TIMERHANDLE_WHEN_METHODDEF    \
+    {"when", (PyCFunction)_asyncio_TimerHandle_when, METH_NOARGS, _asyncio_TimerHandle_when__doc__},
+
+static PyObject *
+_asyncio_TimerHandle_when_impl(TimerHandleObj *self);
+
+static PyObject *
+_asyncio_TimerHandle_when(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return _asyncio_TimerHandle_when_impl((TimerHandleObj *)self);
+}
+
+PyDoc_STRVAR(_asyncio_TimerHandle_cancel__doc__,
+"cancel($self, /)\n"
+"--\n"
+"\n");
+
+#define _ASYNCIO_TIMERHANDLE_CANCEL_METHODDEF    \
+    {"cancel", (PyCFunction)_asyncio_TimerHandle_cancel, METH_NOARGS, _asyncio_TimerHandle_cancel__doc__},
+
+static PyObject *
+_asyncio_TimerHandle_cancel_impl(TimerHandleObj *self);
+
+static PyObject *
+_asyncio_TimerHandle_cancel(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _asyncio_TimerHandle_cancel_impl((TimerHandleObj *)self);
+    Py_END_CRITICAL_SECTION();
+
+    return return_value;
+}
+
+PyDoc_STRVAR(_asyncio_TimerHandle__repr_info__doc__,
+"_repr_info($self, /)\n"
+"--\n"
+"\n");
+
+#define _ASYNCIO_TIMERHANDLE__REPR_INFO_METHODDEF    \
+    {"_repr_info", (PyCFunction)_asyncio_TimerHandle__repr_info, METH_NOARGS, _asyncio_TimerHandle__repr_info__doc__},
+
+static PyObject *
+_asyncio_TimerHandle__repr_info_impl(TimerHandleObj *self);
+
+static PyObject *
+_asyncio_TimerHandle__repr_info(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    return _asyncio_TimerHandle__repr_info_impl((TimerHandleObj *)self);
+}
+
+PyDoc_STRVAR(_asyncio__run_once__doc__,
+"_run_once($module, loop, /)\n"
+"--\n"
+"\n"
+"Run one full iteration of the event loop.\n"
+"\n"
+"This calls all currently ready callbacks, polls for I/O, schedules the\n"
+"resulting callbacks, and finally schedules \'call_later\' callbacks.\n"
+"\n"
+"This is the implementation of BaseEventLoop._run_once() outside of\n"
+"debug mode: callbacks are not timed.");
+
+#define _ASYNCIO__RUN_ONCE_METHODDEF    \
+    {"_run_once", (PyCFunction)_asyncio__run_once, METH_O, _asyncio__run_once__doc__},
+
+#if defined(HAVE_FILE_POOL)
+
+PyDoc_STRVAR(_asyncio_FilePool__doc__,
+"FilePool(max_workers=4)\n"
+"--\n"
+"\n"
+"Pool of threads running file operations for asyncio.\n"
+"\n"
+"  max_workers\n"
+"    The maximum number of worker threads.  They are started when\n"
+"    needed.\n"
+"\n"
+"The completions are collected with completed() once the file descriptor\n"
+"returned by fileno() is readable.");
+
+static PyObject *
+_asyncio_FilePool_impl(PyTypeObject *type, int max_workers);
+
+static PyObject *
+_asyncio_FilePool(PyTypeObject *type, PyObject *args, PyObject *kwargs)
+{
+    PyObject *return_value = NULL;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 1
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_item = { &_Py_ID(max_workers), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"max_workers", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "FilePool",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[1];
+    PyObject * const *fastargs;
+    Py_ssize_t nargs = PyTuple_GET_SIZE(args);
+    Py_ssize_t noptargs = nargs + (kwargs ? PyDict_GET_SIZE(kwargs) : 0) - 0;
+    int max_workers = 4;
+
+    fastargs = _PyArg_UnpackKeywords(_PyTuple_CAST(args)->ob_item, nargs, kwargs, NULL, &_parser,
+            /*minpos*/ 0, /*maxpos*/ 1, /*minkw*/ 0, /*varpos*/ 0, argsbuf);
+    if (!fastargs) {
+        goto exit;
+    }
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    max_workers = PyLong_AsInt(fastargs[0]);
+    if (max_workers == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+skip_optional_pos:
+    return_value = _asyncio_FilePool_impl(type, max_workers);
+
+exit:
+    return return_value;
+}
+
+#endif /* defined(HAVE_FILE_POOL) */
+
+#if defined(HAVE_FILE_POOL)
+
+PyDoc_STRVAR(_asyncio_FilePool_close__doc__,
+"close($self, /)\n"
+"--\n"
+"\n"
+"Stop the workers and close the pool.\n"
+"\n"
+"Do not wait for the operations being run, which can block indefinitely\n"
+"on a pipe or a FIFO: they are counted by inflight until a later call\n"
+"finds them completed.  The completions which have not been collected yet\n"
+"are discarded.");
+
+#define _ASYNCIO_FILEPOOL_CLOSE_METHODDEF    \
+    {"close", (PyCFunction)_asyncio_FilePool_close, METH_NOARGS, _asyncio_FilePool_close__doc__},
+
+static PyObject *
+_asyncio_FilePool_close_impl(FilePoolObj *self);
+
+static PyObject *
+_asyncio_FilePool_close(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _asyncio_FilePool_close_impl((FilePoolObj *)self);
+    Py_END_CRITICAL_SECTION();
+
+    return return_value;
+}
+
+#endif /* defined(HAVE_FILE_POOL) */
+
+#if defined(HAVE_FILE_POOL)
+
+PyDoc_STRVAR(_asyncio_FilePool_fileno__doc__,
+"fileno($self, /)\n"
+"--\n"
+"\n"
+"Return the file descriptor which is readable when completions are ready.");
+
+#define _ASYNCIO_FILEPOOL_FILENO_METHODDEF    \
+    {"fileno", (PyCFunction)_asyncio_FilePool_fileno, METH_NOARGS, _asyncio_FilePool_fileno__doc__},
+
+static PyObject *
+_asyncio_FilePool_fileno_impl(FilePoolObj *self);
+
+static PyObject *
+_asyncio_FilePool_fileno(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _asyncio_FilePool_fileno_impl((FilePoolObj *)self);
+    Py_END_CRITICAL_SECTION();
+
+    return return_value;
+}
+
+#endif /* defined(HAVE_FILE_POOL) */
+
+#if defined(HAVE_FILE_POOL)
+
+PyDoc_STRVAR(_asyncio_FilePool_open__doc__,
+"open($self, token, path, flags, mode=438, /)\n"
+"--\n"
+"\n"
+"Open the file path like os.open().\n"
+"\n"
+"  path\n"
+"    The path encoded with os.fsencode().\n"
+"\n"
+"The completion result is the new file descriptor.");
+
+#define _ASYNCIO_FILEPOOL_OPEN_METHODDEF    \
+    {"open", _PyCFunction_CAST(_asyncio_FilePool_open), METH_FASTCALL, _asyncio_FilePool_open__doc__},
+
+static PyObject *
+_asyncio_FilePool_open_impl(FilePoolObj *self, PyObject *token,
+                            PyObject *path, int flags, int mode);
+
+static PyObject *
+_asyncio_FilePool_open(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *return_value = NULL;
+    PyObject *token;
+    PyObject *path;
+    int flags;
+    int mode = 438;
+
+    if (!_PyArg_CheckPositional("open", nargs, 3, 4)) {
+        goto exit;
+    }
+    token = args[0];
+    if (!PyBytes_Check(args[1])) {
+        _PyArg_BadArgument("open", "argument 2", "bytes", args[1]);
+        goto exit;
+    }
+    path = args[1];
+    flags = PyLong_AsInt(args[2]);
+    if (flags == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+    if (nargs < 4) {
+        goto skip_optional;
+    }
+    mode = PyLong_AsInt(args[3]);
+    if (mode == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+skip_optional:
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _asyncio_FilePool_open_impl((FilePoolObj *)self, token, path, flags, mode);
+    Py_END_CRITICAL_SECTION();
+
+exit:
+    return return_value;
+}
+
+#endif /* defined(HAVE_FILE_POOL) */
+
+#if defined(HAVE_FILE_POOL)
+
+PyDoc_STRVAR(_asyncio_FilePool_read__doc__,
+"read($self, token, fd, size, offset=-1, /)\n"
+"--\n"
+"\n"
+"Read at most size bytes from fd.\n"
+"\n"
+"  offset\n"
+"    The file offset, or -1 to use and update the file position.\n"
+"\n"
+"The completion data is a bytes object with the data read.");
+
+#define _ASYNCIO_FILEPOOL_READ_METHODDEF    \
+    {"read", _PyCFunction_CAST(_asyncio_FilePool_read), METH_FASTCALL, _asyncio_FilePool_read__doc__},
+
+static PyObject *
+_asyncio_FilePool_read_impl(FilePoolObj *self, PyObject *token, int fd,
+                            Py_ssize_t size, long long offset);
+
+static PyObject *
+_asyncio_FilePool_read(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *return_value = NULL;
+    PyObject *token;
+    int fd;
+    Py_ssize_t size;
+    long long offset = -1;
+
+    if (!_PyArg_CheckPositional("read", nargs, 3, 4)) {
+        goto exit;
+    }
+    token = args[0];
+    fd = PyLong_AsInt(args[1]);
+    if (fd == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+    {
+        Py_ssize_t ival = -1;
+        PyObject *iobj = _PyNumber_Index(args[2]);
+        if (iobj != NULL) {
+            ival = PyLong_AsSsize_t(iobj);
+            Py_DECREF(iobj);
+        }
+        if (ival == -1 && PyErr_Occurred()) {
+            goto exit;
+        }
+        size = ival;
+    }
+    if (nargs < 4) {
+        goto skip_optional;
+    }
+    offset = PyLong_AsLongLong(args[3]);
+    if (offset == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+skip_optional:
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _asyncio_FilePool_read_impl((FilePoolObj *)self, token, fd, size, offset);
+    Py_END_CRITICAL_SECTION();
+
+exit:
+    return return_value;
+}
+
+#endif /* defined(HAVE_FILE_POOL) */
+
+#if defined(HAVE_FILE_POOL)
+
+PyDoc_STRVAR(_asyncio_FilePool_readinto__doc__,
+"readinto($self, token, fd, buffer, offset=-1, /)\n"
+"--\n"
+"\n"
+"Read from fd into a writable buffer.");
+
+#define _ASYNCIO_FILEPOOL_READINTO_METHODDEF    \
+    {"readinto", _PyCFunction_CAST(_asyncio_FilePool_readinto), METH_FASTCALL, _asyncio_FilePool_readinto__doc__},
+
+static PyObject *
+_asyncio_FilePool_readinto_impl(FilePoolObj *self, PyObject *token, int fd,
+                                PyObject *buffer, long long offset);
+
+static PyObject *
+_asyncio_FilePool_readinto(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *return_value = NULL;
+    PyObject *token;
+    int fd;
+    PyObject *buffer;
+    long long offset = -1;
+
+    if (!_PyArg_CheckPositional("readinto", nargs, 3, 4)) {
+        goto exit;
+    }
+    token = args[0];
+    fd = PyLong_AsInt(args[1]);
+    if (fd == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+    buffer = args[2];
+    if (nargs < 4) {
+        goto skip_optional;
+    }
+    offset = PyLong_AsLongLong(args[3]);
+    if (offset == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+skip_optional:
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _asyncio_FilePool_readinto_impl((FilePoolObj *)self, token, fd, buffer, offset);
+    Py_END_CRITICAL_SECTION();
+
+exit:
+    return return_value;
+}
+
+#endif /* defined(HAVE_FILE_POOL) */
+
+#if defined(HAVE_FILE_POOL)
+
+PyDoc_STRVAR(_asyncio_FilePool_write__doc__,
+"write($self, token, fd, data, offset=-1, /)\n"
+"--\n"
+"\n"
+"Write the bytes-like object data to fd.\n"
+"\n"
+"The completion result is the number of bytes written, which may be less\n"
+"than the size of data.");
+
+#define _ASYNCIO_FILEPOOL_WRITE_METHODDEF    \
+    {"write", _PyCFunction_CAST(_asyncio_FilePool_write), METH_FASTCALL, _asyncio_FilePool_write__doc__},
+
+static PyObject *
+_asyncio_FilePool_write_impl(FilePoolObj *self, PyObject *token, int fd,
+                             PyObject *data, long long offset);
+
+static PyObject *
+_asyncio_FilePool_write(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *return_value = NULL;
+    PyObject *token;
+    int fd;
+    PyObject *data;
+    long long offset = -1;
+
+    if (!_PyArg_CheckPositional("write", nargs, 3, 4)) {
+        goto exit;
+    }
+    token = args[0];
+    fd = PyLong_AsInt(args[1]);
+    if (fd == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+    data = args[2];
+    if (nargs < 4) {
+        goto skip_optional;
+    }
+    offset = PyLong_AsLongLong(args[3]);
+    if (offset == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+skip_optional:
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _asyncio_FilePool_write_impl((FilePoolObj *)self, token, fd, data, offset);
+    Py_END_CRITICAL_SECTION();
+
+exit:
+    return return_value;
+}
+
+#endif /* defined(HAVE_FILE_POOL) */
+
+#if defined(HAVE_FILE_POOL)
+
+PyDoc_STRVAR(_asyncio_FilePool_fsync__doc__,
+"fsync($self, token, fd, datasync=False, /)\n"
+"--\n"
+"\n"
+"Flush the data of the file fd to disk, like os.fsync().\n"
+"\n"
+"  datasync\n"
+"    Only flush the data and the metadata needed to read it back, like\n"
+"    os.fdatasync().");
+
+#define _ASYNCIO_FILEPOOL_FSYNC_METHODDEF    \
+    {"fsync", _PyCFunction_CAST(_asyncio_FilePool_fsync), METH_FASTCALL, _asyncio_FilePool_fsync__doc__},
+
+static PyObject *
+_asyncio_FilePool_fsync_impl(FilePoolObj *self, PyObject *token, int fd,
+                             int datasync);
+
+static PyObject *
+_asyncio_FilePool_fsync(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *return_value = NULL;
+    PyObject *token;
+    int fd;
+    int datasync = 0;
+
+    if (!_PyArg_CheckPositional("fsync", nargs, 2, 3)) {
+        goto exit;
+    }
+    token = args[0];
+    fd = PyLong_AsInt(args[1]);
+    if (fd == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+    if (nargs < 3) {
+        goto skip_optional;
+    }
+    datasync = PyObject_IsTrue(args[2]);
+    if (datasync < 0) {
+        goto exit;
+    }
+skip_optional:
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _asyncio_FilePool_fsync_impl((FilePoolObj *)self, token, fd, datasync);
+    Py_END_CRITICAL_SECTION();
+
+exit:
+    return return_value;
+}
+
+#endif /* defined(HAVE_FILE_POOL) */
+
+#if defined(HAVE_FILE_POOL)
+
+PyDoc_STRVAR(_asyncio_FilePool_close_fd__doc__,
+"close_fd($self, token, fd, /)\n"
+"--\n"
+"\n"
+"Close the file descriptor fd.");
+
+#define _ASYNCIO_FILEPOOL_CLOSE_FD_METHODDEF    \
+    {"close_fd", _PyCFunction_CAST(_asyncio_FilePool_close_fd), METH_FASTCALL, _asyncio_FilePool_close_fd__doc__},
+
+static PyObject *
+_asyncio_FilePool_close_fd_impl(FilePoolObj *self, PyObject *token, int fd);
+
+static PyObject *
+_asyncio_FilePool_close_fd(PyObject *self, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *return_value = NULL;
+    PyObject *token;
+    int fd;
+
+    if (!_PyArg_CheckPositional("close_fd", nargs, 2, 2)) {
+        goto exit;
+    }
+    token = args[0];
+    fd = PyLong_AsInt(args[1]);
+    if (fd == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _asyncio_FilePool_close_fd_impl((FilePoolObj *)self, token, fd);
+    Py_END_CRITICAL_SECTION();
+
+exit:
+    return return_value;
+}
+
+#endif /* defined(HAVE_FILE_POOL) */
+
+#if defined(HAVE_FILE_POOL)
+
+PyDoc_STRVAR(_asyncio_FilePool_completed__doc__,
+"completed($self, /)\n"
+"--\n"
+"\n"
+"Return the completed operations.\n"
+"\n"
+"Return a list of (token, result, data) tuples.  result is the result of\n"
+"the operation: a negative errno value on failure.  data is the bytes\n"
+"object read by read(), or None.");
+
+#define _ASYNCIO_FILEPOOL_COMPLETED_METHODDEF    \
+    {"completed", (PyCFunction)_asyncio_FilePool_completed, METH_NOARGS, _asyncio_FilePool_completed__doc__},
+
+static PyObject *
+_asyncio_FilePool_completed_impl(FilePoolObj *self);
+
+static PyObject *
+_asyncio_FilePool_completed(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _asyncio_FilePool_completed_impl((FilePoolObj *)self);
+    Py_END_CRITICAL_SECTION();
+
+    return return_value;
+}
+
+#endif /* defined(HAVE_FILE_POOL) */
+
 PyDoc_STRVAR(_asyncio__get_running_loop__doc__,
 "_get_running_loop($module, /)\n"
 "--\n"
@@ -2174,4 +2971,40 @@ _asyncio_future_discard_from_awaited_by(PyObject *module, PyObject *const *args,
 exit:
     return return_value;
 }
-/*[clinic end generated code: output=f14ff14c29c691ec input=a9049054013a1b77]*/
+
+#ifndef _ASYNCIO_FILEPOOL_CLOSE_METHODDEF
+    #define _ASYNCIO_FILEPOOL_CLOSE_METHODDEF
+#endif /* !defined(_ASYNCIO_FILEPOOL_CLOSE_METHODDEF) */
+
+#ifndef _ASYNCIO_FILEPOOL_FILENO_METHODDEF
+    #define _ASYNCIO_FILEPOOL_FILENO_METHODDEF
+#endif /* !defined(_ASYNCIO_FILEPOOL_FILENO_METHODDEF) */
+
+#ifndef _ASYNCIO_FILEPOOL_OPEN_METHODDEF
+    #define _ASYNCIO_FILEPOOL_OPEN_METHODDEF
+#endif /* !defined(_ASYNCIO_FILEPOOL_OPEN_METHODDEF) */
+
+#ifndef _ASYNCIO_FILEPOOL_READ_METHODDEF
+    #define _ASYNCIO_FILEPOOL_READ_METHODDEF
+#endif /* !defined(_ASYNCIO_FILEPOOL_READ_METHODDEF) */
+
+#ifndef _ASYNCIO_FILEPOOL_READINTO_METHODDEF
+    #define _ASYNCIO_FILEPOOL_READINTO_METHODDEF
+#endif /* !defined(_ASYNCIO_FILEPOOL_READINTO_METHODDEF) */
+
+#ifndef _ASYNCIO_FILEPOOL_WRITE_METHODDEF
+    #define _ASYNCIO_FILEPOOL_WRITE_METHODDEF
+#endif /* !defined(_ASYNCIO_FILEPOOL_WRITE_METHODDEF) */
+
+#ifndef _ASYNCIO_FILEPOOL_FSYNC_METHODDEF
+    #define _ASYNCIO_FILEPOOL_FSYNC_METHODDEF
+#endif /* !defined(_ASYNCIO_FILEPOOL_FSYNC_METHODDEF) */
+
+#ifndef _ASYNCIO_FILEPOOL_CLOSE_FD_METHODDEF
+    #define _ASYNCIO_FILEPOOL_CLOSE_FD_METHODDEF
+#endif /* !defined(_ASYNCIO_FILEPOOL_CLOSE_FD_METHODDEF) */
+
+#ifndef _ASYNCIO_FILEPOOL_COMPLETED_METHODDEF
+    #define _ASYNCIO_FILEPOOL_COMPLETED_METHODDEF
+#endif /* !defined(_ASYNCIO_FILEPOOL_COMPLETED_METHODDEF) */
+/*[clinic end generated code: output=d6c66943459979ba input=a9049054013a1b77]*/
@@ -12078,6 +12078,54 @@ exit:
     return return_value;
 }
 
+#if (!defined(MS_WINDOWS) && defined(HAVE_DIRENT_D_TYPE) && defined(HAVE_DIRFD) && defined(HAVE_FSTATAT))
+
+PyDoc_STRVAR(os__scandir_names__doc__,
+"_scandir_names($module, path, follow_symlinks, /)\n"
+"--\n"
+"\n"
+"Return the names of the entries in a directory, split by type.\n"
+"\n"
+"Return a tuple (dirs, nondirs, symlinks).  dirs is the list of the\n"
+"subdirectories, including symbolic links to directories if follow_symlinks\n"
+"is true, nondirs is the list of the other entries and symlinks is the list\n"
+"of the names in dirs which are symbolic links.  The directory is read\n"
+"without creating DirEntry objects and without holding the GIL.");
+
+#define OS__SCANDIR_NAMES_METHODDEF    \
+    {"_scandir_names", _PyCFunction_CAST(os__scandir_names), METH_FASTCALL, os__scandir_names__doc__},
+
+static PyObject *
+os__scandir_names_impl(PyObject *module, path_t *path, int follow_symlinks);
+
+static PyObject *
+os__scandir_names(PyObject *module, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *return_value = NULL;
+    path_t path = PATH_T_INITIALIZE_P("_scandir_names", "path", 0, 0, 0, 0);
+    int follow_symlinks;
+
+    if (!_PyArg_CheckPositional("_scandir_names", nargs, 2, 2)) {
+        goto exit;
+    }
+    if (!path_converter(args[0], &path)) {
+        goto exit;
+    }
+    follow_symlinks = PyObject_IsTrue(args[1]);
+    if (follow_symlinks < 0) {
+        goto exit;
+    }
+    return_value = os__scandir_names_impl(module, &path, follow_symlinks);
+
+exit:
+    /* Cleanup for path */
+    path_cleanup(&path);
+
+    return return_value;
+}
+
+#endif /* (!defined(MS_WINDOWS) && defined(HAVE_DIRENT_D_TYPE) && defined(HAVE_DIRFD) && defined(HAVE_FSTATAT)) */
+
 PyDoc_STRVAR(os_fspath__doc__,
 "fspath($module, /, path)\n"
 "--\n"
@@ -13173,6 +13221,10 @@ os__emscripten_debugger(PyObject *module, PyObject *Py_UNUSED(ignored))
     #define OS_SET_HANDLE_INHERITABLE_METHODDEF
 #endif /* !defined(OS_SET_HANDLE_INHERITABLE_METHODDEF) */
 
+#ifndef OS__SCANDIR_NAMES_METHODDEF
+    #define OS__SCANDIR_NAMES_METHODDEF
+#endif /* !defined(OS__SCANDIR_NAMES_METHODDEF) */
+
 #ifndef OS_GETRANDOM_METHODDEF
     #define OS_GETRANDOM_METHODDEF
 #endif /* !defined(OS_GETRANDOM_METHODDEF) */
@@ -13196,4 +13248,4 @@ os__emscripten_debugger(PyObject *module, PyObject *Py_UNUSED(ignored))
 #ifndef OS__EMSCRIPTEN_DEBUGGER_METHODDEF
     #define OS__EMSCRIPTEN_DEBUGGER_METHODDEF
 #endif /* !defined(OS__EMSCRIPTEN_DEBUGGER_METHODDEF) */
-/*[clinic end generated code: output=8318c26fc2cd236c input=a9049054013a1b77]*/
+/*[clinic end generated code: output=346084d07bd4f098 input=a9049054013a1b77]*/
@@ -5,6 +5,7 @@
  */
 
 #include "Python.h"
+#include "pycore_dict.h"        // _PyDictSharedKeys_Type
 #include "pycore_gc.h"
 #include "pycore_object.h"      // _PyObject_IS_GC()
 #include "pycore_pystate.h"     // _PyInterpreterState_GET()
@@ -238,6 +239,11 @@ static int
 referentsvisit(PyObject *obj, void *arg)
 {
     PyObject *list = arg;
+    if (Py_IS_TYPE(obj, &_PyDictSharedKeys_Type)) {
+        // Report the keys and values of the table shared by copies of a
+        // dict as the referents of the dict
+        return Py_TYPE(obj)->tp_traverse(obj, referentsvisit, list);
+    }
     return PyList_Append(list, obj) < 0;
 }
 
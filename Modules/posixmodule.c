@@ -16538,6 +16538,172 @@ os_scandir_impl(PyObject *module, path_t *path)
     return NULL;
 }
 
+#if !defined(MS_WINDOWS) && defined(HAVE_DIRENT_D_TYPE) && \
+    defined(HAVE_DIRFD) && defined(HAVE_FSTATAT)
+
+enum {
+    SCANDIR_NONDIR,
+    SCANDIR_DIR,
+    SCANDIR_DIR_SYMLINK,
+};
+
+/* Classify the entry name of the directory dir_fd.  Only entries with an
+   unknown d_type, and symbolic links when following them, need a stat call.
+   As with DirEntry.is_dir(), an entry that cannot be stat'ed is not a
+   directory. */
+static int
+scandir_names_kind(int dir_fd, const char *name, unsigned char d_type,
+                   int follow_symlinks)
+{
+    struct stat st;
+
+    if (d_type == DT_UNKNOWN) {
+        if (fstatat(dir_fd, name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+            return SCANDIR_NONDIR;
+        }
+        if (S_ISDIR(st.st_mode)) {
+            return SCANDIR_DIR;
+        }
+        if (!S_ISLNK(st.st_mode)) {
+            return SCANDIR_NONDIR;
+        }
+        d_type = DT_LNK;
+    }
+    if (d_type == DT_DIR) {
+        return SCANDIR_DIR;
+    }
+    if (d_type != DT_LNK || !follow_symlinks) {
+        return SCANDIR_NONDIR;
+    }
+    if (fstatat(dir_fd, name, &st, 0) != 0 || !S_ISDIR(st.st_mode)) {
+        return SCANDIR_NONDIR;
+    }
+    return SCANDIR_DIR_SYMLINK;
+}
+
+/*[clinic input]
+os._scandir_names
+
+    path: path_t
+    follow_symlinks: bool
+    /
+
+Return the names of the entries in a directory, split by type.
+
+Return a tuple (dirs, nondirs, symlinks).  dirs is the list of the
+subdirectories, including symbolic links to directories if follow_symlinks
+is true, nondirs is the list of the other entries and symlinks is the list
+of the names in dirs which are symbolic links.  The directory is read
+without creating DirEntry objects and without holding the GIL.
+[clinic start generated code]*/
+
+static PyObject *
+os__scandir_names_impl(PyObject *module, path_t *path, int follow_symlinks)
+/*[clinic end generated code: output=bc5e332434cb2cda input=8bbf18c159659978]*/
+{
+    DIR *dirp;
+    struct dirent *ep;
+    char *buf = NULL, *newbuf;
+    size_t size = 0, used = 0, name_len, pos;
+    int saved_errno = 0, no_memory = 0, return_str;
+    PyObject *dirs = NULL, *nondirs = NULL, *symlinks = NULL;
+    PyObject *result = NULL;
+
+    if (PySys_Audit("os.scandir", "O", path->object) < 0) {
+        return NULL;
+    }
+    return_str = !PyBytes_Check(path->object);
+
+    /* Read the whole directory in one go, into records made of the kind
+       of the entry followed by its NUL-terminated name. */
+    Py_BEGIN_ALLOW_THREADS
+    dirp = opendir(path->narrow);
+    if (dirp == NULL) {
+        saved_errno = errno;
+    }
+    else {
+        int dir_fd = dirfd(dirp);
+        for (;;) {
+            errno = 0;
+            ep = readdir(dirp);
+            if (ep == NULL) {
+                saved_errno = errno;
+                break;
+            }
+            name_len = NAMLEN(ep);
+            if (ep->d_name[0] == '.' &&
+                (name_len == 1 || (ep->d_name[1] == '.' && name_len == 2)))
+                continue;
+            if (size - used < name_len + 2) {
+                size_t newsize = Py_MAX(2 * size, used + name_len + 2 + 4096);
+                newbuf = PyMem_RawRealloc(buf, newsize);
+                if (newbuf == NULL) {
+                    no_memory = 1;
+                    break;
+                }
+                buf = newbuf;
+                size = newsize;
+            }
+            buf[used] = (char)scandir_names_kind(dir_fd, ep->d_name,
+                                                 ep->d_type, follow_symlinks);
+            memcpy(buf + used + 1, ep->d_name, name_len + 1);
+            used += name_len + 2;
+        }
+        closedir(dirp);
+    }
+    Py_END_ALLOW_THREADS
+
+    if (no_memory) {
+        PyErr_NoMemory();
+        goto exit;
+    }
+    if (saved_errno != 0) {
+        errno = saved_errno;
+        path_error(path);
+        goto exit;
+    }
+
+    if ((dirs = PyList_New(0)) == NULL ||
+        (nondirs = PyList_New(0)) == NULL ||
+        (symlinks = PyList_New(0)) == NULL)
+    {
+        goto exit;
+    }
+    for (pos = 0; pos < used; pos += name_len + 2) {
+        int kind = buf[pos];
+        const char *name = buf + pos + 1;
+        PyObject *v;
+
+        name_len = strlen(name);
+        if (return_str) {
+            v = PyUnicode_DecodeFSDefaultAndSize(name, name_len);
+        }
+        else {
+            v = PyBytes_FromStringAndSize(name, name_len);
+        }
+        if (v == NULL) {
+            goto exit;
+        }
+        if (PyList_Append(kind == SCANDIR_NONDIR ? nondirs : dirs, v) < 0 ||
+            (kind == SCANDIR_DIR_SYMLINK && PyList_Append(symlinks, v) < 0))
+        {
+            Py_DECREF(v);
+            goto exit;
+        }
+        Py_DECREF(v);
+    }
+    result = PyTuple_Pack(3, dirs, nondirs, symlinks);
+
+exit:
+    PyMem_RawFree(buf);
+    Py_XDECREF(dirs);
+    Py_XDECREF(nondirs);
+    Py_XDECREF(symlinks);
+    return result;
+}
+
+#endif
+
 /*
     Return the file system path representation of the object.
 
@@ -17119,6 +17285,7 @@ static PyMethodDef posix_methods[] = {
     OS_GET_BLOCKING_METHODDEF
     OS_SET_BLOCKING_METHODDEF
     OS_SCANDIR_METHODDEF
+    OS__SCANDIR_NAMES_METHODDEF
     OS_FSPATH_METHODDEF
     OS_GETRANDOM_METHODDEF
     OS_MEMFD_CREATE_METHODDEF
@@ -3410,6 +3410,99 @@ sockets the address is a tuple (ifname, proto [,pkttype [,hatype [,addr]]])");
 #endif
 
 
+#ifdef HAVE_SOCK_ZEROCOPY
+/* The data of a MSG_ZEROCOPY send is read by the kernel after send()
+   returns, so the buffer stays exported until the completion
+   notification of the send is read from the error queue of the socket.
+   The kernel numbers the sends which queued data from 0, and notifies
+   completions by ranges of ids. */
+struct sock_zerocopy_buf {
+    uint32_t id;
+    Py_buffer view;
+};
+
+/* Release the buffers of the sends with ids first to last (inclusive,
+   modulo 2**32).  The buffers are released after the array is updated,
+   since releasing a buffer can run arbitrary code.  Return -1 with an
+   exception set on error. */
+static int
+sock_zerocopy_release(PySocketSockObject *s, uint32_t first, uint32_t last)
+{
+    struct sock_zerocopy_buf *bufs, *keep = NULL;
+    Py_ssize_t i, ndone = 0, nkeep = 0;
+    uint32_t span = last - first;
+    int res = 0;
+
+    Py_BEGIN_CRITICAL_SECTION(s);
+    bufs = s->sock_zerocopy_bufs;
+    if (s->sock_zerocopy_size > 0 &&
+        (keep = PyMem_New(struct sock_zerocopy_buf,
+                          s->sock_zerocopy_size)) == NULL) {
+        PyErr_NoMemory();
+        res = -1;
+    }
+    else {
+        for (i = 0; i < s->sock_zerocopy_len; i++) {
+            if ((uint32_t)(bufs[i].id - first) <= span)
+                bufs[ndone++] = bufs[i];
+            else
+                keep[nkeep++] = bufs[i];
+        }
+        s->sock_zerocopy_bufs = keep;
+        s->sock_zerocopy_len = nkeep;
+    }
+    Py_END_CRITICAL_SECTION();
+
+    if (res == 0) {
+        for (i = 0; i < ndone; i++)
+            PyBuffer_Release(&bufs[i].view);
+        PyMem_Free(bufs);
+    }
+    return res;
+}
+
+/* Forget the buffers of the sends not completed yet, when the socket is
+   closed or detached and no more notification can be read.  The kernel
+   may still be reading them, so they are leaked rather than released:
+   their memory must not be reused or modified. */
+static void
+sock_zerocopy_abandon(PySocketSockObject *s)
+{
+    struct sock_zerocopy_buf *bufs;
+
+    Py_BEGIN_CRITICAL_SECTION(s);
+    bufs = s->sock_zerocopy_bufs;
+    s->sock_zerocopy_bufs = NULL;
+    s->sock_zerocopy_len = s->sock_zerocopy_size = 0;
+    Py_END_CRITICAL_SECTION();
+
+    PyMem_Free(bufs);
+}
+
+/* Make room for one more buffer.  Return -1 with an exception set on
+   error. */
+static int
+sock_zerocopy_reserve(PySocketSockObject *s)
+{
+    struct sock_zerocopy_buf *bufs;
+    Py_ssize_t size;
+
+    if (s->sock_zerocopy_len < s->sock_zerocopy_size)
+        return 0;
+    size = s->sock_zerocopy_size ? s->sock_zerocopy_size * 2 : 16;
+    bufs = PyMem_Resize(s->sock_zerocopy_bufs, struct sock_zerocopy_buf,
+                        size);
+    if (bufs == NULL) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    s->sock_zerocopy_bufs = bufs;
+    s->sock_zerocopy_size = size;
+    return 0;
+}
+#endif    /* HAVE_SOCK_ZEROCOPY */
+
+
 /* s.close() method.
    Set the file descriptor to -1 so operations tried subsequently
    will surely fail. */
@@ -3441,6 +3534,9 @@ _socket_socket_close_impl(PySocketSockObject *s)
         Py_BEGIN_ALLOW_THREADS
         res = SOCKETCLOSE(fd);
         Py_END_ALLOW_THREADS
+#ifdef HAVE_SOCK_ZEROCOPY
+        sock_zerocopy_abandon(s);
+#endif
         /* bpo-30319: The peer can already have closed the connection.
            Python ignores ECONNRESET on close(). */
         if (res < 0 && errno != ECONNRESET) {
@@ -3456,6 +3552,9 @@ sock_detach(PyObject *self, PyObject *Py_UNUSED(ignored))
     PySocketSockObject *s = _PySocketSockObject_CAST(self);
     SOCKET_T fd = get_sock_fd(s);
     set_sock_fd(s, INVALID_SOCKET);
+#ifdef HAVE_SOCK_ZEROCOPY
+    sock_zerocopy_abandon(s);
+#endif
     return PyLong_FromSocket_t(fd);
 }
 
@@ -4110,8 +4209,8 @@ PyDoc_STRVAR(recvfrom_into_doc,
 Like recv_into(buffer[, nbytes[, flags]]) but also return the sender's address info.");
 #endif
 
-/* The sendmsg() and recvmsg[_into]() methods require a working
-   CMSG_LEN().  See the comment near get_CMSG_LEN(). */
+/* The sendmsg(), recvmsg[_into]() and recvmmsg_into() methods require a
+   working CMSG_LEN().  See the comment near get_CMSG_LEN(). */
 #ifdef CMSG_LEN
 struct sock_recvmsg {
     struct msghdr *msg;
@@ -4128,6 +4227,96 @@ sock_recvmsg_impl(PySocketSockObject *s, void *data)
     return  (ctx->result >= 0);
 }
 
+/*
+ * Make a list of (level, type, data) tuples from the control messages
+ * of msg.  Returns a new reference, or NULL with an exception set.
+ */
+static PyObject *
+make_cmsg_list(struct msghdr *msg)
+{
+    PyObject *cmsg_list;
+    struct cmsghdr *cmsgh;
+    size_t cmsgdatalen = 0;
+    int cmsg_status;
+
+    if ((cmsg_list = PyList_New(0)) == NULL)
+        return NULL;
+    /* Check for empty ancillary data as old CMSG_FIRSTHDR()
+       implementations didn't do so. */
+    for (cmsgh = ((msg->msg_controllen > 0) ? CMSG_FIRSTHDR(msg) : NULL);
+         cmsgh != NULL; cmsgh = CMSG_NXTHDR(msg, cmsgh)) {
+        PyObject *bytes, *tuple;
+        int tmp;
+
+        cmsg_status = get_cmsg_data_len(msg, cmsgh, &cmsgdatalen);
+        if (cmsg_status != 0) {
+            if (PyErr_WarnEx(PyExc_RuntimeWarning,
+                             "received malformed or improperly-truncated "
+                             "ancillary data", 1) == -1)
+                goto error;
+        }
+        if (cmsg_status < 0)
+            break;
+        if (cmsgdatalen > PY_SSIZE_T_MAX) {
+            PyErr_SetString(PyExc_OSError, "control message too long");
+            goto error;
+        }
+
+        bytes = PyBytes_FromStringAndSize((char *)CMSG_DATA(cmsgh),
+                                          cmsgdatalen);
+        tuple = Py_BuildValue("iiN", (int)cmsgh->cmsg_level,
+                              (int)cmsgh->cmsg_type, bytes);
+        if (tuple == NULL)
+            goto error;
+        tmp = PyList_Append(cmsg_list, tuple);
+        Py_DECREF(tuple);
+        if (tmp != 0)
+            goto error;
+
+        if (cmsg_status != 0)
+            break;
+    }
+    return cmsg_list;
+
+error:
+    Py_DECREF(cmsg_list);
+    return NULL;
+}
+
+/*
+ * Close all descriptors received in the control messages of msg via
+ * SCM_RIGHTS, so they don't leak when the received data cannot be
+ * returned to the caller.
+ */
+static void
+close_cmsg_fds(struct msghdr *msg)
+{
+#ifdef SCM_RIGHTS
+    struct cmsghdr *cmsgh;
+    size_t cmsgdatalen = 0;
+    int cmsg_status;
+
+    for (cmsgh = ((msg->msg_controllen > 0) ? CMSG_FIRSTHDR(msg) : NULL);
+         cmsgh != NULL; cmsgh = CMSG_NXTHDR(msg, cmsgh)) {
+        cmsg_status = get_cmsg_data_len(msg, cmsgh, &cmsgdatalen);
+        if (cmsg_status < 0)
+            break;
+        if (cmsgh->cmsg_level == SOL_SOCKET &&
+            cmsgh->cmsg_type == SCM_RIGHTS) {
+            size_t numfds;
+            int *fdp;
+
+            numfds = cmsgdatalen / sizeof(int);
+            fdp = (int *)CMSG_DATA(cmsgh);
+            while (numfds-- > 0)
+                close(*fdp++);
+        }
+        if (cmsg_status != 0)
+            break;
+    }
+#endif /* SCM_RIGHTS */
+}
+
 /*
  * Call recvmsg() with the supplied iovec structures, flags, and
  * ancillary data buffer size (controllen).  Returns the tuple return
@@ -4148,9 +4337,6 @@ sock_recvmsg_guts(PySocketSockObject *s, struct iovec *iov, int iovlen,
     struct msghdr msg = {0};
     PyObject *cmsg_list = NULL, *retval = NULL;
     void *controlbuf = NULL;
-    struct cmsghdr *cmsgh;
-    size_t cmsgdatalen = 0;
-    int cmsg_status;
     struct sock_recvmsg ctx;
 
     /* XXX: POSIX says that msg_name and msg_namelen "shall be
@@ -4190,44 +4376,8 @@ sock_recvmsg_guts(PySocketSockObject *s, struct iovec *iov, int iovlen,
     if (sock_call(s, 0, sock_recvmsg_impl, &ctx) < 0)
         goto finally;
 
-    /* Make list of (level, type, data) tuples from control messages. */
-    if ((cmsg_list = PyList_New(0)) == NULL)
+    if ((cmsg_list = make_cmsg_list(&msg)) == NULL)
         goto err_closefds;
-    /* Check for empty ancillary data as old CMSG_FIRSTHDR()
-       implementations didn't do so. */
-    for (cmsgh = ((msg.msg_controllen > 0) ? CMSG_FIRSTHDR(&msg) : NULL);
-         cmsgh != NULL; cmsgh = CMSG_NXTHDR(&msg, cmsgh)) {
-        PyObject *bytes, *tuple;
-        int tmp;
-
-        cmsg_status = get_cmsg_data_len(&msg, cmsgh, &cmsgdatalen);
-        if (cmsg_status != 0) {
-            if (PyErr_WarnEx(PyExc_RuntimeWarning,
-                             "received malformed or improperly-truncated "
-                             "ancillary data", 1) == -1)
-                goto err_closefds;
-        }
-        if (cmsg_status < 0)
-            break;
-        if (cmsgdatalen > PY_SSIZE_T_MAX) {
-            PyErr_SetString(PyExc_OSError, "control message too long");
-            goto err_closefds;
-        }
-
-        bytes = PyBytes_FromStringAndSize((char *)CMSG_DATA(cmsgh),
-                                          cmsgdatalen);
-        tuple = Py_BuildValue("iiN", (int)cmsgh->cmsg_level,
-                              (int)cmsgh->cmsg_type, bytes);
-        if (tuple == NULL)
-            goto err_closefds;
-        tmp = PyList_Append(cmsg_list, tuple);
-        Py_DECREF(tuple);
-        if (tmp != 0)
-            goto err_closefds;
-
-        if (cmsg_status != 0)
-            break;
-    }
 
     retval = Py_BuildValue("NOiN",
                            (*makeval)(ctx.result, makeval_data),
@@ -4246,27 +4396,7 @@ sock_recvmsg_guts(PySocketSockObject *s, struct iovec *iov, int iovlen,
     return retval;
 
 err_closefds:
-#ifdef SCM_RIGHTS
-    /* Close all descriptors coming from SCM_RIGHTS, so they don't leak. */
-    for (cmsgh = ((msg.msg_controllen > 0) ? CMSG_FIRSTHDR(&msg) : NULL);
-         cmsgh != NULL; cmsgh = CMSG_NXTHDR(&msg, cmsgh)) {
-        cmsg_status = get_cmsg_data_len(&msg, cmsgh, &cmsgdatalen);
-        if (cmsg_status < 0)
-            break;
-        if (cmsgh->cmsg_level == SOL_SOCKET &&
-            cmsgh->cmsg_type == SCM_RIGHTS) {
-            size_t numfds;
-            int *fdp;
-
-            numfds = cmsgdatalen / sizeof(int);
-            fdp = (int *)CMSG_DATA(cmsgh);
-            while (numfds-- > 0)
-                close(*fdp++);
-        }
-        if (cmsg_status != 0)
-            break;
-    }
-#endif /* SCM_RIGHTS */
+    close_cmsg_fds(&msg);
     goto finally;
 }
 
@@ -4438,6 +4568,185 @@ its value is unspecified.\n\
 If recvmsg_into() raises an exception after the system call returns,\n\
 it will first attempt to close any file descriptors received via the\n\
 SCM_RIGHTS mechanism.");
+
+#ifdef HAVE_RECVMMSG
+struct sock_recvmmsg {
+    struct mmsghdr *msgvec;
+    unsigned int vlen;
+    int flags;
+    int result;
+};
+
+static int
+sock_recvmmsg_impl(PySocketSockObject *s, void *data)
+{
+    struct sock_recvmmsg *ctx = data;
+
+    ctx->result = recvmmsg(get_sock_fd(s), ctx->msgvec, ctx->vlen,
+                           ctx->flags, NULL);
+    return (ctx->result >= 0);
+}
+
+/* s.recvmmsg_into(buffers[, ancbufsize[, flags]]) method */
+
+static PyObject *
+sock_recvmmsg_into(PyObject *self, PyObject *args)
+{
+    PySocketSockObject *s = _PySocketSockObject_CAST(self);
+
+    Py_ssize_t ancbufsize = 0;
+    int flags = 0;
+    Py_ssize_t i, nitems, nbufs = 0, nreceived = 0;
+    Py_buffer *bufs = NULL;
+    struct iovec *iovs = NULL;
+    struct mmsghdr *msgvec = NULL;
+    sock_addr_t *addrbufs = NULL;
+    char *controlbuf = NULL;
+    socklen_t addrbuflen;
+    PyObject *buffers_arg, *fast, *retval = NULL;
+    struct sock_recvmmsg ctx;
+
+    if (!PyArg_ParseTuple(args, "O|ni:recvmmsg_into",
+                          &buffers_arg, &ancbufsize, &flags))
+        return NULL;
+
+    if ((fast = PySequence_Fast(buffers_arg,
+                                "recvmmsg_into() argument 1 must be an "
+                                "iterable")) == NULL)
+        return NULL;
+    nitems = PySequence_Fast_GET_SIZE(fast);
+    if (nitems > INT_MAX) {
+        PyErr_SetString(PyExc_OSError,
+                        "recvmmsg_into() argument 1 is too long");
+        goto finally;
+    }
+    if (ancbufsize < 0 || ancbufsize > SOCKLEN_T_LIMIT) {
+        PyErr_SetString(PyExc_ValueError,
+                        "invalid ancillary data buffer length");
+        goto finally;
+    }
+    if (!getsockaddrlen(s, &addrbuflen))
+        goto finally;
+    if (nitems == 0) {
+        retval = PyList_New(0);
+        goto finally;
+    }
+
+    /* Each buffer receives one datagram, with its own address and
+       ancillary data buffers.  Save the Py_buffer structs to release
+       afterwards. */
+    if ((iovs = PyMem_New(struct iovec, nitems)) == NULL ||
+        (bufs = PyMem_New(Py_buffer, nitems)) == NULL ||
+        (msgvec = PyMem_Calloc(nitems, sizeof(struct mmsghdr))) == NULL ||
+        (addrbufs = PyMem_New(sock_addr_t, nitems)) == NULL ||
+        (ancbufsize > 0 &&
+         (ancbufsize > PY_SSIZE_T_MAX / nitems ||
+          (controlbuf = PyMem_Malloc(ancbufsize * nitems)) == NULL))) {
+        PyErr_NoMemory();
+        goto finally;
+    }
+    for (; nbufs < nitems; nbufs++) {
+        struct msghdr *msg = &msgvec[nbufs].msg_hdr;
+
+        if (!PyArg_Parse(PySequence_Fast_GET_ITEM(fast, nbufs),
+                         "w*;recvmmsg_into() argument 1 must be an iterable "
+                         "of single-segment read-write buffers",
+                         &bufs[nbufs]))
+            goto finally;
+        iovs[nbufs].iov_base = bufs[nbufs].buf;
+        iovs[nbufs].iov_len = bufs[nbufs].len;
+
+        /* See the comment in sock_recvmsg_guts(). */
+        memset(&addrbufs[nbufs], 0, addrbuflen);
+        SAS2SA(&addrbufs[nbufs])->sa_family = AF_UNSPEC;
+        msg->msg_name = SAS2SA(&addrbufs[nbufs]);
+        msg->msg_namelen = addrbuflen;
+        msg->msg_iov = &iovs[nbufs];
+        msg->msg_iovlen = 1;
+        if (ancbufsize > 0) {
+            msg->msg_control = controlbuf + nbufs * ancbufsize;
+            msg->msg_controllen = ancbufsize;
+        }
+    }
+
+    /* Make the system call. */
+    if (!IS_SELECTABLE(s)) {
+        select_error();
+        goto finally;
+    }
+
+    ctx.msgvec = msgvec;
+    ctx.vlen = (unsigned int)nitems;
+    ctx.flags = flags;
+#ifdef MSG_WAITFORONE
+    /* Don't block once a datagram has been received. */
+    ctx.flags |= MSG_WAITFORONE;
+#endif
+    if (sock_call(s, 0, sock_recvmmsg_impl, &ctx) < 0)
+        goto finally;
+    nreceived = ctx.result;
+
+    if ((retval = PyList_New(nreceived)) == NULL)
+        goto err_closefds;
+    for (i = 0; i < nreceived; i++) {
+        struct msghdr *msg = &msgvec[i].msg_hdr;
+        PyObject *cmsg_list, *item;
+
+        if ((cmsg_list = make_cmsg_list(msg)) == NULL)
+            goto err_closefds;
+        item = Py_BuildValue("kNiN",
+                             (unsigned long)msgvec[i].msg_len,
+                             cmsg_list,
+                             (int)msg->msg_flags,
+                             makesockaddr(get_sock_fd(s), msg->msg_name,
+                                          ((msg->msg_namelen > addrbuflen) ?
+                                           addrbuflen : msg->msg_namelen),
+                                          s->sock_proto));
+        if (item == NULL)
+            goto err_closefds;
+        PyList_SET_ITEM(retval, i, item);
+    }
+
+finally:
+    for (i = 0; i < nbufs; i++)
+        PyBuffer_Release(&bufs[i]);
+    PyMem_Free(bufs);
+    PyMem_Free(iovs);
+    PyMem_Free(msgvec);
+    PyMem_Free(addrbufs);
+    PyMem_Free(controlbuf);
+    Py_DECREF(fast);
+    return retval;
+
+err_closefds:
+    Py_CLEAR(retval);
+    for (i = 0; i < nreceived; i++)
+        close_cmsg_fds(&msgvec[i].msg_hdr);
+    goto finally;
+}
+
+PyDoc_STRVAR(recvmmsg_into_doc,
+"recvmmsg_into(buffers[, ancbufsize[, flags]]) -> list of (nbytes, ancdata, msg_flags, address)\n\
+\n\
+Receive up to len(buffers) datagrams from the socket with a single\n\
+system call, writing each datagram into its own buffer.  The buffers\n\
+argument must be an iterable of objects that export writable buffers\n\
+(e.g. bytearray or memoryview objects).  The call returns as soon as\n\
+at least one datagram has been received.  The ancbufsize argument sets\n\
+the size in bytes of the buffer used to receive the ancillary data of\n\
+each datagram; it defaults to 0, meaning that no ancillary data will\n\
+be received.  The flags argument defaults to 0 and has the same\n\
+meaning as for recv().\n\
+\n\
+The return value is a list with one 4-tuple (nbytes, ancdata,\n\
+msg_flags, address) per datagram received, in the order of the\n\
+buffers they were written into.  The items have the same meaning as\n\
+in the return value of recvmsg_into().\n\
+\n\
+If recvmmsg_into() raises an exception after the system call returns,\n\
+it will first attempt to close any file descriptors received via the\n\
+SCM_RIGHTS mechanism.");
+#endif    /* HAVE_RECVMMSG */
 #endif    /* CMSG_LEN */
 
 
@@ -4580,6 +4889,187 @@ argument, see the Unix manual.  This calls send() repeatedly\n\
 until all data is sent.  If an error occurs, it's impossible\n\
 to tell how much data has been sent.");
 
+#ifdef HAVE_SOCK_ZEROCOPY
+/* s.send_zerocopy(data[, flags]) method */
+
+static PyObject *
+sock_send_zerocopy(PyObject *self, PyObject *args)
+{
+    PySocketSockObject *s = _PySocketSockObject_CAST(self);
+
+    int flags = 0, res;
+    Py_buffer pbuf;
+    struct sock_send ctx;
+
+    if (!PyArg_ParseTuple(args, "y*|i:send_zerocopy", &pbuf, &flags))
+        return NULL;
+
+    if (!IS_SELECTABLE(s)) {
+        PyBuffer_Release(&pbuf);
+        return select_error();
+    }
+    /* MSG_ZEROCOPY is silently ignored if SO_ZEROCOPY is not set: no
+       notification would release the buffer. */
+    if (!s->sock_zerocopy) {
+        int one = 1;
+        if (setsockopt(get_sock_fd(s), SOL_SOCKET, SO_ZEROCOPY,
+                       &one, sizeof(one)) < 0) {
+            PyBuffer_Release(&pbuf);
+            return s->errorhandler();
+        }
+        s->sock_zerocopy = 1;
+    }
+    /* The kernel numbers the sends in the order they queue data, and the
+       GIL is released around send(): the sends are serialized so that
+       each one gets the id of its buffer. */
+    PyMutex_Lock(&s->sock_zerocopy_mutex);
+    Py_BEGIN_CRITICAL_SECTION(s);
+    res = sock_zerocopy_reserve(s);
+    Py_END_CRITICAL_SECTION();
+    if (res < 0) {
+        goto error;
+    }
+
+    ctx.buf = pbuf.buf;
+    ctx.len = pbuf.len;
+    ctx.flags = flags | MSG_ZEROCOPY;
+    if (sock_call(s, 1, sock_send_impl, &ctx) < 0) {
+        goto error;
+    }
+    if (ctx.result == 0) {
+        /* Nothing was queued and no id was consumed. */
+        PyMutex_Unlock(&s->sock_zerocopy_mutex);
+        PyBuffer_Release(&pbuf);
+        return PyLong_FromSsize_t(0);
+    }
+
+    /* Only this function adds buffers, so the room reserved above is
+       still free. */
+    Py_BEGIN_CRITICAL_SECTION(s);
+    struct sock_zerocopy_buf *zb;
+    zb = &s->sock_zerocopy_bufs[s->sock_zerocopy_len++];
+    zb->id = s->sock_zerocopy_next++;
+    zb->view = pbuf;
+    Py_END_CRITICAL_SECTION();
+    PyMutex_Unlock(&s->sock_zerocopy_mutex);
+
+    return PyLong_FromSsize_t(ctx.result);
+
+error:
+    PyMutex_Unlock(&s->sock_zerocopy_mutex);
+    PyBuffer_Release(&pbuf);
+    return NULL;
+}
+
+PyDoc_STRVAR(send_zerocopy_doc,
+"send_zerocopy(data[, flags]) -> count\n\
+\n\
+Like send(data[, flags]), but avoid copying the data into the kernel,\n\
+using the MSG_ZEROCOPY flag.  The SO_ZEROCOPY option is enabled on the\n\
+socket first if needed.  The buffer of data is kept exported until the\n\
+kernel notifies that it no longer needs it; it must not be modified\n\
+until then.  Call zerocopy_completions() to read the notifications.\n\
+\n\
+Each call which sends data is assigned a sequential id, from 0.\n\
+\n\
+The buffers of the sends still pending when the socket is closed or\n\
+detached are never released.");
+
+/* s.zerocopy_completions() method */
+
+static PyObject *
+sock_zerocopy_completions(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    PySocketSockObject *s = _PySocketSockObject_CAST(self);
+
+    PyObject *list;
+
+    if ((list = PyList_New(0)) == NULL)
+        return NULL;
+    for (;;) {
+        union {
+            char buf[CMSG_SPACE(sizeof(struct sock_extended_err) +
+                                sizeof(sock_addr_t))];
+            struct cmsghdr align;
+        } control;
+        struct msghdr msg = {0};
+        struct cmsghdr *cmsgh;
+        ssize_t res;
+
+        msg.msg_control = control.buf;
+        msg.msg_controllen = sizeof(control.buf);
+        /* Reading the error queue never blocks. */
+        Py_BEGIN_ALLOW_THREADS
+        res = recvmsg(get_sock_fd(s), &msg, MSG_ERRQUEUE);
+        Py_END_ALLOW_THREADS
+        if (res < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+            if (errno == EINTR) {
+                if (PyErr_CheckSignals() < 0)
+                    goto error;
+                continue;
+            }
+            s->errorhandler();
+            goto error;
+        }
+
+        for (cmsgh = CMSG_FIRSTHDR(&msg); cmsgh != NULL;
+             cmsgh = CMSG_NXTHDR(&msg, cmsgh)) {
+            struct sock_extended_err *serr;
+            PyObject *item;
+            int copied, tmp;
+
+            if (!(cmsgh->cmsg_level == IPPROTO_IP &&
+                  cmsgh->cmsg_type == IP_RECVERR)
+#ifdef IPV6_RECVERR
+                && !(cmsgh->cmsg_level == IPPROTO_IPV6 &&
+                     cmsgh->cmsg_type == IPV6_RECVERR)
+#endif
+                )
+                continue;
+            serr = (struct sock_extended_err *)CMSG_DATA(cmsgh);
+            if (serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY ||
+                serr->ee_errno != 0)
+                continue;
+
+            if (sock_zerocopy_release(s, serr->ee_info, serr->ee_data) < 0)
+                goto error;
+
+#ifdef SO_EE_CODE_ZEROCOPY_COPIED
+            copied = (serr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0;
+#else
+            copied = 0;
+#endif
+            item = Py_BuildValue("kkO", (unsigned long)serr->ee_info,
+                                 (unsigned long)serr->ee_data,
+                                 copied ? Py_True : Py_False);
+            if (item == NULL)
+                goto error;
+            tmp = PyList_Append(list, item);
+            Py_DECREF(item);
+            if (tmp < 0)
+                goto error;
+        }
+    }
+    return list;
+
+error:
+    Py_DECREF(list);
+    return NULL;
+}
+
+PyDoc_STRVAR(zerocopy_completions_doc,
+"zerocopy_completions() -> list of (first, last, copied)\n\
+\n\
+Read the completion notifications of send_zerocopy() calls from the\n\
+error queue of the socket, without blocking, and release the buffers\n\
+of the completed sends.  Return a list of (first, last, copied) tuples:\n\
+the sends with ids from first to last inclusive (modulo 2**32) have\n\
+completed, and copied is true if the kernel had to copy the data\n\
+anyway, in which case zero-copy sends only add overhead.");
+#endif    /* HAVE_SOCK_ZEROCOPY */
+
 
 #ifdef HAVE_SENDTO
 struct sock_sendto {
@@ -4961,6 +5451,149 @@ the message.  The return value is the number of bytes of non-ancillary\n\
 data sent.");
 #endif    /* CMSG_LEN */
 
+#ifdef HAVE_SENDMMSG
+struct sock_sendmmsg {
+    struct mmsghdr *msgvec;
+    unsigned int vlen;
+    int flags;
+    int result;
+};
+
+static int
+sock_sendmmsg_impl(PySocketSockObject *s, void *data)
+{
+    struct sock_sendmmsg *ctx = data;
+
+    ctx->result = sendmmsg(get_sock_fd(s), ctx->msgvec, ctx->vlen,
+                           ctx->flags);
+    return (ctx->result >= 0);
+}
+
+/* s.sendmmsg(buffers[, flags[, addresses]]) method */
+
+static PyObject *
+sock_sendmmsg(PyObject *self, PyObject *args)
+{
+    PySocketSockObject *s = _PySocketSockObject_CAST(self);
+
+    Py_ssize_t i, nitems, nbufs = 0;
+    Py_buffer *bufs = NULL;
+    struct iovec *iovs = NULL;
+    struct mmsghdr *msgvec = NULL;
+    sock_addr_t *addrbufs = NULL;
+    int addrlen, flags = 0;
+    PyObject *data_arg, *addr_arg = NULL, *data_fast, *addr_fast = NULL,
+        *retval = NULL;
+    struct sock_sendmmsg ctx;
+
+    if (!PyArg_ParseTuple(args, "O|iO:sendmmsg",
+                          &data_arg, &flags, &addr_arg))
+        return NULL;
+
+    if ((data_fast = PySequence_Fast(data_arg,
+                                     "sendmmsg() argument 1 must be an "
+                                     "iterable")) == NULL)
+        return NULL;
+    nitems = PySequence_Fast_GET_SIZE(data_fast);
+    if (nitems > INT_MAX) {
+        PyErr_SetString(PyExc_OSError, "sendmmsg() argument 1 is too long");
+        goto finally;
+    }
+    if (addr_arg != NULL && addr_arg != Py_None) {
+        if ((addr_fast = PySequence_Fast(addr_arg,
+                                         "sendmmsg() argument 3 must be an "
+                                         "iterable")) == NULL)
+            goto finally;
+        if (PySequence_Fast_GET_SIZE(addr_fast) != nitems) {
+            PyErr_SetString(PyExc_ValueError,
+                            "sendmmsg() arguments 1 and 3 must have "
+                            "the same length");
+            goto finally;
+        }
+    }
+    if (nitems == 0) {
+        retval = PyLong_FromLong(0);
+        goto finally;
+    }
+
+    /* Each buffer is sent as one datagram, to the matching address if
+       addresses are given.  Save the Py_buffer structs to release
+       afterwards. */
+    if ((iovs = PyMem_New(struct iovec, nitems)) == NULL ||
+        (bufs = PyMem_New(Py_buffer, nitems)) == NULL ||
+        (msgvec = PyMem_Calloc(nitems, sizeof(struct mmsghdr))) == NULL ||
+        (addr_fast != NULL &&
+         (addrbufs = PyMem_New(sock_addr_t, nitems)) == NULL)) {
+        PyErr_NoMemory();
+        goto finally;
+    }
+    for (i = 0; i < nitems; i++) {
+        struct msghdr *msg = &msgvec[i].msg_hdr;
+
+        if (addr_fast != NULL) {
+            if (!getsockaddrarg(s, PySequence_Fast_GET_ITEM(addr_fast, i),
+                                &addrbufs[i], &addrlen, "sendmmsg"))
+                goto finally;
+            msg->msg_name = &addrbufs[i];
+            msg->msg_namelen = addrlen;
+        }
+    }
+    if (addr_fast != NULL &&
+        PySys_Audit("socket.sendmmsg", "OO", s, addr_arg) < 0)
+        goto finally;
+
+    for (; nbufs < nitems; nbufs++) {
+        struct msghdr *msg = &msgvec[nbufs].msg_hdr;
+
+        if (!PyArg_Parse(PySequence_Fast_GET_ITEM(data_fast, nbufs),
+                         "y*;sendmmsg() argument 1 must be an iterable of "
+                         "bytes-like objects",
+                         &bufs[nbufs]))
+            goto finally;
+        iovs[nbufs].iov_base = bufs[nbufs].buf;
+        iovs[nbufs].iov_len = bufs[nbufs].len;
+        msg->msg_iov = &iovs[nbufs];
+        msg->msg_iovlen = 1;
+    }
+
+    /* Make the system call. */
+    if (!IS_SELECTABLE(s)) {
+        select_error();
+        goto finally;
+    }
+
+    ctx.msgvec = msgvec;
+    ctx.vlen = (unsigned int)nitems;
+    ctx.flags = flags;
+    if (sock_call(s, 1, sock_sendmmsg_impl, &ctx) < 0)
+        goto finally;
+
+    retval = PyLong_FromLong(ctx.result);
+
+finally:
+    for (i = 0; i < nbufs; i++)
+        PyBuffer_Release(&bufs[i]);
+    PyMem_Free(bufs);
+    PyMem_Free(iovs);
+    PyMem_Free(msgvec);
+    PyMem_Free(addrbufs);
+    Py_XDECREF(addr_fast);
+    Py_DECREF(data_fast);
+    return retval;
+}
+
+PyDoc_STRVAR(sendmmsg_doc,
+"sendmmsg(buffers[, flags[, addresses]]) -> count\n\
+\n\
+Send each item of buffers as a separate datagram with a single system\n\
+call.  The buffers argument must be an iterable of bytes-like objects.\n\
+The flags argument defaults to 0 and has the same meaning as for\n\
+send().  If addresses is supplied and not None, it must be an iterable\n\
+of the same length as buffers, giving the destination address of each\n\
+datagram.  Return the number of datagrams sent, which may be less than\n\
+len(buffers).");
+#endif    /* HAVE_SENDMMSG */
+
 #ifdef HAVE_SOCKADDR_ALG
 static PyObject*
 sock_sendmsg_afalg(PyObject *s, PyObject *args, PyObject *kwds)
@@ -5317,6 +5950,17 @@ static PyMethodDef sock_methods[] = {
     {"recvmsg", sock_recvmsg, METH_VARARGS, recvmsg_doc},
     {"recvmsg_into", sock_recvmsg_into, METH_VARARGS, recvmsg_into_doc},
     {"sendmsg", sock_sendmsg, METH_VARARGS, sendmsg_doc},
+#ifdef HAVE_RECVMMSG
+    {"recvmmsg_into", sock_recvmmsg_into, METH_VARARGS, recvmmsg_into_doc},
+#endif
+#endif
+#ifdef HAVE_SENDMMSG
+    {"sendmmsg", sock_sendmmsg, METH_VARARGS, sendmmsg_doc},
+#endif
+#ifdef HAVE_SOCK_ZEROCOPY
+    {"send_zerocopy", sock_send_zerocopy, METH_VARARGS, send_zerocopy_doc},
+    {"zerocopy_completions", sock_zerocopy_completions, METH_NOARGS,
+                      zerocopy_completions_doc},
 #endif
 #ifdef HAVE_SOCKADDR_ALG
     {
@@ -5376,6 +6020,9 @@ sock_finalize(PyObject *self)
         (void) SOCKETCLOSE(fd);
         Py_END_ALLOW_THREADS
     }
+#ifdef HAVE_SOCK_ZEROCOPY
+    sock_zerocopy_abandon(s);
+#endif
 
     /* Restore the saved exception. */
     PyErr_SetRaisedException(exc);
@@ -8071,6 +8718,9 @@ socket_exec(PyObject *m)
 #ifdef SO_PROTOCOL
     ADD_INT_MACRO(m, SO_PROTOCOL);
 #endif
+#ifdef  SO_ZEROCOPY
+    ADD_INT_MACRO(m, SO_ZEROCOPY);
+#endif
 #ifdef LOCAL_CREDS
     ADD_INT_MACRO(m, LOCAL_CREDS);
 #endif
@@ -8164,6 +8814,9 @@ socket_exec(PyObject *m)
 #ifdef MSG_FASTOPEN
     ADD_INT_MACRO(m, MSG_FASTOPEN);
 #endif
+#ifdef  MSG_ZEROCOPY
+    ADD_INT_MACRO(m, MSG_ZEROCOPY);
+#endif
 
     /* Protocol level and numbers, usable for [gs]etsockopt */
 #ifdef  SOL_SOCKET
@@ -8811,6 +9464,14 @@ socket_exec(PyObject *m)
     ADD_INT_MACRO(m, TCP_TX_DELAY);
 #endif
 
+    /* UDP options */
+#ifdef  UDP_SEGMENT
+    ADD_INT_MACRO(m, UDP_SEGMENT);
+#endif
+#ifdef  UDP_GRO
+    ADD_INT_MACRO(m, UDP_GRO);
+#endif
+
     /* IPX options */
 #ifdef  IPX_TYPE
     ADD_INT_MACRO(m, IPX_TYPE);
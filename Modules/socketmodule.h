@@ -9,6 +9,9 @@
 # endif
 # include <netinet/in.h>
 # include <netinet/tcp.h>
+# ifdef HAVE_NETINET_UDP_H
+#   include <netinet/udp.h>
+# endif
 
 #else /* MS_WINDOWS */
 # include <winsock2.h>
@@ -176,6 +179,17 @@ typedef int socklen_t;
 # include <linux/netfilter_ipv4.h>
 #endif
 
+#ifdef HAVE_LINUX_ERRQUEUE_H
+# include <linux/errqueue.h>
+#endif
+
+/* MSG_ZEROCOPY sends, with completion notifications read from the
+   error queue of the socket (Linux 4.14 and later) */
+#if defined(MSG_ZEROCOPY) && defined(SO_ZEROCOPY) && \
+    defined(SO_EE_ORIGIN_ZEROCOPY) && defined(MSG_ERRQUEUE)
+# define HAVE_SOCK_ZEROCOPY
+#endif
+
 #ifdef HAVE_SOCKADDR_ALG
 
 # include <linux/if_alg.h>
@@ -332,6 +346,15 @@ typedef struct {
 #ifdef MS_WINDOWS
     int quickack;
 #endif
+#ifdef HAVE_SOCK_ZEROCOPY
+    int sock_zerocopy;          /* SO_ZEROCOPY set by send_zerocopy() */
+    uint32_t sock_zerocopy_next; /* Notification id of the next send */
+    PyMutex sock_zerocopy_mutex; /* Serializes the zero-copy sends */
+    /* Buffers of the zero-copy sends not completed yet, by id */
+    struct sock_zerocopy_buf *sock_zerocopy_bufs;
+    Py_ssize_t sock_zerocopy_len;
+    Py_ssize_t sock_zerocopy_size;
+#endif
 } PySocketSockObject;
 
 /* --- C API ----------------------------------------------------*/
@@ -6,6 +6,7 @@ preserve
 #  include "pycore_gc.h"          // PyGC_Head
 #  include "pycore_runtime.h"     // _Py_ID()
 #endif
+#include "pycore_abstract.h"      // _PyNumber_Index()
 #include "pycore_modsupport.h"    // _PyArg_UnpackKeywords()
 
 PyDoc_STRVAR(memoryview__doc__,
@@ -473,4 +474,167 @@ skip_optional:
 exit:
     return return_value;
 }
-/*[clinic end generated code: output=2ef6c061d9c4e3dc input=a9049054013a1b77]*/
+
+PyDoc_STRVAR(memoryview_split__doc__,
+"split($self, /, sep=None, maxsplit=-1)\n"
+"--\n"
+"\n"
+"Return a list of views of the sections in the memory, using sep as the delimiter.\n"
+"\n"
+"  sep\n"
+"    The delimiter according which to split the bytes.\n"
+"    None (the default value) means split on ASCII whitespace characters\n"
+"    (space, tab, return, newline, formfeed, vertical tab).\n"
+"  maxsplit\n"
+"    Maximum number of splits to do.\n"
+"    -1 (the default value) means no limit.\n"
+"\n"
+"Like bytes.split(), but the sections are memoryviews sharing the memory\n"
+"of this one instead of copies.");
+
+#define MEMORYVIEW_SPLIT_METHODDEF    \
+    {"split", _PyCFunction_CAST(memoryview_split), METH_FASTCALL|METH_KEYWORDS, memoryview_split__doc__},
+
+static PyObject *
+memoryview_split_impl(PyMemoryViewObject *self, PyObject *sep,
+                      Py_ssize_t maxsplit);
+
+static PyObject *
+memoryview_split(PyObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
+{
+    PyObject *return_value = NULL;
+    #if defined(Py_BUILD_CORE) && !defined(Py_BUILD_CORE_MODULE)
+
+    #define NUM_KEYWORDS 2
+    static struct {
+        PyGC_Head _this_is_not_used;
+        PyObject_VAR_HEAD
+        PyObject *ob_item[NUM_KEYWORDS];
+    } _kwtuple = {
+        .ob_base = PyVarObject_HEAD_INIT(&PyTuple_Type, NUM_KEYWORDS)
+        .ob_item = { &_Py_ID(sep), &_Py_ID(maxsplit), },
+    };
+    #undef NUM_KEYWORDS
+    #define KWTUPLE (&_kwtuple.ob_base.ob_base)
+
+    #else  // !Py_BUILD_CORE
+    #  define KWTUPLE NULL
+    #endif  // !Py_BUILD_CORE
+
+    static const char * const _keywords[] = {"sep", "maxsplit", NULL};
+    static _PyArg_Parser _parser = {
+        .keywords = _keywords,
+        .fname = "split",
+        .kwtuple = KWTUPLE,
+    };
+    #undef KWTUPLE
+    PyObject *argsbuf[2];
+    Py_ssize_t noptargs = nargs + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 0;
+    PyObject *sep = Py_None;
+    Py_ssize_t maxsplit = -1;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser,
+            /*minpos*/ 0, /*maxpos*/ 2, /*minkw*/ 0, /*varpos*/ 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    if (!noptargs) {
+        goto skip_optional_pos;
+    }
+    if (args[0]) {
+        sep = args[0];
+        if (!--noptargs) {
+            goto skip_optional_pos;
+        }
+    }
+    {
+        Py_ssize_t ival = -1;
+        PyObject *iobj = _PyNumber_Index(args[1]);
+        if (iobj != NULL) {
+            ival = PyLong_AsSsize_t(iobj);
+            Py_DECREF(iobj);
+        }
+        if (ival == -1 && PyErr_Occurred()) {
+            goto exit;
+        }
+        maxsplit = ival;
+    }
+skip_optional_pos:
+    return_value = memoryview_split_impl((PyMemoryViewObject *)self, sep, maxsplit);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(memoryview_partition__doc__,
+"partition($self, sep, /)\n"
+"--\n"
+"\n"
+"Partition the memory into three views using the given separator.\n"
+"\n"
+"Like bytes.partition(), but the parts are memoryviews sharing the memory\n"
+"of this one instead of copies.  If the separator is not found, return\n"
+"a view of the whole memory and two empty views.");
+
+#define MEMORYVIEW_PARTITION_METHODDEF    \
+    {"partition", (PyCFunction)memoryview_partition, METH_O, memoryview_partition__doc__},
+
+static PyObject *
+memoryview_partition_impl(PyMemoryViewObject *self, Py_buffer *sep);
+
+static PyObject *
+memoryview_partition(PyObject *self, PyObject *arg)
+{
+    PyObject *return_value = NULL;
+    Py_buffer sep = {NULL, NULL};
+
+    if (PyObject_GetBuffer(arg, &sep, PyBUF_SIMPLE) != 0) {
+        goto exit;
+    }
+    return_value = memoryview_partition_impl((PyMemoryViewObject *)self, &sep);
+
+exit:
+    /* Cleanup for sep */
+    if (sep.obj) {
+       PyBuffer_Release(&sep);
+    }
+
+    return return_value;
+}
+
+PyDoc_STRVAR(memoryview_rpartition__doc__,
+"rpartition($self, sep, /)\n"
+"--\n"
+"\n"
+"Partition the memory into three views using the given separator.\n"
+"\n"
+"Like bytes.rpartition(), but the parts are memoryviews sharing the memory\n"
+"of this one instead of copies.  If the separator is not found, return\n"
+"two empty views and a view of the whole memory.");
+
+#define MEMORYVIEW_RPARTITION_METHODDEF    \
+    {"rpartition", (PyCFunction)memoryview_rpartition, METH_O, memoryview_rpartition__doc__},
+
+static PyObject *
+memoryview_rpartition_impl(PyMemoryViewObject *self, Py_buffer *sep);
+
+static PyObject *
+memoryview_rpartition(PyObject *self, PyObject *arg)
+{
+    PyObject *return_value = NULL;
+    Py_buffer sep = {NULL, NULL};
+
+    if (PyObject_GetBuffer(arg, &sep, PyBUF_SIMPLE) != 0) {
+        goto exit;
+    }
+    return_value = memoryview_rpartition_impl((PyMemoryViewObject *)self, &sep);
+
+exit:
+    /* Cleanup for sep */
+    if (sep.obj) {
+       PyBuffer_Release(&sep);
+    }
+
+    return return_value;
+}
+/*[clinic end generated code: output=21424c2d0eb80d8a input=a9049054013a1b77]*/
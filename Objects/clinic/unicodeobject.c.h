@@ -7,6 +7,7 @@ preserve
 #  include "pycore_runtime.h"     // _Py_ID()
 #endif
 #include "pycore_abstract.h"      // _PyNumber_Index()
+#include "pycore_critical_section.h"// Py_BEGIN_CRITICAL_SECTION()
 #include "pycore_modsupport.h"    // _PyArg_CheckPositional()
 
 PyDoc_STRVAR(EncodingMap_size__doc__,
@@ -1894,4 +1895,150 @@ skip_optional_pos:
 exit:
     return return_value;
 }
-/*[clinic end generated code: output=db37497bf38a2c17 input=a9049054013a1b77]*/
+
+PyDoc_STRVAR(stringbuilder_new__doc__,
+"StringBuilder()\n"
+"--\n"
+"\n"
+"Create an empty string builder.\n"
+"\n"
+"Strings appended to the builder are copied into a buffer which grows by\n"
+"a factor, so that building a string of n characters takes O(n) time.");
+
+static PyObject *
+stringbuilder_new_impl(PyTypeObject *type);
+
+static PyObject *
+stringbuilder_new(PyTypeObject *type, PyObject *args, PyObject *kwargs)
+{
+    PyObject *return_value = NULL;
+    PyTypeObject *base_tp = &StringBuilderType;
+
+    if ((type == base_tp || type->tp_init == base_tp->tp_init) &&
+        !_PyArg_NoPositional("StringBuilder", args)) {
+        goto exit;
+    }
+    if ((type == base_tp || type->tp_init == base_tp->tp_init) &&
+        !_PyArg_NoKeywords("StringBuilder", kwargs)) {
+        goto exit;
+    }
+    return_value = stringbuilder_new_impl(type);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_string_StringBuilder_append__doc__,
+"append($self, s, /)\n"
+"--\n"
+"\n"
+"Append s to the builder.");
+
+#define _STRING_STRINGBUILDER_APPEND_METHODDEF    \
+    {"append", (PyCFunction)_string_StringBuilder_append, METH_O, _string_StringBuilder_append__doc__},
+
+static PyObject *
+_string_StringBuilder_append_impl(struct stringbuilder *self, PyObject *s);
+
+static PyObject *
+_string_StringBuilder_append(PyObject *self, PyObject *arg)
+{
+    PyObject *return_value = NULL;
+    PyObject *s;
+
+    if (!PyUnicode_Check(arg)) {
+        _PyArg_BadArgument("append", "argument", "str", arg);
+        goto exit;
+    }
+    s = arg;
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _string_StringBuilder_append_impl((struct stringbuilder *)self, s);
+    Py_END_CRITICAL_SECTION();
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_string_StringBuilder_write__doc__,
+"write($self, s, /)\n"
+"--\n"
+"\n"
+"Append s to the builder and return the number of characters written.\n"
+"\n"
+"This allows the builder to be used as the file argument of print().");
+
+#define _STRING_STRINGBUILDER_WRITE_METHODDEF    \
+    {"write", (PyCFunction)_string_StringBuilder_write, METH_O, _string_StringBuilder_write__doc__},
+
+static PyObject *
+_string_StringBuilder_write_impl(struct stringbuilder *self, PyObject *s);
+
+static PyObject *
+_string_StringBuilder_write(PyObject *self, PyObject *arg)
+{
+    PyObject *return_value = NULL;
+    PyObject *s;
+
+    if (!PyUnicode_Check(arg)) {
+        _PyArg_BadArgument("write", "argument", "str", arg);
+        goto exit;
+    }
+    s = arg;
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _string_StringBuilder_write_impl((struct stringbuilder *)self, s);
+    Py_END_CRITICAL_SECTION();
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(_string_StringBuilder_build__doc__,
+"build($self, /)\n"
+"--\n"
+"\n"
+"Return the contents of the builder as a str.\n"
+"\n"
+"The builder keeps its contents and can be appended to afterwards.");
+
+#define _STRING_STRINGBUILDER_BUILD_METHODDEF    \
+    {"build", (PyCFunction)_string_StringBuilder_build, METH_NOARGS, _string_StringBuilder_build__doc__},
+
+static PyObject *
+_string_StringBuilder_build_impl(struct stringbuilder *self);
+
+static PyObject *
+_string_StringBuilder_build(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _string_StringBuilder_build_impl((struct stringbuilder *)self);
+    Py_END_CRITICAL_SECTION();
+
+    return return_value;
+}
+
+PyDoc_STRVAR(_string_StringBuilder_clear__doc__,
+"clear($self, /)\n"
+"--\n"
+"\n"
+"Remove all the contents of the builder.");
+
+#define _STRING_STRINGBUILDER_CLEAR_METHODDEF    \
+    {"clear", (PyCFunction)_string_StringBuilder_clear, METH_NOARGS, _string_StringBuilder_clear__doc__},
+
+static PyObject *
+_string_StringBuilder_clear_impl(struct stringbuilder *self);
+
+static PyObject *
+_string_StringBuilder_clear(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+
+    Py_BEGIN_CRITICAL_SECTION(self);
+    return_value = _string_StringBuilder_clear_impl((struct stringbuilder *)self);
+    Py_END_CRITICAL_SECTION();
+
+    return return_value;
+}
+/*[clinic end generated code: output=dc24c2b42df21283 input=a9049054013a1b77]*/
@@ -31,6 +31,9 @@ As of Python 3.6, this is compact and ordered. Basic idea is described here:
 | dk_entries[]        |
 |                     |
 +---------------------+
+| dk_ctrl[]           |  (only for large tables of string keys,
+|                     |   see "Grouped tables" below)
++---------------------+
 
 dk_indices is actual hashtable.  It holds index in entries, or DKIX_EMPTY(-1)
 or DKIX_DUMMY(-2).
@@ -57,6 +60,8 @@ The DictObject can be in one of two forms.
   A combined table:
     ma_values == NULL, dk_refcnt == 1.
     Values are stored in the me_value field of the PyDictKeyEntry.
+    dk_refcnt > 1 when the table is shared by copies of the dict, see
+    "Copy-on-write" below.
 Or:
   A split table:
     ma_values != NULL, dk_refcnt >= 1
@@ -124,9 +129,11 @@ As a consequence of this, split keys have a maximum size of 16.
 #include "pycore_dict.h"                 // export _PyDict_SizeOf()
 #include "pycore_freelist.h"             // _PyFreeListState_GET()
 #include "pycore_gc.h"                   // _PyObject_GC_IS_TRACKED()
+#include "pycore_hashtable.h"            // _Py_hashtable_new()
 #include "pycore_object.h"               // _PyObject_GC_TRACK(), _PyDebugAllocatorStats()
 #include "pycore_pyatomic_ft_wrappers.h" // FT_ATOMIC_LOAD_SSIZE_RELAXED
 #include "pycore_pyerrors.h"             // _PyErr_GetRaisedException()
+#include "pycore_pylifecycle.h"          // _Py_IsInterpreterFinalizing()
 #include "pycore_pystate.h"              // _PyThreadState_GET()
 #include "pycore_setobject.h"            // _PySet_NextEntry()
 #include "stringlib/eq.h"                // unicode_eq()
@@ -420,6 +427,91 @@ _PyDict_DebugMallocStats(FILE *out)
 
 static void free_keys_object(PyDictKeysObject *keys, bool use_qsbr);
 
+/* Copy-on-write
+
+Copying a dict with a combined table normally clones its keys object, which
+is O(n): every key and value is increfed.  Instead, the copy shares the keys
+object and dk_refcnt counts the dicts using it.  Any in-place modification
+of a shared table first gives the dict its own clone with
+unshare_combined_keys(), and dictresize() takes its own references to the
+entries of a shared table.
+
+The entries of a shared table hold a single reference to their keys and
+values for all the dicts using it, so the GC must visit them only once.  The
+table is represented to the GC by a _PyDictSharedKeys_Type object, found
+through the interp->dict_state.shared_keys hashtable: each dict using the
+table owns a reference to it and visits it instead of the entries, and it
+visits the entries.  It is detached from the table when only one dict still
+uses it.
+
+Only tables of at least DICT_COW_MIN_ENTRIES entries are shared: cloning a
+smaller table costs less than the bookkeeping, and small copies are usually
+modified.  Tables are no longer shared once the interpreter is finalizing,
+since the hashtable is destroyed with it; _PyDict_ClearSharedKeys() detaches
+the _PyDictSharedKeys_Type objects which are still alive then.
+
+gc.get_referents() and gc.get_referrers() see through the
+_PyDictSharedKeys_Type objects: they report the keys and values as the
+referents of each dict sharing the table.
+
+The free-threaded build always clones: a lock-free reader may still probe a
+table that its dict stopped sharing, and must not see another dict modify
+it in place.
+*/
+
+#ifdef Py_GIL_DISABLED
+#  define DICT_COPY_ON_WRITE 0
+#else
+#  define DICT_COPY_ON_WRITE 1
+#endif
+
+#define DICT_COW_MIN_ENTRIES 1024
+
+typedef struct {
+    PyObject_HEAD
+    PyDictKeysObject *keys;  /* borrowed, NULL once no longer shared */
+} PyDictSharedKeysObject;
+
+/* Return true if the combined table keys is shared by several dicts. */
+static inline int
+dictkeys_shared(PyDictKeysObject *keys)
+{
+#if DICT_COPY_ON_WRITE
+    assert(keys->dk_kind != DICT_KEYS_SPLIT);
+    return keys->dk_refcnt > 1;
+#else
+    (void)keys;
+    return 0;
+#endif
+}
+
+/* Return the GC object of a shared table, or NULL if it has none (once the
+   interpreter is being finalized). */
+static PyObject *
+shared_keys_lookup(PyInterpreterState *interp, PyDictKeysObject *keys)
+{
+    _Py_hashtable_t *ht = interp->dict_state.shared_keys;
+    return ht == NULL ? NULL : _Py_hashtable_get(ht, keys);
+}
+
+/* Called when a dict stops using the shared table keys. */
+static void
+shared_keys_release(PyInterpreterState *interp, PyDictKeysObject *keys)
+{
+    PyDictSharedKeysObject *sk;
+    sk = (PyDictSharedKeysObject *)shared_keys_lookup(interp, keys);
+    if (sk == NULL) {
+        return;
+    }
+    if (keys->dk_refcnt == 2) {
+        /* The remaining dict visits the entries itself again. */
+        _Py_hashtable_steal(interp->dict_state.shared_keys, keys);
+        sk->keys = NULL;
+        Py_DECREF(sk);
+    }
+    Py_DECREF(sk);
+}
+
 /* PyDictKeysObject has refcounts like PyObject does, so we have the
    following two functions to mirror what Py_INCREF() and Py_DECREF() do.
    (Keep in mind that PyDictKeysObject isn't actually a PyObject.)
@@ -451,6 +543,11 @@ dictkeys_decref(PyInterpreterState *interp, PyDictKeysObject *dk, bool use_qsbr)
 #ifdef Py_REF_DEBUG
     _Py_DecRefTotal(_PyThreadState_GET());
 #endif
+    if (DICT_COPY_ON_WRITE && dk->dk_kind != DICT_KEYS_SPLIT
+        && dk->dk_refcnt > 1)
+    {
+        shared_keys_release(interp, dk);
+    }
     if (DECREF_KEYS(dk) == 1) {
         if (DK_IS_UNICODE(dk)) {
             PyDictUnicodeEntry *entries = DK_UNICODE_ENTRIES(dk);
@@ -574,6 +671,120 @@ estimate_log2_keysize(Py_ssize_t n)
 }
 
 
+/* Grouped tables.
+ *
+ * Once a table of string keys is large enough that dk_indices no longer
+ * fits in the CPU caches, nearly every probe of the classic scheme costs a
+ * cache miss in dk_indices, another one in dk_entries and a third one to
+ * read the hash of the key object, even when the slot holds an unrelated
+ * key.  Such tables (DICT_KEYS_UNICODE with at least
+ * 2**DK_GROUPED_MIN_LOG2SIZE slots) carry one control byte per slot after
+ * dk_entries:
+ *
+ *   - DK_CTRL_EMPTY for a DKIX_EMPTY slot,
+ *   - DK_CTRL_DUMMY for a DKIX_DUMMY slot,
+ *   - otherwise the 7 most significant bits of the hash of the key.
+ *
+ * The slots are probed by groups of DK_GROUP_WIDTH consecutive slots, the
+ * groups being visited in the order explained above (with j a group
+ * number).  The control bytes of a group share a cache line and are
+ * compared with the hash tag at once using SSE2 or NEON, so that only
+ * the slots whose tag matches are looked up in dk_indices and dk_entries.
+ * The lookup ends at the first group that has an Unused slot.
+ */
+#define DK_GROUPED_MIN_LOG2SIZE 16
+#define DK_GROUP_WIDTH 16
+#define DK_LOG2_GROUP_WIDTH 4
+
+#define DK_CTRL_EMPTY ((uint8_t)0x80)
+#define DK_CTRL_DUMMY ((uint8_t)0xfe)
+
+#define DK_IS_GROUPED(dk) \
+    ((dk)->dk_kind == DICT_KEYS_UNICODE \
+     && DK_LOG_SIZE(dk) >= DK_GROUPED_MIN_LOG2SIZE)
+
+/* Group matching loads 16 bytes at once, which the thread sanitizer would
+ * report as racing with the relaxed stores of the control bytes. */
+#if defined(_Py_THREAD_SANITIZER)
+   /* use the portable version */
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#  include <emmintrin.h>
+#  define DK_GROUP_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#  include <arm_neon.h>
+#  define DK_GROUP_NEON
+#endif
+
+/* A group mask has one bit set per matching slot, at bit
+ * (slot << DK_GROUP_MASK_SHIFT). */
+#ifdef DK_GROUP_NEON
+#  define DK_GROUP_MASK_SHIFT 2
+#else
+#  define DK_GROUP_MASK_SHIFT 0
+#endif
+
+static inline uint8_t *
+dictkeys_ctrl(PyDictKeysObject *keys)
+{
+    assert(DK_IS_GROUPED(keys));
+    return (uint8_t *)&DK_UNICODE_ENTRIES(keys)[USABLE_FRACTION(DK_SIZE(keys))];
+}
+
+static inline uint8_t
+dictkeys_hash_tag(Py_hash_t hash)
+{
+    return (uint8_t)((size_t)hash >> (SIZEOF_SIZE_T * 8 - 7));
+}
+
+static inline void
+dictkeys_set_ctrl(PyDictKeysObject *keys, Py_ssize_t i, uint8_t ctrl)
+{
+    FT_ATOMIC_STORE_UINT8_RELAXED(dictkeys_ctrl(keys)[i], ctrl);
+}
+
+/* Return the mask of the slots of the group whose control byte is ctrl. */
+static inline uint64_t
+dictkeys_group_match(const uint8_t *group, uint8_t ctrl)
+{
+#if defined(DK_GROUP_SSE2)
+    __m128i g = _mm_loadu_si128((const __m128i *)group);
+    __m128i eq = _mm_cmpeq_epi8(g, _mm_set1_epi8((char)ctrl));
+    return (uint64_t)(unsigned int)_mm_movemask_epi8(eq);
+#elif defined(DK_GROUP_NEON)
+    uint8x16_t eq = vceqq_u8(vld1q_u8(group), vdupq_n_u8(ctrl));
+    /* Narrow every byte to a nibble, keep one bit per nibble. */
+    uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0)
+           & UINT64_C(0x8888888888888888);
+#else
+    uint64_t mask = 0;
+    for (int j = 0; j < DK_GROUP_WIDTH; j++) {
+        if (FT_ATOMIC_LOAD_UINT8_RELAXED(group[j]) == ctrl) {
+            mask |= (uint64_t)1 << j;
+        }
+    }
+    return mask;
+#endif
+}
+
+/* Return the position in its group of the first slot of a non-zero mask. */
+static inline Py_ssize_t
+dictkeys_group_first(uint64_t mask)
+{
+    assert(mask != 0);
+#if defined(__clang__) || defined(__GNUC__)
+    return __builtin_ctzll(mask) >> DK_GROUP_MASK_SHIFT;
+#else
+    Py_ssize_t j = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        j++;
+    }
+    return j >> DK_GROUP_MASK_SHIFT;
+#endif
+}
+
+
 /* GROWTH_RATE. Growth rate upon hitting maximum load.
  * Currently set to used*3.
  * This means that dicts double in size when growing without deletions,
@@ -673,7 +884,8 @@ _PyDict_CheckConsistency(PyObject *op, int check_content)
     if (!splitted) {
         /* combined table */
         CHECK(keys->dk_kind != DICT_KEYS_SPLIT);
-        CHECK(keys->dk_refcnt == 1 || keys == Py_EMPTY_KEYS);
+        CHECK(keys->dk_refcnt == 1 || keys == Py_EMPTY_KEYS
+              || dictkeys_shared(keys));
     }
     else {
         CHECK(keys->dk_kind == DICT_KEYS_SPLIT);
@@ -689,6 +901,19 @@ _PyDict_CheckConsistency(PyObject *op, int check_content)
         for (Py_ssize_t i=0; i < DK_SIZE(keys); i++) {
             Py_ssize_t ix = dictkeys_get_index(keys, i);
             CHECK(DKIX_DUMMY <= ix && ix <= usable);
+            if (DK_IS_GROUPED(keys)) {
+                uint8_t ctrl = dictkeys_ctrl(keys)[i];
+                if (ix == DKIX_EMPTY) {
+                    CHECK(ctrl == DK_CTRL_EMPTY);
+                }
+                else if (ix == DKIX_DUMMY) {
+                    CHECK(ctrl == DK_CTRL_DUMMY);
+                }
+                else {
+                    PyObject *key = DK_UNICODE_ENTRIES(keys)[ix].me_key;
+                    CHECK(ctrl == dictkeys_hash_tag(unicode_get_hash(key)));
+                }
+            }
         }
 
         if (keys->dk_kind == DICT_KEYS_GENERAL) {
@@ -774,6 +999,11 @@ new_keys_object(PyInterpreterState *interp, uint8_t log2_size, bool unicode)
         log2_bytes = log2_size + 2;
     }
 
+    size_t ctrl_size = 0;
+    if (unicode && log2_size >= DK_GROUPED_MIN_LOG2SIZE) {
+        ctrl_size = (size_t)1 << log2_size;
+    }
+
     PyDictKeysObject *dk = NULL;
     if (log2_size == PyDict_LOG_MINSIZE && unicode) {
         dk = _Py_FREELIST_POP_MEM(dictkeys);
@@ -781,7 +1011,8 @@ new_keys_object(PyInterpreterState *interp, uint8_t log2_size, bool unicode)
     if (dk == NULL) {
         dk = PyMem_Malloc(sizeof(PyDictKeysObject)
                           + ((size_t)1 << log2_bytes)
-                          + entry_size * usable);
+                          + entry_size * usable
+                          + ctrl_size);
         if (dk == NULL) {
             PyErr_NoMemory();
             return NULL;
@@ -802,6 +1033,9 @@ new_keys_object(PyInterpreterState *interp, uint8_t log2_size, bool unicode)
     dk->dk_version = 0;
     memset(&dk->dk_indices[0], 0xff, ((size_t)1 << log2_bytes));
     memset(&dk->dk_indices[(size_t)1 << log2_bytes], 0, entry_size * usable);
+    if (ctrl_size) {
+        memset(dictkeys_ctrl(dk), DK_CTRL_EMPTY, ctrl_size);
+    }
     return dk;
 }
 
@@ -906,32 +1140,14 @@ new_dict_with_shared_keys(PyInterpreterState *interp, PyDictKeysObject *keys)
 }
 
 
-static PyDictKeysObject *
-clone_combined_dict_keys(PyDictObject *orig)
+/* Incref the keys and values of the first n entries of a combined table,
+   which are about to be co-owned by a new table. */
+static void
+dictkeys_incref_entries(PyDictKeysObject *keys, Py_ssize_t n)
 {
-    assert(PyDict_Check(orig));
-    assert(Py_TYPE(orig)->tp_iter == dict_iter);
-    assert(orig->ma_values == NULL);
-    assert(orig->ma_keys != Py_EMPTY_KEYS);
-    assert(orig->ma_keys->dk_refcnt == 1);
-
-    ASSERT_DICT_LOCKED(orig);
-
-    size_t keys_size = _PyDict_KeysSize(orig->ma_keys);
-    PyDictKeysObject *keys = PyMem_Malloc(keys_size);
-    if (keys == NULL) {
-        PyErr_NoMemory();
-        return NULL;
-    }
-
-    memcpy(keys, orig->ma_keys, keys_size);
-
-    /* After copying key/value pairs, we need to incref all
-       keys and values and they are about to be co-owned by a
-       new dict object. */
     PyObject **pkey, **pvalue;
     size_t offs;
-    if (DK_IS_UNICODE(orig->ma_keys)) {
+    if (DK_IS_UNICODE(keys)) {
         PyDictUnicodeEntry *ep0 = DK_UNICODE_ENTRIES(keys);
         pkey = &ep0->me_key;
         pvalue = &ep0->me_value;
@@ -944,7 +1160,6 @@ clone_combined_dict_keys(PyDictObject *orig)
         offs = sizeof(PyDictKeyEntry) / sizeof(PyObject*);
     }
 
-    Py_ssize_t n = keys->dk_nentries;
     for (Py_ssize_t i = 0; i < n; i++) {
         PyObject *value = *pvalue;
         if (value != NULL) {
@@ -954,17 +1169,116 @@ clone_combined_dict_keys(PyDictObject *orig)
         pvalue += offs;
         pkey += offs;
     }
+}
+
+static PyDictKeysObject *
+clone_combined_dict_keys(PyDictObject *orig)
+{
+    assert(PyDict_Check(orig));
+    assert(orig->ma_values == NULL);
+    assert(orig->ma_keys != Py_EMPTY_KEYS);
+    assert(orig->ma_keys->dk_refcnt == 1 || dictkeys_shared(orig->ma_keys));
+
+    ASSERT_DICT_LOCKED(orig);
+
+    size_t keys_size = _PyDict_KeysSize(orig->ma_keys);
+    PyDictKeysObject *keys = PyMem_Malloc(keys_size);
+    if (keys == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+
+    memcpy(keys, orig->ma_keys, keys_size);
+    keys->dk_refcnt = 1;
+
+    /* After copying key/value pairs, we need to incref all
+       keys and values and they are about to be co-owned by a
+       new dict object. */
+    dictkeys_incref_entries(keys, keys->dk_nentries);
 
     /* Since we copied the keys table we now have an extra reference
        in the system.  Manually call increment _Py_RefTotal to signal that
        we have it now; calling dictkeys_incref would be an error as
-       keys->dk_refcnt is already set to 1 (after memcpy). */
+       keys->dk_refcnt is already set to 1. */
 #ifdef Py_REF_DEBUG
     _Py_IncRefTotal(_PyThreadState_GET());
 #endif
     return keys;
 }
 
+/* Share the combined table of mp with a new dict: return a new reference to
+   it, or NULL without an exception set if it can't be shared. */
+static PyDictKeysObject *
+share_combined_keys(PyInterpreterState *interp, PyDictObject *mp)
+{
+#if DICT_COPY_ON_WRITE
+    PyDictKeysObject *keys = mp->ma_keys;
+    assert(mp->ma_values == NULL);
+    if (keys == Py_EMPTY_KEYS || keys->dk_nentries < DICT_COW_MIN_ENTRIES) {
+        return NULL;
+    }
+    if (dictkeys_shared(keys)) {
+        PyObject *sk = shared_keys_lookup(interp, keys);
+        if (sk == NULL) {
+            return NULL;
+        }
+        Py_INCREF(sk);
+    }
+    else {
+        _Py_hashtable_t *ht = interp->dict_state.shared_keys;
+        if (ht == NULL) {
+            if (_Py_IsInterpreterFinalizing(interp)) {
+                return NULL;
+            }
+            ht = _Py_hashtable_new(_Py_hashtable_hash_ptr,
+                                   _Py_hashtable_compare_direct);
+            if (ht == NULL) {
+                return NULL;
+            }
+            interp->dict_state.shared_keys = ht;
+        }
+        PyDictSharedKeysObject *sk = PyObject_GC_New(PyDictSharedKeysObject,
+                                                     &_PyDictSharedKeys_Type);
+        if (sk == NULL) {
+            PyErr_Clear();
+            return NULL;
+        }
+        sk->keys = NULL;
+        if (_Py_hashtable_set(ht, keys, sk) < 0) {
+            Py_DECREF(sk);
+            return NULL;
+        }
+        sk->keys = keys;
+        /* One reference for mp and one for its copy. */
+        Py_INCREF(sk);
+        _PyObject_GC_TRACK(sk);
+    }
+    dictkeys_incref(keys);
+    return keys;
+#else
+    (void)interp;
+    (void)mp;
+    return NULL;
+#endif
+}
+
+/* Give the combined dict mp its own table if it shares it with other dicts,
+   before it is modified in place. */
+static int
+unshare_combined_keys(PyInterpreterState *interp, PyDictObject *mp)
+{
+    if (mp->ma_values != NULL || !dictkeys_shared(mp->ma_keys)) {
+        return 0;
+    }
+    PyDictKeysObject *keys = clone_combined_dict_keys(mp);
+    if (keys == NULL) {
+        return -1;
+    }
+    dictkeys_decref(interp, mp->ma_keys, false);
+    set_keys(mp, keys);
+    return 0;
+}
+
 PyObject *
 PyDict_New(void)
 {
@@ -973,10 +1287,40 @@ PyDict_New(void)
     return new_dict(interp, Py_EMPTY_KEYS, NULL, 0, 0);
 }
 
+/* lookdict_index() for grouped tables */
+static Py_ssize_t
+lookdict_index_grouped(PyDictKeysObject *k, Py_hash_t hash, Py_ssize_t index)
+{
+    const uint8_t *ctrl = dictkeys_ctrl(k);
+    uint8_t tag = dictkeys_hash_tag(hash);
+    size_t gmask = DK_MASK(k) >> DK_LOG2_GROUP_WIDTH;
+    size_t perturb = (size_t)hash;
+    size_t g = ((size_t)hash & DK_MASK(k)) >> DK_LOG2_GROUP_WIDTH;
+
+    for (;;) {
+        const uint8_t *group = &ctrl[g << DK_LOG2_GROUP_WIDTH];
+        for (uint64_t m = dictkeys_group_match(group, tag); m; m &= m - 1) {
+            size_t i = (g << DK_LOG2_GROUP_WIDTH) + dictkeys_group_first(m);
+            if (dictkeys_get_index(k, i) == index) {
+                return i;
+            }
+        }
+        if (dictkeys_group_match(group, DK_CTRL_EMPTY)) {
+            return DKIX_EMPTY;
+        }
+        perturb >>= PERTURB_SHIFT;
+        g = gmask & (g*5 + perturb + 1);
+    }
+    Py_UNREACHABLE();
+}
+
 /* Search index of hash table from offset of entry table */
 static Py_ssize_t
 lookdict_index(PyDictKeysObject *k, Py_hash_t hash, Py_ssize_t index)
 {
+    if (DK_IS_GROUPED(k)) {
+        return lookdict_index_grouped(k, hash, index);
+    }
     size_t mask = DK_MASK(k);
     size_t perturb = (size_t)hash;
     size_t i = (size_t)hash & mask;
@@ -995,10 +1339,50 @@ lookdict_index(PyDictKeysObject *k, Py_hash_t hash, Py_ssize_t index)
     Py_UNREACHABLE();
 }
 
+/* do_lookup() for grouped tables: only the slots whose control byte
+   matches the tag of the hash are checked. */
+static inline Py_ALWAYS_INLINE Py_ssize_t
+do_lookup_grouped(PyDictObject *mp, PyDictKeysObject *dk, PyObject *key, Py_hash_t hash,
+                  int (*check_lookup)(PyDictObject *, PyDictKeysObject *, void *, Py_ssize_t ix, PyObject *key, Py_hash_t))
+{
+    void *ep0 = _DK_ENTRIES(dk);
+    const uint8_t *ctrl = dictkeys_ctrl(dk);
+    uint8_t tag = dictkeys_hash_tag(hash);
+    size_t gmask = DK_MASK(dk) >> DK_LOG2_GROUP_WIDTH;
+    size_t perturb = hash;
+    size_t g = ((size_t)hash & DK_MASK(dk)) >> DK_LOG2_GROUP_WIDTH;
+    for (;;) {
+        const uint8_t *group = &ctrl[g << DK_LOG2_GROUP_WIDTH];
+        for (uint64_t m = dictkeys_group_match(group, tag); m; m &= m - 1) {
+            size_t i = (g << DK_LOG2_GROUP_WIDTH) + dictkeys_group_first(m);
+            // In the free-threaded build, the control byte may be ahead of
+            // the index.
+            Py_ssize_t ix = dictkeys_get_index(dk, i);
+            if (ix >= 0) {
+                int cmp = check_lookup(mp, dk, ep0, ix, key, hash);
+                if (cmp < 0) {
+                    return cmp;
+                } else if (cmp) {
+                    return ix;
+                }
+            }
+        }
+        if (dictkeys_group_match(group, DK_CTRL_EMPTY)) {
+            return DKIX_EMPTY;
+        }
+        perturb >>= PERTURB_SHIFT;
+        g = gmask & (g*5 + perturb + 1);
+    }
+    Py_UNREACHABLE();
+}
+
 static inline Py_ALWAYS_INLINE Py_ssize_t
 do_lookup(PyDictObject *mp, PyDictKeysObject *dk, PyObject *key, Py_hash_t hash,
           int (*check_lookup)(PyDictObject *, PyDictKeysObject *, void *, Py_ssize_t ix, PyObject *key, Py_hash_t))
 {
+    if (DK_IS_GROUPED(dk)) {
+        return do_lookup_grouped(mp, dk, key, hash, check_lookup);
+    }
     void *ep0 = _DK_ENTRIES(dk);
     size_t mask = DK_MASK(dk);
     size_t perturb = hash;
@@ -1686,10 +2070,35 @@ is_unusable_slot(Py_ssize_t ix)
 /* Internal function to find slot for an item from its hash
    when it is known that the key is not present in the dict.
  */
+static Py_ssize_t
+find_empty_slot_grouped(PyDictKeysObject *keys, Py_hash_t hash)
+{
+    const uint8_t *ctrl = dictkeys_ctrl(keys);
+    size_t gmask = DK_MASK(keys) >> DK_LOG2_GROUP_WIDTH;
+    size_t perturb = (size_t)hash;
+    size_t g = ((size_t)hash & DK_MASK(keys)) >> DK_LOG2_GROUP_WIDTH;
+    for (;;) {
+        const uint8_t *group = &ctrl[g << DK_LOG2_GROUP_WIDTH];
+        uint64_t m = dictkeys_group_match(group, DK_CTRL_EMPTY);
+#ifndef Py_GIL_DISABLED
+        m |= dictkeys_group_match(group, DK_CTRL_DUMMY);
+#endif
+        if (m) {
+            return (g << DK_LOG2_GROUP_WIDTH) + dictkeys_group_first(m);
+        }
+        perturb >>= PERTURB_SHIFT;
+        g = gmask & (g*5 + perturb + 1);
+    }
+    Py_UNREACHABLE();
+}
+
 static Py_ssize_t
 find_empty_slot(PyDictKeysObject *keys, Py_hash_t hash)
 {
     assert(keys != NULL);
+    if (DK_IS_GROUPED(keys)) {
+        return find_empty_slot_grouped(keys, hash);
+    }
 
     const size_t mask = DK_MASK(keys);
     size_t i = hash & mask;
@@ -1718,12 +2127,18 @@ insert_combined_dict(PyInterpreterState *interp, PyDictObject *mp,
             return -1;
         }
     }
+    else if (unshare_combined_keys(interp, mp) < 0) {
+        return -1;
+    }
 
     _PyDict_NotifyEvent(interp, PyDict_EVENT_ADDED, mp, key, value);
     FT_ATOMIC_STORE_UINT32_RELAXED(mp->ma_keys->dk_version, 0);
 
     Py_ssize_t hashpos = find_empty_slot(mp->ma_keys, hash);
     dictkeys_set_index(mp->ma_keys, hashpos, mp->ma_keys->dk_nentries);
+    if (DK_IS_GROUPED(mp->ma_keys)) {
+        dictkeys_set_ctrl(mp->ma_keys, hashpos, dictkeys_hash_tag(hash));
+    }
 
     if (DK_IS_UNICODE(mp->ma_keys)) {
         PyDictUnicodeEntry *ep;
@@ -1849,6 +2264,9 @@ insertdict(PyInterpreterState *interp, PyDictObject *mp,
     }
 
     if (old_value != value) {
+        if (unshare_combined_keys(interp, mp) < 0) {
+            goto Fail;
+        }
         _PyDict_NotifyEvent(interp, PyDict_EVENT_MODIFIED, mp, key, value);
         assert(old_value != NULL);
         assert(!_PyDict_HasSplitTable(mp));
@@ -1940,6 +2358,16 @@ build_indices_generic(PyDictKeysObject *keys, PyDictKeyEntry *ep, Py_ssize_t n)
 static void
 build_indices_unicode(PyDictKeysObject *keys, PyDictUnicodeEntry *ep, Py_ssize_t n)
 {
+    if (DK_IS_GROUPED(keys)) {
+        for (Py_ssize_t ix = 0; ix != n; ix++, ep++) {
+            Py_hash_t hash = unicode_get_hash(ep->me_key);
+            assert(hash != -1);
+            Py_ssize_t i = find_empty_slot_grouped(keys, hash);
+            dictkeys_set_index(keys, i, ix);
+            dictkeys_set_ctrl(keys, i, dictkeys_hash_tag(hash));
+        }
+        return;
+    }
     size_t mask = DK_MASK(keys);
     for (Py_ssize_t ix = 0; ix != n; ix++, ep++) {
         Py_hash_t hash = unicode_get_hash(ep->me_key);
@@ -2113,7 +2541,12 @@ dictresize(PyInterpreterState *interp, PyDictObject *mp,
 
         set_keys(mp, newkeys);
 
-        if (oldkeys != Py_EMPTY_KEYS) {
+        if (oldkeys != Py_EMPTY_KEYS && dictkeys_shared(oldkeys)) {
+            /* The old table stays alive for the other dicts sharing it. */
+            dictkeys_incref_entries(newkeys, numentries);
+            dictkeys_decref(interp, oldkeys, false);
+        }
+        else if (oldkeys != Py_EMPTY_KEYS) {
 #ifdef Py_REF_DEBUG
             _Py_DecRefTotal(_PyThreadState_GET());
 #endif
@@ -2703,8 +3136,12 @@ delitem_common(PyDictObject *mp, Py_hash_t hash, Py_ssize_t ix,
         ASSERT_CONSISTENT(mp);
     }
     else {
+        assert(!dictkeys_shared(mp->ma_keys));
         FT_ATOMIC_STORE_UINT32_RELAXED(mp->ma_keys->dk_version, 0);
         dictkeys_set_index(mp->ma_keys, hashpos, DKIX_DUMMY);
+        if (DK_IS_GROUPED(mp->ma_keys)) {
+            dictkeys_set_ctrl(mp->ma_keys, hashpos, DK_CTRL_DUMMY);
+        }
         if (DK_IS_UNICODE(mp->ma_keys)) {
             PyDictUnicodeEntry *ep = &DK_UNICODE_ENTRIES(mp->ma_keys)[ix];
             old_key = ep->me_key;
@@ -2763,6 +3200,9 @@ delitem_knownhash_lock_held(PyObject *op, PyObject *key, Py_hash_t hash)
     }
 
     PyInterpreterState *interp = _PyInterpreterState_GET();
+    if (unshare_combined_keys(interp, mp) < 0) {
+        return -1;
+    }
     _PyDict_NotifyEvent(interp, PyDict_EVENT_DELETED, mp, key, NULL);
     delitem_common(mp, hash, ix, old_value);
     return 0;
@@ -2810,6 +3250,9 @@ delitemif_lock_held(PyObject *op, PyObject *key,
 
     if (res > 0) {
         PyInterpreterState *interp = _PyInterpreterState_GET();
+        if (unshare_combined_keys(interp, mp) < 0) {
+            return -1;
+        }
         _PyDict_NotifyEvent(interp, PyDict_EVENT_DELETED, mp, key, NULL);
         delitem_common(mp, hash, ix, old_value);
         return 1;
@@ -2861,7 +3304,7 @@ clear_lock_held(PyObject *op)
     STORE_USED(mp, 0);
     if (oldvalues == NULL) {
         set_keys(mp, Py_EMPTY_KEYS);
-        assert(oldkeys->dk_refcnt == 1);
+        assert(oldkeys->dk_refcnt == 1 || dictkeys_shared(oldkeys));
         dictkeys_decref(interp, oldkeys, IS_DICT_SHARED(mp));
     }
     else {
@@ -3017,6 +3460,12 @@ _PyDict_Pop_KnownHash(PyDictObject *mp, PyObject *key, Py_hash_t hash,
 
     assert(old_value != NULL);
     PyInterpreterState *interp = _PyInterpreterState_GET();
+    if (unshare_combined_keys(interp, mp) < 0) {
+        if (result) {
+            *result = NULL;
+        }
+        return -1;
+    }
     _PyDict_NotifyEvent(interp, PyDict_EVENT_DELETED, mp, key, NULL);
     delitem_common(mp, hash, ix, Py_NewRef(old_value));
 
@@ -3262,7 +3711,8 @@ dict_dealloc(PyObject *self)
         dictkeys_decref(interp, keys, false);
     }
     else if (keys != NULL) {
-        assert(keys->dk_refcnt == 1 || keys == Py_EMPTY_KEYS);
+        assert(keys->dk_refcnt == 1 || keys == Py_EMPTY_KEYS
+               || dictkeys_shared(keys));
         dictkeys_decref(interp, keys, false);
     }
     if (Py_IS_TYPE(mp, &PyDict_Type)) {
@@ -3787,9 +4237,12 @@ dict_dict_merge(PyInterpreterState *interp, PyDictObject *mp, PyDictObject *othe
              USABLE_FRACTION(DK_SIZE(okeys)/2) < other->ma_used)
         ) {
             _PyDict_NotifyEvent(interp, PyDict_EVENT_CLONED, mp, (PyObject *)other, NULL);
-            PyDictKeysObject *keys = clone_combined_dict_keys(other);
-            if (keys == NULL)
-                return -1;
+            PyDictKeysObject *keys = share_combined_keys(interp, other);
+            if (keys == NULL) {
+                keys = clone_combined_dict_keys(other);
+                if (keys == NULL)
+                    return -1;
+            }
 
             ensure_shared_on_resize(mp);
             dictkeys_decref(interp, mp->ma_keys, IS_DICT_SHARED(mp));
@@ -4073,9 +4526,12 @@ copy_lock_held(PyObject *o)
            operations and copied after that.  In cases like this, we defer to
            PyDict_Merge, which produces a compacted copy.
         */
-        PyDictKeysObject *keys = clone_combined_dict_keys(mp);
+        PyDictKeysObject *keys = share_combined_keys(interp, mp);
         if (keys == NULL) {
-            return NULL;
+            keys = clone_combined_dict_keys(mp);
+            if (keys == NULL) {
+                return NULL;
+            }
         }
         PyDictObject *new = (PyDictObject *)new_dict(interp, keys, NULL, 0, 0);
         if (new == NULL) {
@@ -4517,6 +4973,10 @@ dict_popitem_impl(PyDictObject *self)
             return NULL;
         }
     }
+    else if (unshare_combined_keys(interp, self) < 0) {
+        Py_DECREF(res);
+        return NULL;
+    }
     FT_ATOMIC_STORE_UINT32_RELAXED(self->ma_keys->dk_version, 0);
 
     /* Pop last item */
@@ -4558,6 +5018,9 @@ dict_popitem_impl(PyDictObject *self)
     assert(j >= 0);
     assert(dictkeys_get_index(self->ma_keys, j) == i);
     dictkeys_set_index(self->ma_keys, j, DKIX_DUMMY);
+    if (DK_IS_GROUPED(self->ma_keys)) {
+        dictkeys_set_ctrl(self->ma_keys, j, DK_CTRL_DUMMY);
+    }
 
     PyTuple_SET_ITEM(res, 0, key);
     PyTuple_SET_ITEM(res, 1, value);
@@ -4569,25 +5032,14 @@ dict_popitem_impl(PyDictObject *self)
 }
 
 static int
-dict_traverse(PyObject *op, visitproc visit, void *arg)
+dictkeys_traverse_combined(PyDictKeysObject *keys, visitproc visit, void *arg)
 {
-    PyDictObject *mp = (PyDictObject *)op;
-    PyDictKeysObject *keys = mp->ma_keys;
     Py_ssize_t i, n = keys->dk_nentries;
 
     if (DK_IS_UNICODE(keys)) {
-        if (_PyDict_HasSplitTable(mp)) {
-            if (!mp->ma_values->embedded) {
-                for (i = 0; i < n; i++) {
-                    Py_VISIT(mp->ma_values->values[i]);
-                }
-            }
-        }
-        else {
-            PyDictUnicodeEntry *entries = DK_UNICODE_ENTRIES(keys);
-            for (i = 0; i < n; i++) {
-                Py_VISIT(entries[i].me_value);
-            }
+        PyDictUnicodeEntry *entries = DK_UNICODE_ENTRIES(keys);
+        for (i = 0; i < n; i++) {
+            Py_VISIT(entries[i].me_value);
         }
     }
     else {
@@ -4602,6 +5054,83 @@ dict_traverse(PyObject *op, visitproc visit, void *arg)
     return 0;
 }
 
+static int
+dict_traverse(PyObject *op, visitproc visit, void *arg)
+{
+    PyDictObject *mp = (PyDictObject *)op;
+    PyDictKeysObject *keys = mp->ma_keys;
+    Py_ssize_t i, n = keys->dk_nentries;
+
+    if (_PyDict_HasSplitTable(mp)) {
+        if (!mp->ma_values->embedded) {
+            for (i = 0; i < n; i++) {
+                Py_VISIT(mp->ma_values->values[i]);
+            }
+        }
+        return 0;
+    }
+    if (dictkeys_shared(keys)) {
+        /* See "Copy-on-write". */
+        Py_VISIT(shared_keys_lookup(_PyInterpreterState_GET(), keys));
+        return 0;
+    }
+    return dictkeys_traverse_combined(keys, visit, arg);
+}
+
+static int
+shared_keys_traverse(PyObject *op, visitproc visit, void *arg)
+{
+    PyDictKeysObject *keys = ((PyDictSharedKeysObject *)op)->keys;
+    if (keys == NULL) {
+        return 0;
+    }
+    return dictkeys_traverse_combined(keys, visit, arg);
+}
+
+static void
+shared_keys_dealloc(PyObject *op)
+{
+    PyObject_GC_UnTrack(op);
+    assert(((PyDictSharedKeysObject *)op)->keys == NULL);
+    PyObject_GC_Del(op);
+}
+
+PyTypeObject _PyDictSharedKeys_Type = {
+    PyVarObject_HEAD_INIT(&PyType_Type, 0)
+    "dict_shared_keys",
+    sizeof(PyDictSharedKeysObject),
+    0,
+    .tp_dealloc = shared_keys_dealloc,
+    .tp_getattro = PyObject_GenericGetAttr,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .tp_traverse = shared_keys_traverse,
+    .tp_free = PyObject_GC_Del,
+    .tp_hash = PyObject_HashNotImplemented,
+};
+
+static int
+shared_keys_detach(_Py_hashtable_t *ht, const void *key, const void *value,
+                   void *arg)
+{
+    ((PyDictSharedKeysObject *)value)->keys = NULL;
+    return 0;
+}
+
+/* Called when the interpreter is cleared: the _PyDictSharedKeys_Type
+   objects of the dicts which are still alive can no longer be found, and
+   must not refer to tables which can be freed. */
+void
+_PyDict_ClearSharedKeys(PyInterpreterState *interp)
+{
+    _Py_hashtable_t *ht = interp->dict_state.shared_keys;
+    if (ht == NULL) {
+        return;
+    }
+    interp->dict_state.shared_keys = NULL;
+    (void)_Py_hashtable_foreach(ht, shared_keys_detach, NULL);
+    _Py_hashtable_destroy(ht);
+}
+
 static int
 dict_tp_clear(PyObject *op)
 {
@@ -4646,6 +5175,9 @@ _PyDict_KeysSize(PyDictKeysObject *keys)
     size_t size = sizeof(PyDictKeysObject);
     size += (size_t)1 << keys->dk_log2_index_bytes;
     size += USABLE_FRACTION((size_t)DK_SIZE(keys)) * es;
+    if (DK_IS_GROUPED(keys)) {
+        size += (size_t)DK_SIZE(keys);
+    }
     return size;
 }
 
@@ -2,6 +2,7 @@
 
 #include "Python.h"
 #include "pycore_call.h"          // _PyObject_CallNoArgs()
+#include "pycore_freelist.h"      // _Py_FREELIST_FREE(), _Py_FREELIST_POP()
 #include "pycore_long.h"          // _PyLong_GetOne()
 #include "pycore_modsupport.h"    // _PyArg_NoKwnames()
 #include "pycore_object.h"        // _PyObject_GC_TRACK()
@@ -46,11 +47,22 @@ static PyObject *
 enum_new_impl(PyTypeObject *type, PyObject *iterable, PyObject *start)
 /*[clinic end generated code: output=e95e6e439f812c10 input=782e4911efcb8acf]*/
 {
-    enumobject *en;
+    enumobject *en = NULL;
 
-    en = (enumobject *)type->tp_alloc(type, 0);
-    if (en == NULL)
-        return NULL;
+    if (type == &PyEnum_Type) {
+        en = _Py_FREELIST_POP(enumobject, enumerates);
+        if (en != NULL) {
+            en->en_sit = NULL;
+            en->en_result = NULL;
+            en->en_longindex = NULL;
+            _PyObject_GC_TRACK(en);
+        }
+    }
+    if (en == NULL) {
+        en = (enumobject *)type->tp_alloc(type, 0);
+        if (en == NULL)
+            return NULL;
+    }
     if (start != NULL) {
         start = PyNumber_Index(start);
         if (start == NULL) {
@@ -158,7 +170,12 @@ enum_dealloc(PyObject *op)
     Py_XDECREF(en->en_sit);
     Py_XDECREF(en->en_result);
     Py_XDECREF(en->en_longindex);
-    Py_TYPE(en)->tp_free(en);
+    if (Py_IS_TYPE(en, &PyEnum_Type)) {
+        _Py_FREELIST_FREE(enumerates, en, PyObject_GC_Del);
+    }
+    else {
+        Py_TYPE(en)->tp_free(en);
+    }
 }
 
 static int
@@ -177,11 +177,22 @@ gen_dealloc(PyObject *self)
     }
     gen_clear_frame(gen);
     assert(gen->gi_exc_state.exc_value == NULL);
+    // The executable is not a code object if _Py_MakeCoro() failed
+    // before the frame was copied into the generator.
+    PyObject *executable = PyStackRef_AsPyObjectBorrow(gen->gi_iframe.f_executable);
+    int slots = PyGen_MAXSAVESLOTS;
+    if (PyCode_Check(executable)) {
+        slots = _PyFrame_NumSlotsForCodeObject((PyCodeObject *)executable);
+    }
     PyStackRef_CLEAR(gen->gi_iframe.f_executable);
     Py_CLEAR(gen->gi_name);
     Py_CLEAR(gen->gi_qualname);
 
-    PyObject_GC_Del(gen);
+    if (slots >= PyGen_MAXSAVESLOTS ||
+        !_Py_FREELIST_PUSH(gens[slots], gen, Py_gens_MAXFREELIST))
+    {
+        PyObject_GC_Del(gen);
+    }
 }
 
 static PySendResult
@@ -908,11 +919,24 @@ make_gen(PyTypeObject *type, PyFunctionObject *func)
 {
     PyCodeObject *code = (PyCodeObject *)func->func_code;
     int slots = _PyFrame_NumSlotsForCodeObject(code);
-    PyGenObject *gen = PyObject_GC_NewVar(PyGenObject, type, slots);
+    PyGenObject *gen = NULL;
+    if (slots < PyGen_MAXSAVESLOTS) {
+        gen = _Py_FREELIST_POP(PyGenObject, gens[slots]);
+        if (gen != NULL) {
+            // Generators, coroutines and async generators share the same
+            // layout, so the free list holds all of them.
+            Py_SET_TYPE(gen, type);
+            _PyGC_CLEAR_FINALIZED((PyObject *)gen);
+        }
+    }
     if (gen == NULL) {
-        return NULL;
+        gen = PyObject_GC_NewVar(PyGenObject, type, slots);
+        if (gen == NULL) {
+            return NULL;
+        }
     }
     gen->gi_frame_state = FRAME_CLEARED;
+    gen->gi_iframe.f_executable = PyStackRef_None;
     gen->gi_weakreflist = NULL;
     gen->gi_exc_state.exc_value = NULL;
     gen->gi_exc_state.previous_item = NULL;
@@ -37,6 +37,12 @@ static PyLongObject* long_neg(PyLongObject *v);
 static PyLongObject *x_divrem(PyLongObject *, PyLongObject *, PyLongObject **);
 static PyObject* long_long(PyObject *v);
 static PyObject* long_lshift_int64(PyLongObject *a, int64_t shiftby);
+static PyObject* long_lshift1(PyLongObject *a, Py_ssize_t wordshift,
+                              digit remshift);
+static PyObject* long_rshift1(PyLongObject *a, Py_ssize_t wordshift,
+                              digit remshift);
+static PyLongObject* long_abs(PyLongObject *v);
+static PyLongObject* long_mul(PyLongObject *a, PyLongObject *b);
 
 
 static inline void
@@ -81,6 +87,20 @@ maybe_small_long(PyLongObject *v)
 #define KARATSUBA_CUTOFF 70
 #define KARATSUBA_SQUARE_CUTOFF (2 * KARATSUBA_CUTOFF)
 
+/* Above TOOM3_CUTOFF digits, balanced products use Toom-3, and above
+ * NTT_CUTOFF digits a number-theoretic transform, as long as the product has
+ * at most NTT_MAX_SIZE digits.  The cutoffs were measured with
+ * Tools/scripts/mul_threshold.py.
+ */
+#define TOOM3_CUTOFF 150
+#define NTT_CUTOFF 3000
+#define NTT_MAX_SIZE ((Py_ssize_t)1 << 23)
+
+/* Above BZ_CUTOFF bits of quotient, division of large ints uses the
+ * Burnikel-Ziegler recursive algorithm (see l_divmod()).
+ */
+#define BZ_CUTOFF 4000
+
 /* For exponentiation, use the binary left-to-right algorithm unless the
  ^ exponent contains more than HUGE_EXP_CUTOFF bits.  In that case, do
  * (no more than) EXP_WINDOW_SIZE bits at a time.  The potential drawback is
@@ -4070,6 +4090,8 @@ kmul_split(PyLongObject *n,
 }
 
 static PyLongObject *k_lopsided_mul(PyLongObject *a, PyLongObject *b);
+static PyLongObject *toom3_mul(PyLongObject *a, PyLongObject *b);
+static PyLongObject *ntt_mul(PyLongObject *a, PyLongObject *b);
 
 /* Karatsuba multiplication.  Ignores the input signs, and returns the
  * absolute value of the product (or NULL if error).
@@ -4119,6 +4141,10 @@ k_mul(PyLongObject *a, PyLongObject *b)
             return x_mul(a, b);
     }
 
+    /* The cost of the NTT only depends on the size of the product. */
+    if (asize > NTT_CUTOFF && asize + bsize <= NTT_MAX_SIZE)
+        return ntt_mul(a, b);
+
     /* If a is small compared to b, splitting on b gives a degenerate
      * case with ah==0, and Karatsuba may be (even much) less efficient
      * than "grade school" then.  However, we can still win, by viewing
@@ -4128,6 +4154,9 @@ k_mul(PyLongObject *a, PyLongObject *b)
     if (2 * asize <= bsize)
         return k_lopsided_mul(a, b);
 
+    if (asize > TOOM3_CUTOFF)
+        return toom3_mul(a, b);
+
     /* Split a & b into hi & lo pieces. */
     shift = bsize >> 1;
     if (kmul_split(a, shift, &ah, &al) < 0) goto fail;
@@ -4348,6 +4377,449 @@ k_lopsided_mul(PyLongObject *a, PyLongObject *b)
     return NULL;
 }
 
+/* Split n into three pieces of k digits, so that
+ * abs(n) == (parts[2] << 2*k) + (parts[1] << k) + parts[0], viewing the
+ * shifts as being by digits.  Returns 0 on success, -1 on failure.
+ */
+static int
+toom3_split(PyLongObject *n, Py_ssize_t k, PyLongObject *parts[3])
+{
+    PyLongObject *hi;
+
+    if (kmul_split(n, k, &hi, &parts[0]) < 0)
+        return -1;
+    if (kmul_split(hi, k, &parts[2], &parts[1]) < 0) {
+        Py_DECREF(hi);
+        Py_CLEAR(parts[0]);
+        return -1;
+    }
+    Py_DECREF(hi);
+    return 0;
+}
+
+/* Evaluate the polynomial n[0] + n[1]*x + n[2]*x**2 at x = 1, -1 and -2,
+ * storing the values in v[0], v[1] and v[2].  Returns 0 on success, -1 on
+ * failure.
+ */
+static int
+toom3_eval(PyLongObject *n[3], PyLongObject *v[3])
+{
+    PyLongObject *p, *t;
+
+    v[0] = v[1] = v[2] = NULL;
+    if ((p = long_add(n[0], n[2])) == NULL)
+        return -1;
+    v[0] = long_add(p, n[1]);
+    v[1] = long_sub(p, n[1]);
+    Py_DECREF(p);
+    if (v[0] == NULL || v[1] == NULL)
+        goto fail;
+    if ((t = long_add(v[1], n[2])) == NULL)
+        goto fail;
+    p = long_add(t, t);
+    Py_DECREF(t);
+    if (p == NULL)
+        goto fail;
+    v[2] = long_sub(p, n[0]);
+    Py_DECREF(p);
+    if (v[2] == NULL)
+        goto fail;
+    return 0;
+
+  fail:
+    Py_CLEAR(v[0]);
+    Py_CLEAR(v[1]);
+    return -1;
+}
+
+/* Exact division of a (possibly negative) int by 2 or 3. */
+static PyLongObject *
+toom3_divexact(PyLongObject *a, digit n)
+{
+    PyLongObject *z;
+    digit rem;
+
+    if (n == 2)
+        return (PyLongObject *)long_rshift1(a, 0, 1);
+    z = divrem1(a, n, &rem);
+    assert(rem == 0);
+    if (z != NULL && _PyLong_IsNegative(a))
+        _PyLong_Negate(&z);
+    return z;
+}
+
+/* Toom-3 multiplication.  Ignores the input signs, and returns the absolute
+ * value of the product (or NULL if error).  a and b are split into three
+ * pieces of k digits, which are the coefficients of two polynomials of
+ * degree 2 in X = BASE**k.  The polynomials are evaluated at 0, 1, -1, -2
+ * and infinity, the 5 values are multiplied pairwise, and the product is
+ * interpolated back with Bodrato's sequence ("Towards Optimal Toom-Cook
+ * Multiplication for Univariate and Multivariate Polynomials in
+ * Characteristic 2 and 0", WAIFI 2007).  That is 5 multiplies of numbers a
+ * third the size, instead of the 9 of the grade school method.
+ */
+static PyLongObject *
+toom3_mul(PyLongObject *a, PyLongObject *b)
+{
+    Py_ssize_t asize = _PyLong_DigitCount(a);
+    Py_ssize_t bsize = _PyLong_DigitCount(b);
+    PyLongObject *an[3] = {NULL}, *bn[3] = {NULL};
+    PyLongObject *av[3] = {NULL}, *bv[3] = {NULL};
+    /* Products at 0, 1, -1, -2 and infinity, then coefficients of X**i. */
+    PyLongObject *r[5] = {NULL};
+    PyLongObject *t = NULL, *ret = NULL;
+    Py_ssize_t k, i;
+
+    k = (Py_MAX(asize, bsize) + 2) / 3;
+    if (toom3_split(a, k, an) < 0)
+        goto fail;
+    if (toom3_eval(an, av) < 0)
+        goto fail;
+    if (a == b) {
+        for (i = 0; i < 3; i++) {
+            bn[i] = (PyLongObject *)Py_NewRef(an[i]);
+            bv[i] = (PyLongObject *)Py_NewRef(av[i]);
+        }
+    }
+    else {
+        if (toom3_split(b, k, bn) < 0)
+            goto fail;
+        if (toom3_eval(bn, bv) < 0)
+            goto fail;
+    }
+
+    if ((r[0] = long_mul(an[0], bn[0])) == NULL)
+        goto fail;
+    if ((r[1] = long_mul(av[0], bv[0])) == NULL)
+        goto fail;
+    if ((r[2] = long_mul(av[1], bv[1])) == NULL)
+        goto fail;
+    if ((r[3] = long_mul(av[2], bv[2])) == NULL)
+        goto fail;
+    if ((r[4] = long_mul(an[2], bn[2])) == NULL)
+        goto fail;
+
+    /* Interpolation.  With r1, rm1, rm2 the products at 1, -1 and -2:
+     *     c3 = (rm2 - r1) / 3
+     *     c1 = (r1 - rm1) / 2
+     *     c2 = rm1 - r0
+     *     c3 = (c2 - c3) / 2 + 2*rinf
+     *     c2 = c2 + c1 - rinf
+     *     c1 = c1 - c3
+     * All the divisions are exact.
+     */
+#define TOOM3_SET(i, expr) \
+    do { if ((t = (expr)) == NULL) goto fail; Py_SETREF(r[i], t); } while (0)
+    TOOM3_SET(3, long_sub(r[3], r[1]));
+    TOOM3_SET(3, toom3_divexact(r[3], 3));
+    TOOM3_SET(1, long_sub(r[1], r[2]));
+    TOOM3_SET(1, toom3_divexact(r[1], 2));
+    TOOM3_SET(2, long_sub(r[2], r[0]));
+    TOOM3_SET(3, long_sub(r[2], r[3]));
+    TOOM3_SET(3, toom3_divexact(r[3], 2));
+    TOOM3_SET(3, long_add(r[3], r[4]));
+    TOOM3_SET(3, long_add(r[3], r[4]));
+    TOOM3_SET(2, long_add(r[2], r[1]));
+    TOOM3_SET(2, long_sub(r[2], r[4]));
+    TOOM3_SET(1, long_sub(r[1], r[3]));
+#undef TOOM3_SET
+
+    /* Add the coefficients into the result at offsets i*k.  They are all
+     * nonnegative, and since coefficient i is at most the product divided
+     * by X**i, it fits in the digits above offset i*k.
+     */
+    ret = long_alloc(asize + bsize);
+    if (ret == NULL)
+        goto fail;
+    memset(ret->long_value.ob_digit, 0, (asize + bsize) * sizeof(digit));
+    for (i = 0; i < 5; i++) {
+        Py_ssize_t size = _PyLong_DigitCount(r[i]);
+        assert(!_PyLong_IsNegative(r[i]));
+        if (size == 0)
+            continue;
+        assert(i*k + size <= asize + bsize);
+        (void)v_iadd(ret->long_value.ob_digit + i*k, asize + bsize - i*k,
+                     r[i]->long_value.ob_digit, size);
+    }
+    ret = long_normalize(ret);
+
+  fail:
+    for (i = 0; i < 3; i++) {
+        Py_XDECREF(an[i]);
+        Py_XDECREF(bn[i]);
+        Py_XDECREF(av[i]);
+        Py_XDECREF(bv[i]);
+    }
+    for (i = 0; i < 5; i++) {
+        Py_XDECREF(r[i]);
+    }
+    return ret;
+}
+
+/* Number-theoretic transform (NTT) multiplication.
+ *
+ * The digits of a and b are the coefficients of two polynomials in BASE.
+ * Their product is computed modulo three primes p = c*2**e + 1 by cyclic
+ * convolutions of length n = 2**m <= 2**23, done with fast Fourier
+ * transforms over Z/pZ.  A coefficient of the product is less than
+ * NTT_MAX_SIZE * BASE**2 < p1*p2*p3, so it is recovered exactly with the
+ * Chinese remainder theorem, and carries are propagated into the result
+ * digits.  Arithmetic modulo p uses Montgomery multiplication with
+ * R = 2**32, so that a modular product costs three integer multiplies.
+ */
+
+typedef struct {
+    uint32_t p;         /* the prime */
+    uint32_t g;         /* a primitive root modulo p */
+    uint32_t pinv;      /* -p**-1 mod R */
+    uint32_t r2;        /* R**2 mod p */
+} ntt_modulus;
+
+/* Montgomery reduction: t * R**-1 mod p, for t < p * R. */
+static inline uint32_t
+ntt_redc(const ntt_modulus *m, uint64_t t)
+{
+    uint32_t q = (uint32_t)t * m->pinv;
+    uint32_t r = (uint32_t)((t + (uint64_t)q * m->p) >> 32);
+    return r >= m->p ? r - m->p : r;
+}
+
+/* a * b * R**-1 mod p: if b is in Montgomery form (b*R), this is a*b. */
+static inline uint32_t
+ntt_mulmod(const ntt_modulus *m, uint32_t a, uint32_t b)
+{
+    return ntt_redc(m, (uint64_t)a * b);
+}
+
+static inline uint32_t
+ntt_addmod(const ntt_modulus *m, uint32_t a, uint32_t b)
+{
+    uint32_t s = a + b;
+    return s >= m->p ? s - m->p : s;
+}
+
+static inline uint32_t
+ntt_submod(const ntt_modulus *m, uint32_t a, uint32_t b)
+{
+    return a >= b ? a - b : a + m->p - b;
+}
+
+static void
+ntt_init_modulus(ntt_modulus *m, uint32_t p, uint32_t g)
+{
+    uint32_t inv = p;               /* p*p == 1 mod 8 */
+    for (int i = 0; i < 4; i++)
+        inv *= 2 - p * inv;         /* Newton: doubles the correct bits */
+    m->p = p;
+    m->g = g;
+    m->pinv = (uint32_t)0 - inv;
+    uint64_t r = ((uint64_t)1 << 32) % p;
+    m->r2 = (uint32_t)(r * r % p);
+}
+
+/* The Montgomery form of x, x*R mod p. */
+static inline uint32_t
+ntt_to_mont(const ntt_modulus *m, uint32_t x)
+{
+    return ntt_mulmod(m, x, m->r2);
+}
+
+/* base**e mod p, with base and result in Montgomery form. */
+static uint32_t
+ntt_powmod(const ntt_modulus *m, uint32_t base, uint64_t e)
+{
+    uint32_t result = ntt_to_mont(m, 1);
+    while (e) {
+        if (e & 1)
+            result = ntt_mulmod(m, result, base);
+        base = ntt_mulmod(m, base, base);
+        e >>= 1;
+    }
+    return result;
+}
+
+/* Fill roots[0:n/2] with w**j in Montgomery form, where w is a primitive
+ * n-th root of unity modulo p, or its inverse if inverse is true.
+ */
+static void
+ntt_roots(const ntt_modulus *m, uint32_t *roots, Py_ssize_t n, int inverse)
+{
+    uint64_t e = (m->p - 1) / (uint64_t)n;
+    if (inverse)
+        e = (m->p - 1) - e;
+    uint32_t w = ntt_powmod(m, ntt_to_mont(m, m->g), e);
+    uint32_t x = ntt_to_mont(m, 1);
+    for (Py_ssize_t j = 0; j < n / 2; j++) {
+        roots[j] = x;
+        x = ntt_mulmod(m, x, w);
+    }
+}
+
+/* Decimation in frequency transform: natural order input, bit-reversed
+ * order output.  The values need not be in Montgomery form.
+ */
+static void
+ntt_forward(const ntt_modulus *m, uint32_t *a, Py_ssize_t n,
+            const uint32_t *roots)
+{
+    for (Py_ssize_t len = n; len >= 2; len >>= 1) {
+        Py_ssize_t half = len >> 1, step = n / len;
+        for (Py_ssize_t i = 0; i < n; i += len) {
+            for (Py_ssize_t j = 0; j < half; j++) {
+                uint32_t u = a[i + j], v = a[i + j + half];
+                a[i + j] = ntt_addmod(m, u, v);
+                a[i + j + half] = ntt_mulmod(m, ntt_submod(m, u, v),
+                                             roots[j * step]);
+            }
+        }
+    }
+}
+
+/* Decimation in time transform: bit-reversed order input, natural order
+ * output.  With the inverse roots, this undoes ntt_forward(), except for a
+ * factor of n.
+ */
+static void
+ntt_inverse(const ntt_modulus *m, uint32_t *a, Py_ssize_t n,
+            const uint32_t *roots)
+{
+    for (Py_ssize_t len = 2; len <= n; len <<= 1) {
+        Py_ssize_t half = len >> 1, step = n / len;
+        for (Py_ssize_t i = 0; i < n; i += len) {
+            for (Py_ssize_t j = 0; j < half; j++) {
+                uint32_t u = a[i + j];
+                uint32_t v = ntt_mulmod(m, a[i + j + half], roots[j * step]);
+                a[i + j] = ntt_addmod(m, u, v);
+                a[i + j + half] = ntt_submod(m, u, v);
+            }
+        }
+    }
+}
+
+/* Store the cyclic convolution of a and b modulo m->p into fa[0:n].
+ * fb[0:n] and roots[0:n/2] are scratch space.
+ */
+static void
+ntt_convolve(const ntt_modulus *m, PyLongObject *a, PyLongObject *b,
+             uint32_t *fa, uint32_t *fb, uint32_t *roots, Py_ssize_t n)
+{
+    Py_ssize_t asize = _PyLong_DigitCount(a);
+    Py_ssize_t bsize = _PyLong_DigitCount(b);
+    Py_ssize_t i;
+
+    for (i = 0; i < asize; i++)
+        fa[i] = a->long_value.ob_digit[i] % m->p;
+    memset(fa + asize, 0, (n - asize) * sizeof(uint32_t));
+    ntt_roots(m, roots, n, 0);
+    ntt_forward(m, fa, n, roots);
+    if (a == b) {
+        for (i = 0; i < n; i++)
+            fa[i] = ntt_mulmod(m, fa[i], fa[i]);
+    }
+    else {
+        for (i = 0; i < bsize; i++)
+            fb[i] = b->long_value.ob_digit[i] % m->p;
+        memset(fb + bsize, 0, (n - bsize) * sizeof(uint32_t));
+        ntt_forward(m, fb, n, roots);
+        for (i = 0; i < n; i++)
+            fa[i] = ntt_mulmod(m, fa[i], fb[i]);
+    }
+    ntt_roots(m, roots, n, 1);
+    ntt_inverse(m, fa, n, roots);
+
+    /* The pointwise products were multiplied by R**-1 and the inverse
+     * transform by n: multiply by R/n (R**2/n in Montgomery form).
+     */
+    uint32_t scale = ntt_powmod(m, ntt_to_mont(m, (uint32_t)n), m->p - 2);
+    scale = ntt_to_mont(m, scale);
+    for (i = 0; i < n; i++)
+        fa[i] = ntt_mulmod(m, fa[i], scale);
+}
+
+/* NTT multiplication.  Ignores the input signs, and returns the absolute
+ * value of the product (or NULL if error).  The product must have at most
+ * NTT_MAX_SIZE digits.
+ */
+static PyLongObject *
+ntt_mul(PyLongObject *a, PyLongObject *b)
+{
+    /* The primes are in increasing order, and each has 2**23 | p - 1. */
+    static const uint32_t primes[3][2] = {
+        {167772161, 3},     /* 5 * 2**25 + 1 */
+        {469762049, 3},     /* 7 * 2**26 + 1 */
+        {998244353, 3},     /* 119 * 2**23 + 1 */
+    };
+    Py_ssize_t asize = _PyLong_DigitCount(a);
+    Py_ssize_t bsize = _PyLong_DigitCount(b);
+    Py_ssize_t zsize = asize + bsize, n, i;
+    ntt_modulus m[3];
+    uint32_t *buf, *res[3], *fb, *roots;
+    PyLongObject *z;
+
+    assert(zsize <= NTT_MAX_SIZE);
+    if (asize == 0 || bsize == 0)
+        return (PyLongObject *)PyLong_FromLong(0);
+    for (n = 2; n < zsize - 1; n <<= 1)
+        ;
+
+    /* Three residue vectors, the transform of b and the roots. */
+    buf = PyMem_New(uint32_t, 4 * n + n / 2);
+    if (buf == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    res[0] = buf;
+    res[1] = buf + n;
+    res[2] = buf + 2 * n;
+    fb = buf + 3 * n;
+    roots = buf + 4 * n;
+    for (i = 0; i < 3; i++) {
+        ntt_init_modulus(&m[i], primes[i][0], primes[i][1]);
+        ntt_convolve(&m[i], a, b, res[i], fb, roots, n);
+        SIGCHECK({
+                PyMem_Free(buf);
+                return NULL;
+            });
+    }
+
+    z = long_alloc(zsize);
+    if (z == NULL) {
+        PyMem_Free(buf);
+        return NULL;
+    }
+
+    /* Garner's algorithm: the coefficient is x1 + p1*(x2 + p2*x3), with
+     * x1 < p1, x2 < p2 and x3 < p3, all computed in Montgomery form.
+     */
+    const uint32_t p1 = m[0].p, p2 = m[1].p;
+    uint32_t inv_p1_mod_p2 = ntt_powmod(&m[1], ntt_to_mont(&m[1], p1),
+                                        m[1].p - 2);
+    uint32_t inv_p1_mod_p3 = ntt_powmod(&m[2], ntt_to_mont(&m[2], p1),
+                                        m[2].p - 2);
+    uint32_t inv_p2_mod_p3 = ntt_powmod(&m[2], ntt_to_mont(&m[2], p2),
+                                        m[2].p - 2);
+    uint64_t carry = 0;
+    for (i = 0; i < zsize - 1; i++) {
+        uint32_t x1 = res[0][i];
+        uint32_t x2 = ntt_mulmod(&m[1], ntt_submod(&m[1], res[1][i], x1),
+                                 inv_p1_mod_p2);
+        uint32_t x3 = ntt_mulmod(&m[2], ntt_submod(&m[2], res[2][i], x1),
+                                 inv_p1_mod_p3);
+        x3 = ntt_mulmod(&m[2], ntt_submod(&m[2], x3, x2), inv_p2_mod_p3);
+        uint64_t hi = x2 + (uint64_t)p2 * x3;
+        uint64_t lo = x1 + (uint64_t)p1 * (hi & PyLong_MASK);
+        /* The coefficient is lo + p1 * (hi >> PyLong_SHIFT) * BASE. */
+        carry += lo & PyLong_MASK;
+        z->long_value.ob_digit[i] = (digit)(carry & PyLong_MASK);
+        carry >>= PyLong_SHIFT;
+        carry += (lo >> PyLong_SHIFT) + (uint64_t)p1 * (hi >> PyLong_SHIFT);
+    }
+    assert(carry <= PyLong_MASK);
+    z->long_value.ob_digit[zsize - 1] = (digit)carry;
+    PyMem_Free(buf);
+    return long_normalize(z);
+}
+
 
 static PyLongObject*
 long_mul(PyLongObject *a, PyLongObject *b)
@@ -4372,6 +4844,25 @@ _PyLong_Multiply(PyLongObject *a, PyLongObject *b)
     return (PyObject*)long_mul(a, b);
 }
 
+/* Multiply with Toom-3 or the NTT regardless of the size cutoffs, ignoring
+   the signs.  For tests and Tools/scripts/mul_threshold.py. */
+PyObject *
+_PyLong_MultiplyToom3(PyLongObject *a, PyLongObject *b)
+{
+    return (PyObject *)toom3_mul(a, b);
+}
+
+PyObject *
+_PyLong_MultiplyNTT(PyLongObject *a, PyLongObject *b)
+{
+    if (_PyLong_DigitCount(a) + _PyLong_DigitCount(b) > NTT_MAX_SIZE) {
+        PyErr_SetString(PyExc_OverflowError,
+                        "product too large for the NTT");
+        return NULL;
+    }
+    return (PyObject *)ntt_mul(a, b);
+}
+
 static PyObject *
 long_mul_method(PyObject *a, PyObject *b)
 {
@@ -4423,45 +4914,370 @@ fast_floor_div(PyLongObject *a, PyLongObject *b)
     return PyLong_FromLong(div);
 }
 
-#ifdef WITH_PYLONG_MODULE
-/* asymptotically faster divmod, using _pylong.py */
+/* Burnikel-Ziegler division.
+ *
+ * This is the recursive division algorithm of _pylong._div2n1n(), see
+ * C. Burnikel and J. Ziegler, "Fast Recursive Division", MPI-I-98-1-022.
+ * Dividing a 2n-bit number by an n-bit number takes two divisions of
+ * 3n/2-bit numbers by n-bit numbers, each of which takes one recursive
+ * 2n/2-by-n/2-bit division and one n/2-by-n/2-bit multiplication.  With a
+ * subquadratic multiplication, the division has the same complexity up to
+ * a log factor.  All operands are nonnegative and sizes are in bits.
+ */
+
+/* (a >> start) & (2**nbits - 1), ignoring the sign of a. */
+static PyLongObject *
+long_bits(PyLongObject *a, int64_t start, int64_t nbits)
+{
+    Py_ssize_t size_a = _PyLong_DigitCount(a);
+    Py_ssize_t wordshift = (Py_ssize_t)(start / PyLong_SHIFT);
+    int remshift = (int)(start % PyLong_SHIFT);
+    Py_ssize_t fullsize = (Py_ssize_t)((nbits + PyLong_SHIFT - 1) / PyLong_SHIFT);
+    Py_ssize_t size, j;
+    digit *pa = a->long_value.ob_digit;
+    PyLongObject *z;
+
+    if (wordshift >= size_a || nbits == 0) {
+        return (PyLongObject *)PyLong_FromLong(0);
+    }
+    size = Py_MIN(fullsize, size_a - wordshift);
+    z = long_alloc(size);
+    if (z == NULL) {
+        return NULL;
+    }
+    for (j = 0; j < size; j++) {
+        twodigits accum = pa[wordshift + j] >> remshift;
+        if (remshift && wordshift + j + 1 < size_a) {
+            accum |= (twodigits)pa[wordshift + j + 1] << (PyLong_SHIFT - remshift);
+        }
+        z->long_value.ob_digit[j] = (digit)(accum & PyLong_MASK);
+    }
+    if (size == fullsize && nbits % PyLong_SHIFT) {
+        z->long_value.ob_digit[size - 1] &= ((digit)1 << (nbits % PyLong_SHIFT)) - 1;
+    }
+    return long_normalize(z);
+}
+
+static int bz_div2n1n(PyLongObject *a, PyLongObject *b, int64_t n,
+                      PyLongObject **pq, PyLongObject **pr);
+
+/* Divide a12 * 2**n + a3 by b = b1 * 2**n + b2, where a12 < 2**n * b,
+ * a3 < 2**n and b has exactly 2n bits.  See _pylong._div3n2n().
+ */
 static int
-pylong_int_divmod(PyLongObject *v, PyLongObject *w,
-                  PyLongObject **pdiv, PyLongObject **pmod)
+bz_div3n2n(PyLongObject *a12, PyLongObject *a3, PyLongObject *b,
+           PyLongObject *b1, PyLongObject *b2, int64_t n,
+           PyLongObject **pq, PyLongObject **pr)
 {
-    PyObject *mod = PyImport_ImportModule("_pylong");
-    if (mod == NULL) {
+    PyLongObject *q = NULL, *r = NULL, *t, *u;
+
+    t = (PyLongObject *)_PyLong_Rshift((PyObject *)a12, n);
+    if (t == NULL) {
         return -1;
     }
-    PyObject *result = PyObject_CallMethod(mod, "int_divmod", "OO", v, w);
-    Py_DECREF(mod);
-    if (result == NULL) {
+    int top_is_b1 = (long_compare(t, b1) == 0);
+    Py_DECREF(t);
+    if (top_is_b1) {
+        /* q = 2**n - 1, r = a12 - (b1 << n) + b1 */
+        t = (PyLongObject *)long_lshift_int64((PyLongObject *)_PyLong_GetOne(), n);
+        if (t == NULL) {
+            return -1;
+        }
+        q = long_sub(t, (PyLongObject *)_PyLong_GetOne());
+        Py_DECREF(t);
+        if (q == NULL) {
+            goto error;
+        }
+        if ((t = (PyLongObject *)long_lshift_int64(b1, n)) == NULL) {
+            goto error;
+        }
+        u = long_sub(a12, t);
+        Py_DECREF(t);
+        if (u == NULL) {
+            goto error;
+        }
+        r = long_add(u, b1);
+        Py_DECREF(u);
+        if (r == NULL) {
+            goto error;
+        }
+    }
+    else if (bz_div2n1n(a12, b1, n, &q, &r) < 0) {
         return -1;
     }
-    if (!PyTuple_Check(result)) {
-        Py_DECREF(result);
-        PyErr_SetString(PyExc_ValueError,
-                        "tuple is required from int_divmod()");
+
+    /* r = (r << n | a3) - q * b2 */
+    if ((t = (PyLongObject *)long_lshift_int64(r, n)) == NULL) {
+        goto error;
+    }
+    Py_SETREF(r, long_add(t, a3));
+    Py_DECREF(t);
+    if (r == NULL) {
+        goto error;
+    }
+    if ((t = long_mul(q, b2)) == NULL) {
+        goto error;
+    }
+    Py_SETREF(r, long_sub(r, t));
+    Py_DECREF(t);
+    if (r == NULL) {
+        goto error;
+    }
+    while (_PyLong_IsNegative(r)) {
+        Py_SETREF(q, long_sub(q, (PyLongObject *)_PyLong_GetOne()));
+        if (q == NULL) {
+            goto error;
+        }
+        Py_SETREF(r, long_add(r, b));
+        if (r == NULL) {
+            goto error;
+        }
+    }
+    *pq = q;
+    *pr = r;
+    return 0;
+
+  error:
+    Py_XDECREF(q);
+    Py_XDECREF(r);
+    return -1;
+}
+
+/* Divide a by b, where b has exactly n bits and a < 2**n * b.  See
+ * _pylong._div2n1n().
+ */
+static int
+bz_div2n1n(PyLongObject *a, PyLongObject *b, int64_t n,
+           PyLongObject **pq, PyLongObject **pr)
+{
+    PyLongObject *b1 = NULL, *b2 = NULL, *a12 = NULL, *a3 = NULL;
+    PyLongObject *q1 = NULL, *q2 = NULL, *r = NULL, *t;
+    int64_t half_n;
+    int pad, res = -1;
+
+    if (_PyLong_NumBits((PyObject *)a) - n <= BZ_CUTOFF) {
+        return long_divrem(a, b, pq, pr);
+    }
+    pad = n & 1;
+    if (pad) {
+        a = (PyLongObject *)long_lshift_int64(a, 1);
+        if (a == NULL) {
+            return -1;
+        }
+        b = (PyLongObject *)long_lshift_int64(b, 1);
+        if (b == NULL) {
+            Py_DECREF(a);
+            return -1;
+        }
+        n++;
+    }
+    else {
+        Py_INCREF(a);
+        Py_INCREF(b);
+    }
+    half_n = n >> 1;
+
+    if ((b1 = (PyLongObject *)_PyLong_Rshift((PyObject *)b, half_n)) == NULL) {
+        goto done;
+    }
+    if ((b2 = long_bits(b, 0, half_n)) == NULL) {
+        goto done;
+    }
+    if ((a12 = (PyLongObject *)_PyLong_Rshift((PyObject *)a, n)) == NULL) {
+        goto done;
+    }
+    if ((a3 = long_bits(a, half_n, half_n)) == NULL) {
+        goto done;
+    }
+    if (bz_div3n2n(a12, a3, b, b1, b2, half_n, &q1, &r) < 0) {
+        goto done;
+    }
+    Py_SETREF(a3, long_bits(a, 0, half_n));
+    if (a3 == NULL) {
+        goto done;
+    }
+    t = r;
+    r = NULL;
+    res = bz_div3n2n(t, a3, b, b1, b2, half_n, &q2, &r);
+    Py_DECREF(t);
+    if (res < 0) {
+        goto done;
+    }
+    res = -1;
+    if (pad) {
+        Py_SETREF(r, (PyLongObject *)long_rshift1(r, 0, 1));
+        if (r == NULL) {
+            goto done;
+        }
+    }
+    /* q = q1 << half_n | q2 */
+    if ((t = (PyLongObject *)long_lshift_int64(q1, half_n)) == NULL) {
+        goto done;
+    }
+    *pq = long_add(t, q2);
+    Py_DECREF(t);
+    if (*pq == NULL) {
+        goto done;
+    }
+    *pr = r;
+    r = NULL;
+    res = 0;
+
+  done:
+    Py_DECREF(a);
+    Py_DECREF(b);
+    Py_XDECREF(b1);
+    Py_XDECREF(b2);
+    Py_XDECREF(a12);
+    Py_XDECREF(a3);
+    Py_XDECREF(q1);
+    Py_XDECREF(q2);
+    Py_XDECREF(r);
+    return res;
+}
+
+/* Divide nonnegative a by positive b with the grade school algorithm in
+ * base 2**n, where n is the number of bits of b, using bz_div2n1n() for
+ * each step.  See _pylong._divmod_pos().
+ */
+static int
+bz_divmod_pos(PyLongObject *a, PyLongObject *b,
+              PyLongObject **pq, PyLongObject **pr)
+{
+    int64_t n = _PyLong_NumBits((PyObject *)b);
+    int64_t na = _PyLong_NumBits((PyObject *)a);
+    Py_ssize_t size_q = _PyLong_DigitCount(a) + 1;
+    PyLongObject *q, *r, *qi, *t, *u;
+
+    if (n < 0 || na < 0) {
         return -1;
     }
-    PyObject *q = PyTuple_GET_ITEM(result, 0);
-    PyObject *r = PyTuple_GET_ITEM(result, 1);
-    if (!PyLong_Check(q) || !PyLong_Check(r)) {
-        Py_DECREF(result);
-        PyErr_SetString(PyExc_ValueError,
-                        "tuple of int is required from int_divmod()");
+    q = long_alloc(size_q);
+    if (q == NULL) {
+        return -1;
+    }
+    memset(q->long_value.ob_digit, 0, size_q * sizeof(digit));
+    r = (PyLongObject *)Py_NewRef(_PyLong_GetZero());
+    for (int64_t i = (na + n - 1) / n - 1; i >= 0; i--) {
+        /* r, qi = divmod(r << n | (a >> i*n) & (2**n - 1), b) */
+        if ((t = (PyLongObject *)long_lshift_int64(r, n)) == NULL) {
+            goto error;
+        }
+        if ((u = long_bits(a, i * n, n)) == NULL) {
+            Py_DECREF(t);
+            goto error;
+        }
+        Py_SETREF(r, long_add(t, u));
+        Py_DECREF(t);
+        Py_DECREF(u);
+        if (r == NULL) {
+            goto error;
+        }
+        t = r;
+        r = NULL;
+        int res = bz_div2n1n(t, b, n, &qi, &r);
+        Py_DECREF(t);
+        if (res < 0) {
+            goto error;
+        }
+        /* The quotient digits have n bits and don't overlap: add qi << i*n
+         * into q.
+         */
+        if (!_PyLong_IsZero(qi)) {
+            Py_ssize_t wordshift = (Py_ssize_t)(i * n / PyLong_SHIFT);
+            t = (PyLongObject *)long_lshift1(qi, 0, (digit)(i * n % PyLong_SHIFT));
+            Py_DECREF(qi);
+            if (t == NULL) {
+                goto error;
+            }
+            assert(wordshift + _PyLong_DigitCount(t) <= size_q);
+            (void)v_iadd(q->long_value.ob_digit + wordshift, size_q - wordshift,
+                         t->long_value.ob_digit, _PyLong_DigitCount(t));
+            Py_DECREF(t);
+        }
+        else {
+            Py_DECREF(qi);
+        }
+        SIGCHECK({
+                goto error;
+            });
+    }
+    *pq = long_normalize(q);
+    *pr = r;
+    return 0;
+
+  error:
+    Py_DECREF(q);
+    Py_XDECREF(r);
+    return -1;
+}
+
+/* Like long_divrem(), but using Burnikel-Ziegler division. */
+static int
+bz_divrem(PyLongObject *a, PyLongObject *b,
+          PyLongObject **pdiv, PyLongObject **prem)
+{
+    PyLongObject *abs_a, *abs_b;
+    int res;
+
+    if (_PyLong_IsZero(b)) {
+        PyErr_SetString(PyExc_ZeroDivisionError, "division by zero");
         return -1;
     }
-    if (pdiv != NULL) {
-        *pdiv = (PyLongObject *)Py_NewRef(q);
+    if ((abs_a = long_abs(a)) == NULL) {
+        return -1;
     }
-    if (pmod != NULL) {
-        *pmod = (PyLongObject *)Py_NewRef(r);
+    if ((abs_b = long_abs(b)) == NULL) {
+        Py_DECREF(abs_a);
+        return -1;
+    }
+    res = bz_divmod_pos(abs_a, abs_b, pdiv, prem);
+    Py_DECREF(abs_a);
+    Py_DECREF(abs_b);
+    if (res < 0) {
+        return -1;
+    }
+    /* The quotient has the sign of a*b and the remainder the sign of a. */
+    if (_PyLong_IsNegative(a) != _PyLong_IsNegative(b)) {
+        _PyLong_Negate(pdiv);
+    }
+    if (_PyLong_IsNegative(a)) {
+        _PyLong_Negate(prem);
     }
-    Py_DECREF(result);
+    if (*pdiv == NULL || *prem == NULL) {
+        Py_XDECREF(*pdiv);
+        Py_XDECREF(*prem);
+        return -1;
+    }
+    *pdiv = maybe_small_long(*pdiv);
+    *prem = maybe_small_long(*prem);
     return 0;
 }
-#endif /* WITH_PYLONG_MODULE */
+
+/* Truncated division with Burnikel-Ziegler regardless of the size cutoffs.
+   For tests and Tools/scripts/divmod_threshold.py. */
+PyObject *
+_PyLong_DivremBZ(PyLongObject *a, PyLongObject *b)
+{
+    PyLongObject *div, *rem;
+    if (bz_divrem(a, b, &div, &rem) < 0) {
+        return NULL;
+    }
+    return Py_BuildValue("(NN)", div, rem);
+}
+
+/* Use Burnikel-Ziegler division if the divisor is large and the quotient
+ * has more than BZ_CUTOFF bits.  If the quotient is small then "schoolbook"
+ * division is linear-time.  These limits are empirically determined, see
+ * Tools/scripts/divmod_threshold.py.
+ */
+static inline int
+use_bz_division(PyLongObject *v, PyLongObject *w)
+{
+    Py_ssize_t size_v = _PyLong_DigitCount(v); /* digits in numerator */
+    Py_ssize_t size_w = _PyLong_DigitCount(w); /* digits in denominator */
+    return (size_w > 300 && (size_v - size_w) * PyLong_SHIFT > BZ_CUTOFF);
+}
 
 /* The / and % operators are now defined in terms of divmod().
    The expression a mod b has the value a - b*floor(a/b).
@@ -4514,19 +5330,11 @@ l_divmod(PyLongObject *v, PyLongObject *w,
         }
         return 0;
     }
-#if WITH_PYLONG_MODULE
-    Py_ssize_t size_v = _PyLong_DigitCount(v); /* digits in numerator */
-    Py_ssize_t size_w = _PyLong_DigitCount(w); /* digits in denominator */
-    if (size_w > 300 && (size_v - size_w) > 150) {
-        /* Switch to _pylong.int_divmod().  If the quotient is small then
-          "schoolbook" division is linear-time so don't use in that case.
-          These limits are empirically determined and should be slightly
-          conservative so that _pylong is used in cases it is likely
-          to be faster. See Tools/scripts/divmod_threshold.py. */
-        return pylong_int_divmod(v, w, pdiv, pmod);
+    if (use_bz_division(v, w)) {
+        if (bz_divrem(v, w, &div, &mod) < 0)
+            return -1;
     }
-#endif
-    if (long_divrem(v, w, &div, &mod) < 0)
+    else if (long_divrem(v, w, &div, &mod) < 0)
         return -1;
     if ((_PyLong_IsNegative(mod) && _PyLong_IsPositive(w)) ||
         (_PyLong_IsPositive(mod) && _PyLong_IsNegative(w))) {
@@ -4573,7 +5381,13 @@ l_mod(PyLongObject *v, PyLongObject *w, PyLongObject **pmod)
         *pmod = (PyLongObject *)fast_mod(v, w);
         return -(*pmod == NULL);
     }
-    if (long_rem(v, w, &mod) < 0)
+    if (use_bz_division(v, w)) {
+        PyLongObject *div;
+        if (bz_divrem(v, w, &div, &mod) < 0)
+            return -1;
+        Py_DECREF(div);
+    }
+    else if (long_rem(v, w, &mod) < 0)
         return -1;
     if ((_PyLong_IsNegative(mod) && _PyLong_IsPositive(w)) ||
         (_PyLong_IsPositive(mod) && _PyLong_IsNegative(w))) {
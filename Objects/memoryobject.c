@@ -12,6 +12,7 @@
 
 #include "Python.h"
 #include "pycore_abstract.h"      // _PyIndex_Check()
+#include "pycore_bytesobject.h"   // _PyBytes_Find()
 #include "pycore_memoryobject.h"  // _PyManagedBuffer_Type
 #include "pycore_object.h"        // _PyObject_GC_UNTRACK()
 #include "pycore_strhex.h"        // _Py_strhex_with_sep()
@@ -2902,6 +2903,240 @@ memoryview_index_impl(PyMemoryViewObject *self, PyObject *value,
 }
 
 
+/**************************************************************************/
+/*                        Splitting into subviews                         */
+/**************************************************************************/
+
+/* Check that the memoryview can be searched as a sequence of bytes. */
+static int
+check_bytes_view(PyMemoryViewObject *self, const char *name)
+{
+    const Py_buffer *view = &self->view;
+    char fmt;
+
+    CHECK_RELEASED_INT(self);
+    CHECK_RESTRICTED_INT(self);
+
+    if (view->ndim != 1 || !MV_C_CONTIGUOUS(self->flags) ||
+        get_native_fmtchar(&fmt, view->format) < 0 || !IS_BYTE_FORMAT(fmt)) {
+        PyErr_Format(PyExc_TypeError,
+            "memoryview: %s() is restricted to contiguous 1-D views "
+            "with format 'B', 'b' or 'c'", name);
+        return -1;
+    }
+    return 0;
+}
+
+/* Return a new view of the bytes [start:stop] of a view checked with
+   check_bytes_view(). The new view shares the memory of self. */
+static PyObject *
+memory_subview(PyMemoryViewObject *self, Py_ssize_t start, Py_ssize_t stop)
+{
+    PyMemoryViewObject *mv;
+
+    assert(0 <= start && start <= stop && stop <= self->view.len);
+    mv = (PyMemoryViewObject *)mbuf_add_view(self->mbuf, &self->view);
+    if (mv == NULL)
+        return NULL;
+
+    mv->view.buf = (char *)mv->view.buf + start;
+    mv->view.shape[0] = stop - start;
+    init_len(&mv->view);
+    init_flags(mv);
+
+    return (PyObject *)mv;
+}
+
+static int
+append_subview(PyObject *list, PyMemoryViewObject *self,
+               Py_ssize_t start, Py_ssize_t stop)
+{
+    PyObject *sub = memory_subview(self, start, stop);
+    if (sub == NULL)
+        return -1;
+    int res = PyList_Append(list, sub);
+    Py_DECREF(sub);
+    return res;
+}
+
+/*[clinic input]
+memoryview.split
+
+    sep: object = None
+        The delimiter according which to split the bytes.
+        None (the default value) means split on ASCII whitespace characters
+        (space, tab, return, newline, formfeed, vertical tab).
+    maxsplit: Py_ssize_t = -1
+        Maximum number of splits to do.
+        -1 (the default value) means no limit.
+
+Return a list of views of the sections in the memory, using sep as the delimiter.
+
+Like bytes.split(), but the sections are memoryviews sharing the memory
+of this one instead of copies.
+[clinic start generated code]*/
+
+static PyObject *
+memoryview_split_impl(PyMemoryViewObject *self, PyObject *sep,
+                      Py_ssize_t maxsplit)
+/*[clinic end generated code: output=ea5d2082a93b78f7 input=9360e3248bb55df2]*/
+{
+    const char *s;
+    Py_ssize_t len, i, j;
+    Py_buffer vsep = {NULL, NULL};
+    PyObject *list = NULL;
+
+    /* Get the buffer of the separator first: it can run Python code which
+       releases the view. */
+    if (sep != Py_None) {
+        if (PyObject_GetBuffer(sep, &vsep, PyBUF_SIMPLE) != 0)
+            return NULL;
+        if (vsep.len == 0) {
+            PyErr_SetString(PyExc_ValueError, "empty separator");
+            goto error;
+        }
+    }
+    if (check_bytes_view(self, "split") < 0)
+        goto error;
+    s = self->view.buf;
+    len = self->view.len;
+    if (maxsplit < 0)
+        maxsplit = PY_SSIZE_T_MAX;
+
+    list = PyList_New(0);
+    if (list == NULL)
+        goto error;
+
+    if (sep == Py_None) {
+        i = 0;
+        while (maxsplit-- > 0) {
+            while (i < len && Py_ISSPACE(s[i]))
+                i++;
+            if (i == len)
+                break;
+            j = i;
+            i++;
+            while (i < len && !Py_ISSPACE(s[i]))
+                i++;
+            if (append_subview(list, self, j, i) < 0)
+                goto error;
+        }
+        /* Only occurs when maxsplit was reached: skip any remaining
+           whitespace and add the rest of the memory */
+        while (i < len && Py_ISSPACE(s[i]))
+            i++;
+        if (i != len && append_subview(list, self, i, len) < 0)
+            goto error;
+        return list;
+    }
+
+    i = 0;
+    while (maxsplit-- > 0) {
+        j = _PyBytes_Find(s + i, len - i, vsep.buf, vsep.len, i);
+        if (j < 0)
+            break;
+        if (append_subview(list, self, i, j) < 0)
+            goto error;
+        i = j + vsep.len;
+    }
+    if (append_subview(list, self, i, len) < 0)
+        goto error;
+    PyBuffer_Release(&vsep);
+    return list;
+
+error:
+    if (vsep.obj != NULL)
+        PyBuffer_Release(&vsep);
+    Py_XDECREF(list);
+    return NULL;
+}
+
+/* Return the 3-tuple of views of [0:start], [start:stop] and [stop:len]. */
+static PyObject *
+partition_views(PyMemoryViewObject *self, Py_ssize_t start, Py_ssize_t stop)
+{
+    Py_ssize_t bounds[4] = {0, start, stop, self->view.len};
+    PyObject *out;
+
+    out = PyTuple_New(3);
+    if (out == NULL)
+        return NULL;
+    for (int i = 0; i < 3; i++) {
+        PyObject *part = memory_subview(self, bounds[i], bounds[i+1]);
+        if (part == NULL) {
+            Py_DECREF(out);
+            return NULL;
+        }
+        PyTuple_SET_ITEM(out, i, part);
+    }
+    return out;
+}
+
+/*[clinic input]
+memoryview.partition
+
+    sep: Py_buffer
+    /
+
+Partition the memory into three views using the given separator.
+
+Like bytes.partition(), but the parts are memoryviews sharing the memory
+of this one instead of copies.  If the separator is not found, return
+a view of the whole memory and two empty views.
+[clinic start generated code]*/
+
+static PyObject *
+memoryview_partition_impl(PyMemoryViewObject *self, Py_buffer *sep)
+/*[clinic end generated code: output=b867f1824a4e9a83 input=aa86a8019b0a04f5]*/
+{
+    Py_ssize_t len, pos;
+
+    if (check_bytes_view(self, "partition") < 0)
+        return NULL;
+    if (sep->len == 0) {
+        PyErr_SetString(PyExc_ValueError, "empty separator");
+        return NULL;
+    }
+    len = self->view.len;
+    pos = _PyBytes_Find(self->view.buf, len, sep->buf, sep->len, 0);
+    if (pos < 0)
+        return partition_views(self, len, len);
+    return partition_views(self, pos, pos + sep->len);
+}
+
+/*[clinic input]
+memoryview.rpartition
+
+    sep: Py_buffer
+    /
+
+Partition the memory into three views using the given separator.
+
+Like bytes.rpartition(), but the parts are memoryviews sharing the memory
+of this one instead of copies.  If the separator is not found, return
+two empty views and a view of the whole memory.
+[clinic start generated code]*/
+
+static PyObject *
+memoryview_rpartition_impl(PyMemoryViewObject *self, Py_buffer *sep)
+/*[clinic end generated code: output=7163049eb3ece465 input=1b83a5f6d8edb28a]*/
+{
+    Py_ssize_t len, pos;
+
+    if (check_bytes_view(self, "rpartition") < 0)
+        return NULL;
+    if (sep->len == 0) {
+        PyErr_SetString(PyExc_ValueError, "empty separator");
+        return NULL;
+    }
+    len = self->view.len;
+    pos = _PyBytes_ReverseFind(self->view.buf, len, sep->buf, sep->len, 0);
+    if (pos < 0)
+        return partition_views(self, 0, 0);
+    return partition_views(self, pos, pos + sep->len);
+}
+
+
 /**************************************************************************/
 /*                             Comparisons                                */
 /**************************************************************************/
@@ -3440,6 +3675,9 @@ static PyMethodDef memory_methods[] = {
     MEMORYVIEW__FROM_FLAGS_METHODDEF
     MEMORYVIEW_COUNT_METHODDEF
     MEMORYVIEW_INDEX_METHODDEF
+    MEMORYVIEW_SPLIT_METHODDEF
+    MEMORYVIEW_PARTITION_METHODDEF
+    MEMORYVIEW_RPARTITION_METHODDEF
     {"__enter__",   memory_enter, METH_NOARGS, NULL},
     {"__exit__",    memory_exit, METH_VARARGS, memory_exit_doc},
     {"__class_getitem__", Py_GenericAlias, METH_O|METH_CLASS, PyDoc_STR("See PEP 585")},
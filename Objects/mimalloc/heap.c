@@ -437,6 +437,15 @@ static void mi_heap_absorb(mi_heap_t* heap, mi_heap_t* from) {
   mi_heap_reset_pages(from);
 }
 
+// Transfer the pages from one heap to the other and keep the `from` heap
+// usable for new allocations (used by CPython's allocation scopes).
+void _mi_heap_absorb(mi_heap_t* heap, mi_heap_t* from) {
+  mi_heap_absorb(heap, from);
+  _mi_memcpy_aligned(&from->pages_free_direct, &_mi_heap_empty.pages_free_direct, sizeof(from->pages_free_direct));
+  from->page_retired_min = MI_BIN_FULL;
+  from->page_retired_max = 0;
+}
+
 // Safe delete a heap without freeing any still allocated blocks in that heap.
 void mi_heap_delete(mi_heap_t* heap)
 {
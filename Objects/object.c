@@ -902,6 +902,12 @@ clear_freelist(struct _Py_freelist *freelist, int is_finalization,
     if (is_finalization) {
         freelist->size = -1;
     }
+    // Give back the capacity gained by bursty allocation: threads that have
+    // gone idle shrink back to the base capacity over a few collections.
+    if (freelist->shift > 0) {
+        freelist->shift--;
+    }
+    freelist->overflows = 0;
 }
 
 static void
@@ -940,6 +946,12 @@ _PyObject_ClearFreeLists(struct _Py_freelists *freelists, int is_finalization)
     clear_freelist(&freelists->unicode_writers, is_finalization, PyMem_Free);
     clear_freelist(&freelists->ints, is_finalization, free_object);
     clear_freelist(&freelists->pymethodobjects, is_finalization, free_object);
+    clear_freelist(&freelists->cells, is_finalization, free_object);
+    clear_freelist(&freelists->enumerates, is_finalization, free_object);
+    clear_freelist(&freelists->range_iters, is_finalization, free_object);
+    for (Py_ssize_t i = 0; i < PyGen_MAXSAVESLOTS; i++) {
+        clear_freelist(&freelists->gens[i], is_finalization, free_object);
+    }
 }
 
 /*
@@ -2374,6 +2386,7 @@ static PyTypeObject* static_types[] = {
     &PyWrapperDescr_Type,
     &PyZip_Type,
     &Py_GenericAliasType,
+    &_PyAllocationScope_Type,
     &_PyAnextAwaitable_Type,
     &_PyAsyncGenASend_Type,
     &_PyAsyncGenAThrow_Type,
@@ -2381,6 +2394,7 @@ static PyTypeObject* static_types[] = {
     &_PyBufferWrapper_Type,
     &_PyContextTokenMissing_Type,
     &_PyCoroWrapper_Type,
+    &_PyDictSharedKeys_Type,
     &_Py_GenericAliasIterType,
     &_PyHamtItems_Type,
     &_PyHamtKeys_Type,
@@ -419,6 +419,99 @@ _PyMem_DefaultRawWcsdup(const wchar_t *str)
 #  endif
 #endif
 
+#if defined(ARENAS_USE_MMAP) && defined(__linux__) && defined(HAVE_SYS_SYSCALL_H)
+#  include <sys/syscall.h>        // SYS_mbind, SYS_getcpu
+#  if defined(SYS_mbind) && defined(SYS_getcpu)
+#    define ARENAS_USE_MBIND
+#    define ARENA_MPOL_PREFERRED 1  // from <linux/mempolicy.h>
+#  endif
+#endif
+
+void
+_PyMem_SetArenaOptions(int hugepages, int numa)
+{
+    _PyRuntime.allocators.arena_hugepages = hugepages;
+    _PyRuntime.allocators.arena_numa = numa;
+#ifdef WITH_MIMALLOC
+    // mimalloc asks for MAP_HUGETLB pages and falls back to
+    // madvise(MADV_HUGEPAGE).  Its segments are owned by a thread and
+    // first touched by it, so they are already local to its NUMA node.
+    mi_option_set_enabled(mi_option_allow_large_os_pages, hugepages != 0);
+#endif
+}
+
+#ifdef ARENAS_USE_MMAP
+static void
+arena_advise(void *ptr, size_t size)
+{
+#ifdef MADV_HUGEPAGE
+    if (_PyRuntime.allocators.arena_hugepages) {
+        // Failures are harmless: the arena keeps using normal pages.
+        (void)madvise(ptr, size, MADV_HUGEPAGE);
+    }
+#endif
+#ifdef ARENAS_USE_MBIND
+    if (_PyRuntime.allocators.arena_numa) {
+        unsigned int cpu, node;
+        unsigned long nodemask;
+        // maxnode is the number of bits of the mask, but the kernel only
+        // reads maxnode - 1 of them: the last node cannot be selected.
+        if (syscall(SYS_getcpu, &cpu, &node, NULL) == 0
+            && node < sizeof(nodemask) * 8 - 1)
+        {
+            nodemask = 1UL << node;
+            (void)syscall(SYS_mbind, ptr, size, ARENA_MPOL_PREFERRED,
+                          &nodemask, sizeof(nodemask) * 8, 0);
+        }
+    }
+#endif
+}
+
+/* A transparent huge page covers 2 MiB aligned to its size on x86-64 and
+   on most other platforms */
+#define ARENA_HUGEPAGE_SIZE (2 << 20)
+
+/* Return an arena of half a huge page.  Arenas are allocated in pairs
+   filling a region aligned to the huge page size, so that the kernel can
+   back them with a single huge page; the second one is kept for the next
+   call.  Arenas are freed one by one, which splits the huge page. */
+static void *
+arena_alloc_hugepage_half(size_t size)
+{
+    void **spare = &_PyRuntime.allocators.arena_spare;
+    void *ptr = _Py_atomic_exchange_ptr(spare, NULL);
+    if (ptr != NULL) {
+        // Advised with the whole region
+        return ptr;
+    }
+
+    // Map twice the region size to find an aligned region in it
+    size_t maplen = 2 * ARENA_HUGEPAGE_SIZE;
+    char *map = mmap(NULL, maplen, PROT_READ|PROT_WRITE,
+                     MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+    if (map == MAP_FAILED) {
+        return NULL;
+    }
+    char *region = _Py_ALIGN_UP(map, ARENA_HUGEPAGE_SIZE);
+    size_t head = region - map;
+    if (head != 0) {
+        munmap(map, head);
+    }
+    size_t tail = maplen - head - ARENA_HUGEPAGE_SIZE;
+    if (tail != 0) {
+        munmap(region + ARENA_HUGEPAGE_SIZE, tail);
+    }
+    arena_advise(region, ARENA_HUGEPAGE_SIZE);
+
+    void *expected = NULL;
+    if (!_Py_atomic_compare_exchange_ptr(spare, &expected, region + size)) {
+        // Another thread stored its spare arena first
+        munmap(region + size, size);
+    }
+    return region;
+}
+#endif
+
 void *
 _PyMem_ArenaAlloc(void *Py_UNUSED(ctx), size_t size)
 {
@@ -426,12 +519,18 @@ _PyMem_ArenaAlloc(void *Py_UNUSED(ctx), size_t size)
     return VirtualAlloc(NULL, size,
                         MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
 #elif defined(ARENAS_USE_MMAP)
+    if (_PyRuntime.allocators.arena_hugepages
+        && size == ARENA_HUGEPAGE_SIZE / 2)
+    {
+        return arena_alloc_hugepage_half(size);
+    }
     void *ptr;
     ptr = mmap(NULL, size, PROT_READ|PROT_WRITE,
                MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
     if (ptr == MAP_FAILED)
         return NULL;
     assert(ptr != NULL);
+    arena_advise(ptr, size);
     return ptr;
 #else
     return malloc(size);
@@ -1373,6 +1472,61 @@ _PyMem_FiniDelayed(PyInterpreterState *interp)
     }
 }
 
+/**************************************************/
+/* Allocation scopes for request-lifetime objects */
+/**************************************************/
+
+/* Inside an allocation scope, the objects allocated by the current thread
+ * are placed in dedicated mimalloc heaps, one per object heap tag, so that
+ * they do not share pages with long-lived objects.  When the outermost scope
+ * exits, the pages that became empty are released together and the pages
+ * still holding objects that escaped the scope are handed over to the
+ * regular heaps.  The GC visits the scoped heaps of GC objects too.
+ *
+ * Scopes are only effective in the free-threaded build: pymalloc has no
+ * per-thread heaps, so elsewhere they are only counted.
+ */
+
+void
+_PyMem_EnterAllocationScope(PyThreadState *tstate)
+{
+    _PyThreadStateImpl *tstate_impl = (_PyThreadStateImpl *)tstate;
+    tstate_impl->allocation_scope_depth++;
+#if defined(Py_GIL_DISABLED) && defined(WITH_MIMALLOC)
+    if (tstate_impl->allocation_scope_depth == 1) {
+        struct _mimalloc_thread_state *m = &tstate_impl->mimalloc;
+        m->current_object_heap = &m->scoped_heaps[_Py_MIMALLOC_HEAP_OBJECT];
+    }
+#endif
+}
+
+int
+_PyMem_ExitAllocationScope(PyThreadState *tstate)
+{
+    _PyThreadStateImpl *tstate_impl = (_PyThreadStateImpl *)tstate;
+    if (tstate_impl->allocation_scope_depth <= 0) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "no allocation scope to exit");
+        return -1;
+    }
+    tstate_impl->allocation_scope_depth--;
+#if defined(Py_GIL_DISABLED) && defined(WITH_MIMALLOC)
+    if (tstate_impl->allocation_scope_depth == 0) {
+        struct _mimalloc_thread_state *m = &tstate_impl->mimalloc;
+        m->current_object_heap = &m->heaps[_Py_MIMALLOC_HEAP_OBJECT];
+        for (int i = 0; i < _Py_MIMALLOC_HEAP_COUNT; i++) {
+            if (i < _Py_MIMALLOC_HEAP_OBJECT) {
+                continue;
+            }
+            // Free the pages that are now empty, then promote the rest.
+            mi_heap_collect(&m->scoped_heaps[i], false);
+            _mi_heap_absorb(&m->heaps[i], &m->scoped_heaps[i]);
+        }
+    }
+#endif
+    return 0;
+}
+
 /**************************/
 /* the "object" allocator */
 /**************************/
@@ -1495,6 +1649,11 @@ get_mimalloc_allocated_blocks(PyInterpreterState *interp)
         for (int i = 0; i < _Py_MIMALLOC_HEAP_COUNT; i++) {
             mi_heap_t *heap = &tstate->mimalloc.heaps[i];
             mi_heap_visit_blocks(heap, false, &count_blocks, &allocated_blocks);
+            if (i >= _Py_MIMALLOC_HEAP_OBJECT) {
+                heap = &tstate->mimalloc.scoped_heaps[i];
+                mi_heap_visit_blocks(heap, false, &count_blocks,
+                                     &allocated_blocks);
+            }
         }
     }
 
@@ -2605,6 +2764,115 @@ _PyObject_Realloc(void *ctx, void *ptr, size_t nbytes)
     return PyMem_RawRealloc(ptr, nbytes);
 }
 
+/*==========================================================================*/
+/* Giving free memory back to the OS.
+ *
+ * An arena is only unmapped once all of its pools are free, so a long-running
+ * process whose live objects are scattered over many arenas can hold on to a
+ * lot of memory in free pools.  The pages of those pools, except the first one
+ * that holds the pool header, are handed back with madvise(MADV_DONTNEED).
+ * The pool's size class index is reset, so that its (now zeroed) free list is
+ * rebuilt the next time the pool is used.  Pools that were released already
+ * are recognized by that index and skipped.
+ */
+
+#ifdef ARENAS_USE_MMAP
+static size_t
+release_free_pools(OMState *state, size_t threshold)
+{
+    long pagesize = sysconf(_SC_PAGESIZE);
+    if (pagesize <= 0 || (size_t)pagesize >= POOL_SIZE) {
+        return 0;
+    }
+    size_t per_pool = POOL_SIZE - (size_t)pagesize;
+
+    if (threshold > 0) {
+        size_t resident = 0;
+        for (uint i = 0; i < maxarenas; ++i) {
+            if (allarenas[i].address == 0) {
+                continue;
+            }
+            for (poolp p = allarenas[i].freepools; p != NULL; p = p->nextpool) {
+                if (p->szidx != DUMMY_SIZE_IDX) {
+                    resident += per_pool;
+                }
+            }
+        }
+        if (resident < threshold) {
+            return 0;
+        }
+    }
+
+    size_t released = 0;
+    for (uint i = 0; i < maxarenas; ++i) {
+        /* Skip arenas which are not allocated. */
+        if (allarenas[i].address == 0) {
+            continue;
+        }
+        for (poolp p = allarenas[i].freepools; p != NULL; p = p->nextpool) {
+            if (p->szidx == DUMMY_SIZE_IDX) {
+                continue;
+            }
+            if (madvise((char *)p + pagesize, per_pool, MADV_DONTNEED) == 0) {
+                p->szidx = DUMMY_SIZE_IDX;
+                released += per_pool;
+            }
+        }
+    }
+    return released;
+}
+#endif
+
+static Py_ssize_t
+release_free_memory(PyInterpreterState *interp, size_t threshold)
+{
+#ifdef WITH_MIMALLOC
+    if (_PyMem_MimallocEnabled()) {
+        // mimalloc purges free pages on its own after a short delay
+        // (mi_option_purge_delay); only explicit calls force it.
+        if (threshold == 0) {
+#ifdef Py_GIL_DISABLED
+            // Other threads' heaps can only be collected by their owner.
+            _PyThreadStateImpl *tstate = (_PyThreadStateImpl *)_PyThreadState_GET();
+            for (int i = 0; i < _Py_MIMALLOC_HEAP_COUNT; i++) {
+                mi_heap_collect(&tstate->mimalloc.heaps[i], true);
+                if (i >= _Py_MIMALLOC_HEAP_OBJECT) {
+                    mi_heap_collect(&tstate->mimalloc.scoped_heaps[i], true);
+                }
+            }
+            _mi_arena_collect(true, &tstate->mimalloc.tld.stats);
+#else
+            mi_collect(true);
+#endif
+        }
+        return 0;
+    }
+#endif
+#ifdef ARENAS_USE_MMAP
+    if (!_PyMem_PymallocEnabled() || interp->obmalloc == NULL) {
+        return 0;
+    }
+    return (Py_ssize_t)release_free_pools(interp->obmalloc, threshold);
+#else
+    return 0;
+#endif
+}
+
+Py_ssize_t
+_PyMem_ReleaseFreeMemory(PyInterpreterState *interp)
+{
+    return release_free_memory(interp, 0);
+}
+
+void
+_PyMem_ReleaseFreeMemoryIfNeeded(PyInterpreterState *interp)
+{
+    size_t threshold = _PyRuntime.allocators.release_threshold;
+    if (threshold > 0) {
+        (void)release_free_memory(interp, threshold);
+    }
+}
+
 #else   /* ! WITH_PYMALLOC */
 
 /*==========================================================================*/
@@ -2635,6 +2903,18 @@ _Py_FinalizeAllocatedBlocks(_PyRuntimeState *Py_UNUSED(runtime))
     return;
 }
 
+Py_ssize_t
+_PyMem_ReleaseFreeMemory(PyInterpreterState *Py_UNUSED(interp))
+{
+    return 0;
+}
+
+void
+_PyMem_ReleaseFreeMemoryIfNeeded(PyInterpreterState *Py_UNUSED(interp))
+{
+    return;
+}
+
 #endif /* WITH_PYMALLOC */
 
 
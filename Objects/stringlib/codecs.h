@@ -19,6 +19,209 @@
 /* 10xxxxxx */
 #define IS_CONTINUATION_BYTE(ch) ((ch) >= 0x80 && (ch) < 0xC0)
 
+/* The UTF-8 decoder and encoder handle blocks of UTF8_BLOCK bytes or
+   characters at once with SSE2 on x86-64 and NEON on AArch64.  Comparing a
+   block of bytes with a few thresholds gives masks which tell whether the
+   block only holds ASCII characters and valid 2- and 3-byte sequences, and
+   where each character starts; the characters of such a block are then
+   decoded without a branch per character.  Blocks holding anything else
+   (4-byte sequences, errors, characters out of range) are decoded one
+   character at a time. */
+#if PY_LITTLE_ENDIAN
+#  if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#    include <emmintrin.h>
+#    define UTF8_VECTOR_SSE2
+#  elif defined(__ARM_NEON) && defined(__aarch64__)
+#    include <arm_neon.h>
+#    define UTF8_VECTOR_NEON
+#  endif
+#endif
+
+#if defined(UTF8_VECTOR_SSE2) || defined(UTF8_VECTOR_NEON)
+#define UTF8_BLOCK 16
+/* After a block which can't be handled at once, decode or encode this
+   many bytes or characters one at a time before trying the next block. */
+#define UTF8_BACKOFF (4 * UTF8_BLOCK)
+
+#ifdef UTF8_VECTOR_SSE2
+#  define UTF8_VECTOR __m128i
+#  define UTF8_LOAD(s) _mm_loadu_si128((const __m128i *)(s))
+#  define UTF8_GE(v, k) \
+    _mm_cmpeq_epi8(_mm_max_epu8((v), _mm_set1_epi8((char)(k))), (v))
+#  define UTF8_EQ(v, k) _mm_cmpeq_epi8((v), _mm_set1_epi8((char)(k)))
+#else
+#  define UTF8_VECTOR uint8x16_t
+#  define UTF8_LOAD(s) vld1q_u8((const uint8_t *)(s))
+#  define UTF8_GE(v, k) vcgeq_u8((v), vdupq_n_u8(k))
+#  define UTF8_EQ(v, k) vceqq_u8((v), vdupq_n_u8(k))
+#endif
+
+/* Return a mask with bit i set if byte i of the comparison result v is
+   set. */
+Py_LOCAL_INLINE(unsigned int)
+STRINGLIB(_utf8_mask)(UTF8_VECTOR v)
+{
+#ifdef UTF8_VECTOR_SSE2
+    return (unsigned int)_mm_movemask_epi8(v);
+#else
+    static const uint8_t bits[16] = {1, 2, 4, 8, 16, 32, 64, 128,
+                                     1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t t = vandq_u8(v, vld1q_u8(bits));
+    return ((unsigned int)vaddv_u8(vget_low_u8(t))
+            | (unsigned int)vaddv_u8(vget_high_u8(t)) << 8);
+#endif
+}
+
+/* Store in vals[i] the character of the 1-, 2- or 3-byte sequence
+   starting at s[i], as told by its first byte, for i in [0, UTF8_BLOCK).
+   The value is meaningless where s[i] doesn't start a valid sequence.
+   Read UTF8_BLOCK + 2 bytes. */
+Py_LOCAL_INLINE(void)
+STRINGLIB(_utf8_block_values)(const unsigned char *s, uint16_t *vals)
+{
+#ifdef UTF8_VECTOR_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i low5 = _mm_set1_epi16(0x1F), low6 = _mm_set1_epi16(0x3F);
+    __m128i b0 = UTF8_LOAD(s), b1 = UTF8_LOAD(s + 1), b2 = UTF8_LOAD(s + 2);
+    for (int h = 0; h < 2; h++) {
+        __m128i w0, c1, c2;
+        if (h == 0) {
+            w0 = _mm_unpacklo_epi8(b0, zero);
+            c1 = _mm_and_si128(_mm_unpacklo_epi8(b1, zero), low6);
+            c2 = _mm_and_si128(_mm_unpacklo_epi8(b2, zero), low6);
+        }
+        else {
+            w0 = _mm_unpackhi_epi8(b0, zero);
+            c1 = _mm_and_si128(_mm_unpackhi_epi8(b1, zero), low6);
+            c2 = _mm_and_si128(_mm_unpackhi_epi8(b2, zero), low6);
+        }
+        __m128i v2 = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(w0, low5), 6),
+                                  c1);
+        __m128i v3 = _mm_or_si128(_mm_slli_epi16(w0, 12),
+                                  _mm_or_si128(_mm_slli_epi16(c1, 6), c2));
+        __m128i is2 = _mm_cmpgt_epi16(w0, _mm_set1_epi16(0x7F));
+        __m128i is3 = _mm_cmpgt_epi16(w0, _mm_set1_epi16(0xDF));
+        __m128i v = _mm_or_si128(_mm_and_si128(is2, v2),
+                                 _mm_andnot_si128(is2, w0));
+        v = _mm_or_si128(_mm_and_si128(is3, v3), _mm_andnot_si128(is3, v));
+        _mm_storeu_si128((__m128i *)(vals + 8 * h), v);
+    }
+#else
+    const uint16x8_t low5 = vdupq_n_u16(0x1F), low6 = vdupq_n_u16(0x3F);
+    uint8x16_t b0 = UTF8_LOAD(s), b1 = UTF8_LOAD(s + 1), b2 = UTF8_LOAD(s + 2);
+    for (int h = 0; h < 2; h++) {
+        uint16x8_t w0, c1, c2;
+        if (h == 0) {
+            w0 = vmovl_u8(vget_low_u8(b0));
+            c1 = vandq_u16(vmovl_u8(vget_low_u8(b1)), low6);
+            c2 = vandq_u16(vmovl_u8(vget_low_u8(b2)), low6);
+        }
+        else {
+            w0 = vmovl_u8(vget_high_u8(b0));
+            c1 = vandq_u16(vmovl_u8(vget_high_u8(b1)), low6);
+            c2 = vandq_u16(vmovl_u8(vget_high_u8(b2)), low6);
+        }
+        uint16x8_t v2 = vorrq_u16(vshlq_n_u16(vandq_u16(w0, low5), 6), c1);
+        uint16x8_t v3 = vorrq_u16(vshlq_n_u16(w0, 12),
+                                  vorrq_u16(vshlq_n_u16(c1, 6), c2));
+        uint16x8_t v = vbslq_u16(vcgtq_u16(w0, vdupq_n_u16(0x7F)), v2, w0);
+        v = vbslq_u16(vcgtq_u16(w0, vdupq_n_u16(0xDF)), v3, v);
+        vst1q_u16(vals + 8 * h, v);
+    }
+#endif
+}
+
+/* Decode the characters starting in the UTF8_BLOCK bytes at s if they are
+   all valid 1-, 2- or 3-byte sequences which fit in STRINGLIB_CHAR, and
+   return the number of bytes decoded.  A sequence starting at the end of
+   the block and going past it is left for the next block.  Return 0 if
+   the block must be decoded one character at a time.
+   Read UTF8_BLOCK + 2 bytes. */
+Py_LOCAL_INLINE(Py_ssize_t)
+STRINGLIB(_utf8_decode_block)(const unsigned char *s, STRINGLIB_CHAR **outptr)
+{
+    STRINGLIB_CHAR *p = *outptr;
+    UTF8_VECTOR b = UTF8_LOAD(s);
+    unsigned int nonascii = STRINGLIB(_utf8_mask)(UTF8_GE(b, 0x80));
+
+    if (nonascii == 0) {
+        for (int i = 0; i < UTF8_BLOCK; i++) {
+            p[i] = s[i];
+        }
+        *outptr = p + UTF8_BLOCK;
+        return UTF8_BLOCK;
+    }
+#if STRINGLIB_MAX_CHAR <= 0x7F
+    return 0;
+#else
+    if (nonascii == 0xFFFF) {
+        /* Runs of sequences of the same length are decoded as fast one
+           character at a time: the branches are predictable. */
+        return 0;
+    }
+    unsigned int ge_c0 = STRINGLIB(_utf8_mask)(UTF8_GE(b, 0xC0));
+    unsigned int ge_c2 = STRINGLIB(_utf8_mask)(UTF8_GE(b, 0xC2));
+    unsigned int ge_e0 = STRINGLIB(_utf8_mask)(UTF8_GE(b, 0xE0));
+    unsigned int ge_f0 = STRINGLIB(_utf8_mask)(UTF8_GE(b, 0xF0));
+    unsigned int cont = nonascii & ~ge_c0;
+    unsigned int lead2 = ge_c2 & ~ge_e0;
+    unsigned int lead3 = ge_e0 & ~ge_f0;
+
+    /* \xC0 and \xC1 are invalid, \xF0-\xFF start 4-byte sequences or are
+       invalid. */
+    if ((ge_c0 & ~ge_c2) | ge_f0) {
+        return 0;
+    }
+    /* Continuation bytes must be exactly those following a start byte. */
+    if ((((lead2 | lead3) << 1 | lead3 << 2) & 0xFFFF) != cont) {
+        return 0;
+    }
+
+    Py_ssize_t n = UTF8_BLOCK;
+    if ((lead2 | lead3) & 0x8000) {
+        n = UTF8_BLOCK - 1;
+    }
+    else if (lead3 & 0x4000) {
+        n = UTF8_BLOCK - 2;
+    }
+    unsigned int starts = ~cont & ((1u << n) - 1);
+
+    if (lead3 & starts) {
+        /* Bit i is set if s[i + 1] >= 0xA0, for i < UTF8_BLOCK - 1. */
+        unsigned int ge_a0 = STRINGLIB(_utf8_mask)(UTF8_GE(b, 0xA0)) >> 1;
+        /* \xE0\x80-\xE0\x9F are overlong, \xED\xA0-\xED\xBF encode
+           surrogates. */
+        unsigned int e0 = STRINGLIB(_utf8_mask)(UTF8_EQ(b, 0xE0));
+        unsigned int ed = STRINGLIB(_utf8_mask)(UTF8_EQ(b, 0xED));
+        if (((e0 & ~ge_a0) | (ed & ge_a0)) & starts) {
+            return 0;
+        }
+#if STRINGLIB_MAX_CHAR <= 0x07FF
+        return 0;
+#endif
+    }
+#if STRINGLIB_MAX_CHAR <= 0xFF
+    if (lead2 & starts & STRINGLIB(_utf8_mask)(UTF8_GE(b, 0xC4))) {
+        return 0;
+    }
+#endif
+
+    uint16_t vals[UTF8_BLOCK];
+    STRINGLIB(_utf8_block_values)(s, vals);
+    /* The value of every byte is written, and kept if the byte starts a
+       character.  This writes one character past the output, where the
+       next character goes. */
+    Py_ssize_t k = 0;
+    for (int i = 0; i < UTF8_BLOCK; i++) {
+        p[k] = (STRINGLIB_CHAR)vals[i];
+        k += (starts >> i) & 1;
+    }
+    *outptr = p + k;
+    return n;
+#endif
+}
+#endif  /* UTF8_VECTOR_SSE2 || UTF8_VECTOR_NEON */
+
 Py_LOCAL_INLINE(Py_UCS4)
 STRINGLIB(utf8_decode)(const char **inptr, const char *end,
                        STRINGLIB_CHAR *dest,
@@ -27,8 +230,26 @@ STRINGLIB(utf8_decode)(const char **inptr, const char *end,
     Py_UCS4 ch;
     const char *s = *inptr;
     STRINGLIB_CHAR *p = dest + *outpos;
+#ifdef UTF8_BLOCK
+    /* Decode one character at a time up to there. */
+    const char *scalar_end = s;
+#endif
 
     while (s < end) {
+#ifdef UTF8_BLOCK
+        if (s >= scalar_end) {
+            while (end - s >= UTF8_BLOCK + 2) {
+                Py_ssize_t n = STRINGLIB(_utf8_decode_block)(
+                    (const unsigned char *)s, &p);
+                if (n == 0) {
+                    break;
+                }
+                s += n;
+            }
+            /* Don't form a pointer past the end of the input. */
+            scalar_end = s + Py_MIN(end - s, UTF8_BACKOFF);
+        }
+#endif
         ch = (unsigned char)*s;
 
         if (ch < 0x80) {
@@ -253,6 +474,45 @@ STRINGLIB(utf8_decode)(const char **inptr, const char *end,
 
 #undef ASCII_CHAR_MASK
 
+#ifdef UTF8_BLOCK
+/* Encode the UTF8_BLOCK characters at data and return the end of the
+   output, or return NULL if the block must be encoded one character at a
+   time.  Latin-1 characters are stored as 16-bit words and the output
+   pointer moves by their length, so that there is no branch per character;
+   one byte may be written past the end of the output.  Wider kinds only
+   take blocks of ASCII characters. */
+Py_LOCAL_INLINE(char *)
+STRINGLIB(_utf8_encode_block)(const STRINGLIB_CHAR *data, char *p)
+{
+#if STRINGLIB_SIZEOF_CHAR == 1
+    if (STRINGLIB(_utf8_mask)(UTF8_GE(UTF8_LOAD(data), 0x80)) == 0) {
+        memcpy(p, data, UTF8_BLOCK);
+        return p + UTF8_BLOCK;
+    }
+    for (int i = 0; i < UTF8_BLOCK; i++) {
+        unsigned int ch = data[i];
+        uint16_t w = (uint16_t)(ch < 0x80 ? ch
+                                : (0xc0 | ch >> 6) | (0x80 | (ch & 0x3f)) << 8);
+        memcpy(p, &w, sizeof(w));
+        p += 1 + (ch >> 7);
+    }
+    return p;
+#else
+    Py_UCS4 all = 0;
+    for (int i = 0; i < UTF8_BLOCK; i++) {
+        all |= data[i];
+    }
+    if (all >= 0x80) {
+        return NULL;
+    }
+    for (int i = 0; i < UTF8_BLOCK; i++) {
+        p[i] = (char)data[i];
+    }
+    return p + UTF8_BLOCK;
+#endif
+}
+#endif  /* UTF8_BLOCK */
+
 
 /* UTF-8 encoder specialized for a Unicode kind to avoid the slow
    PyUnicode_READ() macro. Delete some parts of the code depending on the kind:
@@ -292,7 +552,25 @@ STRINGLIB(utf8_encoder)(_PyBytesWriter *writer,
     if (p == NULL)
         return NULL;
 
+#ifdef UTF8_BLOCK
+    /* Encode one character at a time up to there. */
+    Py_ssize_t scalar_end = 0;
+#endif
     for (i = 0; i < size;) {
+#ifdef UTF8_BLOCK
+        if (i >= scalar_end) {
+            /* Leave room for the byte written past the end of a block. */
+            while (size - i > UTF8_BLOCK) {
+                char *q = STRINGLIB(_utf8_encode_block)(data + i, p);
+                if (q == NULL) {
+                    break;
+                }
+                p = q;
+                i += UTF8_BLOCK;
+            }
+            scalar_end = i + UTF8_BACKOFF;
+        }
+#endif
         Py_UCS4 ch = data[i++];
 
         if (ch < 0x80) {
@@ -828,3 +1106,12 @@ STRINGLIB(utf32_encode)(const STRINGLIB_CHAR *in,
 }
 
 #endif
+
+#undef UTF8_VECTOR_SSE2
+#undef UTF8_VECTOR_NEON
+#undef UTF8_BLOCK
+#undef UTF8_BACKOFF
+#undef UTF8_VECTOR
+#undef UTF8_LOAD
+#undef UTF8_GE
+#undef UTF8_EQ
@@ -686,6 +686,160 @@ STRINGLIB(adaptive_find)(const STRINGLIB_CHAR* s, Py_ssize_t n,
 }
 
 
+/* Vectorized search for 1- and 2-byte characters.  A block of positions is
+   compared at once with the first and the last characters of the needle,
+   and only the positions where both match are compared with the rest of the
+   needle.  On typical text this filter leaves few candidates; if it leaves
+   too many, the search goes on with the two-way algorithm. */
+
+#if STRINGLIB_SIZEOF_CHAR <= 2
+#  if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#    include <emmintrin.h>
+#    define STRINGLIB_VECTOR_SSE2
+#  elif defined(__ARM_NEON) && defined(__aarch64__)
+#    include <arm_neon.h>
+#    define STRINGLIB_VECTOR_NEON
+#  endif
+#endif
+
+#if defined(STRINGLIB_VECTOR_SSE2) || defined(STRINGLIB_VECTOR_NEON)
+#define STRINGLIB_VECTOR_CHARS (16 / STRINGLIB_SIZEOF_CHAR)
+/* Longer needles are searched with the two-way algorithm, which skips
+   further ahead.  A block holds half as many UCS2 characters, so the
+   two-way algorithm catches up with much shorter needles. */
+#if STRINGLIB_SIZEOF_CHAR == 1
+#  define STRINGLIB_VECTOR_MAX_NEEDLE 256
+#else
+#  define STRINGLIB_VECTOR_MAX_NEEDLE 32
+#endif
+
+/* A candidate mask has one bit set per candidate position i of the block,
+   at bit (i << VECTOR_MASK_SHIFT). */
+#ifdef STRINGLIB_VECTOR_SSE2
+#  define VECTOR_MASK_SHIFT (STRINGLIB_SIZEOF_CHAR - 1)
+#else
+#  define VECTOR_MASK_SHIFT (STRINGLIB_SIZEOF_CHAR + 1)
+#endif
+
+/* Return the mask of the positions i in [0, STRINGLIB_VECTOR_CHARS) such
+   that s[i] == first and s[i + mlast] == last. */
+Py_LOCAL_INLINE(uint64_t)
+STRINGLIB(_vector_candidates)(const STRINGLIB_CHAR *s, Py_ssize_t mlast,
+                              STRINGLIB_CHAR first, STRINGLIB_CHAR last)
+{
+#if defined(STRINGLIB_VECTOR_SSE2)
+    __m128i a = _mm_loadu_si128((const __m128i *)s);
+    __m128i b = _mm_loadu_si128((const __m128i *)(s + mlast));
+#  if STRINGLIB_SIZEOF_CHAR == 1
+    __m128i eq = _mm_and_si128(_mm_cmpeq_epi8(a, _mm_set1_epi8((char)first)),
+                               _mm_cmpeq_epi8(b, _mm_set1_epi8((char)last)));
+    return (uint64_t)(unsigned int)_mm_movemask_epi8(eq);
+#  else
+    __m128i eq = _mm_and_si128(_mm_cmpeq_epi16(a, _mm_set1_epi16((short)first)),
+                               _mm_cmpeq_epi16(b, _mm_set1_epi16((short)last)));
+    return (uint64_t)(unsigned int)_mm_movemask_epi8(eq) & 0x5555;
+#  endif
+#else
+#  if STRINGLIB_SIZEOF_CHAR == 1
+    const uint8_t *a = (const uint8_t *)s;
+    uint8x16_t eq = vandq_u8(vceqq_u8(vld1q_u8(a), vdupq_n_u8((uint8_t)first)),
+                             vceqq_u8(vld1q_u8(a + mlast),
+                                      vdupq_n_u8((uint8_t)last)));
+    const uint64_t keep = UINT64_C(0x8888888888888888);
+#  else
+    const uint16_t *a = (const uint16_t *)s;
+    uint8x16_t eq = vreinterpretq_u8_u16(
+        vandq_u16(vceqq_u16(vld1q_u16(a), vdupq_n_u16(first)),
+                  vceqq_u16(vld1q_u16(a + mlast), vdupq_n_u16(last))));
+    const uint64_t keep = UINT64_C(0x8080808080808080);
+#  endif
+    /* Narrow every byte to a nibble, keep one bit per character. */
+    uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & keep;
+#endif
+}
+
+Py_LOCAL_INLINE(Py_ssize_t)
+STRINGLIB(_vector_first)(uint64_t mask)
+{
+    assert(mask != 0);
+#if defined(__clang__) || defined(__GNUC__)
+    return __builtin_ctzll(mask) >> VECTOR_MASK_SHIFT;
+#else
+    Py_ssize_t j = 0;
+    while (!(mask & 1)) {
+        mask >>= 1;
+        j++;
+    }
+    return j >> VECTOR_MASK_SHIFT;
+#endif
+}
+
+static Py_ssize_t
+STRINGLIB(vector_find)(const STRINGLIB_CHAR* s, Py_ssize_t n,
+                       const STRINGLIB_CHAR* p, Py_ssize_t m,
+                       Py_ssize_t maxcount, int mode)
+{
+    const Py_ssize_t w = n - m;
+    const Py_ssize_t mlast = m - 1;
+    const STRINGLIB_CHAR first = p[0];
+    const STRINGLIB_CHAR last = p[mlast];
+    Py_ssize_t i = 0, count = 0, misses = 0, res;
+
+    assert(m >= 2);
+    /* Blocks of positions [i, i + STRINGLIB_VECTOR_CHARS) <= w */
+    while (i < w - (STRINGLIB_VECTOR_CHARS - 2)) {
+        uint64_t mask = STRINGLIB(_vector_candidates)(s + i, mlast,
+                                                      first, last);
+        Py_ssize_t next = i + STRINGLIB_VECTOR_CHARS;
+        while (mask != 0) {
+            Py_ssize_t j = i + STRINGLIB(_vector_first)(mask);
+            mask &= mask - 1;
+            if (memcmp(s + j + 1, p + 1,
+                       (m - 2) * sizeof(STRINGLIB_CHAR)) == 0)
+            {
+                /* got a match! */
+                if (mode != FAST_COUNT) {
+                    return j;
+                }
+                count++;
+                if (count == maxcount) {
+                    return maxcount;
+                }
+                next = j + m;
+                break;
+            }
+            /* Switch to the two-way algorithm once the false candidates
+               cost more than the characters scanned so far. */
+            misses += m;
+            if (m >= 6 && misses > i + 1000 && w - j > 2000) {
+                j++;
+                if (mode == FAST_SEARCH) {
+                    res = STRINGLIB(_two_way_find)(s + j, n - j, p, m);
+                    return res == -1 ? -1 : res + j;
+                }
+                res = STRINGLIB(_two_way_count)(s + j, n - j, p, m,
+                                                maxcount - count);
+                return res + count;
+            }
+        }
+        i = next;
+    }
+    if (i > w) {
+        return mode == FAST_COUNT ? count : -1;
+    }
+    /* The last positions don't fill a block. */
+    res = STRINGLIB(default_find)(s + i, n - i, p, m, maxcount - count, mode);
+    if (mode == FAST_COUNT) {
+        return res + count;
+    }
+    return res == -1 ? -1 : res + i;
+}
+
+#undef VECTOR_MASK_SHIFT
+#endif  /* STRINGLIB_VECTOR_SSE2 || STRINGLIB_VECTOR_NEON */
+
+
 static Py_ssize_t
 STRINGLIB(default_rfind)(const STRINGLIB_CHAR* s, Py_ssize_t n,
                          const STRINGLIB_CHAR* p, Py_ssize_t m,
@@ -797,6 +951,11 @@ FASTSEARCH(const STRINGLIB_CHAR* s, Py_ssize_t n,
     }
 
     if (mode != FAST_RSEARCH) {
+#ifdef STRINGLIB_VECTOR_CHARS
+        if (m <= STRINGLIB_VECTOR_MAX_NEEDLE) {
+            return STRINGLIB(vector_find)(s, n, p, m, maxcount, mode);
+        }
+#endif
         if (n < 2500 || (m < 100 && n < 30000) || m < 6) {
             return STRINGLIB(default_find)(s, n, p, m, maxcount, mode);
         }
@@ -828,3 +987,7 @@ FASTSEARCH(const STRINGLIB_CHAR* s, Py_ssize_t n,
     }
 }
 
+#undef STRINGLIB_VECTOR_SSE2
+#undef STRINGLIB_VECTOR_NEON
+#undef STRINGLIB_VECTOR_CHARS
+#undef STRINGLIB_VECTOR_MAX_NEEDLE
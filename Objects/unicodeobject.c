@@ -551,6 +551,8 @@ static const unsigned char ascii_linebreak[] = {
 static int convert_uc(PyObject *obj, void *addr);
 
 struct encoding_map;
+struct stringbuilder;
+static PyTypeObject StringBuilderType;
 #include "clinic/unicodeobject.c.h"
 
 _Py_error_handler
@@ -15672,6 +15674,9 @@ _PyUnicode_InitTypes(PyInterpreterState *interp)
     if (_PyStaticType_InitBuiltin(interp, &PyFormatterIter_Type) < 0) {
         goto error;
     }
+    if (_PyStaticType_InitBuiltin(interp, &StringBuilderType) < 0) {
+        goto error;
+    }
     return _PyStatus_OK();
 
 error:
@@ -16442,6 +16447,7 @@ _PyUnicode_FiniTypes(PyInterpreterState *interp)
     _PyStaticType_FiniBuiltin(interp, &EncodingMapType);
     _PyStaticType_FiniBuiltin(interp, &PyFieldNameIter_Type);
     _PyStaticType_FiniBuiltin(interp, &PyFormatterIter_Type);
+    _PyStaticType_FiniBuiltin(interp, &StringBuilderType);
 }
 
 
@@ -16464,6 +16470,213 @@ _PyUnicode_Fini(PyInterpreterState *interp)
     unicode_clear_identifiers(state);
 }
 
+/* string.StringBuilder: a mutable string accumulator exposing the
+   overallocation and kind widening of the Unicode writer to Python code.
+
+   The builder is either empty, accumulating (the contents are in writer) or
+   built (the contents are the str value, returned by the last build()).
+   Appending to a built builder copies value into a new writer, so that
+   build() doesn't have to copy the buffer of the writer. */
+
+/*[clinic input]
+module _string
+class _string.StringBuilder "struct stringbuilder *" "&StringBuilderType"
+[clinic start generated code]*/
+/*[clinic end generated code: output=da39a3ee5e6b4b0d input=dc6122251af3565a]*/
+
+struct stringbuilder {
+    PyObject_HEAD
+    PyUnicodeWriter *writer;
+    PyObject *value;
+};
+
+#define stringbuilder_CAST(op) ((struct stringbuilder *)(op))
+
+/*[clinic input]
+@classmethod
+_string.StringBuilder.__new__ as stringbuilder_new
+
+Create an empty string builder.
+
+Strings appended to the builder are copied into a buffer which grows by
+a factor, so that building a string of n characters takes O(n) time.
+[clinic start generated code]*/
+
+static PyObject *
+stringbuilder_new_impl(PyTypeObject *type)
+/*[clinic end generated code: output=e3feb9632492b0a2 input=c04cd672888f2683]*/
+{
+    struct stringbuilder *self = (struct stringbuilder *)type->tp_alloc(type, 0);
+    if (self == NULL) {
+        return NULL;
+    }
+    self->writer = NULL;
+    self->value = NULL;
+    return (PyObject *)self;
+}
+
+static void
+stringbuilder_dealloc(PyObject *op)
+{
+    struct stringbuilder *self = stringbuilder_CAST(op);
+    PyUnicodeWriter_Discard(self->writer);
+    Py_XDECREF(self->value);
+    Py_TYPE(self)->tp_free(self);
+}
+
+static int
+stringbuilder_write_lock_held(struct stringbuilder *self, PyObject *str)
+{
+    _Py_CRITICAL_SECTION_ASSERT_OBJECT_LOCKED(self);
+    if (PyUnicode_GET_LENGTH(str) == 0) {
+        return 0;
+    }
+    if (self->writer == NULL) {
+        self->writer = PyUnicodeWriter_Create(0);
+        if (self->writer == NULL) {
+            return -1;
+        }
+        if (self->value != NULL) {
+            if (PyUnicodeWriter_WriteStr(self->writer, self->value) < 0) {
+                PyUnicodeWriter_Discard(self->writer);
+                self->writer = NULL;
+                return -1;
+            }
+            Py_CLEAR(self->value);
+        }
+    }
+    return PyUnicodeWriter_WriteStr(self->writer, str);
+}
+
+/*[clinic input]
+@critical_section
+_string.StringBuilder.append
+
+    s: unicode
+    /
+
+Append s to the builder.
+[clinic start generated code]*/
+
+static PyObject *
+_string_StringBuilder_append_impl(struct stringbuilder *self, PyObject *s)
+/*[clinic end generated code: output=9a1dfab0e6f7e489 input=b70cd5524f30aff0]*/
+{
+    if (stringbuilder_write_lock_held(self, s) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+@critical_section
+_string.StringBuilder.write
+
+    s: unicode
+    /
+
+Append s to the builder and return the number of characters written.
+
+This allows the builder to be used as the file argument of print().
+[clinic start generated code]*/
+
+static PyObject *
+_string_StringBuilder_write_impl(struct stringbuilder *self, PyObject *s)
+/*[clinic end generated code: output=fab5e072246ecbdf input=e7de150adf3d250c]*/
+{
+    if (stringbuilder_write_lock_held(self, s) < 0) {
+        return NULL;
+    }
+    return PyLong_FromSsize_t(PyUnicode_GET_LENGTH(s));
+}
+
+/*[clinic input]
+@critical_section
+_string.StringBuilder.build
+
+Return the contents of the builder as a str.
+
+The builder keeps its contents and can be appended to afterwards.
+[clinic start generated code]*/
+
+static PyObject *
+_string_StringBuilder_build_impl(struct stringbuilder *self)
+/*[clinic end generated code: output=f74710f7ca958fc1 input=6106df5f9f0e15ce]*/
+{
+    if (self->writer != NULL) {
+        assert(self->value == NULL);
+        self->value = PyUnicodeWriter_Finish(self->writer);
+        self->writer = NULL;
+        if (self->value == NULL) {
+            return NULL;
+        }
+    }
+    if (self->value == NULL) {
+        return Py_GetConstant(Py_CONSTANT_EMPTY_STR);
+    }
+    return Py_NewRef(self->value);
+}
+
+/*[clinic input]
+@critical_section
+_string.StringBuilder.clear
+
+Remove all the contents of the builder.
+[clinic start generated code]*/
+
+static PyObject *
+_string_StringBuilder_clear_impl(struct stringbuilder *self)
+/*[clinic end generated code: output=0fb1e63db56fed52 input=9cccfebe7bba3756]*/
+{
+    PyUnicodeWriter_Discard(self->writer);
+    self->writer = NULL;
+    Py_CLEAR(self->value);
+    Py_RETURN_NONE;
+}
+
+static Py_ssize_t
+stringbuilder_length(PyObject *op)
+{
+    struct stringbuilder *self = stringbuilder_CAST(op);
+    Py_ssize_t length;
+    Py_BEGIN_CRITICAL_SECTION(self);
+    if (self->writer != NULL) {
+        length = ((_PyUnicodeWriter *)self->writer)->pos;
+    }
+    else if (self->value != NULL) {
+        length = PyUnicode_GET_LENGTH(self->value);
+    }
+    else {
+        length = 0;
+    }
+    Py_END_CRITICAL_SECTION();
+    return length;
+}
+
+static PyMethodDef stringbuilder_methods[] = {
+    _STRING_STRINGBUILDER_APPEND_METHODDEF
+    _STRING_STRINGBUILDER_WRITE_METHODDEF
+    _STRING_STRINGBUILDER_BUILD_METHODDEF
+    _STRING_STRINGBUILDER_CLEAR_METHODDEF
+    {NULL, NULL}
+};
+
+static PySequenceMethods stringbuilder_as_sequence = {
+    .sq_length = stringbuilder_length,
+};
+
+static PyTypeObject StringBuilderType = {
+    PyVarObject_HEAD_INIT(&PyType_Type, 0)
+    .tp_name = "string.StringBuilder",
+    .tp_basicsize = sizeof(struct stringbuilder),
+    .tp_dealloc = stringbuilder_dealloc,
+    .tp_as_sequence = &stringbuilder_as_sequence,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_doc = stringbuilder_new__doc__,
+    .tp_methods = stringbuilder_methods,
+    .tp_new = stringbuilder_new,
+};
+
 /* A _string module, to export formatter_parser and formatter_field_name_split
    to the string.Formatter class implemented in Python. */
 
@@ -16475,7 +16688,15 @@ static PyMethodDef _string_methods[] = {
     {NULL, NULL}
 };
 
+static int
+_string_exec(PyObject *module)
+{
+    return PyModule_AddObjectRef(module, "StringBuilder",
+                                 (PyObject *)&StringBuilderType);
+}
+
 static PyModuleDef_Slot module_slots[] = {
+    {Py_mod_exec, _string_exec},
     {Py_mod_multiple_interpreters, Py_MOD_PER_INTERPRETER_GIL_SUPPORTED},
     {Py_mod_gil, Py_MOD_GIL_NOT_USED},
     {0, NULL}
@@ -1278,6 +1278,80 @@ sys__clear_type_cache(PyObject *module, PyObject *Py_UNUSED(ignored))
     return sys__clear_type_cache_impl(module);
 }
 
+PyDoc_STRVAR(sys__enter_allocation_scope__doc__,
+"_enter_allocation_scope($module, /)\n"
+"--\n"
+"\n"
+"Start placing new objects of this thread in separate heaps.\n"
+"\n"
+"Objects allocated until the matching _exit_allocation_scope() call are kept\n"
+"apart from longer-lived objects, so that their memory can be released\n"
+"together once they die.  Scopes can be nested.  Only the free-threaded\n"
+"build keeps separate heaps.");
+
+#define SYS__ENTER_ALLOCATION_SCOPE_METHODDEF    \
+    {"_enter_allocation_scope", (PyCFunction)sys__enter_allocation_scope, METH_NOARGS, sys__enter_allocation_scope__doc__},
+
+static PyObject *
+sys__enter_allocation_scope_impl(PyObject *module);
+
+static PyObject *
+sys__enter_allocation_scope(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return sys__enter_allocation_scope_impl(module);
+}
+
+PyDoc_STRVAR(sys__exit_allocation_scope__doc__,
+"_exit_allocation_scope($module, /)\n"
+"--\n"
+"\n"
+"Exit the innermost scope entered by _enter_allocation_scope().\n"
+"\n"
+"Memory of the outermost scope that is no longer used is released, and\n"
+"objects that are still alive are moved to the regular heap.");
+
+#define SYS__EXIT_ALLOCATION_SCOPE_METHODDEF    \
+    {"_exit_allocation_scope", (PyCFunction)sys__exit_allocation_scope, METH_NOARGS, sys__exit_allocation_scope__doc__},
+
+static PyObject *
+sys__exit_allocation_scope_impl(PyObject *module);
+
+static PyObject *
+sys__exit_allocation_scope(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return sys__exit_allocation_scope_impl(module);
+}
+
+PyDoc_STRVAR(sys__release_free_memory__doc__,
+"_release_free_memory($module, /)\n"
+"--\n"
+"\n"
+"Give the memory of free allocator pools and pages back to the OS.\n"
+"\n"
+"Return the number of bytes released from pymalloc pools.");
+
+#define SYS__RELEASE_FREE_MEMORY_METHODDEF    \
+    {"_release_free_memory", (PyCFunction)sys__release_free_memory, METH_NOARGS, sys__release_free_memory__doc__},
+
+static Py_ssize_t
+sys__release_free_memory_impl(PyObject *module);
+
+static PyObject *
+sys__release_free_memory(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+    Py_ssize_t _return_value;
+
+    _return_value = sys__release_free_memory_impl(module);
+    if ((_return_value == -1) && PyErr_Occurred()) {
+        goto exit;
+    }
+    return_value = PyLong_FromSsize_t(_return_value);
+
+exit:
+    return return_value;
+}
+
 PyDoc_STRVAR(sys__clear_internal_caches__doc__,
 "_clear_internal_caches($module, /)\n"
 "--\n"
@@ -1754,4 +1828,4 @@ exit:
 #ifndef SYS_GETANDROIDAPILEVEL_METHODDEF
     #define SYS_GETANDROIDAPILEVEL_METHODDEF
 #endif /* !defined(SYS_GETANDROIDAPILEVEL_METHODDEF) */
-/*[clinic end generated code: output=1e5f608092c12636 input=a9049054013a1b77]*/
+/*[clinic end generated code: output=02effe191033e10f input=a9049054013a1b77]*/
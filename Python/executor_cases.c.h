@@ -3470,8 +3470,10 @@
             #endif
             assert(PyDict_CheckExact((PyObject *)dict));
             PyObject *name = GETITEM(FRAME_CO_NAMES, oparg);
+            // A table shared with a copy of the dict must be copied first
             if (hint >= (size_t)dict->ma_keys->dk_nentries ||
-                !DK_IS_UNICODE(dict->ma_keys)) {
+                !DK_IS_UNICODE(dict->ma_keys) ||
+                dict->ma_keys->dk_refcnt != 1) {
                 UNLOCK_OBJECT(dict);
                 if (true) {
                     UOP_STAT_INC(uopcode, miss);
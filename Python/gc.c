@@ -11,6 +11,7 @@
 #include "pycore_object.h"
 #include "pycore_object_alloc.h"  // _PyObject_MallocWithType()
 #include "pycore_pyerrors.h"
+#include "pycore_pymem.h"         // _PyMem_ReleaseFreeMemoryIfNeeded()
 #include "pycore_pystate.h"       // _PyThreadState_GET()
 #include "pycore_weakref.h"       // _PyWeakref_ClearRef()
 #include "pydtrace.h"
@@ -363,7 +364,9 @@ append_objects(PyObject *py_list, PyGC_Head *gc_list)
     PyGC_Head *gc;
     for (gc = GC_NEXT(gc_list); gc != gc_list; gc = GC_NEXT(gc)) {
         PyObject *op = FROM_GC(gc);
-        if (op != py_list) {
+        // The tables shared by copies of a dict are an implementation
+        // detail of dict
+        if (op != py_list && !Py_IS_TYPE(op, &_PyDictSharedKeys_Type)) {
             if (PyList_Append(py_list, op)) {
                 return -1; /* exception */
             }
@@ -1670,6 +1673,7 @@ gc_collect_full(PyThreadState *tstate,
     gcstate->old[1].count = 0;
     completed_scavenge(gcstate);
     _PyGC_ClearAllFreeLists(tstate->interp);
+    _PyMem_ReleaseFreeMemoryIfNeeded(tstate->interp);
     validate_spaces(gcstate);
     add_stats(gcstate, 2, stats);
 }
@@ -1826,6 +1830,11 @@ referrersvisit(PyObject* obj, void *arg)
 {
     PyObject *objs = arg;
     Py_ssize_t i;
+    if (Py_IS_TYPE(obj, &_PyDictSharedKeys_Type)) {
+        // Report the dicts sharing the table as the referrers of its
+        // keys and values
+        return Py_TYPE(obj)->tp_traverse(obj, referrersvisit, objs);
+    }
     for (i = 0; i < PyTuple_GET_SIZE(objs); i++) {
         if (PyTuple_GET_ITEM(objs, i) == obj) {
             return 1;
@@ -1843,7 +1852,9 @@ gc_referrers_for(PyObject *objs, PyGC_Head *list, PyObject *resultlist)
     for (gc = GC_NEXT(list); gc != list; gc = GC_NEXT(gc)) {
         obj = FROM_GC(gc);
         traverse = Py_TYPE(obj)->tp_traverse;
-        if (obj == objs || obj == resultlist) {
+        if (obj == objs || obj == resultlist ||
+            Py_IS_TYPE(obj, &_PyDictSharedKeys_Type))
+        {
             continue;
         }
         if (traverse(obj, referrersvisit, objs)) {
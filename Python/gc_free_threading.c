@@ -372,15 +372,20 @@ gc_visit_heaps_lock_held(PyInterpreterState *interp, mi_block_visit_fun *visitor
             continue;
         }
 
-        arg->offset = offset_base;
-        if (!mi_heap_visit_blocks(&m->heaps[_Py_MIMALLOC_HEAP_GC], true,
-                                  visitor, arg)) {
-            return -1;
-        }
-        arg->offset = offset_pre;
-        if (!mi_heap_visit_blocks(&m->heaps[_Py_MIMALLOC_HEAP_GC_PRE], true,
-                                  visitor, arg)) {
-            return -1;
+        // The scoped heaps hold the objects allocated in an allocation
+        // scope which is not exited yet.
+        mi_heap_t *heaps[] = {m->heaps, m->scoped_heaps};
+        for (size_t i = 0; i < Py_ARRAY_LENGTH(heaps); i++) {
+            arg->offset = offset_base;
+            if (!mi_heap_visit_blocks(&heaps[i][_Py_MIMALLOC_HEAP_GC], true,
+                                      visitor, arg)) {
+                return -1;
+            }
+            arg->offset = offset_pre;
+            if (!mi_heap_visit_blocks(&heaps[i][_Py_MIMALLOC_HEAP_GC_PRE],
+                                      true, visitor, arg)) {
+                return -1;
+            }
         }
     }
 
@@ -353,6 +353,10 @@ static const char usage_envvars[] =
 "                  on Python memory allocators.  Use PYTHONMALLOC=debug to\n"
 "                  install debug hooks.\n"
 "PYTHONMALLOCSTATS: print memory allocator statistics\n"
+"PYTHON_MALLOC_HUGEPAGES: back memory allocator arenas with huge pages\n"
+"PYTHON_MALLOC_NUMA: place memory allocator arenas on the local NUMA node\n"
+"PYTHON_MALLOC_RELEASE_THRESHOLD: after full collections, give free memory\n"
+"                  allocator pools back to the OS once they reach this size\n"
 "PYTHONCOERCECLOCALE: if this variable is set to 0, it disables the locale\n"
 "                  coercion behavior.  Use PYTHONCOERCECLOCALE=warn to request\n"
 "                  display of locale coercion and locale compatibility warnings\n"
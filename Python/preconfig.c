@@ -922,6 +922,38 @@ _PyPreConfig_Read(PyPreConfig *config, const _PyArgv *args)
 }
 
 
+/* Parse a number of bytes, optionally followed by K, M or G (multiples of
+   1024).  Return -1 if str is not such a size or if it overflows size_t. */
+static int
+str_to_size(const char *str, size_t *result)
+{
+    if (!Py_ISDIGIT(*str)) {
+        return -1;
+    }
+    const char *endptr = str;
+    errno = 0;
+    unsigned long long value = strtoull(str, (char **)&endptr, 10);
+    if (errno == ERANGE || value > SIZE_MAX) {
+        return -1;
+    }
+    int shift = 0;
+    if (*endptr != '\0') {
+        const char *units = "KMG";
+        const char *unit = strchr(units, Py_TOUPPER(*endptr));
+        if (unit == NULL) {
+            return -1;
+        }
+        shift = 10 * (int)(unit - units + 1);
+        endptr++;
+    }
+    if (*endptr != '\0' || value > (SIZE_MAX >> shift)) {
+        return -1;
+    }
+    *result = (size_t)value << shift;
+    return 0;
+}
+
+
 /* Write the pre-configuration:
 
    - set the memory allocators
@@ -957,6 +989,24 @@ _PyPreConfig_Write(const PyPreConfig *src_config)
         }
     }
 
+    int hugepages = 0, numa = 0;
+    _Py_get_env_flag(config.use_environment, &hugepages,
+                     "PYTHON_MALLOC_HUGEPAGES");
+    _Py_get_env_flag(config.use_environment, &numa, "PYTHON_MALLOC_NUMA");
+    if (hugepages || numa) {
+        _PyMem_SetArenaOptions(hugepages, numa);
+    }
+
+    size_t release_threshold = 0;
+    const char *env = _Py_GetEnv(config.use_environment,
+                                 "PYTHON_MALLOC_RELEASE_THRESHOLD");
+    if (env && str_to_size(env, &release_threshold) < 0) {
+        return _PyStatus_ERR("PYTHON_MALLOC_RELEASE_THRESHOLD must be "
+                             "a number of bytes, optionally followed by "
+                             "K, M or G");
+    }
+    _PyRuntime.allocators.release_threshold = release_threshold;
+
     preconfig_set_global_vars(&config);
 
     if (config.configure_locale) {
@@ -7,6 +7,7 @@
 #include "pycore_ceval.h"
 #include "pycore_code.h"          // stats
 #include "pycore_critical_section.h"       // _PyCriticalSection_Resume()
+#include "pycore_dict.h"          // _PyDict_ClearSharedKeys()
 #include "pycore_dtoa.h"          // _dtoa_state_INIT()
 #include "pycore_emscripten_trampoline.h"  // _Py_EmscriptenTrampoline_Init()
 #include "pycore_frame.h"
@@ -909,6 +910,7 @@ interpreter_clear(PyInterpreterState *interp, PyThreadState *tstate)
     for (int i=0; i < DICT_MAX_WATCHERS; i++) {
         interp->dict_state.watchers[i] = NULL;
     }
+    _PyDict_ClearSharedKeys(interp);
 
     for (int i=0; i < TYPE_MAX_WATCHERS; i++) {
         interp->type_watchers[i] = NULL;
@@ -3057,6 +3059,15 @@ tstate_mimalloc_bind(PyThreadState *tstate)
 
     // Initialize each heap
     for (uint8_t i = 0; i < _Py_MIMALLOC_HEAP_COUNT; i++) {
+        if (i >= _Py_MIMALLOC_HEAP_OBJECT) {
+            // A scoped heap shares the tag of the regular heap. It is
+            // initialized first because mimalloc reclaims abandoned pages
+            // into the most recently initialized heap with a matching tag.
+            _mi_heap_init_ex(&mts->scoped_heaps[i], tld, _mi_arena_id_none(),
+                             false, i);
+            mts->scoped_heaps[i].debug_offset = (uint8_t)debug_offsets[i];
+            mts->scoped_heaps[i].page_use_qsbr = true;
+        }
         _mi_heap_init_ex(&mts->heaps[i], tld, _mi_arena_id_none(), false, i);
         mts->heaps[i].debug_offset = (uint8_t)debug_offsets[i];
     }
@@ -3092,6 +3103,9 @@ _PyThreadState_ClearMimallocHeaps(PyThreadState *tstate)
         // to do this before the thread state is destroyed so that objects
         // remain visible to the GC.
         _mi_heap_collect_abandon(&tstate_impl->mimalloc.heaps[i]);
+        if (i >= _Py_MIMALLOC_HEAP_OBJECT) {
+            _mi_heap_collect_abandon(&tstate_impl->mimalloc.scoped_heaps[i]);
+        }
     }
 #endif
 }
@@ -2150,6 +2150,101 @@ sys__clear_type_cache_impl(PyObject *module)
     Py_RETURN_NONE;
 }
 
+/*[clinic input]
+sys._enter_allocation_scope
+
+Start placing new objects of this thread in separate heaps.
+
+Objects allocated until the matching _exit_allocation_scope() call are kept
+apart from longer-lived objects, so that their memory can be released
+together once they die.  Scopes can be nested.  Only the free-threaded
+build keeps separate heaps.
+[clinic start generated code]*/
+
+static PyObject *
+sys__enter_allocation_scope_impl(PyObject *module)
+/*[clinic end generated code: output=39d6c0b62dae6525 input=8734e96caf8652e5]*/
+{
+    _PyMem_EnterAllocationScope(_PyThreadState_GET());
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+sys._exit_allocation_scope
+
+Exit the innermost scope entered by _enter_allocation_scope().
+
+Memory of the outermost scope that is no longer used is released, and
+objects that are still alive are moved to the regular heap.
+[clinic start generated code]*/
+
+static PyObject *
+sys__exit_allocation_scope_impl(PyObject *module)
+/*[clinic end generated code: output=2b1c1fa15e586909 input=0ad1226bf8e9b50e]*/
+{
+    if (_PyMem_ExitAllocationScope(_PyThreadState_GET()) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+/* sys._allocation_scope: context manager entering an allocation scope */
+
+static PyObject *
+allocation_scope_enter(PyObject *self, PyObject *Py_UNUSED(ignored))
+{
+    _PyMem_EnterAllocationScope(_PyThreadState_GET());
+    return Py_NewRef(self);
+}
+
+static PyObject *
+allocation_scope_exit(PyObject *self, PyObject *Py_UNUSED(args))
+{
+    if (_PyMem_ExitAllocationScope(_PyThreadState_GET()) < 0) {
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef allocation_scope_methods[] = {
+    {"__enter__", allocation_scope_enter, METH_NOARGS, NULL},
+    {"__exit__", allocation_scope_exit, METH_VARARGS, NULL},
+    {NULL, NULL}
+};
+
+PyDoc_STRVAR(allocation_scope_doc,
+"_allocation_scope()\n\
+--\n\
+\n\
+Context manager running its block in an allocation scope.\n\
+\n\
+See _enter_allocation_scope().");
+
+PyTypeObject _PyAllocationScope_Type = {
+    PyVarObject_HEAD_INIT(&PyType_Type, 0)
+    .tp_name = "sys._allocation_scope",
+    .tp_basicsize = sizeof(PyObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = allocation_scope_doc,
+    .tp_methods = allocation_scope_methods,
+    .tp_new = PyType_GenericNew,
+};
+
+/*[clinic input]
+sys._release_free_memory -> Py_ssize_t
+
+Give the memory of free allocator pools and pages back to the OS.
+
+Return the number of bytes released from pymalloc pools.
+[clinic start generated code]*/
+
+static Py_ssize_t
+sys__release_free_memory_impl(PyObject *module)
+/*[clinic end generated code: output=60f4279a74937f53 input=059d822c12d2f501]*/
+{
+    return _PyMem_ReleaseFreeMemory(_PyInterpreterState_GET());
+}
+
 /*[clinic input]
 sys._clear_internal_caches
 
@@ -2580,6 +2675,9 @@ static PyMethodDef sys_methods[] = {
      METH_FASTCALL | METH_KEYWORDS, breakpointhook_doc},
     SYS__CLEAR_INTERNAL_CACHES_METHODDEF
     SYS__CLEAR_TYPE_CACHE_METHODDEF
+    SYS__ENTER_ALLOCATION_SCOPE_METHODDEF
+    SYS__EXIT_ALLOCATION_SCOPE_METHODDEF
+    SYS__RELEASE_FREE_MEMORY_METHODDEF
     SYS__CURRENT_FRAMES_METHODDEF
     SYS__CURRENT_EXCEPTIONS_METHODDEF
     SYS_DISPLAYHOOK_METHODDEF
@@ -3561,6 +3659,7 @@ _PySys_InitCore(PyThreadState *tstate, PyObject *sysdict)
     SET_SYS_FROM_STRING("copyright", Py_GetCopyright());
     SET_SYS_FROM_STRING("platform", Py_GetPlatform());
     SET_SYS("maxsize", PyLong_FromSsize_t(PY_SSIZE_T_MAX));
+    SET_SYS("_allocation_scope", Py_NewRef(&_PyAllocationScope_Type));
     SET_SYS("float_info", PyFloat_GetInfo());
     SET_SYS("int_info", PyLong_GetInfo());
     /* initialize hash_info */
@@ -83,6 +83,33 @@ def generator():
             accu += v
     return accu
 
+async def simple_coro(i):
+    return i
+
+async def await_coros():
+    accu = 0
+    for i in range(10):
+        accu += await simple_coro(i)
+    return accu
+
+@register_benchmark
+def coroutine():
+    accu = 0
+    for i in range(100 * WORK_SCALE):
+        try:
+            await_coros().send(None)
+        except StopIteration as e:
+            accu += e.value
+    return accu
+
+@register_benchmark
+def enumerate_range():
+    accu = 0
+    for i in range(100 * WORK_SCALE):
+        for j, v in enumerate(range(10)):
+            accu += j + v
+    return accu
+
 class Counter:
     def __init__(self):
         self.i = 0
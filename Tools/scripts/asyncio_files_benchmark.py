@@ -0,0 +1,171 @@
+#!/usr/bin/env python3
+#
+# Serve small files over loopback TCP connections, like a static file
+# server, and compare the ways to read them from asyncio:
+#
+# * blocking: open() and read() in the event loop, which blocks it;
+# * executor: the same in loop.run_in_executor();
+# * open_file: asyncio.open_file(), which runs the operations in the
+#   thread pool of the _asyncio module with the selector event loop.
+#
+# Each client requests a random file by name, waits for its content, and
+# repeats.  The files are in the page cache: the benchmark measures the
+# overhead of the asynchronous operations, not the disk.
+#
+#   ./python Tools/scripts/asyncio_files_benchmark.py
+#   ./python Tools/scripts/asyncio_files_benchmark.py --clients 100 --size 65536
+
+import argparse
+import asyncio
+import os
+import random
+import selectors
+import sys
+import tempfile
+from time import perf_counter as now
+
+
+def create_files(directory, count, size):
+    names = []
+    for i in range(count):
+        name = f'file{i:05}.html'
+        with open(os.path.join(directory, name), 'wb') as f:
+            f.write(os.urandom(size))
+        names.append(name.encode())
+    return names
+
+
+def _read(path):
+    with open(path, 'rb') as f:
+        return f.read()
+
+
+async def read_blocking(path):
+    return _read(path)
+
+
+async def read_executor(path):
+    loop = asyncio.get_running_loop()
+    return await loop.run_in_executor(None, _read, path)
+
+
+async def read_open_file(path):
+    async with await asyncio.open_file(path) as f:
+        return await f.read()
+
+
+class FileServer(asyncio.Protocol):
+    # Requests are file names terminated by a newline.
+
+    def __init__(self, directory, read_file):
+        self.directory = os.fsencode(directory)
+        self.read_file = read_file
+        self.buffer = b''
+
+    def connection_made(self, transport):
+        self.transport = transport
+
+    def data_received(self, data):
+        self.buffer += data
+        while (end := self.buffer.find(b'\n')) >= 0:
+            name = self.buffer[:end]
+            self.buffer = self.buffer[end + 1:]
+            asyncio.create_task(self.serve(name))
+
+    async def serve(self, name):
+        data = await self.read_file(os.path.join(self.directory, name))
+        self.transport.write(data)
+
+
+class Client(asyncio.Protocol):
+    # Request a random file, wait for its content, and repeat.
+
+    def __init__(self, names, size, count, done):
+        self.names = names
+        self.size = size
+        self.count = count
+        self.done = done
+        self.received = 0
+
+    def connection_made(self, transport):
+        self.transport = transport
+        self.request()
+
+    def request(self):
+        self.transport.write(random.choice(self.names) + b'\n')
+
+    def data_received(self, data):
+        self.received += len(data)
+        if self.received < self.size:
+            return
+        self.received = 0
+        self.count -= 1
+        if self.count:
+            self.request()
+        else:
+            self.transport.close()
+            self.done.set_result(None)
+
+
+async def serve_files(args, directory, names, read_file):
+    loop = asyncio.get_running_loop()
+    server = await loop.create_server(
+        lambda: FileServer(directory, read_file), '127.0.0.1', 0)
+    addr = server.sockets[0].getsockname()
+    done = []
+    for _ in range(args.clients):
+        fut = loop.create_future()
+        await loop.create_connection(
+            lambda: Client(names, args.size, args.requests, fut), *addr)
+        done.append(fut)
+    await asyncio.gather(*done)
+    server.close()
+    await server.wait_closed()
+
+
+def new_selector_loop():
+    return asyncio.SelectorEventLoop(selectors.DefaultSelector())
+
+
+def run(loop_factory, coro):
+    loop = loop_factory()
+    try:
+        t0 = now()
+        loop.run_until_complete(coro)
+        return now() - t0
+    finally:
+        loop.run_until_complete(loop.shutdown_default_executor())
+        loop.close()
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--files', type=int, default=1000)
+    parser.add_argument('--size', type=int, default=4096,
+                        help='size of the files')
+    parser.add_argument('--clients', type=int, default=50)
+    parser.add_argument('--requests', type=int, default=200,
+                        help='requests per client')
+    args = parser.parse_args()
+
+    loops = [('epoll', new_selector_loop)]
+
+    print(sys.version)
+    print(f'{args.files} files of {args.size} bytes, {args.clients} clients, '
+          f'{args.requests} requests per client')
+    total = args.clients * args.requests
+    readers = [('blocking', read_blocking), ('executor', read_executor),
+               ('open_file', read_open_file)]
+    with tempfile.TemporaryDirectory() as directory:
+        names = create_files(directory, args.files, args.size)
+        for reader_name, read_file in readers:
+            for loop_name, loop_factory in loops:
+                dt = min(run(loop_factory,
+                             serve_files(args, directory, names, read_file))
+                         for _ in range(3))
+                print(f'{reader_name:9} {loop_name:9} {total / dt:9.0f} req/s '
+                      f'{dt / total * 1e6:8.1f} us/req')
+
+
+if __name__ == '__main__':
+    main()
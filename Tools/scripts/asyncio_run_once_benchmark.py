@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+#
+# Measure the number of callbacks per second run by the asyncio event loop
+# with the C and with the pure Python implementations of Handle,
+# TimerHandle and BaseEventLoop._run_once():
+#
+# * call_soon: chains of callbacks, each one scheduling the next one;
+# * call_later: timers firing in the same iteration;
+# * call_later_cancel: timers which are cancelled before they fire;
+# * tasks: tasks yielding to the event loop with asyncio.sleep(0).
+#
+#   ./python Tools/scripts/asyncio_run_once_benchmark.py
+#   ./python Tools/scripts/asyncio_run_once_benchmark.py --count 1000000
+
+import argparse
+import asyncio
+import sys
+from contextlib import contextmanager
+from time import perf_counter as now
+from unittest import mock
+from asyncio import base_events, events
+
+
+def call_soon(loop, count, chains=100):
+    done = loop.create_future()
+    remaining = count
+
+    def callback():
+        nonlocal remaining
+        remaining -= 1
+        if remaining >= chains:
+            loop.call_soon(callback)
+        elif remaining == 0:
+            done.set_result(None)
+
+    for _ in range(chains):
+        loop.call_soon(callback)
+    return done
+
+
+def call_later(loop, count, batch=1000):
+    done = loop.create_future()
+    remaining = count
+
+    def callback():
+        nonlocal remaining
+        remaining -= 1
+        if remaining == 0:
+            done.set_result(None)
+        elif remaining % batch == 0:
+            schedule()
+
+    def schedule():
+        for i in range(batch):
+            loop.call_later(i * 1e-9, callback)
+
+    schedule()
+    return done
+
+
+def call_later_cancel(loop, count, batch=1000):
+    done = loop.create_future()
+    remaining = count
+
+    def callback():
+        nonlocal remaining
+        for _ in range(batch):
+            loop.call_later(3600, callback).cancel()
+        remaining -= batch
+        if remaining <= 0:
+            done.set_result(None)
+        else:
+            loop.call_soon(callback)
+
+    loop.call_soon(callback)
+    return done
+
+
+def tasks(loop, count, workers=100):
+    async def worker(n):
+        for _ in range(n):
+            await asyncio.sleep(0)
+
+    async def main():
+        await asyncio.gather(*(worker(count // workers)
+                               for _ in range(workers)))
+
+    return main()
+
+
+BENCHMARKS = [call_soon, call_later, call_later_cancel, tasks]
+
+
+@contextmanager
+def python_implementation():
+    with mock.patch.object(base_events, '_c_run_once', None), \
+         mock.patch.multiple(events, Handle=events._PyHandle,
+                             TimerHandle=events._PyTimerHandle):
+        yield
+
+
+def run(bench, count):
+    loop = asyncio.new_event_loop()
+    try:
+        t0 = now()
+        loop.run_until_complete(bench(loop, count))
+        return now() - t0
+    finally:
+        loop.close()
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--count', type=int, default=200_000,
+                        help='callbacks per benchmark')
+    args = parser.parse_args()
+
+    if base_events._c_run_once is None:
+        sys.exit('the C implementation of _run_once() is not available')
+    print(sys.version)
+    for bench in BENCHMARKS:
+        with python_implementation():
+            dt_py = min(run(bench, args.count) for _ in range(3))
+        dt_c = min(run(bench, args.count) for _ in range(3))
+        print(f'{bench.__name__:18} '
+              f'Python {args.count / dt_py:10.0f}/s  '
+              f'C {args.count / dt_c:10.0f}/s  '
+              f'{dt_py / dt_c:4.2f}x faster')
+
+
+if __name__ == '__main__':
+    main()
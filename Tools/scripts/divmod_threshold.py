@@ -1,11 +1,11 @@
 #!/usr/bin/env python3
 #
-# Determine threshold for switching from longobject.c divmod to
-# _pylong.int_divmod().
+# Determine threshold for switching from longobject.c schoolbook divmod to
+# Burnikel-Ziegler division (see use_bz_division() in longobject.c).
 
 from random import randrange
 from time import perf_counter as now
-from _pylong import int_divmod as divmod_fast
+from _testinternalcapi import long_divrem_bz as divmod_fast
 
 BITS_PER_DIGIT = 30
 
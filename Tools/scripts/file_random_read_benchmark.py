@@ -0,0 +1,102 @@
+#!/usr/bin/env python3
+#
+# Measure the number of random-access reads per second of small records from
+# a large read-only file:
+#
+# * buffered: seek() and read() on open(path, 'rb');
+# * unbuffered: seek() and read() on open(path, 'rb', buffering=0);
+# * mmap: seek() and read() on open(path, 'rb', mmap=True);
+# * getbuffer: slices of the memoryview returned by getbuffer(), in mmap mode.
+#
+#   ./python Tools/scripts/file_random_read_benchmark.py
+#   ./python Tools/scripts/file_random_read_benchmark.py --record-size 4096
+
+import argparse
+import os
+import random
+import sys
+import tempfile
+from time import perf_counter as now
+
+
+def create_file(path, size):
+    block = bytes(range(256)) * 4096
+    with open(path, 'wb') as f:
+        written = 0
+        while written < size:
+            written += f.write(block)
+
+
+def read_seek(path, offsets, record_size, **kwargs):
+    with open(path, 'rb', **kwargs) as f:
+        for offset in offsets:
+            f.seek(offset)
+            f.read(record_size)
+
+
+def read_buffered(path, offsets, record_size):
+    read_seek(path, offsets, record_size)
+
+
+def read_unbuffered(path, offsets, record_size):
+    read_seek(path, offsets, record_size, buffering=0)
+
+
+def read_mmap(path, offsets, record_size):
+    read_seek(path, offsets, record_size, mmap=True)
+
+
+def read_getbuffer(path, offsets, record_size):
+    with open(path, 'rb', mmap=True) as f:
+        view = f.getbuffer()
+        for offset in offsets:
+            view[offset:offset + record_size]
+        view.release()
+
+
+BENCHMARKS = [read_buffered, read_unbuffered, read_mmap, read_getbuffer]
+
+
+def run(args, bench, offsets):
+    best = float('inf')
+    for _ in range(3):
+        t0 = now()
+        bench(args.path, offsets, args.record_size)
+        best = min(best, now() - t0)
+    return best
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('path', nargs='?',
+                        help='file to read (default: a temporary file)')
+    parser.add_argument('--size', type=int, default=256,
+                        help='size of the temporary file in MiB')
+    parser.add_argument('--record-size', type=int, default=100)
+    parser.add_argument('--count', type=int, default=200_000,
+                        help='reads per benchmark')
+    args = parser.parse_args()
+
+    print(sys.version)
+    tmpdir = None
+    if args.path is None:
+        tmpdir = tempfile.TemporaryDirectory()
+        args.path = os.path.join(tmpdir.name, 'records')
+        create_file(args.path, args.size * 1024 * 1024)
+    try:
+        size = os.path.getsize(args.path)
+        rand = random.Random(0)
+        offsets = [rand.randrange(size - args.record_size)
+                   for _ in range(args.count)]
+        print(f'{args.path}: {size / (1024 * 1024):.0f} MiB, '
+              f'{args.count} reads of {args.record_size} bytes')
+        for bench in BENCHMARKS:
+            dt = run(args, bench, offsets)
+            print(f'{bench.__name__:16} {args.count / dt:10.0f} reads/s')
+    finally:
+        if tmpdir is not None:
+            tmpdir.cleanup()
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+#
+# Measure the throughput of scanning a large file from start to end with
+# open() and open(sequential=True):
+#
+# * read: binary reads of a fixed size;
+# * readline: binary lines;
+# * lines: iteration over the lines of a text file.
+#
+# With --cold, the file is evicted from the page cache before each run, so
+# that the disk (or the network filesystem) is actually read.
+#
+#   ./python Tools/scripts/file_scan_benchmark.py
+#   ./python Tools/scripts/file_scan_benchmark.py --size 1024 --cold /mnt/nfs/f
+
+import argparse
+import os
+import sys
+import tempfile
+from time import perf_counter as now
+
+
+def create_file(path, size):
+    line = b'x' * 79 + b'\n'
+    block = line * (1024 * 1024 // len(line))
+    with open(path, 'wb') as f:
+        written = 0
+        while written < size:
+            written += f.write(block)
+        f.flush()
+        os.fsync(f.fileno())
+
+
+def evict(path):
+    # Drop the clean pages of the file from the page cache.
+    fd = os.open(path, os.O_RDONLY)
+    try:
+        os.posix_fadvise(fd, 0, 0, os.POSIX_FADV_DONTNEED)
+    finally:
+        os.close(fd)
+
+
+def scan_read(path, sequential, chunk_size):
+    with open(path, 'rb', sequential=sequential) as f:
+        while f.read(chunk_size):
+            pass
+
+
+def scan_readline(path, sequential, chunk_size):
+    with open(path, 'rb', sequential=sequential) as f:
+        for line in f:
+            pass
+
+
+def scan_lines(path, sequential, chunk_size):
+    with open(path, encoding='ascii', sequential=sequential) as f:
+        for line in f:
+            pass
+
+
+BENCHMARKS = [scan_read, scan_readline, scan_lines]
+
+
+def run(args, bench, sequential):
+    best = float('inf')
+    for _ in range(args.repeat):
+        if args.cold:
+            evict(args.path)
+        t0 = now()
+        bench(args.path, sequential, args.chunk_size)
+        best = min(best, now() - t0)
+    return best
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('path', nargs='?',
+                        help='file to scan (default: a temporary file)')
+    parser.add_argument('--size', type=int, default=256,
+                        help='size of the temporary file in MiB')
+    parser.add_argument('--chunk-size', type=int, default=4096,
+                        help='size of the binary reads')
+    parser.add_argument('--repeat', type=int, default=3)
+    parser.add_argument('--cold', action='store_true',
+                        help='evict the file from the page cache before '
+                             'each run')
+    args = parser.parse_args()
+
+    if args.cold and not hasattr(os, 'posix_fadvise'):
+        sys.exit('--cold requires os.posix_fadvise()')
+    print(sys.version)
+    tmpdir = None
+    if args.path is None:
+        tmpdir = tempfile.TemporaryDirectory()
+        args.path = os.path.join(tmpdir.name, 'scan')
+        create_file(args.path, args.size * 1024 * 1024)
+    try:
+        size = os.path.getsize(args.path) / (1024 * 1024)
+        print(f'{args.path}: {size:.0f} MiB, '
+              f'{"cold" if args.cold else "warm"} cache')
+        for bench in BENCHMARKS:
+            dt_default = run(args, bench, False)
+            dt_sequential = run(args, bench, True)
+            print(f'{bench.__name__:14} '
+                  f'default {size / dt_default:8.0f} MiB/s  '
+                  f'sequential {size / dt_sequential:8.0f} MiB/s  '
+                  f'{dt_default / dt_sequential:4.2f}x faster')
+    finally:
+        if tmpdir is not None:
+            tmpdir.cleanup()
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,60 @@
+#!/usr/bin/env python3
+#
+# Determine the thresholds for switching from Karatsuba to Toom-3 and to
+# NTT multiplication in longobject.c (TOOM3_CUTOFF and NTT_CUTOFF).
+#
+# For each size, the time of the built-in multiplication, which uses the
+# algorithm selected by the current cutoffs, is compared with the time of
+# Toom-3 and of the NTT forced at the top level.  A forced algorithm that is
+# faster than the built-in one below its cutoff means that the cutoff should
+# be lowered.
+
+from random import randrange
+from time import perf_counter as now
+import sys
+import _testinternalcapi
+
+BITS_PER_DIGIT = sys.int_info.bits_per_digit
+
+
+def rand_digits(n):
+    top = 1 << (n * BITS_PER_DIGIT)
+    return randrange(top >> 1, top)
+
+
+def best_time(func, a, b, repeat=5):
+    best = None
+    for _ in range(repeat):
+        t0 = now()
+        func(a, b)
+        t1 = now()
+        if best is None or t1 - t0 < best:
+            best = t1 - t0
+    return best
+
+
+def probe(nd):
+    a = rand_digits(nd)
+    b = rand_digits(nd)
+    expected = a * b
+    assert _testinternalcapi.long_mul_toom3(a, b) == expected
+    assert _testinternalcapi.long_mul_ntt(a, b) == expected
+    times = {
+        'builtin': best_time(lambda x, y: x * y, a, b),
+        'toom3': best_time(_testinternalcapi.long_mul_toom3, a, b),
+        'ntt': best_time(_testinternalcapi.long_mul_ntt, a, b),
+    }
+    fastest = min(times, key=times.get)
+    print(f"{nd:7} digits:",
+          "  ".join(f"{name} {t * 1e6:10.1f} us" for name, t in times.items()),
+          f"  fastest: {fastest}")
+
+
+def main():
+    for nd in (100, 150, 200, 250, 300, 400, 600, 800, 1000, 1200, 1400,
+               1600, 2000, 3000, 5000, 10_000, 50_000):
+        probe(nd)
+
+
+if __name__ == '__main__':
+    main()
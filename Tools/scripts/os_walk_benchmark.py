@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+#
+# Time os.walk() over a large synthetic directory tree, as in backup and
+# indexing jobs:
+#
+# * topdown: os.walk(top);
+# * bottomup: os.walk(top, topdown=False);
+# * threads: one os.walk() per top-level subdirectory in a thread pool,
+#   which scales with the number of CPUs on free-threaded builds;
+# * rglob: pathlib.Path(top).rglob('*').
+#
+#   ./python Tools/scripts/os_walk_benchmark.py
+#   ./python Tools/scripts/os_walk_benchmark.py --dirs 100 --files 1000
+#   ./python Tools/scripts/os_walk_benchmark.py /usr/lib
+
+import argparse
+import os
+import pathlib
+import sys
+import tempfile
+from concurrent.futures import ThreadPoolExecutor
+from time import perf_counter as now
+
+
+def create_tree(top, ndirs, nfiles):
+    for i in range(ndirs):
+        subdir = os.path.join(top, f'dir{i:04}')
+        for j in range(4):
+            os.makedirs(os.path.join(subdir, f'sub{j}'))
+        for j in range(nfiles):
+            path = os.path.join(subdir, f'sub{j % 4}', f'file{j:05}.dat')
+            open(path, 'wb').close()
+
+
+def walk_topdown(top, threads):
+    return sum(len(dirs) + len(files) for _, dirs, files in os.walk(top))
+
+
+def walk_bottomup(top, threads):
+    return sum(len(dirs) + len(files)
+               for _, dirs, files in os.walk(top, topdown=False))
+
+
+def _count(top):
+    return sum(len(dirs) + len(files) for _, dirs, files in os.walk(top))
+
+
+def walk_threads(top, threads):
+    _, dirs, files = next(os.walk(top))
+    with ThreadPoolExecutor(threads) as executor:
+        paths = [os.path.join(top, name) for name in dirs]
+        return len(dirs) + len(files) + sum(executor.map(_count, paths))
+
+
+def rglob(top, threads):
+    return sum(1 for _ in pathlib.Path(top).rglob('*'))
+
+
+BENCHMARKS = [walk_topdown, walk_bottomup, walk_threads, rglob]
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('path', nargs='?',
+                        help='tree to walk (default: a temporary tree)')
+    parser.add_argument('--dirs', type=int, default=50,
+                        help='top-level directories of the temporary tree')
+    parser.add_argument('--files', type=int, default=2000,
+                        help='files per top-level directory')
+    parser.add_argument('--threads', type=int, default=os.cpu_count())
+    parser.add_argument('--repeat', type=int, default=5)
+    args = parser.parse_args()
+
+    print(sys.version)
+    tmpdir = None
+    if args.path is None:
+        tmpdir = tempfile.TemporaryDirectory()
+        args.path = tmpdir.name
+        create_tree(args.path, args.dirs, args.files)
+    try:
+        for bench in BENCHMARKS:
+            best = float('inf')
+            for _ in range(args.repeat):
+                t0 = now()
+                count = bench(args.path, args.threads)
+                best = min(best, now() - t0)
+            print(f'{bench.__name__:14} {count:9} entries '
+                  f'{best * 1e3:9.1f} ms {count / best:12.0f} entries/s')
+    finally:
+        if tmpdir is not None:
+            tmpdir.cleanup()
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,128 @@
+#!/usr/bin/env python3
+#
+# Time str and bytes searching methods (find, in, count, split, replace)
+# on synthetic web server log lines, one line at a time and on the whole
+# log at once.  The log is generated as ASCII, as Latin-1 (with a few
+# accented user names) and as UCS-2 (with a few Cyrillic user names) text,
+# since the search code is specialized for each string kind.
+#
+# Run it with two builds and compare the output, for example:
+#
+#   ./python Tools/scripts/strsearch_benchmark.py > before.txt
+#   ./python Tools/scripts/strsearch_benchmark.py > after.txt
+#   paste before.txt after.txt
+
+import random
+import sys
+from time import perf_counter as now
+
+NLINES = 20_000
+
+LEVELS = ['INFO'] * 20 + ['DEBUG'] * 10 + ['WARNING'] * 3 + ['ERROR']
+METHODS = ['GET'] * 8 + ['POST'] * 3 + ['PUT', 'DELETE']
+PATHS = ['/api/v1/users/{}', '/api/v1/orders/{}/items', '/static/js/app.{}.js',
+         '/healthz', '/api/v2/search?q=item{}&page=2', '/login', '/logout']
+AGENTS = ['Mozilla/5.0 (X11; Linux x86_64; rv:128.0) Gecko/20100101 Firefox/128.0',
+          'curl/8.5.0', 'python-requests/2.32.3',
+          'Mozilla/5.0 (Macintosh; Intel Mac OS X 14_5) AppleWebKit/605.1.15']
+USERS = {
+    'ascii': ['alice', 'bob', 'carol', 'dave', 'eve', 'mallory'],
+    'latin1': ['alice', 'bob', 'ren\xe9e', 'fran\xe7ois', 'j\xfcrgen', 'eve'],
+    'ucs2': ['alice', 'bob', '\u0438\u0432\u0430\u043d', 'eve',
+             '\u043e\u043b\u044c\u0433\u0430', 'mallory'],
+}
+
+
+def make_lines(kind, rand):
+    users = USERS[kind]
+    lines = []
+    for i in range(NLINES):
+        path = rand.choice(PATHS).format(rand.randrange(100_000))
+        status = rand.choice([200] * 30 + [201, 204, 301, 304, 404, 500])
+        lines.append(
+            f'2024-06-{rand.randrange(1, 31):02d}T{rand.randrange(24):02d}:'
+            f'{rand.randrange(60):02d}:{rand.randrange(60):02d}.'
+            f'{rand.randrange(1000):03d}Z {rand.choice(LEVELS)} '
+            f'[worker-{rand.randrange(16)}] 10.0.{rand.randrange(256)}.'
+            f'{rand.randrange(256)} - user={rand.choice(users)} | '
+            f'{rand.choice(METHODS)} {path} HTTP/1.1 | status={status} | '
+            f'bytes={rand.randrange(100_000)} | '
+            f'latency_ms={rand.random() * 500:.3f} | '
+            f'agent="{rand.choice(AGENTS)}"')
+    return lines
+
+
+def best_time(func, repeat=5):
+    best = None
+    for _ in range(repeat):
+        t0 = now()
+        func()
+        t1 = now()
+        if best is None or t1 - t0 < best:
+            best = t1 - t0
+    return best
+
+
+def per_line(lines, lit):
+    absent, orders, sep = lit('status=503'), lit('/api/v1/orders/'), lit(' | ')
+    old, new = lit('latency_ms='), lit('lat=')
+    def find_absent():
+        for line in lines:
+            line.find(absent)
+    def contains():
+        for line in lines:
+            orders in line
+    def count():
+        for line in lines:
+            line.count(sep)
+    def split():
+        for line in lines:
+            line.split(sep)
+    def replace():
+        for line in lines:
+            line.replace(old, new)
+    return [find_absent, contains, count, split, replace]
+
+
+def whole(text, lit):
+    absent, rare = lit('status=503'), lit('user=mallory | DELETE /api/v1/orders/9')
+    status, nl, sep, tab = lit('status=500'), lit('\n'), lit(' | '), lit('\t')
+    def find_absent():
+        text.find(absent)
+    def find_rare():
+        text.find(rare)
+    def count():
+        text.count(status)
+    def count_char():
+        text.count(nl)
+    def split_lines():
+        text.split(nl)
+    def split_sep():
+        text.split(sep)
+    def replace():
+        text.replace(sep, tab)
+    return [find_absent, find_rare, count, count_char, split_lines,
+            split_sep, replace]
+
+
+def main():
+    rand = random.Random(5)
+    print(sys.version)
+    for kind in USERS:
+        lines = make_lines(kind, rand)
+        text = '\n'.join(lines)
+        variants = [(kind, lines, text, str)]
+        if kind == 'ascii':
+            variants.append(('bytes', [line.encode() for line in lines],
+                             text.encode(), str.encode))
+        for name, lines, text, lit in variants:
+            for group, funcs in (('line', per_line(lines, lit)),
+                                 ('text', whole(text, lit))):
+                for func in funcs:
+                    t = best_time(func)
+                    print(f'{name:7} {group:5} {func.__name__:12} '
+                          f'{t * 1e3:9.3f} ms')
+
+
+if __name__ == '__main__':
+    main()
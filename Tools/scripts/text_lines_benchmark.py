@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+#
+# Time the iteration over the lines of a UTF-8 text file, as in log
+# processing, for LF and CRLF line endings, ASCII, Latin-1 and CJK text, and
+# the newline modes of open(): None (translated universal newlines), ''
+# (untranslated universal newlines) and '\n'.
+#
+# Run it with two builds and compare the output, for example:
+#
+#   ./python Tools/scripts/text_lines_benchmark.py > before.txt
+#   ./python Tools/scripts/text_lines_benchmark.py > after.txt
+#   paste before.txt after.txt
+
+import argparse
+import os
+import sys
+import tempfile
+from time import perf_counter as now
+
+LINE = ('2026-10-19 12:00:00 INFO worker-{} request handled in {} ms '
+        '{} path=/api/v1/items')
+
+TEXTS = {
+    'ascii': 'user=alice',
+    'latin1': 'user=zoë',
+    'cjk': 'user=山田太郎',
+}
+
+
+def create_file(path, text, line_ending, size):
+    with open(path, 'w', encoding='utf-8', newline='') as f:
+        written = i = 0
+        while written < size:
+            line = LINE.format(i % 17, i % 1000, text) + line_ending
+            written += len(line.encode())
+            f.write(line)
+            i += 1
+
+
+def iterate(path, newline):
+    with open(path, encoding='utf-8', newline=newline) as f:
+        for line in f:
+            pass
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--size', type=int, default=64,
+                        help='size of the files in MiB')
+    parser.add_argument('--repeat', type=int, default=5)
+    args = parser.parse_args()
+
+    print(sys.version)
+    size = args.size * 1024 * 1024
+    with tempfile.TemporaryDirectory() as tmpdir:
+        path = os.path.join(tmpdir, 'lines')
+        for name, text in TEXTS.items():
+            for line_ending, ending_name in [('\n', 'lf'), ('\r\n', 'crlf')]:
+                create_file(path, text, line_ending, size)
+                for newline in (None, '', '\n'):
+                    best = float('inf')
+                    for _ in range(args.repeat):
+                        t0 = now()
+                        iterate(path, newline)
+                        best = min(best, now() - t0)
+                    print(f'{name:6} {ending_name:4} '
+                          f'newline={newline!r:5} '
+                          f'{args.size / best:8.0f} MiB/s')
+
+
+if __name__ == '__main__':
+    main()
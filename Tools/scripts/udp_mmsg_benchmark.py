@@ -0,0 +1,155 @@
+#!/usr/bin/env python3
+#
+# Measure the number of UDP datagrams per second moved over the loopback
+# interface:
+#
+# * socket: sendto() and recvfrom() against sendmmsg() and recvmmsg_into(),
+#   one system call per burst of datagrams;
+# * asyncio: a datagram endpoint of the selector event loop receiving bursts
+#   of datagrams, with and without recvmmsg_into().
+#
+#   ./python Tools/scripts/udp_mmsg_benchmark.py
+#   ./python Tools/scripts/udp_mmsg_benchmark.py --size 1200 --burst 64
+
+import argparse
+import asyncio
+import socket
+import sys
+from contextlib import nullcontext
+from time import perf_counter as now
+from unittest import mock
+from asyncio import selector_events
+
+
+def socket_pair():
+    recv_sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    recv_sock.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 4 << 20)
+    recv_sock.bind(('127.0.0.1', 0))
+    send_sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    send_sock.connect(recv_sock.getsockname())
+    return send_sock, recv_sock
+
+
+def socket_single(args, send_sock, recv_sock):
+    data = b'x' * args.size
+    send_time = recv_time = 0
+    for _ in range(args.count // args.burst):
+        t0 = now()
+        for _ in range(args.burst):
+            send_sock.send(data)
+        t1 = now()
+        for _ in range(args.burst):
+            recv_sock.recvfrom(65536)
+        t2 = now()
+        send_time += t1 - t0
+        recv_time += t2 - t1
+    return send_time, recv_time
+
+
+def socket_batched(args, send_sock, recv_sock):
+    datagrams = [b'x' * args.size] * args.burst
+    buffers = [bytearray(65536) for _ in range(args.burst)]
+    send_time = recv_time = 0
+    for _ in range(args.count // args.burst):
+        t0 = now()
+        sent = 0
+        while sent < args.burst:
+            sent += send_sock.sendmmsg(datagrams[sent:])
+        t1 = now()
+        received = 0
+        while received < args.burst:
+            received += len(recv_sock.recvmmsg_into(buffers))
+        t2 = now()
+        send_time += t1 - t0
+        recv_time += t2 - t1
+    return send_time, recv_time
+
+
+class Receiver(asyncio.DatagramProtocol):
+    # Ask for a new burst of datagrams each time the previous one has been
+    # received.
+
+    def __init__(self, args, send_sock, done):
+        self.send_sock = send_sock
+        self.datagrams = [b'x' * args.size] * args.burst
+        self.burst = args.burst
+        self.remaining = args.count
+        self.done = done
+
+    def connection_made(self, transport):
+        self.send_burst()
+
+    def send_burst(self):
+        for data in self.datagrams:
+            self.send_sock.send(data)
+
+    def datagram_received(self, data, addr):
+        self.remaining -= 1
+        if self.remaining <= 0:
+            self.done.set_result(None)
+        elif self.remaining % self.burst == 0:
+            self.send_burst()
+
+
+async def asyncio_receive(args, send_sock, recv_sock):
+    loop = asyncio.get_running_loop()
+    done = loop.create_future()
+    transport, _ = await loop.create_datagram_endpoint(
+        lambda: Receiver(args, send_sock, done), sock=recv_sock)
+    t0 = now()
+    await done
+    dt = now() - t0
+    transport.close()
+    return dt
+
+
+def run_asyncio(args, use_mmsg):
+    send_sock, recv_sock = socket_pair()
+    patch = (nullcontext() if use_mmsg else
+             mock.patch.object(selector_events, '_HAS_MMSG', False))
+    with send_sock, patch:
+        return asyncio.run(asyncio_receive(args, send_sock, recv_sock),
+                           loop_factory=asyncio.SelectorEventLoop)
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument('--count', type=int, default=200_000,
+                        help='datagrams per benchmark')
+    parser.add_argument('--size', type=int, default=100,
+                        help='datagram size')
+    parser.add_argument('--burst', type=int, default=16,
+                        help='datagrams sent before reading them')
+    args = parser.parse_args()
+
+    if not hasattr(socket.socket, 'recvmmsg_into'):
+        sys.exit('recvmmsg_into() and sendmmsg() are not available')
+    print(sys.version)
+    print(f'{args.count} datagrams of {args.size} bytes, '
+          f'bursts of {args.burst}')
+
+    results = {}
+    for name, func in [('single', socket_single),
+                       ('batched', socket_batched)]:
+        send_sock, recv_sock = socket_pair()
+        with send_sock, recv_sock:
+            results[name] = min((func(args, send_sock, recv_sock)
+                                 for _ in range(3)), key=sum)
+    for i, op in enumerate(['send', 'recv']):
+        dt_single = results['single'][i]
+        dt_batched = results['batched'][i]
+        print(f'socket {op:9} '
+              f'single {args.count / dt_single:10.0f}/s  '
+              f'batched {args.count / dt_batched:10.0f}/s  '
+              f'{dt_single / dt_batched:4.2f}x faster')
+
+    dt_single = min(run_asyncio(args, False) for _ in range(3))
+    dt_batched = min(run_asyncio(args, True) for _ in range(3))
+    print(f'asyncio receive  '
+          f'single {args.count / dt_single:10.0f}/s  '
+          f'batched {args.count / dt_batched:10.0f}/s  '
+          f'{dt_single / dt_batched:4.2f}x faster')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+#
+# Time UTF-8 decoding and encoding of synthetic text in several scripts:
+# ASCII, Latin-1 (accented Latin letters), Cyrillic and Greek (2-byte
+# sequences), CJK (3-byte sequences) and ASCII text with a few emoji
+# (4-byte sequences).  Each text is timed as a list of short lines and as
+# a single large buffer.
+#
+# Run it with two builds and compare the output, for example:
+#
+#   ./python Tools/scripts/utf8_benchmark.py > before.txt
+#   ./python Tools/scripts/utf8_benchmark.py > after.txt
+#   paste before.txt after.txt
+
+import random
+import sys
+from time import perf_counter as now
+
+SIZE = 1 << 20
+LINE = 80
+
+ALPHABETS = {
+    'ascii': [chr(c) for c in range(ord('a'), ord('z') + 1)],
+    'latin1': ([chr(c) for c in range(ord('a'), ord('z') + 1)] * 4
+               + [chr(c) for c in range(0xe0, 0x100) if c != 0xf7]),
+    'cyrillic': [chr(c) for c in range(0x430, 0x450)],
+    'greek': [chr(c) for c in range(0x3b1, 0x3ca)],
+    'cjk': [chr(c) for c in range(0x4e00, 0x4e00 + 3000)],
+    'emoji': [chr(c) for c in range(ord('a'), ord('z') + 1)],
+}
+
+
+def make_text(kind, rand):
+    letters = ALPHABETS[kind]
+    words = []
+    length = 0
+    while length < SIZE:
+        if kind == 'cjk':
+            word = ''.join(rand.choices(letters, k=rand.randrange(4, 20)))
+            word += rand.choice('，。')
+        else:
+            word = ''.join(rand.choices(letters, k=rand.randrange(1, 10)))
+            if rand.random() < 0.1:
+                word += rand.choice(',.;:!?')
+            if rand.random() < 0.05:
+                word = str(rand.randrange(10_000))
+            if kind == 'emoji' and rand.random() < 0.05:
+                word += chr(rand.randrange(0x1f600, 0x1f650))
+            word += ' '
+        words.append(word)
+        length += len(word.encode())
+    return ''.join(words)
+
+
+def best_time(func, repeat=5):
+    best = None
+    for _ in range(repeat):
+        t0 = now()
+        func()
+        t1 = now()
+        if best is None or t1 - t0 < best:
+            best = t1 - t0
+    return best
+
+
+def main():
+    rand = random.Random(5)
+    print(sys.version)
+    for kind in ALPHABETS:
+        text = make_text(kind, rand)
+        data = text.encode()
+        lines = [text[i:i + LINE] for i in range(0, len(text), LINE)]
+        blines = [line.encode() for line in lines]
+        def decode():
+            data.decode()
+        def decode_lines():
+            for line in blines:
+                line.decode()
+        def encode():
+            text.encode()
+        def encode_lines():
+            for line in lines:
+                line.encode()
+        for func in decode, decode_lines, encode, encode_lines:
+            t = best_time(func)
+            print(f'{kind:9} {func.__name__:13} {t * 1e3:8.3f} ms '
+                  f'{len(data) / t / 1e9:6.2f} GB/s')
+
+
+if __name__ == '__main__':
+    main()